@@ -43,6 +43,10 @@ Image<TPixel, VImageDimension>::Allocate(bool initializePixels)
   this->ComputeOffsetTable();
   num = static_cast<SizeValueType>(this->GetOffsetTable()[VImageDimension]);
 
+  if (m_BufferAllocator)
+  {
+    m_Buffer->SetBufferAllocator(m_BufferAllocator);
+  }
   m_Buffer->Reserve(num, initializePixels);
 }
 
@@ -152,6 +156,7 @@ Image<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent) cons
 
   os << indent << "PixelContainer: " << std::endl;
   m_Buffer->Print(os, indent.GetNextIndent());
+  itkPrintSelfObjectMacro(BufferAllocator);
 
   // m_Origin and m_Spacing are printed in the Superclass
 }
@@ -19,6 +19,9 @@
 #define itkImageAlgorithm_h
 
 #include "itkImageRegionIterator.h"
+#include "itkDefaultPixelAccessor.h"
+#include "itkDefaultPixelAccessorFunctor.h"
+#include "itkIndexRange.h"
 
 #include <type_traits>
 
@@ -113,6 +116,44 @@ struct ImageAlgorithm
 
   /// \endcond
 
+  /** Whether the pixels of an image type are stored as such in its buffer,
+   * so that they can be read and written through a pointer to the buffer
+   * rather than through the pixel accessor. */
+  template <typename TImage>
+  static constexpr bool SupportsDirectPixelAccess =
+    std::is_same_v<typename TImage::PixelType, typename TImage::InternalPixelType> &&
+    std::is_same_v<typename TImage::AccessorType, DefaultPixelAccessor<typename TImage::PixelType>> &&
+    std::is_same_v<typename TImage::AccessorFunctorType, DefaultPixelAccessorFunctor<std::remove_const_t<TImage>>>;
+
+  /**
+   * \brief Calls a function for each chunk of a region whose pixels are
+   * contiguous in the buffers of all the given images.
+   *
+   * The function is called with the first index of the chunk and its
+   * number of pixels. A chunk is at least a line of the region, and
+   * extends over the next dimensions while the region covers the whole
+   * buffered regions of the images along the previous ones, as in Copy.
+   * This allows pixel-wise filters to process the pixels of the chunks
+   * with plain loops over pointers, which the compiler can vectorize:
+     \code
+         ImageAlgorithm::ForEachContiguousChunk(
+           region,
+           [&](const IndexType & index, SizeValueType numberOfPixels) {
+             const InputPixelType * in = inImage->GetBufferPointer() + inImage->ComputeOffset(index);
+             OutputPixelType *      out = outImage->GetBufferPointer() + outImage->ComputeOffset(index);
+             for (SizeValueType i = 0; i < numberOfPixels; ++i)
+             {
+               out[i] = functor(in[i]);
+             }
+           },
+           inImage,
+           outImage);
+     \endcode
+   */
+  template <typename TRegion, typename TChunkFunction, typename... TImages>
+  static void
+  ForEachContiguousChunk(const TRegion & region, const TChunkFunction & chunkFunction, const TImages *... images);
+
   /**
    * \brief Sets the output region to the smallest
    * region of the output image that fully contains
@@ -167,6 +167,42 @@ ImageAlgorithm::DispatchedCopy(const InputImageType *                       inIm
 }
 
 
+template <typename TRegion, typename TChunkFunction, typename... TImages>
+void
+ImageAlgorithm::ForEachContiguousChunk(const TRegion &        region,
+                                       const TChunkFunction & chunkFunction,
+                                       const TImages *... images)
+{
+  constexpr unsigned int ImageDimension = TRegion::ImageDimension;
+
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // Compute the number of contiguous pixels. The region must extend to
+  // the full buffered regions, to ensure continuity of pixels between
+  // dimensions.
+  SizeValueType numberOfPixels = region.GetSize(0);
+  unsigned int  movingDirection = 1;
+  while (movingDirection < ImageDimension &&
+         ((region.GetSize(movingDirection - 1) == images->GetBufferedRegion().GetSize(movingDirection - 1)) && ...))
+  {
+    numberOfPixels *= region.GetSize(movingDirection);
+    ++movingDirection;
+  }
+
+  TRegion chunkStarts = region;
+  for (unsigned int i = 0; i < movingDirection; ++i)
+  {
+    chunkStarts.SetSize(i, 1);
+  }
+  for (const auto & index : ImageRegionIndexRange<ImageDimension>(chunkStarts))
+  {
+    chunkFunction(index, numberOfPixels);
+  }
+}
+
 template <typename InputImageType, typename OutputImageType>
 typename OutputImageType::RegionType
 ImageAlgorithm::EnlargeRegionOverBox(const typename InputImageType::RegionType & inputRegion,
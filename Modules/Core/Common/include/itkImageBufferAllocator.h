@@ -0,0 +1,210 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocator_h
+#define itkImageBufferAllocator_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkIntTypes.h"
+#include "itkSingletonMacro.h"
+
+#include <map>
+#include <mutex>
+
+namespace itk
+{
+
+/** \class ImageBufferAllocator
+ * \brief Allocates the pixel buffers of images.
+ *
+ * By default, ImportImageContainer allocates its elements with
+ * `new TElement[size]`. An ImageBufferAllocator may be used instead, either
+ * globally (SetGlobalDefault) or for the buffer of a specific image
+ * (Image::SetBufferAllocator, ImportImageContainer::SetBufferAllocator). It
+ * provides:
+ *
+ * - Alignment of every buffer to Alignment bytes (64 by default, the size of
+ *   a cache line and of an AVX-512 register).
+ * - For buffers of at least HugePageThreshold bytes, alignment to a huge
+ *   page boundary and, on Linux, an madvise(MADV_HUGEPAGE) hint, so that
+ *   multi-GB volumes need far fewer page faults and TLB entries.
+ * - Optionally (UseBufferPool), a pool of released buffers, bucketed by
+ *   size, which are reused by later allocations of a similar size instead of
+ *   being returned to the operating system. Repeated pipeline updates then
+ *   do not pay for page faults and zero-filling of fresh memory every time.
+ *   At most MaximumPoolSize bytes are kept in the pool.
+ *
+ * Allocate and Deallocate are thread-safe, also while the settings are
+ * changed. A buffer allocated before a change of the alignment settings is
+ * released to the system by Deallocate, instead of being pooled. Buffers
+ * obtained from an
+ * ImageBufferAllocator must be released by its Deallocate method, with the
+ * same number of bytes, and never by `delete[]`.
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+
+struct ImageBufferAllocatorGlobals;
+
+class ITKCommon_EXPORT ImageBufferAllocator : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = ImageBufferAllocator;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageBufferAllocator);
+
+  /** Set/Get the allocator used by the image buffers which do not have their
+   * own allocator. nullptr, the default, means that buffers are allocated
+   * with `new[]`. */
+  static void
+  SetGlobalDefault(Self * allocator);
+  static Pointer
+  GetGlobalDefault();
+
+  /** Set/Get the alignment, in bytes, of the allocated buffers. It must be a
+   * power of two, and is at least the alignment of std::max_align_t. */
+  void
+  SetAlignment(SizeValueType alignment);
+  SizeValueType
+  GetAlignment() const;
+
+  /** Set/Get whether large buffers are aligned to huge page boundaries and
+   * advised to be backed by transparent huge pages. Default is on. Changing
+   * it releases the pooled buffers, which were allocated with the previous
+   * setting. */
+  void
+  SetUseHugePages(bool useHugePages);
+  bool
+  GetUseHugePages() const;
+  itkBooleanMacro(UseHugePages);
+
+  /** Set/Get the size, in bytes, from which a buffer is considered large
+   * enough for huge pages. Default is 32 MiB. Changing it releases the
+   * pooled buffers, as SetUseHugePages does. */
+  void
+  SetHugePageThreshold(SizeValueType hugePageThreshold);
+  SizeValueType
+  GetHugePageThreshold() const;
+
+  /** Set/Get whether released buffers are kept for reuse. Default is off.
+   * Turning it off releases the pooled buffers. */
+  void
+  SetUseBufferPool(bool useBufferPool);
+  bool
+  GetUseBufferPool() const;
+  itkBooleanMacro(UseBufferPool);
+
+  /** Set/Get the maximum number of bytes kept in the pool. Default is 4 GiB. */
+  void
+  SetMaximumPoolSize(SizeValueType maximumPoolSize);
+  SizeValueType
+  GetMaximumPoolSize() const;
+
+  /** Number of bytes currently kept in the pool. */
+  SizeValueType
+  GetPoolSize() const;
+
+  /** Release all the buffers kept in the pool. */
+  void
+  ReleasePooledBuffers();
+
+  /** Allocate an uninitialized buffer of at least numberOfBytes bytes.
+   * Returns nullptr when the memory cannot be allocated. */
+  virtual void *
+  Allocate(SizeValueType numberOfBytes);
+
+  /** Release a buffer returned by Allocate(numberOfBytes). */
+  virtual void
+  Deallocate(void * buffer, SizeValueType numberOfBytes);
+
+protected:
+  ImageBufferAllocator() = default;
+  ~ImageBufferAllocator() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Number of bytes actually allocated for a request of numberOfBytes. Sizes
+   * are rounded up to one of eight buckets per power of two, so that a pooled
+   * buffer can serve similar requests. */
+  SizeValueType
+  GetBucketSize(SizeValueType numberOfBytes) const;
+
+  /** Alignment used for a buffer of the given (bucket) size, with the
+   * current settings. m_PoolMutex must be locked. */
+  SizeValueType
+  GetBufferAlignment(SizeValueType bucketSize) const;
+
+  /** Allocate and release memory from the system. */
+  static void *
+  AllocateFromSystem(SizeValueType bucketSize, SizeValueType alignment);
+  static void
+  DeallocateToSystem(void * buffer);
+
+private:
+  /** Released buffers, by bucket size. */
+  using PoolType = std::multimap<SizeValueType, void *>;
+
+  /** Stored just in front of each buffer allocated from the system. */
+  struct BufferHeader
+  {
+    void *        Raw;
+    SizeValueType Alignment;
+  };
+
+  static BufferHeader &
+  GetBufferHeader(void * buffer);
+
+  static void
+  DeallocateToSystem(const PoolType & pool);
+
+  /** Empties the pool, and returns its buffers. m_PoolMutex must be locked. */
+  PoolType
+  TakePooledBuffers();
+
+  /** Only used to synchronize the global variable across static libraries.*/
+  itkGetGlobalDeclarationMacro(ImageBufferAllocatorGlobals, PimplGlobals);
+
+  /** The settings, which are read by Allocate and Deallocate. */
+  SizeValueType m_Alignment{ 64 };                                // guarded by m_PoolMutex
+  bool          m_UseHugePages{ true };                           // guarded by m_PoolMutex
+  SizeValueType m_HugePageThreshold{ SizeValueType{ 32 } << 20 }; // guarded by m_PoolMutex
+  bool          m_UseBufferPool{ false };                         // guarded by m_PoolMutex
+  SizeValueType m_MaximumPoolSize{ SizeValueType{ 4 } << 30 };    // guarded by m_PoolMutex
+
+  PoolType           m_Pool{};       // guarded by m_PoolMutex
+  SizeValueType      m_PoolSize{ 0 }; // guarded by m_PoolMutex
+  mutable std::mutex m_PoolMutex{};
+
+  static ImageBufferAllocatorGlobals * m_PimplGlobals;
+};
+
+} // end namespace itk
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkImageBufferAllocator.h"
 #include <utility>
 
 namespace itk
@@ -34,6 +35,11 @@ namespace itk
  * \tparam TElementIdentifier An INTEGRAL type for use in indexing the
  * imported buffer.
  *
+ * The memory allocated by the container itself comes from `new[]`, unless an
+ * ImageBufferAllocator is set on the container (SetBufferAllocator) or globally
+ * (ImageBufferAllocator::SetGlobalDefault), in which case the buffer is
+ * aligned, may use huge pages, and may be recycled through a buffer pool.
+ *
  * \tparam TElement The element type stored in the container.
  *
  * \ingroup ImageObjects
@@ -159,6 +165,37 @@ public:
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
 
+  /** Set/Get the allocator used for the buffers allocated by this container
+   * from now on. When it is nullptr (the default), the global default of
+   * ImageBufferAllocator is used, and when that one is nullptr as well, the
+   * buffers are allocated by `new[]`.
+   *
+   * The buffers which come from an allocator are not allocated by
+   * AllocateElements(), which subclasses only override for the buffers
+   * allocated without one.
+   *
+   * \warning A buffer allocated by an ImageBufferAllocator must be released
+   * by that allocator. When ContainerManageMemoryOff() is used for such a
+   * buffer, the application must destroy its elements and call
+   * GetModifiableImportPointerAllocator()->Deallocate(pointer, n), with n
+   * being Capacity() * sizeof(TElement).
+   */
+  itkSetObjectMacro(BufferAllocator, ImageBufferAllocator);
+  itkGetModifiableObjectMacro(BufferAllocator, ImageBufferAllocator);
+
+  /** Get the allocator which allocated the import pointer, or nullptr when
+   * the buffer was allocated by `new[]` or set by SetImportPointer. */
+  ImageBufferAllocator *
+  GetModifiableImportPointerAllocator()
+  {
+    return m_ImportPointerAllocator.GetPointer();
+  }
+  const ImageBufferAllocator *
+  GetImportPointerAllocator() const
+  {
+    return m_ImportPointerAllocator.GetPointer();
+  }
+
 protected:
   ImportImageContainer() = default;
   ~ImportImageContainer() override;
@@ -206,10 +243,24 @@ protected:
   }
 
 private:
+  /** Allocates a buffer from the allocator of the container, or else the
+   * global default, and sets importPointerAllocator to the allocator used.
+   * Without any allocator, the buffer is allocated by AllocateElements() and
+   * importPointerAllocator is set to nullptr. */
+  TElement *
+  AllocateBuffer(ElementIdentifier               size,
+                 bool                            UseValueInitialization,
+                 ImageBufferAllocator::Pointer & importPointerAllocator) const;
+
   TElement *         m_ImportPointer{};
   TElementIdentifier m_Size{};
   TElementIdentifier m_Capacity{};
   bool               m_ContainerManageMemory{ true };
+
+  ImageBufferAllocator::Pointer m_BufferAllocator{};
+
+  /** Allocator of m_ImportPointer, nullptr when it must be released by delete[]. */
+  ImageBufferAllocator::Pointer m_ImportPointerAllocator{};
 };
 } // end namespace itk
 
@@ -29,6 +29,7 @@
 #define itkImportImageContainer_hxx
 
 #include <algorithm> // For copy_n.
+#include <memory>    // For uninitialized_value_construct_n and destroy_n.
 
 namespace itk
 {
@@ -53,13 +54,15 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   {
     if (size > m_Capacity)
     {
-      TElement * temp = this->AllocateElements(size, UseValueInitialization);
+      ImageBufferAllocator::Pointer importPointerAllocator;
+      TElement *                    temp = this->AllocateBuffer(size, UseValueInitialization, importPointerAllocator);
       // only copy the portion of the data used in the old buffer
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_ImportPointerAllocator = std::move(importPointerAllocator);
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -73,7 +76,7 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   }
   else
   {
-    m_ImportPointer = this->AllocateElements(size, UseValueInitialization);
+    m_ImportPointer = this->AllocateBuffer(size, UseValueInitialization, m_ImportPointerAllocator);
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -94,12 +97,14 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
     if (m_Size < m_Capacity)
     {
       const TElementIdentifier size = m_Size;
-      TElement *               temp = this->AllocateElements(size, false);
+      ImageBufferAllocator::Pointer importPointerAllocator;
+      TElement *                    temp = this->AllocateBuffer(size, false, importPointerAllocator);
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_ImportPointerAllocator = std::move(importPointerAllocator);
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -150,6 +155,48 @@ ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *
   this->Modified();
 }
 
+template <typename TElementIdentifier, typename TElement>
+TElement *
+ImportImageContainer<TElementIdentifier, TElement>::AllocateBuffer(
+  ElementIdentifier               size,
+  bool                            UseValueInitialization,
+  ImageBufferAllocator::Pointer & importPointerAllocator) const
+{
+  ImageBufferAllocator::Pointer allocator =
+    m_BufferAllocator ? m_BufferAllocator : ImageBufferAllocator::GetGlobalDefault();
+  if (allocator)
+  {
+    const SizeValueType numberOfBytes = static_cast<SizeValueType>(size) * sizeof(TElement);
+    void *              buffer = allocator->Allocate(numberOfBytes);
+    if (!buffer)
+    {
+      throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+    }
+    auto * data = static_cast<TElement *>(buffer);
+    try
+    {
+      if (UseValueInitialization)
+      {
+        std::uninitialized_value_construct_n(data, size);
+      }
+      else
+      {
+        std::uninitialized_default_construct_n(data, size);
+      }
+    }
+    catch (...)
+    {
+      allocator->Deallocate(buffer, numberOfBytes);
+      throw;
+    }
+    importPointerAllocator = std::move(allocator);
+    return data;
+  }
+
+  importPointerAllocator = nullptr;
+  return this->AllocateElements(size, UseValueInitialization);
+}
+
 template <typename TElementIdentifier, typename TElement>
 TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
@@ -188,8 +235,21 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_ImportPointerAllocator)
+    {
+      if (m_ImportPointer)
+      {
+        std::destroy_n(m_ImportPointer, m_Capacity);
+        m_ImportPointerAllocator->Deallocate(m_ImportPointer,
+                                             static_cast<SizeValueType>(m_Capacity) * sizeof(TElement));
+      }
+    }
+    else
+    {
+      delete[] m_ImportPointer;
+    }
   }
+  m_ImportPointerAllocator = nullptr;
   m_ImportPointer = nullptr;
   m_Capacity = 0;
   m_Size = 0;
@@ -205,6 +265,8 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
+  itkPrintSelfObjectMacro(BufferAllocator);
+  itkPrintSelfObjectMacro(ImportPointerAllocator);
 }
 } // end namespace itk
 
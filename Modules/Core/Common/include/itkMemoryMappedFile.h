@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedFile_h
+#define itkMemoryMappedFile_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkIntTypes.h"
+
+#include <string>
+
+namespace itk
+{
+
+/** \class MemoryMappedFile
+ * \brief Maps a byte range of a file into memory.
+ *
+ * The mapping is private (copy-on-write): the pages are shared with the
+ * page cache, and therefore with other processes mapping or reading the
+ * same file, until they are written to. Writes to the mapped memory are
+ * never written back to the file.
+ *
+ * The range is unmapped by Unmap(), by a subsequent Map(), or when the
+ * object is destroyed.
+ *
+ * \sa MemoryMappedImageContainer
+ * \ingroup OSSystemObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT MemoryMappedFile : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedFile);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedFile;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedFile);
+
+  /** Map numberOfBytes bytes of the file, starting at the given offset.
+   * The offset does not need to be aligned to a page boundary. Throws an
+   * exception when the file cannot be opened, is too small, or cannot be
+   * mapped. */
+  void
+  Map(const std::string & fileName, SizeValueType offset, SizeValueType numberOfBytes);
+
+  /** Release the current mapping, if any. */
+  void
+  Unmap();
+
+  /** Pointer to the first mapped byte, nullptr when nothing is mapped. */
+  void *
+  GetPointer() const
+  {
+    return m_Pointer;
+  }
+
+  itkGetConstMacro(NumberOfBytes, SizeValueType);
+  itkGetStringMacro(FileName);
+
+protected:
+  MemoryMappedFile() = default;
+  ~MemoryMappedFile() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  std::string   m_FileName{};
+  void *        m_Pointer{ nullptr };
+  SizeValueType m_NumberOfBytes{ 0 };
+
+  /** The actual mapping, which starts at a page (or allocation granularity)
+   * boundary at or before m_Pointer. */
+  void *        m_MappedAddress{ nullptr };
+  SizeValueType m_MappedLength{ 0 };
+};
+
+} // end namespace itk
+
+#endif
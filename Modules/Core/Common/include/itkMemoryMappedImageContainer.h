@@ -0,0 +1,123 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImageContainer_h
+#define itkMemoryMappedImageContainer_h
+
+#include "itkImportImageContainer.h"
+#include "itkMemoryMappedFile.h"
+
+#include <type_traits>
+
+namespace itk
+{
+
+/** \class MemoryMappedImageContainer
+ * \brief Image container whose elements are memory-mapped from a file.
+ *
+ * The buffer of the container is a private (copy-on-write) mapping of a
+ * byte range of a file, which holds the elements exactly as they are laid
+ * out in memory. No memory is allocated and nothing is read until the
+ * elements are accessed, and then only the accessed pages are loaded, from
+ * the page cache shared with other processes. Modifications of the
+ * elements are never written back to the file.
+ *
+ * As the container derives from ImportImageContainer, it can be used as the
+ * pixel container of an Image, see Image::SetPixelContainer. Growing the
+ * container by Reserve copies the elements into a newly allocated buffer
+ * and releases the mapping.
+ *
+ * \sa ImageFileReader::SetUseMemoryMapping
+ * \ingroup ImageObjects
+ * \ingroup IOFilters
+ * \ingroup ITKCommon
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT MemoryMappedImageContainer : public ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedImageContainer);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedImageContainer;
+  using Superclass = ImportImageContainer<TElementIdentifier, TElement>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Save the template parameters. */
+  using typename Superclass::ElementIdentifier;
+  using typename Superclass::Element;
+
+  static_assert(std::is_trivially_copyable_v<TElement>, "The elements of a mapped file must be trivially copyable.");
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedImageContainer);
+
+  /** Map numberOfElements elements of the file, stored from the given byte
+   * offset on, as the buffer of this container. The offset must be a
+   * multiple of the alignment of TElement. Throws an exception when the
+   * file cannot be mapped. */
+  void
+  MapFile(const std::string & fileName, SizeValueType offset, ElementIdentifier numberOfElements)
+  {
+    if (offset % alignof(TElement) != 0)
+    {
+      itkExceptionMacro("Offset " << offset << " is not aligned for the elements of the container");
+    }
+    const auto mappedFile = MemoryMappedFile::New();
+    mappedFile->Map(fileName, offset, static_cast<SizeValueType>(numberOfElements) * sizeof(TElement));
+
+    // Releases the previous buffer (and mapping) of the container.
+    this->SetImportPointer(static_cast<TElement *>(mappedFile->GetPointer()), numberOfElements, false);
+    m_MappedFile = mappedFile;
+  }
+
+  /** Get the current mapping, nullptr when the buffer is not mapped. */
+  const MemoryMappedFile *
+  GetMappedFile() const
+  {
+    return m_MappedFile.GetPointer();
+  }
+
+protected:
+  MemoryMappedImageContainer() = default;
+  ~MemoryMappedImageContainer() override = default;
+
+  void
+  DeallocateManagedMemory() override
+  {
+    Superclass::DeallocateManagedMemory();
+    m_MappedFile = nullptr;
+  }
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override
+  {
+    Superclass::PrintSelf(os, indent);
+    itkPrintSelfObjectMacro(MappedFile);
+  }
+
+private:
+  MemoryMappedFile::Pointer m_MappedFile{};
+};
+
+} // end namespace itk
+
+#endif
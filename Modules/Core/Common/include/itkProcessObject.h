@@ -494,6 +494,29 @@ public:
   itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
   itkGetConstReferenceMacro(NumberOfWorkUnits, ThreadIdType);
 
+  /** Turn on/off updating independent upstream branches concurrently.
+   * When this filter has several inputs, their upstream pipelines are
+   * grouped into branches which do not share any ProcessObject, nor any
+   * DataObject, such as an input image without a source. If this flag is on,
+   * the branches are updated concurrently on the global
+   * WorkStealingThreadPool, and the number of work units of the filters of
+   * each branch is divided by the number of branches for the duration of the
+   * update. Branches which share a ProcessObject or a DataObject are updated
+   * serially, as before. Observers of the upstream filters may be invoked
+   * from a worker thread, so they have to be thread-safe. Default value is
+   * off.
+   *
+   * The branches run on the WorkStealingThreadPool, whatever the
+   * multi-threader of the filters, because a thread waiting for a branch
+   * executes the pending tasks meanwhile, so that the filters of a branch can
+   * run their own work units without a deadlock. When the filters use
+   * another multi-threader, such as the PoolMultiThreader, one thread per
+   * branch of the WorkStealingThreadPool runs next to the threads of that
+   * multi-threader. Dividing the work units keeps their total unchanged. */
+  itkSetMacro(ParallelInputUpdate, bool);
+  itkGetConstReferenceMacro(ParallelInputUpdate, bool);
+  itkBooleanMacro(ParallelInputUpdate);
+
   /** Return the multithreader used by this class. */
   MultiThreaderType *
   GetMultiThreader() const
@@ -945,6 +968,11 @@ protected:
   TimeStamp m_OutputInformationMTime{};
 
 private:
+  /** Update the inputs, running the independent upstream branches concurrently.
+   * Used by UpdateOutputData when ParallelInputUpdate is on. */
+  void
+  UpdateInputsInParallel();
+
   DataObjectIdentifierType MakeNameFromIndex(DataObjectPointerArraySizeType) const;
   DataObjectPointerArraySizeType
   MakeIndexFromName(const DataObjectIdentifierType &) const;
@@ -986,6 +1014,8 @@ private:
 
   bool m_ThreaderUpdateProgress{ true };
 
+  bool m_ParallelInputUpdate{ false };
+
   /** Memory management ivars */
   bool m_ReleaseDataBeforeUpdateFlag{};
 
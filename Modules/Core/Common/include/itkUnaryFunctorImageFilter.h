@@ -36,6 +36,13 @@ namespace itk
  * UnaryFunctorImageFilter (like the CastImageFilter) can be used
  * to promote a 2D image to a 3D image, etc.
  *
+ * When the input and the output have the same dimension and store their
+ * pixels directly in their buffers, as Image does, the functor is applied
+ * over chunks of contiguous pixels through pointers, in loops that the
+ * compiler can vectorize for simple functors. Each work unit then calls
+ * its own copy of a functor whose operator() is const, while a functor
+ * which can only be called as non-const is shared by all the work units.
+ *
  * \sa UnaryGeneratorImageFilter
  * \sa BinaryFunctorImageFilter TernaryFunctorImageFilter
  *
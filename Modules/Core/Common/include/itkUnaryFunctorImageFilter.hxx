@@ -18,8 +18,10 @@
 #ifndef itkUnaryFunctorImageFilter_hxx
 #define itkUnaryFunctorImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
+#include <type_traits>
 
 namespace itk
 {
@@ -86,6 +88,37 @@ UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGe
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if constexpr (TInputImage::ImageDimension == TOutputImage::ImageDimension &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TInputImage> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TOutputImage>)
+  {
+    if (inputRegionForThread == outputRegionForThread)
+    {
+      // A local copy of the functor, which the output pixels cannot alias.
+      // A functor which can only be called as non-const is shared by the
+      // work units instead, as in the loop over the iterators.
+      using LocalFunctorType = std::conditional_t<std::is_invocable_v<const FunctorType &, const InputImagePixelType &>,
+                                                  const FunctorType,
+                                                  FunctorType &>;
+      LocalFunctorType functor = m_Functor;
+      ImageAlgorithm::ForEachContiguousChunk(
+        outputRegionForThread,
+        [inputPtr, outputPtr, &functor, &progress](const typename OutputImageRegionType::IndexType & index,
+                                                   SizeValueType numberOfPixels) {
+          const InputImagePixelType * in = inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(index);
+          OutputImagePixelType *      out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+          for (SizeValueType i = 0; i < numberOfPixels; ++i)
+          {
+            out[i] = functor(in[i]);
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr,
+        outputPtr);
+      return;
+    }
+  }
+
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
 
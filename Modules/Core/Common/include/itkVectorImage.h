@@ -322,6 +322,13 @@ public:
   void
   SetPixelContainer(PixelContainer * container);
 
+  /** Set/Get the allocator of the pixel buffer, which is passed to the pixel
+   * container by Allocate(). When it is nullptr (the default), the allocator
+   * of the pixel container, or else the global default of
+   * ImageBufferAllocator, is used. \sa ImportImageContainer::SetBufferAllocator */
+  itkSetObjectMacro(BufferAllocator, ImageBufferAllocator);
+  itkGetModifiableObjectMacro(BufferAllocator, ImageBufferAllocator);
+
   /** Graft the data and information from one image to another. This
    * is a convenience method to setup a second image with all the meta
    * information of another image and use the same pixel
@@ -390,6 +397,8 @@ private:
 
   /** Memory for the current buffer. */
   PixelContainerPointer m_Buffer{ PixelContainer::New() };
+
+  ImageBufferAllocator::Pointer m_BufferAllocator{};
 };
 } // end namespace itk
 
@@ -46,6 +46,10 @@ VectorImage<TPixel, VImageDimension>::Allocate(const bool UseValueInitialization
   this->ComputeOffsetTable();
   num = this->GetOffsetTable()[VImageDimension];
 
+  if (m_BufferAllocator)
+  {
+    m_Buffer->SetBufferAllocator(m_BufferAllocator);
+  }
   m_Buffer->Reserve(num * m_VectorLength, UseValueInitialization);
 }
 
@@ -163,6 +167,7 @@ VectorImage<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent
   os << indent << "VectorLength: " << m_VectorLength << std::endl;
   os << indent << "PixelContainer: " << std::endl;
   m_Buffer->Print(os, indent.GetNextIndent());
+  itkPrintSelfObjectMacro(BufferAllocator);
 
   // m_Origin and m_Spacing are printed in the Superclass
 }
@@ -0,0 +1,209 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWorkStealingThreadPool_h
+#define itkWorkStealingThreadPool_h
+
+#include "itkConfigure.h"
+#include "itkIntTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkSingletonMacro.h"
+
+
+namespace itk
+{
+
+/**
+ * \class WorkStealingThreadPool
+ * \brief Thread pool with one task deque per worker thread.
+ *
+ * Unlike ThreadPool, which feeds all jobs through a single queue guarded by
+ * a single mutex, every worker of this pool owns its own deque. A worker
+ * pushes and pops tasks at the back of its own deque, and when it runs out
+ * of work it steals from the front of the deques of the other workers.
+ * Tasks submitted from outside the pool are distributed round-robin.
+ *
+ * Tasks are grouped in a TaskGroup. A thread waiting for a TaskGroup does
+ * not block: it keeps executing (or stealing) pending tasks until the whole
+ * group is finished. This makes nested parallelism safe: a filter which runs
+ * inside a worker of another filter submits its work units to the same
+ * workers, without deadlock and without creating additional threads.
+ *
+ * \ingroup OSSystemObjects
+ * \ingroup ITKCommon
+ */
+
+struct WorkStealingThreadPoolGlobals;
+
+class ITKCommon_EXPORT WorkStealingThreadPool : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WorkStealingThreadPool);
+
+  /** Standard class type aliases. */
+  using Self = WorkStealingThreadPool;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(WorkStealingThreadPool);
+
+  /** Returns the global instance */
+  static Pointer
+  New();
+
+  /** Returns the global singleton instance of the WorkStealingThreadPool */
+  static Pointer
+  GetInstance();
+
+  /** \class TaskGroup
+   * \brief Set of tasks which are waited for together.
+   *
+   * The first exception thrown by any task of the group is stored,
+   * and rethrown by WorkStealingThreadPool::Wait.
+   * \ingroup ITKCommon
+   */
+  class TaskGroup
+  {
+  private:
+    friend class WorkStealingThreadPool;
+
+    std::mutex              m_Mutex;
+    std::condition_variable m_Condition;
+    SizeValueType           m_Pending{ 0 };         // guarded by m_Mutex
+    std::exception_ptr      m_FirstCaughtException; // guarded by m_Mutex
+  };
+
+  /** Add a task to the pool, as part of the given group.
+   * When called from a worker thread, the task is pushed onto the deque of
+   * that worker, so nested work stays local to the thread which created it. */
+  void
+  AddWork(TaskGroup & group, std::function<void()> task);
+
+  /** Execute pending tasks of the pool until all the tasks of the group are
+   * finished, then rethrow the first exception thrown by one of them.
+   * The optional callback is invoked periodically while waiting, which is
+   * used to keep a filter's progress (and abort check) alive. */
+  void
+  Wait(TaskGroup & group, const std::function<void()> & whileWaiting = nullptr);
+
+  /** Can call this method if we want to add extra threads to the pool.
+   * The number of threads is limited to ITK_MAX_THREADS. */
+  void
+  AddThreads(ThreadIdType count);
+
+  ThreadIdType
+  GetMaximumNumberOfThreads() const
+  {
+    return m_NumberOfWorkers.load();
+  }
+
+  /** Index of the calling worker thread in this pool, or -1 when it is not
+   * one of the workers. */
+  static int
+  GetCurrentWorkerIndex();
+
+protected:
+  WorkStealingThreadPool();
+
+  /** Stop the pool and release threads. To be called by the destructor and atfork. */
+  void
+  CleanUp();
+
+  ~WorkStealingThreadPool() override { this->CleanUp(); }
+
+  static void
+  PrepareForFork();
+  static void
+  ResumeFromFork();
+
+private:
+  /** Only used to synchronize the global variable across static libraries.*/
+  itkGetGlobalDeclarationMacro(WorkStealingThreadPoolGlobals, PimplGlobals);
+
+  struct QueuedTask
+  {
+    std::function<void()> Function;
+    TaskGroup *           Group;
+  };
+
+  /** Deque of one worker, padded to avoid false sharing between workers. */
+  struct alignas(64) WorkerQueue
+  {
+    std::mutex             m_Mutex;
+    std::deque<QueuedTask> m_Tasks; // guarded by m_Mutex
+  };
+
+  /** Pop a task from the back of the own deque, or steal one from the front
+   * of another deque. Returns false when no task could be found. */
+  bool
+  TryGetTask(int workerIndex, QueuedTask & task);
+
+  /** Run a task and account for its completion in its group. */
+  static void
+  RunTask(QueuedTask & task);
+
+  /** The continuously running thread function */
+  void
+  ThreadExecute(int workerIndex);
+
+  /** One deque per possible worker, allocated once so that stealing never
+   * races with AddThreads. */
+  std::unique_ptr<WorkerQueue[]> m_Queues;
+
+  std::atomic<ThreadIdType> m_NumberOfWorkers{ 0 };
+
+  /** Total number of queued (not yet started) tasks, used to put idle
+   * workers to sleep. */
+  std::atomic<SizeValueType> m_NumberOfQueuedTasks{ 0 };
+
+  /** Number of workers sleeping on m_Condition. AddWork only needs to wake
+   * up a worker when this is not zero. */
+  std::atomic<ThreadIdType> m_NumberOfSleepingWorkers{ 0 };
+
+  /** Round-robin target for tasks submitted from outside of the pool. */
+  std::atomic<unsigned int> m_NextExternalQueue{ 0 };
+
+  /** Idle workers sleep on m_Condition, which is guarded by m_SleepMutex. */
+  std::mutex              m_SleepMutex;
+  std::condition_variable m_Condition;
+
+  /** Thread handles, used to join the threads. */
+  std::vector<std::thread> m_Threads; // guarded by m_SleepMutex
+
+  /* Has destruction started? */
+  bool m_Stopping{ false }; // guarded by m_SleepMutex
+
+  /** To lock on the internal variables */
+  static WorkStealingThreadPoolGlobals * m_PimplGlobals;
+};
+
+} // namespace itk
+#endif
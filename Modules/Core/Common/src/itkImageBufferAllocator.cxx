@@ -0,0 +1,357 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocator.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+namespace
+{
+// Transparent huge pages are 2 MiB on the common x86-64 and AArch64 configurations.
+constexpr SizeValueType hugePageSize = SizeValueType{ 2 } << 20;
+
+// Smallest granularity of the buckets.
+constexpr SizeValueType minimumBucketStep = 64;
+} // namespace
+
+struct ImageBufferAllocatorGlobals
+{
+  ImageBufferAllocatorGlobals() = default;
+
+  std::mutex                    m_Mutex;
+  ImageBufferAllocator::Pointer m_GlobalDefault; // guarded by m_Mutex
+};
+
+itkGetGlobalSimpleMacro(ImageBufferAllocator, ImageBufferAllocatorGlobals, PimplGlobals);
+
+void
+ImageBufferAllocator::SetGlobalDefault(Self * allocator)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_GlobalDefault = allocator;
+}
+
+ImageBufferAllocator::Pointer
+ImageBufferAllocator::GetGlobalDefault()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_GlobalDefault;
+}
+
+ImageBufferAllocator::~ImageBufferAllocator()
+{
+  this->ReleasePooledBuffers();
+}
+
+void
+ImageBufferAllocator::SetAlignment(SizeValueType alignment)
+{
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+  {
+    itkExceptionMacro("Alignment must be a power of two, but it is " << alignment);
+  }
+  alignment = std::max<SizeValueType>(alignment, alignof(std::max_align_t));
+  PoolType pool;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+    if (m_Alignment == alignment)
+    {
+      return;
+    }
+    // Pooled buffers may not satisfy the new alignment.
+    m_Alignment = alignment;
+    pool = this->TakePooledBuffers();
+  }
+  DeallocateToSystem(pool);
+  this->Modified();
+}
+
+SizeValueType
+ImageBufferAllocator::GetAlignment() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+  return m_Alignment;
+}
+
+void
+ImageBufferAllocator::SetUseHugePages(bool useHugePages)
+{
+  PoolType pool;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+    if (m_UseHugePages == useHugePages)
+    {
+      return;
+    }
+    // Pooled buffers have the alignment and advice of the previous setting.
+    m_UseHugePages = useHugePages;
+    pool = this->TakePooledBuffers();
+  }
+  DeallocateToSystem(pool);
+  this->Modified();
+}
+
+bool
+ImageBufferAllocator::GetUseHugePages() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+  return m_UseHugePages;
+}
+
+void
+ImageBufferAllocator::SetHugePageThreshold(SizeValueType hugePageThreshold)
+{
+  PoolType pool;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+    if (m_HugePageThreshold == hugePageThreshold)
+    {
+      return;
+    }
+    m_HugePageThreshold = hugePageThreshold;
+    pool = this->TakePooledBuffers();
+  }
+  DeallocateToSystem(pool);
+  this->Modified();
+}
+
+SizeValueType
+ImageBufferAllocator::GetHugePageThreshold() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+  return m_HugePageThreshold;
+}
+
+void
+ImageBufferAllocator::SetUseBufferPool(bool useBufferPool)
+{
+  PoolType pool;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+    if (m_UseBufferPool == useBufferPool)
+    {
+      return;
+    }
+    m_UseBufferPool = useBufferPool;
+    if (!useBufferPool)
+    {
+      pool = this->TakePooledBuffers();
+    }
+  }
+  DeallocateToSystem(pool);
+  this->Modified();
+}
+
+bool
+ImageBufferAllocator::GetUseBufferPool() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+  return m_UseBufferPool;
+}
+
+void
+ImageBufferAllocator::SetMaximumPoolSize(SizeValueType maximumPoolSize)
+{
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+    if (m_MaximumPoolSize == maximumPoolSize)
+    {
+      return;
+    }
+    m_MaximumPoolSize = maximumPoolSize;
+  }
+  this->Modified();
+}
+
+SizeValueType
+ImageBufferAllocator::GetMaximumPoolSize() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+  return m_MaximumPoolSize;
+}
+
+SizeValueType
+ImageBufferAllocator::GetPoolSize() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+  return m_PoolSize;
+}
+
+void
+ImageBufferAllocator::ReleasePooledBuffers()
+{
+  PoolType pool;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+    pool = this->TakePooledBuffers();
+  }
+  DeallocateToSystem(pool);
+}
+
+auto
+ImageBufferAllocator::TakePooledBuffers() -> PoolType
+{
+  PoolType pool;
+  pool.swap(m_Pool);
+  m_PoolSize = 0;
+  return pool;
+}
+
+SizeValueType
+ImageBufferAllocator::GetBucketSize(SizeValueType numberOfBytes) const
+{
+  // Eight buckets per power of two waste at most 12.5% of a buffer.
+  SizeValueType powerOfTwo = 1;
+  while (powerOfTwo <= numberOfBytes / 2)
+  {
+    powerOfTwo *= 2;
+  }
+  const SizeValueType step = std::max(powerOfTwo / 8, minimumBucketStep);
+  return std::max<SizeValueType>(1, (numberOfBytes + step - 1) / step) * step;
+}
+
+SizeValueType
+ImageBufferAllocator::GetBufferAlignment(SizeValueType bucketSize) const
+{
+  if (m_UseHugePages && bucketSize >= m_HugePageThreshold)
+  {
+    return std::max(m_Alignment, hugePageSize);
+  }
+  return m_Alignment;
+}
+
+void *
+ImageBufferAllocator::AllocateFromSystem(SizeValueType bucketSize, SizeValueType alignment)
+{
+  // Over-allocate, so that the buffer can be aligned, and the original
+  // pointer and the alignment can be stored just in front of the aligned
+  // buffer.
+  void * raw = std::malloc(bucketSize + alignment + sizeof(BufferHeader));
+  if (raw == nullptr)
+  {
+    return nullptr;
+  }
+  const auto address = reinterpret_cast<std::uintptr_t>(raw) + sizeof(BufferHeader);
+  auto *     buffer = reinterpret_cast<void *>((address + alignment - 1) & ~(std::uintptr_t{ alignment } - 1));
+  GetBufferHeader(buffer) = BufferHeader{ raw, alignment };
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (alignment >= hugePageSize)
+  {
+    // Only a hint: the buffer remains valid when transparent huge pages are disabled.
+    madvise(buffer, bucketSize - bucketSize % hugePageSize, MADV_HUGEPAGE);
+  }
+#endif
+  return buffer;
+}
+
+void
+ImageBufferAllocator::DeallocateToSystem(void * buffer)
+{
+  std::free(GetBufferHeader(buffer).Raw);
+}
+
+void
+ImageBufferAllocator::DeallocateToSystem(const PoolType & pool)
+{
+  for (const auto & entry : pool)
+  {
+    DeallocateToSystem(entry.second);
+  }
+}
+
+auto
+ImageBufferAllocator::GetBufferHeader(void * buffer) -> BufferHeader &
+{
+  return static_cast<BufferHeader *>(buffer)[-1];
+}
+
+void *
+ImageBufferAllocator::Allocate(SizeValueType numberOfBytes)
+{
+  const SizeValueType bucketSize = this->GetBucketSize(numberOfBytes);
+  SizeValueType       alignment;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+    if (m_UseBufferPool)
+    {
+      const auto it = m_Pool.find(bucketSize);
+      if (it != m_Pool.end())
+      {
+        void * buffer = it->second;
+        m_Pool.erase(it);
+        m_PoolSize -= bucketSize;
+        return buffer;
+      }
+    }
+    alignment = this->GetBufferAlignment(bucketSize);
+  }
+  return AllocateFromSystem(bucketSize, alignment);
+}
+
+void
+ImageBufferAllocator::Deallocate(void * buffer, SizeValueType numberOfBytes)
+{
+  if (buffer == nullptr)
+  {
+    return;
+  }
+  const SizeValueType bucketSize = this->GetBucketSize(numberOfBytes);
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+    // A buffer allocated before a change of the alignment settings is not
+    // pooled, since it would not have the alignment of the new buffers.
+    if (m_UseBufferPool && m_PoolSize + bucketSize <= m_MaximumPoolSize &&
+        GetBufferHeader(buffer).Alignment == this->GetBufferAlignment(bucketSize))
+    {
+      m_Pool.emplace(bucketSize, buffer);
+      m_PoolSize += bucketSize;
+      return;
+    }
+  }
+  DeallocateToSystem(buffer);
+}
+
+void
+ImageBufferAllocator::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PoolMutex);
+  os << indent << "Alignment: " << m_Alignment << std::endl;
+  itkPrintSelfBooleanMacro(UseHugePages);
+  os << indent << "HugePageThreshold: " << m_HugePageThreshold << std::endl;
+  itkPrintSelfBooleanMacro(UseBufferPool);
+  os << indent << "MaximumPoolSize: " << m_MaximumPoolSize << std::endl;
+  os << indent << "PoolSize: " << m_PoolSize << std::endl;
+}
+
+ImageBufferAllocatorGlobals * ImageBufferAllocator::m_PimplGlobals;
+
+} // end namespace itk
@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMemoryMappedFile.h"
+#include "itksys/SystemTools.hxx"
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+  this->Unmap();
+}
+
+void
+MemoryMappedFile::Map(const std::string & fileName, SizeValueType offset, SizeValueType numberOfBytes)
+{
+  this->Unmap();
+
+  if (numberOfBytes == 0)
+  {
+    m_FileName = fileName;
+    return;
+  }
+
+#if defined(_WIN32)
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const SizeValueType granularity = systemInfo.dwAllocationGranularity;
+
+  const std::wstring uncpath = itksys::SystemTools::ConvertToWindowsExtendedPath(fileName.c_str());
+  const HANDLE       file = CreateFileW(
+    uncpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    itkExceptionMacro("Could not open file: " << fileName << " for mapping." << std::endl
+                                              << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || static_cast<SizeValueType>(fileSize.QuadPart) < offset + numberOfBytes)
+  {
+    CloseHandle(file);
+    itkExceptionMacro("File: " << fileName << " is too small to map " << numberOfBytes << " bytes at offset "
+                               << offset);
+  }
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr)
+  {
+    itkExceptionMacro("Could not create a mapping of file: " << fileName);
+  }
+  const SizeValueType mappedOffset = offset - offset % granularity;
+  const SizeValueType mappedLength = numberOfBytes + (offset - mappedOffset);
+  void *              address = MapViewOfFile(mapping,
+                                 FILE_MAP_COPY,
+                                 static_cast<DWORD>(static_cast<uint64_t>(mappedOffset) >> 32),
+                                 static_cast<DWORD>(mappedOffset & 0xFFFFFFFF),
+                                 static_cast<SIZE_T>(mappedLength));
+  CloseHandle(mapping);
+  if (address == nullptr)
+  {
+    itkExceptionMacro("Could not map " << numberOfBytes << " bytes of file: " << fileName);
+  }
+#else
+  const auto          pageSize = static_cast<SizeValueType>(sysconf(_SC_PAGESIZE));
+  const SizeValueType mappedOffset = offset - offset % pageSize;
+  const SizeValueType mappedLength = numberOfBytes + (offset - mappedOffset);
+
+  const int file = open(fileName.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    itkExceptionMacro("Could not open file: " << fileName << " for mapping." << std::endl
+                                              << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  struct stat fileStatus;
+  if (fstat(file, &fileStatus) != 0 || static_cast<SizeValueType>(fileStatus.st_size) < offset + numberOfBytes)
+  {
+    close(file);
+    itkExceptionMacro("File: " << fileName << " is too small to map " << numberOfBytes << " bytes at offset "
+                               << offset);
+  }
+  // A private writable mapping lets filters modify the pixels (copy-on-write)
+  // without ever changing the file.
+  void * address =
+    mmap(nullptr, mappedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, static_cast<off_t>(mappedOffset));
+  close(file);
+  if (address == MAP_FAILED)
+  {
+    itkExceptionMacro("Could not map " << numberOfBytes << " bytes of file: " << fileName << std::endl
+                                       << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+#endif
+
+  m_FileName = fileName;
+  m_MappedAddress = address;
+  m_MappedLength = mappedLength;
+  m_Pointer = static_cast<char *>(address) + (offset - mappedOffset);
+  m_NumberOfBytes = numberOfBytes;
+  this->Modified();
+}
+
+void
+MemoryMappedFile::Unmap()
+{
+  if (m_MappedAddress != nullptr)
+  {
+#if defined(_WIN32)
+    UnmapViewOfFile(m_MappedAddress);
+#else
+    munmap(m_MappedAddress, m_MappedLength);
+#endif
+    this->Modified();
+  }
+  m_MappedAddress = nullptr;
+  m_MappedLength = 0;
+  m_Pointer = nullptr;
+  m_NumberOfBytes = 0;
+}
+
+void
+MemoryMappedFile::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "Pointer: " << m_Pointer << std::endl;
+  os << indent << "NumberOfBytes: " << m_NumberOfBytes << std::endl;
+}
+
+} // end namespace itk
@@ -32,6 +32,9 @@
 #include <sstream>
 #include <algorithm>
 #include "itkMultiThreaderBase.h"
+#if defined(ITK_USE_POOL_MULTI_THREADER)
+#  include "itkWorkStealingThreadPool.h"
+#endif
 
 namespace itk
 {
@@ -1268,6 +1271,7 @@ ProcessObject::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "NumberOfRequiredOutputs: " << m_NumberOfRequiredOutputs << std::endl;
   os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
+  itkPrintSelfBooleanMacro(ParallelInputUpdate);
   itkPrintSelfBooleanMacro(ReleaseDataBeforeUpdateFlag);
   itkPrintSelfBooleanMacro(AbortGenerateData);
   os << indent << "Progress: " << progressFixedToFloat(m_Progress) << std::endl;
@@ -1653,6 +1657,10 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
       this->GetPrimaryInput()->UpdateOutputData();
     }
   }
+  else if (m_ParallelInputUpdate)
+  {
+    this->UpdateInputsInParallel();
+  }
   else
   {
     for (auto & input : m_Inputs)
@@ -1746,6 +1754,154 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
 }
 
 
+void
+ProcessObject::UpdateInputsInParallel()
+{
+  std::vector<DataObject *> inputs;
+  for (auto & input : m_Inputs)
+  {
+    if (input.second)
+    {
+      inputs.push_back(input.second);
+    }
+  }
+
+  // Collect the process objects and the data objects upstream of each input.
+  // Updating a branch writes the requested region of every data object it
+  // reaches, sources or not, so two branches must not share any of them.
+  std::vector<std::set<ProcessObject *>> upstream(inputs.size());
+  std::vector<std::set<DataObject *>>    upstreamData(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i)
+  {
+    std::vector<DataObject *> toVisit{ inputs[i] };
+    while (!toVisit.empty())
+    {
+      DataObject * dataObject = toVisit.back();
+      toVisit.pop_back();
+      upstreamData[i].insert(dataObject);
+      ProcessObject * source = dataObject->GetSource();
+      if (source != nullptr && source != this && upstream[i].insert(source).second)
+      {
+        for (auto & sourceInput : source->m_Inputs)
+        {
+          if (sourceInput.second)
+          {
+            toVisit.push_back(sourceInput.second);
+          }
+        }
+      }
+    }
+  }
+
+  // Inputs which share an upstream process object or data object belong to
+  // the same branch.
+  std::vector<size_t> branchOfInput(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i)
+  {
+    branchOfInput[i] = i;
+    for (size_t j = 0; j < i; ++j)
+    {
+      const bool sharedProcessObject =
+        std::any_of(upstream[i].cbegin(), upstream[i].cend(), [&upstream, j](ProcessObject * po) {
+          return upstream[j].count(po) > 0;
+        });
+      const bool sharedDataObject =
+        std::any_of(upstreamData[i].cbegin(), upstreamData[i].cend(), [&upstreamData, j](DataObject * dataObject) {
+          return upstreamData[j].count(dataObject) > 0;
+        });
+      if (sharedProcessObject || sharedDataObject)
+      {
+        const size_t oldBranch = branchOfInput[i];
+        for (size_t k = 0; k <= i; ++k)
+        {
+          if (branchOfInput[k] == oldBranch)
+          {
+            branchOfInput[k] = branchOfInput[j];
+          }
+        }
+      }
+    }
+  }
+
+  // The inputs without a source have nothing to update upstream, and do not
+  // make a branch.
+  std::vector<size_t>                          inputsWithoutSource;
+  std::map<size_t, std::vector<size_t>>        branches;
+  std::map<size_t, std::set<ProcessObject *>> branchProcessObjects;
+  for (size_t i = 0; i < inputs.size(); ++i)
+  {
+    if (upstream[i].empty())
+    {
+      inputsWithoutSource.push_back(i);
+      continue;
+    }
+    branches[branchOfInput[i]].push_back(i);
+    branchProcessObjects[branchOfInput[i]].insert(upstream[i].cbegin(), upstream[i].cend());
+  }
+
+  const auto updateBranch = [&inputs](const std::vector<size_t> & branch) {
+    for (const size_t i : branch)
+    {
+      inputs[i]->PropagateRequestedRegion();
+      inputs[i]->UpdateOutputData();
+    }
+  };
+  updateBranch(inputsWithoutSource);
+
+#if defined(ITK_USE_POOL_MULTI_THREADER)
+  if (branches.size() > 1)
+  {
+    // Share the work units between the concurrently running branches. The
+    // member is modified directly, because the setter would mark the filters
+    // as modified and trigger another execution at the next update.
+    const auto                                            numberOfBranches = static_cast<ThreadIdType>(branches.size());
+    std::vector<std::pair<ProcessObject *, ThreadIdType>> savedNumberOfWorkUnits;
+    for (const auto & branch : branchProcessObjects)
+    {
+      for (ProcessObject * po : branch.second)
+      {
+        savedNumberOfWorkUnits.emplace_back(po, po->m_NumberOfWorkUnits);
+        po->m_NumberOfWorkUnits = std::max<ThreadIdType>(1, po->m_NumberOfWorkUnits / numberOfBranches);
+      }
+    }
+
+    // The waits of the WorkStealingThreadPool execute pending tasks, so the
+    // branches may themselves use it. See SetParallelInputUpdate.
+    const WorkStealingThreadPool::Pointer threadPool = WorkStealingThreadPool::GetInstance();
+    WorkStealingThreadPool::TaskGroup     group;
+    for (const auto & branch : branches)
+    {
+      const std::vector<size_t> & branchInputs = branch.second;
+      threadPool->AddWork(group, [&updateBranch, &branchInputs] { updateBranch(branchInputs); });
+    }
+
+    try
+    {
+      threadPool->Wait(group);
+    }
+    catch (...)
+    {
+      for (const auto & saved : savedNumberOfWorkUnits)
+      {
+        saved.first->m_NumberOfWorkUnits = saved.second;
+      }
+      throw;
+    }
+    for (const auto & saved : savedNumberOfWorkUnits)
+    {
+      saved.first->m_NumberOfWorkUnits = saved.second;
+    }
+    return;
+  }
+#endif
+
+  for (const auto & branch : branches)
+  {
+    updateBranch(branch.second);
+  }
+}
+
+
 void
 ProcessObject::CacheInputReleaseDataFlags()
 {
@@ -0,0 +1,299 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWorkStealingMultiThreader.h"
+#include "itkProcessObject.h"
+#include "itkImageSourceCommon.h"
+#include "itkTotalProgressReporter.h"
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+namespace itk
+{
+
+WorkStealingMultiThreader::WorkStealingMultiThreader()
+  : m_ThreadPool(WorkStealingThreadPool::GetInstance())
+{
+  ThreadIdType defaultThreads = std::max(1u, GetGlobalDefaultNumberOfThreads());
+  if (defaultThreads > 1) // one work unit for only one thread
+  {
+    // Stealing keeps the workers busy, so smaller work units can be afforded
+    defaultThreads *= 4;
+  }
+  m_NumberOfWorkUnits = std::min<ThreadIdType>(ITK_MAX_THREADS, defaultThreads);
+  m_MaximumNumberOfThreads = m_ThreadPool->GetMaximumNumberOfThreads();
+}
+
+WorkStealingMultiThreader::~WorkStealingMultiThreader() = default;
+
+void
+WorkStealingMultiThreader::SetSingleMethod(ThreadFunctionType f, void * data)
+{
+  m_SingleMethod = std::move(f);
+  m_SingleData = data;
+}
+
+void
+WorkStealingMultiThreader::SetMaximumNumberOfThreads(ThreadIdType numberOfThreads)
+{
+  Superclass::SetMaximumNumberOfThreads(numberOfThreads);
+  const ThreadIdType threadCount = m_ThreadPool->GetMaximumNumberOfThreads();
+  if (threadCount < m_MaximumNumberOfThreads)
+  {
+    m_ThreadPool->AddThreads(m_MaximumNumberOfThreads - threadCount);
+  }
+  m_MaximumNumberOfThreads = m_ThreadPool->GetMaximumNumberOfThreads();
+}
+
+void
+WorkStealingMultiThreader::SingleMethodExecute()
+{
+  if (!m_SingleMethod)
+  {
+    itkExceptionMacro("No single method set!");
+  }
+
+  // obey the global maximum number of threads limit
+  m_NumberOfWorkUnits = std::min(this->GetGlobalMaximumNumberOfThreads(), m_NumberOfWorkUnits);
+
+  // A local array, so that the same multi-threader may be used by nested work units
+  std::vector<WorkUnitInfo> workUnitInfoArray(m_NumberOfWorkUnits);
+  for (ThreadIdType i = 0; i < m_NumberOfWorkUnits; ++i)
+  {
+    workUnitInfoArray[i].WorkUnitID = i;
+    workUnitInfoArray[i].NumberOfWorkUnits = m_NumberOfWorkUnits;
+    workUnitInfoArray[i].UserData = m_SingleData;
+  }
+
+  const ThreadFunctionType          singleMethod = m_SingleMethod;
+  WorkStealingThreadPool::TaskGroup group;
+  for (ThreadIdType i = 1; i < m_NumberOfWorkUnits; ++i)
+  {
+    WorkUnitInfo * workUnitInfo = &workUnitInfoArray[i];
+    m_ThreadPool->AddWork(group, [singleMethod, workUnitInfo] { singleMethod(workUnitInfo); });
+  }
+
+  // Now, the parent thread calls this->SingleMethod() itself
+  std::exception_ptr firstCaughtException;
+  try
+  {
+    singleMethod(&workUnitInfoArray[0]);
+  }
+  catch (...)
+  {
+    firstCaughtException = std::current_exception();
+  }
+
+  // The parent thread has finished SingleMethod(),
+  // so now it helps with the other work units until all of them are done
+  try
+  {
+    m_ThreadPool->Wait(group);
+  }
+  catch (...)
+  {
+    if (firstCaughtException == nullptr)
+    {
+      firstCaughtException = std::current_exception();
+    }
+  }
+
+  if (firstCaughtException != nullptr)
+  {
+    std::rethrow_exception(firstCaughtException);
+  }
+}
+
+void
+WorkStealingMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
+                                            SizeValueType             lastIndexPlus1,
+                                            ArrayThreadingFunctorType aFunc,
+                                            ProcessObject *           filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  const ProgressReporter progressStartEnd(filter, 0, 1);
+
+  if (firstIndex + 1 < lastIndexPlus1)
+  {
+    const SizeValueType count = lastIndexPlus1 - firstIndex;
+    const SizeValueType numberOfChunks = std::min<SizeValueType>(count, m_NumberOfWorkUnits);
+    SizeValueType       chunkSize = count / numberOfChunks;
+    if (count % numberOfChunks > 0)
+    {
+      ++chunkSize; // we want slightly bigger chunks to be processed first
+    }
+
+    auto chunkFunction = [aFunc, filter, numberOfChunks](SizeValueType start, SizeValueType end) {
+      TotalProgressReporter progress(filter, numberOfChunks);
+      progress.CheckAbortGenerateData();
+      for (SizeValueType ii = start; ii < end; ++ii)
+      {
+        aFunc(ii);
+      }
+      progress.Completed(1);
+    };
+
+    WorkStealingThreadPool::TaskGroup group;
+    for (SizeValueType i = firstIndex + chunkSize; i < lastIndexPlus1; i += chunkSize)
+    {
+      const SizeValueType end = std::min(i + chunkSize, lastIndexPlus1);
+      m_ThreadPool->AddWork(group, [chunkFunction, i, end] { chunkFunction(i, end); });
+    }
+
+    // execute this thread's share
+    std::exception_ptr firstCaughtException;
+    try
+    {
+      chunkFunction(firstIndex, firstIndex + chunkSize);
+    }
+    catch (...)
+    {
+      firstCaughtException = std::current_exception();
+    }
+
+    // now help with the other chunks until they are all finished
+    try
+    {
+      m_ThreadPool->Wait(group, [filter] {
+        if (filter)
+        {
+          filter->IncrementProgress(0);
+        }
+      });
+    }
+    catch (...)
+    {
+      if (firstCaughtException == nullptr)
+      {
+        firstCaughtException = std::current_exception();
+      }
+    }
+
+    if (firstCaughtException != nullptr)
+    {
+      std::rethrow_exception(firstCaughtException);
+    }
+  }
+  else if (firstIndex + 1 == lastIndexPlus1)
+  {
+    aFunc(firstIndex);
+  }
+  // else nothing needs to be executed
+}
+
+void
+WorkStealingMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
+                                                  const IndexValueType index[],
+                                                  const SizeValueType  size[],
+                                                  ThreadingFunctorType funcP,
+                                                  ProcessObject *      filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  const ProgressReporter progressStartEnd(filter, 0, 1);
+
+  ImageIORegion region(dimension);
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    region.SetIndex(d, index[d]);
+    region.SetSize(d, size[d]);
+  }
+
+  if (m_NumberOfWorkUnits == 1 || region.GetNumberOfPixels() <= 1)
+  {
+    funcP(index, size); // process whole region
+    return;
+  }
+
+  const ImageRegionSplitterBase * splitter = ImageSourceCommon::GetGlobalDefaultSplitter();
+  const ThreadIdType              splitCount = splitter->GetNumberOfSplits(region, m_NumberOfWorkUnits);
+  itkAssertOrThrowMacro(splitCount <= m_NumberOfWorkUnits, "Split count is greater than number of work units!");
+
+  const SizeValueType numberOfPixels = region.GetNumberOfPixels();
+  auto                regionFunction = [funcP, filter, numberOfPixels](const ImageIORegion & iRegion) {
+    TotalProgressReporter progress(filter, numberOfPixels);
+    progress.CheckAbortGenerateData();
+    funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]);
+    progress.Completed(iRegion.GetNumberOfPixels());
+  };
+
+  WorkStealingThreadPool::TaskGroup group;
+  for (ThreadIdType i = 1; i < splitCount; ++i)
+  {
+    ImageIORegion      iRegion = region;
+    const ThreadIdType total = splitter->GetSplit(i, splitCount, iRegion);
+    if (i < total)
+    {
+      m_ThreadPool->AddWork(group, [regionFunction, iRegion] { regionFunction(iRegion); });
+    }
+    else
+    {
+      itkExceptionMacro("Could not get work unit "
+                        << i << " even though we checked possible number of splits beforehand!");
+    }
+  }
+  ImageIORegion iRegion = region;
+  splitter->GetSplit(0, splitCount, iRegion);
+
+  // execute this thread's share
+  std::exception_ptr firstCaughtException;
+  try
+  {
+    regionFunction(iRegion);
+  }
+  catch (...)
+  {
+    firstCaughtException = std::current_exception();
+  }
+
+  // now help with the other pieces until they are all finished
+  try
+  {
+    m_ThreadPool->Wait(group, [filter] {
+      if (filter)
+      {
+        filter->IncrementProgress(0);
+      }
+    });
+  }
+  catch (...)
+  {
+    if (firstCaughtException == nullptr)
+    {
+      firstCaughtException = std::current_exception();
+    }
+  }
+
+  if (firstCaughtException != nullptr)
+  {
+    std::rethrow_exception(firstCaughtException);
+  }
+}
+
+void
+WorkStealingMultiThreader::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+}
+
+} // namespace itk
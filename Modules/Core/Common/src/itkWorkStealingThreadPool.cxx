@@ -0,0 +1,333 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWorkStealingThreadPool.h"
+#include "itkThreadSupport.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+
+namespace itk
+{
+namespace
+{
+// Index of the worker executing on the current thread, -1 for other threads.
+thread_local int currentWorkerIndex = -1;
+
+// How often WorkStealingThreadPool::Wait invokes its callback.
+constexpr std::chrono::milliseconds waitCallbackInterval(10);
+
+// How long a waiting thread sleeps when there is nothing it could help with.
+constexpr std::chrono::microseconds idleWaitInterval(500);
+} // namespace
+
+struct WorkStealingThreadPoolGlobals
+{
+  WorkStealingThreadPoolGlobals() = default;
+
+  // To allow singleton creation of WorkStealingThreadPool.
+  std::once_flag m_ThreadPoolOnceFlag;
+
+  // The singleton instance of WorkStealingThreadPool.
+  WorkStealingThreadPool::Pointer m_ThreadPoolInstance;
+};
+
+itkGetGlobalSimpleMacro(WorkStealingThreadPool, WorkStealingThreadPoolGlobals, PimplGlobals);
+
+WorkStealingThreadPool::Pointer
+WorkStealingThreadPool::New()
+{
+  return Self::GetInstance();
+}
+
+
+WorkStealingThreadPool::Pointer
+WorkStealingThreadPool::GetInstance()
+{
+  // This is called once, on-demand to ensure that m_PimplGlobals is
+  // initialized.
+  itkInitGlobalsMacro(PimplGlobals);
+
+  // Create a singleton WorkStealingThreadPool.
+  std::call_once(m_PimplGlobals->m_ThreadPoolOnceFlag, []() {
+    m_PimplGlobals->m_ThreadPoolInstance = ObjectFactory<Self>::Create();
+    if (m_PimplGlobals->m_ThreadPoolInstance.IsNull())
+    {
+      new WorkStealingThreadPool(); // constructor sets m_PimplGlobals->m_ThreadPoolInstance
+    }
+#if defined(ITK_USE_PTHREADS)
+    pthread_atfork(WorkStealingThreadPool::PrepareForFork,
+                   WorkStealingThreadPool::ResumeFromFork,
+                   WorkStealingThreadPool::ResumeFromFork);
+#endif
+  });
+
+  return m_PimplGlobals->m_ThreadPoolInstance;
+}
+
+int
+WorkStealingThreadPool::GetCurrentWorkerIndex()
+{
+  return currentWorkerIndex;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool()
+  : m_Queues(new WorkerQueue[ITK_MAX_THREADS])
+{
+  m_PimplGlobals->m_ThreadPoolInstance = this;        // threads need this
+  m_PimplGlobals->m_ThreadPoolInstance->UnRegister(); // Remove extra reference
+  this->AddThreads(MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+}
+
+void
+WorkStealingThreadPool::AddThreads(ThreadIdType count)
+{
+  const std::lock_guard<std::mutex> lockGuard(m_SleepMutex);
+  m_Threads.reserve(m_Threads.size() + count);
+  for (ThreadIdType i = 0; i < count; ++i)
+  {
+    const ThreadIdType workerIndex = m_NumberOfWorkers.load();
+    if (workerIndex >= ITK_MAX_THREADS)
+    {
+      break;
+    }
+    m_Threads.emplace_back(&WorkStealingThreadPool::ThreadExecute, this, static_cast<int>(workerIndex));
+    ++m_NumberOfWorkers;
+  }
+}
+
+void
+WorkStealingThreadPool::AddWork(TaskGroup & group, std::function<void()> task)
+{
+  {
+    const std::lock_guard<std::mutex> lockGuard(group.m_Mutex);
+    ++group.m_Pending;
+  }
+
+  int queueIndex = currentWorkerIndex;
+  if (queueIndex < 0)
+  {
+    const ThreadIdType numberOfWorkers = std::max<ThreadIdType>(1, m_NumberOfWorkers.load());
+    queueIndex = static_cast<int>(m_NextExternalQueue++ % numberOfWorkers);
+  }
+
+  // Counting before pushing ensures the counter never drops below the number of queued tasks.
+  ++m_NumberOfQueuedTasks;
+  {
+    WorkerQueue &                     queue = m_Queues[queueIndex];
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    queue.m_Tasks.push_back(QueuedTask{ std::move(task), &group });
+  }
+
+  if (m_NumberOfSleepingWorkers.load() > 0)
+  {
+    {
+      // Synchronize with a worker which is about to go to sleep.
+      const std::lock_guard<std::mutex> lockGuard(m_SleepMutex);
+    }
+    m_Condition.notify_one();
+  }
+}
+
+bool
+WorkStealingThreadPool::TryGetTask(int workerIndex, QueuedTask & task)
+{
+  if (m_NumberOfQueuedTasks.load() == 0)
+  {
+    return false;
+  }
+
+  // The newest task of the own deque is the most likely one to be cache-hot.
+  if (workerIndex >= 0)
+  {
+    WorkerQueue &                     queue = m_Queues[workerIndex];
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    if (!queue.m_Tasks.empty())
+    {
+      task = std::move(queue.m_Tasks.back());
+      queue.m_Tasks.pop_back();
+      --m_NumberOfQueuedTasks;
+      return true;
+    }
+  }
+
+  // Steal the oldest task of another deque, which is usually the biggest chunk of work.
+  const ThreadIdType workerCount = m_NumberOfWorkers.load();
+  const auto         numberOfWorkers = static_cast<int>(workerCount);
+  // The counter wraps around, so it is reduced in unsigned arithmetic, as in AddWork.
+  const int start = workerIndex >= 0
+                      ? workerIndex + 1
+                      : static_cast<int>(m_NextExternalQueue.load() % std::max<ThreadIdType>(1, workerCount));
+  for (int i = 0; i < numberOfWorkers; ++i)
+  {
+    const int victim = (start + i) % numberOfWorkers;
+    if (victim == workerIndex)
+    {
+      continue;
+    }
+    WorkerQueue &                      queue = m_Queues[victim];
+    const std::unique_lock<std::mutex> lock(queue.m_Mutex, std::try_to_lock);
+    if (lock.owns_lock() && !queue.m_Tasks.empty())
+    {
+      task = std::move(queue.m_Tasks.front());
+      queue.m_Tasks.pop_front();
+      --m_NumberOfQueuedTasks;
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+WorkStealingThreadPool::RunTask(QueuedTask & task)
+{
+  std::exception_ptr exception;
+  try
+  {
+    task.Function();
+  }
+  catch (...)
+  {
+    exception = std::current_exception();
+  }
+
+  TaskGroup &                       group = *task.Group;
+  const std::lock_guard<std::mutex> lockGuard(group.m_Mutex);
+  if (exception != nullptr && group.m_FirstCaughtException == nullptr)
+  {
+    group.m_FirstCaughtException = exception;
+  }
+  if (--group.m_Pending == 0)
+  {
+    // Notify while holding the lock, because the group may be destroyed as soon as it is released.
+    group.m_Condition.notify_all();
+  }
+}
+
+void
+WorkStealingThreadPool::Wait(TaskGroup & group, const std::function<void()> & whileWaiting)
+{
+  const int workerIndex = currentWorkerIndex;
+  auto      lastCallback = std::chrono::steady_clock::now();
+
+  std::unique_lock<std::mutex> lock(group.m_Mutex);
+  while (group.m_Pending > 0)
+  {
+    lock.unlock();
+
+    // Help executing pending tasks instead of blocking this thread. Besides
+    // using the waiting thread, this is what prevents nested parallel sections
+    // from deadlocking when all the workers are waiting.
+    QueuedTask task;
+    const bool foundTask = this->TryGetTask(workerIndex, task);
+    if (foundTask)
+    {
+      RunTask(task);
+    }
+
+    if (whileWaiting)
+    {
+      const auto now = std::chrono::steady_clock::now();
+      if (now - lastCallback >= waitCallbackInterval)
+      {
+        whileWaiting();
+        lastCallback = now;
+      }
+    }
+
+    lock.lock();
+    if (!foundTask && group.m_Pending > 0)
+    {
+      group.m_Condition.wait_for(lock, idleWaitInterval);
+    }
+  }
+
+  if (group.m_FirstCaughtException != nullptr)
+  {
+    std::exception_ptr exception = group.m_FirstCaughtException;
+    group.m_FirstCaughtException = nullptr;
+    lock.unlock();
+    std::rethrow_exception(exception);
+  }
+}
+
+void
+WorkStealingThreadPool::CleanUp()
+{
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_SleepMutex);
+    m_Stopping = true;
+  }
+  m_Condition.notify_all();
+
+  for (auto & thread : m_Threads)
+  {
+    assert(thread.joinable());
+    thread.join();
+  }
+}
+
+void
+WorkStealingThreadPool::PrepareForFork()
+{
+  m_PimplGlobals->m_ThreadPoolInstance->CleanUp();
+}
+
+void
+WorkStealingThreadPool::ResumeFromFork()
+{
+  WorkStealingThreadPool * instance = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+  const ThreadIdType       threadCount = instance->m_NumberOfWorkers.load();
+  instance->m_Threads.clear();
+  instance->m_NumberOfWorkers = 0;
+  instance->m_Stopping = false;
+  instance->AddThreads(threadCount);
+}
+
+void
+WorkStealingThreadPool::ThreadExecute(int workerIndex)
+{
+  currentWorkerIndex = workerIndex;
+
+  while (true)
+  {
+    QueuedTask task;
+    if (this->TryGetTask(workerIndex, task))
+    {
+      RunTask(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_SleepMutex);
+    ++m_NumberOfSleepingWorkers;
+    m_Condition.wait(lock, [this] { return m_Stopping || m_NumberOfQueuedTasks.load() > 0; });
+    --m_NumberOfSleepingWorkers;
+    if (m_Stopping && m_NumberOfQueuedTasks.load() == 0)
+    {
+      return;
+    }
+  }
+}
+
+WorkStealingThreadPoolGlobals * WorkStealingThreadPool::m_PimplGlobals;
+
+} // namespace itk
@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <set>
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+using FloatImageType = itk::Image<float, 3>;
+using RegionType = ImageType::RegionType;
+using IndexType = ImageType::IndexType;
+
+ImageType::Pointer
+CreateImage(const RegionType & bufferedRegion)
+{
+  auto image = ImageType::New();
+  image->SetRegions(bufferedRegion);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, bufferedRegion); !it.IsAtEnd(); ++it)
+  {
+    const IndexType & index = it.GetIndex();
+    it.Set(static_cast<short>(index[0] - 3 * index[1] + 7 * index[2]));
+  }
+  return image;
+}
+
+// Checks that the chunks are contiguous in the image buffers, cover the
+// region exactly once, and have the expected number of pixels.
+template <typename... TImages>
+bool
+CheckChunks(const RegionType &  region,
+            itk::SizeValueType  expectedNumberOfPixels,
+            const ImageType *   image,
+            const TImages *... otherImages)
+{
+  bool                           success = true;
+  std::set<itk::OffsetValueType> visited;
+  itk::ImageAlgorithm::ForEachContiguousChunk(
+    region,
+    [&](const IndexType & index, itk::SizeValueType numberOfPixels) {
+      if (numberOfPixels != expectedNumberOfPixels)
+      {
+        std::cerr << "Chunk of " << numberOfPixels << " pixels at " << index << ", expected "
+                  << expectedNumberOfPixels << std::endl;
+        success = false;
+      }
+      for (const ImageType * chunkImage : { image, otherImages... })
+      {
+        const itk::OffsetValueType first = chunkImage->ComputeOffset(index);
+        for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+        {
+          const IndexType pixelIndex = chunkImage->ComputeIndex(first + static_cast<itk::OffsetValueType>(i));
+          if (!region.IsInside(pixelIndex))
+          {
+            std::cerr << "Pixel " << pixelIndex << " of the chunk at " << index << " is outside the region"
+                      << std::endl;
+            success = false;
+          }
+          if (chunkImage == image)
+          {
+            visited.insert(first + static_cast<itk::OffsetValueType>(i));
+          }
+        }
+      }
+    },
+    image,
+    otherImages...);
+  if (visited.size() != region.GetNumberOfPixels())
+  {
+    std::cerr << visited.size() << " pixels visited, expected " << region.GetNumberOfPixels() << std::endl;
+    success = false;
+  }
+  return success;
+}
+
+class AddAndScale
+{
+public:
+  float
+  operator()(short value) const
+  {
+    return m_Scale * static_cast<float>(value) + 0.5f;
+  }
+
+  bool
+  operator==(const AddAndScale & other) const
+  {
+    return m_Scale == other.m_Scale;
+  }
+
+  float m_Scale{ 1.5f };
+};
+} // namespace
+
+int
+itkImageAlgorithmForEachContiguousChunkTest(int, char *[])
+{
+  const RegionType bufferedRegion({ { -2, 1, 0 } }, { { 11, 7, 5 } });
+  const auto       image = CreateImage(bufferedRegion);
+  const auto       largerImage = CreateImage(RegionType({ { -3, 0, 0 } }, { { 13, 8, 6 } }));
+
+  // the whole buffered region is a single chunk
+  ITK_TEST_EXPECT_TRUE(CheckChunks(bufferedRegion, bufferedRegion.GetNumberOfPixels(), image.GetPointer()));
+
+  // whole slices of a slab are a single chunk, but not in an image with a
+  // larger buffered region
+  RegionType slab = bufferedRegion;
+  slab.SetIndex(2, 1);
+  slab.SetSize(2, 3);
+  ITK_TEST_EXPECT_TRUE(CheckChunks(slab, slab.GetNumberOfPixels(), image.GetPointer()));
+  ITK_TEST_EXPECT_TRUE(CheckChunks(slab, 11, image.GetPointer(), largerImage.GetPointer()));
+
+  // whole lines of a part of the slices are chunks of one slice
+  RegionType rows = slab;
+  rows.SetIndex(1, 2);
+  rows.SetSize(1, 4);
+  ITK_TEST_EXPECT_TRUE(CheckChunks(rows, 44, image.GetPointer()));
+
+  // partial lines are chunks of one line
+  RegionType box = rows;
+  box.SetIndex(0, 0);
+  box.SetSize(0, 5);
+  ITK_TEST_EXPECT_TRUE(CheckChunks(box, 5, image.GetPointer()));
+
+  // an empty region has no chunks
+  RegionType empty = box;
+  empty.SetSize(1, 0);
+  ITK_TEST_EXPECT_TRUE(CheckChunks(empty, 0, image.GetPointer()));
+
+  // UnaryFunctorImageFilter computes a requested region of the output from
+  // contiguous chunks, with the same result as pixel by pixel
+  using FilterType = itk::UnaryFunctorImageFilter<ImageType, FloatImageType, AddAndScale>;
+  auto filter = FilterType::New();
+  filter->SetInput(largerImage);
+  filter->GetFunctor().m_Scale = -2.0f;
+  filter->GetOutput()->SetRequestedRegion(box);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const FloatImageType * output = filter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(output->GetBufferedRegion(), box);
+  for (itk::ImageRegionConstIteratorWithIndex<FloatImageType> it(output, box); !it.IsAtEnd(); ++it)
+  {
+    ITK_TEST_EXPECT_EQUAL(it.Get(), -2.0f * static_cast<float>(largerImage->GetPixel(it.GetIndex())) + 0.5f);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,228 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkImageBufferAllocator.h"
+
+#include "itkImage.h"
+#include "itkVectorImage.h"
+
+#include <gtest/gtest.h>
+#include <algorithm> // For all_of.
+#include <atomic>
+#include <cstdint> // For uintptr_t.
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+bool
+IsAligned(const void * const pointer, const itk::SizeValueType alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+} // namespace
+
+
+// Tests that the allocated buffers have the requested alignment, including huge page alignment for large buffers.
+TEST(ImageBufferAllocator, AllocatesAlignedBuffers)
+{
+  const auto allocator = itk::ImageBufferAllocator::New();
+  EXPECT_EQ(allocator->GetAlignment(), 64);
+
+  for (const itk::SizeValueType alignment : { 16, 64, 128, 4096 })
+  {
+    allocator->SetAlignment(alignment);
+    for (const itk::SizeValueType numberOfBytes : { 0, 1, 100, 1000, 123457 })
+    {
+      void * const buffer = allocator->Allocate(numberOfBytes);
+      ASSERT_NE(buffer, nullptr);
+      EXPECT_TRUE(IsAligned(buffer, alignment));
+      allocator->Deallocate(buffer, numberOfBytes);
+    }
+  }
+
+  EXPECT_THROW(allocator->SetAlignment(48), itk::ExceptionObject);
+
+  allocator->SetHugePageThreshold(1 << 20);
+  void * const largeBuffer = allocator->Allocate(3 << 20);
+  ASSERT_NE(largeBuffer, nullptr);
+  EXPECT_TRUE(IsAligned(largeBuffer, itk::SizeValueType{ 2 } << 20));
+  allocator->Deallocate(largeBuffer, 3 << 20);
+}
+
+
+// Tests that released buffers are reused when pooling, up to the maximum pool size.
+TEST(ImageBufferAllocator, ReusesPooledBuffers)
+{
+  const auto allocator = itk::ImageBufferAllocator::New();
+  EXPECT_FALSE(allocator->GetUseBufferPool());
+  allocator->UseBufferPoolOn();
+
+  void * const buffer = allocator->Allocate(10000);
+  allocator->Deallocate(buffer, 10000);
+  EXPECT_GE(allocator->GetPoolSize(), 10000);
+
+  // A slightly smaller request falls into the same bucket.
+  EXPECT_EQ(allocator->Allocate(9990), buffer);
+  EXPECT_EQ(allocator->GetPoolSize(), 0);
+  allocator->Deallocate(buffer, 9990);
+
+  allocator->ReleasePooledBuffers();
+  EXPECT_EQ(allocator->GetPoolSize(), 0);
+
+  allocator->SetMaximumPoolSize(1000);
+  void * const tooLarge = allocator->Allocate(10000);
+  allocator->Deallocate(tooLarge, 10000);
+  EXPECT_EQ(allocator->GetPoolSize(), 0);
+
+  // The buffers pooled with another huge page setting are not reused.
+  allocator->SetMaximumPoolSize(1 << 30);
+  for (const bool useHugePages : { false, true })
+  {
+    allocator->Deallocate(allocator->Allocate(10000), 10000);
+    EXPECT_GT(allocator->GetPoolSize(), 0);
+    allocator->SetUseHugePages(useHugePages);
+    EXPECT_EQ(allocator->GetPoolSize(), 0);
+  }
+  allocator->Deallocate(allocator->Allocate(10000), 10000);
+  allocator->SetHugePageThreshold(1 << 20);
+  EXPECT_EQ(allocator->GetPoolSize(), 0);
+}
+
+
+// Tests that a buffer which is in use while the alignment changes is not pooled afterwards.
+TEST(ImageBufferAllocator, DoesNotPoolBuffersOfPreviousSettings)
+{
+  const auto allocator = itk::ImageBufferAllocator::New();
+  allocator->UseBufferPoolOn();
+
+  void * const buffer = allocator->Allocate(10000);
+  allocator->SetAlignment(4096);
+  allocator->Deallocate(buffer, 10000);
+  EXPECT_EQ(allocator->GetPoolSize(), 0);
+  void * const alignedBuffer = allocator->Allocate(10000);
+  EXPECT_TRUE(IsAligned(alignedBuffer, 4096));
+  allocator->Deallocate(alignedBuffer, 10000);
+  EXPECT_GT(allocator->GetPoolSize(), 0);
+
+  // The settings may change while other threads allocate buffers.
+  std::vector<std::thread> threads;
+  std::atomic<bool>        misaligned{ false };
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&allocator, &misaligned] {
+      for (int i = 0; i < 1000; ++i)
+      {
+        void * const pooledBuffer = allocator->Allocate(10000);
+        if (!IsAligned(pooledBuffer, 64))
+        {
+          misaligned = true;
+        }
+        allocator->Deallocate(pooledBuffer, 10000);
+      }
+    });
+  }
+  for (int i = 0; i < 100; ++i)
+  {
+    allocator->SetAlignment(i % 2 == 0 ? 64 : 256);
+    allocator->SetUseHugePages(i % 3 != 0);
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_FALSE(misaligned);
+
+  // Only buffers of the current alignment are pooled.
+  allocator->SetAlignment(1024);
+  for (int i = 0; i < 10; ++i)
+  {
+    void * const pooledBuffer = allocator->Allocate(10000);
+    EXPECT_TRUE(IsAligned(pooledBuffer, 1024));
+    allocator->Deallocate(pooledBuffer, 10000);
+  }
+}
+
+
+// Tests that images allocate their buffer from their allocator, or else from the global default.
+TEST(ImageBufferAllocator, IsUsedByImages)
+{
+  using ImageType = itk::Image<float, 3>;
+
+  const auto allocator = itk::ImageBufferAllocator::New();
+  allocator->SetAlignment(256);
+  allocator->UseBufferPoolOn();
+
+  const auto image = ImageType::New();
+  image->SetBufferAllocator(allocator);
+  image->SetRegions(ImageType::SizeType::Filled(17));
+  image->Allocate();
+  const ImageType::PixelType * const firstBuffer = image->GetBufferPointer();
+  EXPECT_TRUE(IsAligned(firstBuffer, 256));
+  EXPECT_EQ(image->GetPixelContainer()->GetImportPointerAllocator(), allocator.GetPointer());
+
+  // Once released, the buffer is reused, and still value-initialized on request.
+  image->FillBuffer(1.0f);
+  image->Initialize();
+  EXPECT_GT(allocator->GetPoolSize(), 0);
+  image->SetRegions(ImageType::SizeType::Filled(17));
+  image->AllocateInitialized();
+  EXPECT_EQ(image->GetBufferPointer(), firstBuffer);
+  const auto numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  EXPECT_TRUE(std::all_of(firstBuffer, firstBuffer + numberOfPixels, [](const float pixel) { return pixel == 0.0f; }));
+
+  // Without an allocator, images keep using new[].
+  const auto defaultImage = ImageType::New();
+  defaultImage->SetRegions(ImageType::SizeType::Filled(4));
+  defaultImage->Allocate();
+  EXPECT_EQ(defaultImage->GetPixelContainer()->GetImportPointerAllocator(), nullptr);
+
+  itk::ImageBufferAllocator::SetGlobalDefault(allocator);
+  const auto vectorImage = itk::VectorImage<double, 2>::New();
+  vectorImage->SetRegions(itk::Size<2>::Filled(5));
+  vectorImage->SetVectorLength(3);
+  vectorImage->Allocate();
+  itk::ImageBufferAllocator::SetGlobalDefault(nullptr);
+  EXPECT_EQ(vectorImage->GetPixelContainer()->GetImportPointerAllocator(), allocator.GetPointer());
+  EXPECT_TRUE(IsAligned(vectorImage->GetBufferPointer(), 256));
+
+  // Reallocating the buffer copies the pixels into a buffer of the new allocator.
+  const auto container = itk::ImportImageContainer<itk::SizeValueType, int>::New();
+  container->Reserve(10, true);
+  (*container)[9] = 42;
+  EXPECT_EQ(container->GetImportPointerAllocator(), nullptr);
+  container->SetBufferAllocator(allocator);
+  EXPECT_EQ(container->GetBufferAllocator(), allocator.GetPointer());
+  container->Reserve(20);
+  EXPECT_EQ(container->GetImportPointerAllocator(), allocator.GetPointer());
+  EXPECT_EQ((*container)[9], 42);
+  container->Reserve(10);
+  container->Squeeze();
+  EXPECT_EQ(container->Capacity(), 10);
+  EXPECT_EQ(container->GetImportPointerAllocator(), allocator.GetPointer());
+  EXPECT_EQ((*container)[9], 42);
+
+  // A buffer taken over by the application is released by its allocator.
+  const auto  poolSize = allocator->GetPoolSize();
+  int * const buffer = container->GetImportPointer();
+  container->ContainerManageMemoryOff();
+  container->GetModifiableImportPointerAllocator()->Deallocate(buffer, container->Capacity() * sizeof(int));
+  EXPECT_GT(allocator->GetPoolSize(), poolSize);
+}
@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Compares how the multi-threader implementations scale with the number of
+// threads on ParallelizeArray and ParallelizeImageRegion workloads, and how
+// they handle fine-grained splits. The thread pools of the Pool and
+// WorkStealing threaders are process-wide and cannot shrink, so the number
+// of threads working at once is varied through the number of work units,
+// each of which runs on one thread. The default sizes keep the test short;
+// pass bigger ones to benchmark, e.g.
+//   ITKCommon2TestDriver itkMultiThreaderScalingTest 100000000 512 5
+
+#include "itkMultiThreaderBase.h"
+#include "itkTimeProbesCollectorBase.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+using ThreaderEnum = itk::MultiThreaderBase::ThreaderEnum;
+
+// Some arithmetic per element, so that the workload is not purely memory bound.
+inline float
+Work(itk::SizeValueType i)
+{
+  const auto x = static_cast<float>(i % 1024);
+  return std::sqrt(x) * std::sin(x);
+}
+
+bool
+RunArrayWorkload(itk::MultiThreaderBase * threader, std::vector<float> & buffer)
+{
+  float * data = buffer.data();
+  threader->ParallelizeArray(0, buffer.size(), [data](itk::SizeValueType i) { data[i] = Work(i); }, nullptr);
+  return buffer.back() == Work(buffer.size() - 1);
+}
+
+bool
+RunRegionWorkload(itk::MultiThreaderBase * threader, std::vector<float> & buffer, itk::SizeValueType edge)
+{
+  using RegionType = itk::ImageRegion<3>;
+  const RegionType region({ { 0, 0, 0 } }, { { edge, edge, edge } });
+  float *          data = buffer.data();
+  threader->ParallelizeImageRegion<3>(
+    region,
+    [data, edge](const RegionType & piece) {
+      const itk::IndexValueType * index = piece.GetIndex().data();
+      const itk::SizeValueType *  size = piece.GetSize().data();
+      for (itk::SizeValueType z = index[2]; z < index[2] + size[2]; ++z)
+      {
+        for (itk::SizeValueType y = index[1]; y < index[1] + size[1]; ++y)
+        {
+          const itk::SizeValueType offset = (z * edge + y) * edge;
+          for (itk::SizeValueType x = index[0]; x < index[0] + size[0]; ++x)
+          {
+            data[offset + x] = Work(offset + x);
+          }
+        }
+      }
+    },
+    nullptr);
+  return buffer.back() == Work(buffer.size() - 1);
+}
+} // namespace
+
+int
+itkMultiThreaderScalingTest(int argc, char * argv[])
+{
+  const itk::SizeValueType arraySize = argc > 1 ? std::stoul(argv[1]) : 1000000;
+  const itk::SizeValueType edge = argc > 2 ? std::stoul(argv[2]) : 64;
+  const unsigned int       repetitions = argc > 3 ? std::stoi(argv[3]) : 2;
+
+  const std::vector<ThreaderEnum> threadersToTest = {
+    ThreaderEnum::Pool,
+#ifdef ITK_USE_TBB
+    ThreaderEnum::TBB,
+#endif // ITK_USE_TBB
+    ThreaderEnum::WorkStealing,
+  };
+
+  std::vector<itk::ThreadIdType> threadCounts;
+  const itk::ThreadIdType        maximumThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  for (itk::ThreadIdType threads = 1; threads < maximumThreads; threads *= 2)
+  {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(maximumThreads);
+
+  std::vector<float>           arrayBuffer(arraySize);
+  std::vector<float>           regionBuffer(edge * edge * edge);
+  itk::TimeProbesCollectorBase collector;
+  bool                         success = true;
+
+  const auto runWorkloads = [&](itk::MultiThreaderBase * threader, const std::string & suffix) {
+    for (unsigned int r = 0; r < repetitions; ++r)
+    {
+      collector.Start(("Array" + suffix).c_str());
+      success &= RunArrayWorkload(threader, arrayBuffer);
+      collector.Stop(("Array" + suffix).c_str());
+
+      collector.Start(("Region" + suffix).c_str());
+      success &= RunRegionWorkload(threader, regionBuffer, edge);
+      collector.Stop(("Region" + suffix).c_str());
+    }
+  };
+
+  for (const auto threaderType : threadersToTest)
+  {
+    itk::MultiThreaderBase::SetGlobalDefaultThreader(threaderType);
+    const std::string threaderName = itk::MultiThreaderBase::ThreaderTypeToString(threaderType);
+    for (const auto threads : threadCounts)
+    {
+      const auto threader = itk::MultiThreaderBase::New();
+      threader->SetMaximumNumberOfThreads(threads);
+      threader->SetNumberOfWorkUnits(threads);
+      runWorkloads(threader, ' ' + threaderName + ' ' + std::to_string(threads) + " threads");
+    }
+
+    // Fine-grained splits, as used by filters, are where the schedulers differ the most.
+    const auto threader = itk::MultiThreaderBase::New();
+    threader->SetMaximumNumberOfThreads(maximumThreads);
+    threader->SetNumberOfWorkUnits(16 * maximumThreads);
+    runWorkloads(threader, ' ' + threaderName + ' ' + std::to_string(maximumThreads) + " threads, fine-grained");
+  }
+
+  collector.Report();
+
+  if (!success)
+  {
+    std::cerr << "Test failed: a workload computed a wrong result." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,224 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkProcessObject.h"
+
+#include "itkAbsImageFilter.h"
+#include "itkAddImageFilter.h"
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+
+namespace
+{
+using ImageType = itk::Image<int, 3>;
+using AbsFilterType = itk::AbsImageFilter<ImageType, ImageType>;
+using AddFilterType = itk::AddImageFilter<ImageType, ImageType, ImageType>;
+
+ImageType::Pointer
+MakeImage(const int value)
+{
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(32));
+  image->AllocateInitialized();
+  image->FillBuffer(value);
+  return image;
+}
+
+// Adds an observer which counts the executions of the specified filter.
+void
+CountExecutions(itk::ProcessObject & filter, std::atomic<int> & counter)
+{
+  filter.AddObserver(itk::StartEvent(), [&counter](const itk::EventObject &) { ++counter; });
+}
+} // namespace
+
+
+// Tests that independent input branches are updated correctly when ParallelInputUpdate is on.
+TEST(ProcessObject, ParallelInputUpdateOfIndependentBranches)
+{
+  const auto abs1 = AbsFilterType::New();
+  const auto abs2 = AbsFilterType::New();
+  abs1->SetInput(MakeImage(-3));
+  abs2->SetInput(MakeImage(-4));
+  abs1->SetNumberOfWorkUnits(8);
+  abs2->SetNumberOfWorkUnits(8);
+
+  std::atomic<int> executions{ 0 };
+  CountExecutions(*abs1, executions);
+  CountExecutions(*abs2, executions);
+
+  const auto add = AddFilterType::New();
+  EXPECT_FALSE(add->GetParallelInputUpdate());
+  add->ParallelInputUpdateOn();
+  add->SetInput1(abs1->GetOutput());
+  add->SetInput2(abs2->GetOutput());
+  add->Update();
+
+  EXPECT_EQ(executions, 2);
+  for (const int pixel : itk::ImageBufferRange<const ImageType>(*add->GetOutput()))
+  {
+    EXPECT_EQ(pixel, 7);
+  }
+
+  // The work units shared between the branches are restored afterwards,
+  // without modifying the upstream filters.
+  EXPECT_EQ(abs1->GetNumberOfWorkUnits(), 8u);
+  EXPECT_EQ(abs2->GetNumberOfWorkUnits(), 8u);
+  add->Update();
+  EXPECT_EQ(executions, 2);
+
+  // Modifying one branch only executes that branch again.
+  abs2->SetInput(MakeImage(5));
+  add->Update();
+  EXPECT_EQ(executions, 3);
+  EXPECT_EQ(add->GetOutput()->GetPixel({}), 8);
+}
+
+
+#if defined(ITK_USE_POOL_MULTI_THREADER)
+// Tests that independent input branches are actually updated at the same time when ParallelInputUpdate is on.
+TEST(ProcessObject, ParallelInputUpdateRunsBranchesConcurrently)
+{
+  const auto abs1 = AbsFilterType::New();
+  const auto abs2 = AbsFilterType::New();
+  abs1->SetInput(MakeImage(-3));
+  abs2->SetInput(MakeImage(-4));
+
+  // Each filter waits for the other one to start, which only happens in time
+  // when both branches run concurrently.
+  std::atomic<int>  started{ 0 };
+  std::atomic<bool> overlapped{ true };
+  const auto        waitForTheOtherBranch = [&started, &overlapped](const itk::EventObject &) {
+    ++started;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (started < 2)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        overlapped = false;
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  };
+  abs1->AddObserver(itk::StartEvent(), waitForTheOtherBranch);
+  abs2->AddObserver(itk::StartEvent(), waitForTheOtherBranch);
+
+  const auto add = AddFilterType::New();
+  add->ParallelInputUpdateOn();
+  add->SetInput1(abs1->GetOutput());
+  add->SetInput2(abs2->GetOutput());
+  add->Update();
+
+  EXPECT_EQ(started, 2);
+  EXPECT_TRUE(overlapped);
+  EXPECT_EQ(add->GetOutput()->GetPixel({}), 7);
+}
+#endif
+
+
+// Tests that inputs sharing an upstream filter are still updated correctly when ParallelInputUpdate is on.
+TEST(ProcessObject, ParallelInputUpdateOfSharedBranch)
+{
+  const auto abs = AbsFilterType::New();
+  abs->SetInput(MakeImage(-2));
+
+  std::atomic<int> executions{ 0 };
+  CountExecutions(*abs, executions);
+
+  const auto abs1 = AbsFilterType::New();
+  const auto abs2 = AbsFilterType::New();
+  abs1->SetInput(abs->GetOutput());
+  abs2->SetInput(abs->GetOutput());
+
+  const auto add = AddFilterType::New();
+  add->ParallelInputUpdateOn();
+  add->SetInput1(abs1->GetOutput());
+  add->SetInput2(abs2->GetOutput());
+  add->Update();
+
+  EXPECT_EQ(executions, 1);
+  EXPECT_EQ(add->GetOutput()->GetPixel({}), 4);
+}
+
+
+// Tests that an input without a source does not make a branch, so that a single upstream branch is updated serially.
+TEST(ProcessObject, ParallelInputUpdateOfInputWithoutSource)
+{
+  const auto abs = AbsFilterType::New();
+  abs->SetInput(MakeImage(-3));
+  abs->SetNumberOfWorkUnits(8);
+
+  itk::ThreadIdType numberOfWorkUnitsDuringUpdate = 0;
+  abs->AddObserver(itk::StartEvent(), [&abs, &numberOfWorkUnitsDuringUpdate](const itk::EventObject &) {
+    numberOfWorkUnitsDuringUpdate = abs->GetNumberOfWorkUnits();
+  });
+
+  const auto add = AddFilterType::New();
+  add->ParallelInputUpdateOn();
+  add->SetInput1(abs->GetOutput());
+  add->SetInput2(MakeImage(4));
+  add->Update();
+
+  EXPECT_EQ(numberOfWorkUnitsDuringUpdate, 8u);
+  EXPECT_EQ(add->GetOutput()->GetPixel({}), 7);
+}
+
+
+// Tests that inputs sharing an upstream input without a source belong to the same branch, so that they are not updated
+// concurrently.
+TEST(ProcessObject, ParallelInputUpdateOfSharedSourcelessInput)
+{
+  const auto image = MakeImage(-3);
+
+  const auto abs1 = AbsFilterType::New();
+  const auto abs2 = AbsFilterType::New();
+  abs1->SetInput(image);
+  abs2->SetInput(image);
+  abs1->SetNumberOfWorkUnits(8);
+  abs2->SetNumberOfWorkUnits(8);
+
+  std::atomic<int>  executions{ 0 };
+  itk::ThreadIdType numberOfWorkUnitsDuringUpdate = 0;
+  CountExecutions(*abs1, executions);
+  CountExecutions(*abs2, executions);
+  abs1->AddObserver(itk::StartEvent(), [&abs1, &numberOfWorkUnitsDuringUpdate](const itk::EventObject &) {
+    numberOfWorkUnitsDuringUpdate = abs1->GetNumberOfWorkUnits();
+  });
+
+  const auto add = AddFilterType::New();
+  add->ParallelInputUpdateOn();
+  add->SetInput1(abs1->GetOutput());
+  add->SetInput2(abs2->GetOutput());
+  add->Update();
+
+  // A single branch is updated serially, with all of its work units.
+  EXPECT_EQ(numberOfWorkUnitsDuringUpdate, 8u);
+  EXPECT_EQ(executions, 2);
+  for (const int pixel : itk::ImageBufferRange<const ImageType>(*add->GetOutput()))
+  {
+    EXPECT_EQ(pixel, 6);
+  }
+}
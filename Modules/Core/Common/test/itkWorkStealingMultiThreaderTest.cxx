@@ -0,0 +1,127 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWorkStealingMultiThreader.h"
+#include "itkTestingMacros.h"
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+// Sum of all the indices in [0, size), computed with a parallel section
+// nested inside every iteration of an outer parallel section.
+bool
+TestNestedParallelism(itk::MultiThreaderBase * outer, itk::MultiThreaderBase * inner)
+{
+  constexpr itk::SizeValueType outerSize = 64;
+  constexpr itk::SizeValueType innerSize = 1000;
+
+  std::vector<itk::SizeValueType> sums(outerSize, 0);
+  outer->ParallelizeArray(
+    0,
+    outerSize,
+    [&sums, inner](itk::SizeValueType i) {
+      std::atomic<itk::SizeValueType> sum{ 0 };
+      inner->ParallelizeArray(0, innerSize, [&sum](itk::SizeValueType j) { sum += j; }, nullptr);
+      sums[i] = sum;
+    },
+    nullptr);
+
+  constexpr itk::SizeValueType expected = innerSize * (innerSize - 1) / 2;
+  for (itk::SizeValueType i = 0; i < outerSize; ++i)
+  {
+    if (sums[i] != expected)
+    {
+      std::cerr << "Nested sum " << i << " is " << sums[i] << " instead of " << expected << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkWorkStealingMultiThreaderTest(int, char *[])
+{
+  const auto workStealingThreader = itk::WorkStealingMultiThreader::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(workStealingThreader, WorkStealingMultiThreader, MultiThreaderBase);
+
+  // The templated ParallelizeImageRegion overload is only visible through the base class.
+  itk::MultiThreaderBase * threader = workStealingThreader;
+
+  // Every index is visited exactly once.
+  constexpr itk::SizeValueType size = 100003;
+  std::vector<unsigned int>    visits(size, 0);
+  threader->ParallelizeArray(0, size, [&visits](itk::SizeValueType i) { ++visits[i]; }, nullptr);
+  for (itk::SizeValueType i = 0; i < size; ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL(visits[i], 1u);
+  }
+
+  // Every pixel of a region is visited exactly once.
+  using RegionType = itk::ImageRegion<3>;
+  const RegionType                region({ { 3, -2, 5 } }, { { 37, 41, 13 } });
+  std::atomic<itk::SizeValueType> pixelCount{ 0 };
+  threader->ParallelizeImageRegion<3>(
+    region,
+    [&pixelCount, &region](const RegionType & piece) {
+      if (!region.IsInside(piece))
+      {
+        itkGenericExceptionMacro("Piece " << piece << " is outside of " << region);
+      }
+      pixelCount += piece.GetNumberOfPixels();
+    },
+    nullptr);
+  ITK_TEST_EXPECT_EQUAL(pixelCount.load(), region.GetNumberOfPixels());
+
+  // Exceptions thrown by a work unit are propagated to the caller.
+  ITK_TRY_EXPECT_EXCEPTION(threader->ParallelizeArray(
+    0,
+    size,
+    [](itk::SizeValueType i) {
+      if (i == size - 1)
+      {
+        itkGenericExceptionMacro("Exception from the last work unit");
+      }
+    },
+    nullptr));
+
+  // SingleMethodExecute calls the method once per work unit.
+  threader->SetNumberOfWorkUnits(7);
+  std::vector<unsigned int> workUnitVisits(threader->GetNumberOfWorkUnits(), 0);
+  threader->SetSingleMethodAndExecute(
+    [](void * arg) -> itk::ITK_THREAD_RETURN_TYPE {
+      auto * info = static_cast<itk::MultiThreaderBase::WorkUnitInfo *>(arg);
+      ++(*static_cast<std::vector<unsigned int> *>(info->UserData))[info->WorkUnitID];
+      return ITK_THREAD_RETURN_DEFAULT_VALUE;
+    },
+    &workUnitVisits);
+  ITK_TEST_EXPECT_EQUAL(std::accumulate(workUnitVisits.cbegin(), workUnitVisits.cend(), 0u),
+                        threader->GetNumberOfWorkUnits());
+
+  // Parallel sections nested inside work units must neither deadlock nor
+  // give wrong results, including when the same threader is reused.
+  const auto innerThreader = itk::WorkStealingMultiThreader::New();
+  ITK_TEST_EXPECT_TRUE(TestNestedParallelism(threader, innerThreader));
+  ITK_TEST_EXPECT_TRUE(TestNestedParallelism(threader, threader));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -136,6 +136,7 @@ public:
   using typename Superclass::JacobianType;
   using typename Superclass::JacobianPositionType;
   using typename Superclass::InverseJacobianPositionType;
+  using typename Superclass::NonZeroJacobianIndicesType;
 
   /** The number of parameters defining this transform. */
   using typename Superclass::NumberOfParametersType;
@@ -238,10 +239,33 @@ public:
                  ParameterIndexArrayType & indices,
                  bool &                    inside) const override;
 
+  /** Transform a batch of points, reading the coefficients of the support
+   * regions directly in the coefficient buffers. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /** Compute the Jacobian in one position. */
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override;
 
+  /** The Jacobian has at most SpaceDimension * NumberOfWeights nonzero
+   * columns at each point. */
+  bool
+  HasSparseJacobianWithRespectToParameters() const override
+  {
+    return true;
+  }
+
+  /** Compute the columns of the Jacobian in one position for the
+   * coefficients of the support region, without the zero columns of the
+   * other coefficients. There are no columns outside of the valid region. */
+  void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &       point,
+                                               JacobianType &               jacobian,
+                                               NonZeroJacobianIndicesType & nonZeroJacobianIndices) const override;
+
   /** Return the number of parameters that completely define the Transform. */
   NumberOfParametersType
   GetNumberOfParameters() const override;
@@ -22,6 +22,7 @@
 #include "itkContinuousIndex.h"
 #include "itkImageScanlineConstIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkIndexRange.h"
 
 namespace itk
 {
@@ -592,6 +593,75 @@ BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoint
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoints(const InputPointType * inputPoints,
+                                                                                  OutputPointType *      outputPoints,
+                                                                                  SizeValueType numberOfPoints) const
+{
+  const ImageType * const coefficientImage = this->m_CoefficientImages[0];
+  if (!coefficientImage->GetBufferPointer())
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  // The offsets of the coefficients of a support region, relative to its
+  // first coefficient, are the same for all the points.
+  FixedArray<OffsetValueType, Superclass::NumberOfWeights> supportOffsets;
+  const OffsetValueType * const                            offsetTable = coefficientImage->GetOffsetTable();
+  unsigned int                                             counter = 0;
+  for (const IndexType & index : ZeroBasedIndexRange<SpaceDimension>(SizeType::Filled(SplineOrder + 1)))
+  {
+    OffsetValueType offset = 0;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      offset += index[d] * offsetTable[d];
+    }
+    supportOffsets[counter++] = offset;
+  }
+  const ParametersValueType * coefficients[SpaceDimension];
+  for (unsigned int j = 0; j < SpaceDimension; ++j)
+  {
+    coefficients[j] = this->m_CoefficientImages[j]->GetBufferPointer();
+  }
+
+  using ContinuousIndexValueType = typename ContinuousIndexType::ValueType;
+
+  WeightsType weights;
+  IndexType   supportIndex;
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    // a copy, as the output may overwrite the input
+    const InputPointType point = inputPoints[i];
+    ContinuousIndexType  index =
+      coefficientImage->template TransformPhysicalPointToContinuousIndex<ContinuousIndexValueType>(point);
+
+    // NOTE: if the support region does not lie totally within the grid
+    // we assume zero displacement and return the input point
+    if (!this->InsideValidRegion(index))
+    {
+      outputPoints[i] = point;
+      continue;
+    }
+
+    this->m_WeightsFunction->Evaluate(index, weights, supportIndex);
+
+    // For each dimension, correlate coefficient with weights
+    const OffsetValueType supportOffset = coefficientImage->ComputeOffset(supportIndex);
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      const ParametersValueType * const supportCoefficients = coefficients[j] + supportOffset;
+      ScalarType                        displacement{};
+      for (unsigned int k = 0; k < Superclass::NumberOfWeights; ++k)
+      {
+        displacement += static_cast<ScalarType>(weights[k] * supportCoefficients[supportOffsets[k]]);
+      }
+      outputPoints[i][j] = displacement + point[j];
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 void
 BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeJacobianWithRespectToParameters(
@@ -655,6 +725,55 @@ BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeJacobia
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &       point,
+  JacobianType &               jacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+{
+  const ImageType * const coefficientImage = this->m_CoefficientImages[0];
+
+  ContinuousIndexType index =
+    coefficientImage->template TransformPhysicalPointToContinuousIndex<typename ContinuousIndexType::ValueType>(point);
+
+  // NOTE: if the support region does not lie totally within the grid, the
+  // Jacobian is zero
+  if (!this->InsideValidRegion(index))
+  {
+    jacobian.SetSize(SpaceDimension, 0);
+    nonZeroJacobianIndices.clear();
+    return;
+  }
+
+  // Compute interpolation weights
+  WeightsType weights;
+  IndexType   supportIndex;
+  this->m_WeightsFunction->Evaluate(index, weights, supportIndex);
+
+  // The columns of dimension d are those of the coefficients of the support
+  // region in the parameters of dimension d, with the weights in row d.
+  constexpr unsigned int numberOfWeights = Superclass::NumberOfWeights;
+  jacobian.SetSize(SpaceDimension, SpaceDimension * numberOfWeights);
+  jacobian.Fill(0.0);
+  nonZeroJacobianIndices.resize(SpaceDimension * numberOfWeights);
+
+  const SizeValueType numberOfParametersPerDimension = this->GetNumberOfParametersPerDimension();
+
+  const RegionType supportRegion(supportIndex, SizeType::Filled(SplineOrder + 1));
+  unsigned int     counter = 0;
+  for (const IndexType & coefficientIndex : ImageRegionIndexRange<SpaceDimension>(supportRegion))
+  {
+    const auto number = static_cast<NumberOfParametersType>(coefficientImage->ComputeOffset(coefficientIndex));
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      jacobian(d, d * numberOfWeights + counter) = weights[counter];
+      nonZeroJacobianIndices[d * numberOfWeights + counter] = number + d * numberOfParametersPerDimension;
+    }
+    ++counter;
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 void
 BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::PrintSelf(std::ostream & os, Indent indent) const
@@ -18,6 +18,7 @@
 #ifndef itkCompositeTransform_hxx
 #define itkCompositeTransform_hxx
 
+#include <algorithm>
 
 namespace itk
 {
@@ -70,6 +71,28 @@ CompositeTransform<TParametersValueType, VDimension>::TransformPoint(const Input
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                      OutputPointType *      outputPoints,
+                                                                      SizeValueType          numberOfPoints) const
+{
+  if (this->m_TransformQueue.empty())
+  {
+    std::copy_n(inputPoints, numberOfPoints, outputPoints);
+    return;
+  }
+
+  /* Apply in reverse queue order, in place after the first transform.  */
+  const InputPointType * points = inputPoints;
+  for (auto it = this->m_TransformQueue.rbegin(); it != this->m_TransformQueue.rend(); ++it)
+  {
+    (*it)->TransformPoints(points, outputPoints, numberOfPoints);
+    points = outputPoints;
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 CompositeTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & inputVector) const
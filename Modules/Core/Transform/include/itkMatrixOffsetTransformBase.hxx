@@ -128,6 +128,30 @@ MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimensio
 }
 
 
+template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
+void
+MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    // a copy, as the output may overwrite the input
+    const InputPointType point = inputPoints[i];
+    for (unsigned int r = 0; r < VOutputDimension; ++r)
+    {
+      ScalarType value = m_Offset[r];
+      for (unsigned int c = 0; c < VInputDimension; ++c)
+      {
+        value += m_Matrix[r][c] * point[c];
+      }
+      outputPoints[i][r] = value;
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
 auto
 MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformVector(
@@ -117,6 +117,26 @@ ScaleTransform<TParametersValueType, VDimension>::TransformPoint(const InputPoin
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+ScaleTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                  OutputPointType *      outputPoints,
+                                                                  SizeValueType          numberOfPoints) const
+{
+  const InputPointType & center = this->GetCenter();
+
+  for (SizeValueType p = 0; p < numberOfPoints; ++p)
+  {
+    // The output may overwrite the input
+    const InputPointType point = inputPoints[p];
+    for (unsigned int i = 0; i < SpaceDimension; ++i)
+    {
+      outputPoints[p][i] = (point[i] - center[i]) * m_Scale[i] + center[i];
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 ScaleTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & vect) const
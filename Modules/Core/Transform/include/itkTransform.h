@@ -19,6 +19,7 @@
 #define itkTransform_h
 
 #include <type_traits> // For std::enable_if
+#include <vector>
 #include "itkTransformBase.h"
 #include "itkVector.h"
 #include "itkSymmetricSecondRankTensor.h"
@@ -173,6 +174,10 @@ public:
 
   using typename Superclass::NumberOfParametersType;
 
+  /** Type of the indices of the parameters of the columns of a sparse
+   * Jacobian. */
+  using NonZeroJacobianIndicesType = std::vector<NumberOfParametersType>;
+
   /**  Method to transform a point.
    * \warning This method must be thread-safe. See, e.g., its use
    * in ResampleImageFilter.
@@ -180,6 +185,17 @@ public:
   virtual OutputPointType
   TransformPoint(const InputPointType &) const = 0;
 
+  /** Method to transform a batch of points, for example the points of a line
+   * of an image. The default implementation calls TransformPoint for each
+   * point. Subclasses may override it to avoid a virtual call per point, and
+   * to share computations between the points. \c outputPoints may be the same
+   * buffer as \c inputPoints when the point types are the same.
+   * \warning This method must be thread-safe. */
+  virtual void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const;
+
   /**  Method to transform a vector. */
   virtual OutputVectorType
   TransformVector(const InputVectorType &) const
@@ -515,6 +531,29 @@ public:
     this->ComputeJacobianWithRespectToParameters(p, jacobian);
   }
 
+  /** Whether only a few columns of the Jacobian with respect to the
+   * parameters are nonzero at each point, as for a transform whose
+   * parameters have a local support, e.g. BSplineTransform. Such transforms
+   * compute these columns with ComputeSparseJacobianWithRespectToParameters
+   * in much less time than the whole Jacobian. */
+  virtual bool
+  HasSparseJacobianWithRespectToParameters() const
+  {
+    return false;
+  }
+
+  /** Compute the columns of the Jacobian with respect to the parameters
+   * which may be nonzero at a point. \c nonZeroJacobianIndices holds the
+   * indices of the parameters of the columns of \c jacobian, which are
+   * distinct. The other columns of the Jacobian are zero. The default
+   * implementation returns all the columns of
+   * ComputeJacobianWithRespectToParameters.
+   * \warning This method must be thread-safe. */
+  virtual void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &       p,
+                                               JacobianType &               jacobian,
+                                               NonZeroJacobianIndicesType & nonZeroJacobianIndices) const;
+
 
   /** This provides the ability to get a local jacobian value
    *  in a dense/local transform, e.g. DisplacementFieldTransform. For such
@@ -22,6 +22,8 @@
 #include "vnl/algo/vnl_svd_fixed.h"
 #include "itkMetaProgrammingLibrary.h"
 
+#include <numeric> // For iota.
+
 namespace itk
 {
 
@@ -119,6 +121,32 @@ Transform<TParametersValueType, VInputDimension, VOutputDimension>::UpdateTransf
 }
 
 
+template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
+void
+Transform<TParametersValueType, VInputDimension, VOutputDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                                    OutputPointType *      outputPoints,
+                                                                                    SizeValueType numberOfPoints) const
+{
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    outputPoints[i] = this->TransformPoint(inputPoints[i]);
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
+void
+Transform<TParametersValueType, VInputDimension, VOutputDimension>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &       p,
+  JacobianType &               jacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+{
+  this->ComputeJacobianWithRespectToParameters(p, jacobian);
+  nonZeroJacobianIndices.resize(jacobian.cols());
+  std::iota(nonZeroJacobianIndices.begin(), nonZeroJacobianIndices.end(), NumberOfParametersType{ 0 });
+}
+
+
 template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
 auto
 Transform<TParametersValueType, VInputDimension, VOutputDimension>::TransformVector(const InputVectorType & vector,
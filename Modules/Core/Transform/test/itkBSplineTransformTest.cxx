@@ -30,6 +30,7 @@
 
 
 #include "itkTextOutput.h"
+#include "itkTestingMacros.h"
 
 /**
  * This module test the functionality of the BSplineTransform class.
@@ -306,6 +307,37 @@ itkBSplineTransformTest1()
     std::cout << std::endl;
   }
 
+  /**
+   * The sparse Jacobian holds the nonzero columns of the Jacobian
+   */
+  ITK_TEST_EXPECT_TRUE(transform->HasSparseJacobianWithRespectToParameters());
+  for (const double coordinate : { 7.5, 3.2, 12.9, -10.0 })
+  {
+    inputPoint.Fill(coordinate);
+    inputPoint[1] += 0.7;
+    JacobianType jacobian;
+    transform->ComputeJacobianWithRespectToParameters(inputPoint, jacobian);
+    JacobianType                                sparseJacobian;
+    TransformType::NonZeroJacobianIndicesType nonZeroJacobianIndices;
+    transform->ComputeSparseJacobianWithRespectToParameters(inputPoint, sparseJacobian, nonZeroJacobianIndices);
+    ITK_TEST_EXPECT_EQUAL(sparseJacobian.cols(), nonZeroJacobianIndices.size());
+
+    JacobianType expandedJacobian(jacobian.rows(), jacobian.cols());
+    expandedJacobian.Fill(0.0);
+    for (unsigned int k = 0; k < nonZeroJacobianIndices.size(); ++k)
+    {
+      for (unsigned int d = 0; d < SpaceDimension; ++d)
+      {
+        expandedJacobian(d, nonZeroJacobianIndices[k]) += sparseJacobian(d, k);
+      }
+    }
+    if (expandedJacobian != jacobian)
+    {
+      std::cout << "The sparse Jacobian is different from the Jacobian at " << inputPoint << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   /**
    * TODO: add test to check the numerical accuracy of the jacobian output
    */
@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkCompositeTransform.h"
+#include "itkIdentityTransform.h"
+#include "itkScaleTransform.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using TransformType = itk::Transform<double, Dimension, Dimension>;
+using PointType = TransformType::InputPointType;
+
+// Points inside and outside of the domain of the B-spline transform.
+std::vector<PointType>
+CreatePoints()
+{
+  std::vector<PointType> points;
+  for (unsigned int i = 0; i < 200; ++i)
+  {
+    PointType point;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      point[d] = -5.0 + 25.0 * std::abs(std::sin(1.7 * i + 0.9 * d));
+    }
+    points.push_back(point);
+  }
+  return points;
+}
+
+// The batched transform of the points, also in place, gives the transform of
+// each point.
+bool
+TestTransformPoints(const char * name, const TransformType * transform)
+{
+  std::cout << name << std::endl;
+
+  const std::vector<PointType> points = CreatePoints();
+  std::vector<PointType>       outputPoints(points.size());
+  transform->TransformPoints(points.data(), outputPoints.data(), points.size());
+  std::vector<PointType> inPlacePoints = points;
+  transform->TransformPoints(inPlacePoints.data(), inPlacePoints.data(), inPlacePoints.size());
+
+  for (unsigned int i = 0; i < points.size(); ++i)
+  {
+    const PointType expected = transform->TransformPoint(points[i]);
+    if (expected.EuclideanDistanceTo(outputPoints[i]) > 1e-12 ||
+        expected.EuclideanDistanceTo(inPlacePoints[i]) > 1e-12)
+    {
+      std::cerr << name << ": different points for " << points[i] << ": " << outputPoints[i] << " and "
+                << inPlacePoints[i] << " != " << expected << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkTransformPointsTest(int, char *[])
+{
+  using AffineTransformType = itk::AffineTransform<double, Dimension>;
+  using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+  using CompositeTransformType = itk::CompositeTransform<double, Dimension>;
+  using ScaleTransformType = itk::ScaleTransform<double, Dimension>;
+
+  bool success = true;
+
+  const auto identityTransform = itk::IdentityTransform<double, Dimension>::New();
+  success = TestTransformPoints("IdentityTransform", identityTransform) && success;
+
+  auto                                 affineTransform = AffineTransformType::New();
+  AffineTransformType::ParametersType affineParameters(affineTransform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < affineParameters.size(); ++i)
+  {
+    affineParameters[i] = (i % 4 == 0 ? 1.0 : 0.0) + 0.1 * std::cos(1.3 * i);
+  }
+  affineTransform->SetParameters(affineParameters);
+  success = TestTransformPoints("AffineTransform", affineTransform) && success;
+
+  // The scale transform ignores the translation, in both TransformPoint and TransformPoints
+  auto scaleTransform = ScaleTransformType::New();
+  scaleTransform->SetScale(itk::MakeVector(1.5, 0.75, 2.0));
+  scaleTransform->SetCenter(itk::MakePoint(1.0, -2.0, 3.0));
+  scaleTransform->SetTranslation(itk::MakeVector(0.5, 1.0, -1.5));
+  success = TestTransformPoints("ScaleTransform", scaleTransform) && success;
+
+  auto bsplineTransform = BSplineTransformType::New();
+  success = TestTransformPoints("BSplineTransform without parameters", bsplineTransform) && success;
+  bsplineTransform->SetTransformDomainOrigin(itk::MakeFilled<BSplineTransformType::OriginType>(1.0));
+  bsplineTransform->SetTransformDomainPhysicalDimensions(
+    itk::MakeFilled<BSplineTransformType::PhysicalDimensionsType>(12.0));
+  BSplineTransformType::MeshSizeType meshSize;
+  meshSize[0] = 4;
+  meshSize[1] = 5;
+  meshSize[2] = 3;
+  bsplineTransform->SetTransformDomainMeshSize(meshSize);
+  BSplineTransformType::ParametersType bsplineParameters(bsplineTransform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < bsplineParameters.size(); ++i)
+  {
+    bsplineParameters[i] = 0.8 * std::sin(0.7 * i);
+  }
+  bsplineTransform->SetParameters(bsplineParameters);
+  success = TestTransformPoints("BSplineTransform", bsplineTransform) && success;
+
+  auto compositeTransform = CompositeTransformType::New();
+  success = TestTransformPoints("CompositeTransform without transforms", compositeTransform) && success;
+  compositeTransform->AddTransform(affineTransform);
+  compositeTransform->AddTransform(bsplineTransform);
+  compositeTransform->AddTransform(identityTransform);
+  success = TestTransformPoints("CompositeTransform", compositeTransform) && success;
+
+  std::cout << "Test finished." << std::endl;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -101,6 +101,43 @@ DisplacementFieldTransform<TParametersValueType, VDimension>::TransformPoint(con
   return outputPoint;
 }
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+DisplacementFieldTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                              OutputPointType *      outputPoints,
+                                                                              SizeValueType numberOfPoints) const
+{
+  if (!this->m_DisplacementField)
+  {
+    itkExceptionMacro("No displacement field is specified.");
+  }
+  if (!this->m_Interpolator)
+  {
+    itkExceptionMacro("No interpolator is specified.");
+  }
+
+  using ContinuousIndexType = typename InterpolatorType::ContinuousIndexType;
+  using ContinuousIndexValueType = typename ContinuousIndexType::ValueType;
+
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    typename InterpolatorType::PointType point;
+    point.CastFrom(inputPoints[i]);
+    outputPoints[i].CastFrom(inputPoints[i]);
+
+    const ContinuousIndexType cidx =
+      this->m_DisplacementField->template TransformPhysicalPointToContinuousIndex<ContinuousIndexValueType>(point);
+    if (this->m_Interpolator->IsInsideBuffer(cidx))
+    {
+      const typename InterpolatorType::OutputType displacement = this->m_Interpolator->EvaluateAtContinuousIndex(cidx);
+      for (unsigned int ii = 0; ii < VDimension; ++ii)
+      {
+        outputPoints[i][ii] += displacement[ii];
+      }
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension>
 bool
 DisplacementFieldTransform<TParametersValueType, VDimension>::GetInverse(Self * inverse) const
@@ -425,6 +425,19 @@ itkDisplacementFieldTransformTest(int argc, char * argv[])
     return EXIT_FAILURE;
   }
 
+  // Test a batch of points, with a point outside of the field
+  DisplacementTransformType::InputPointType batchPoints[2] = { testPoint, testPoint };
+  batchPoints[1][0] = -100.0;
+  const DisplacementTransformType::OutputPointType outsideTruth = displacementTransform->TransformPoint(batchPoints[1]);
+  displacementTransform->TransformPoints(batchPoints, batchPoints, 2);
+
+  if (!samePoint(batchPoints[0], deformTruth) || !samePoint(batchPoints[1], outsideTruth))
+  {
+    std::cout << "Error transforming points: TransformPoints(...)" << std::endl;
+    std::cout << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   DisplacementTransformType::InputVectorType testVector;
   testVector[0] = 0.5;
   testVector[1] = 0.5;
@@ -48,7 +48,19 @@ namespace itk
  *  input binary image. Normally this is zero and, as such, zero is the
  *  default value.  Other than that, the usage is completely analogous to
  *  the itk::DanielssonDistanceImageFilter class except it does not return
- *  the Voronoi map.
+ *  the Voronoi map. The vector distance map, from each pixel to its nearest
+ *  pixel of the object boundary, is computed along with the distances when
+ *  ComputeVectorDistanceMap is on.
+ *
+ *  \par Implementation
+ *  The distances are computed one dimension after the other, in parallel
+ *  over the lines along the dimension. The lines along the other dimensions
+ *  than the first one are processed by blocks of adjacent lines, so that
+ *  the image is read and written by contiguous runs of pixels. The boundary
+ *  of the object is found while processing the first dimension, and the
+ *  final distances are written while processing the last one. Without image
+ *  spacing, or with a unit spacing, the squared distances are computed with
+ *  integers.
  *
  *  Reference:
  *  C. R. Maurer, Jr., R. Qi, and V. Raghavan, "A Linear Time Algorithm
@@ -115,6 +127,11 @@ public:
   using OutputSpacingType = typename OutputImageType::SpacingType;
   using OutputImageRegionType = typename OutputImageType::RegionType;
 
+  /** Type of the vector distance map, from each pixel to its nearest pixel
+   * of the object boundary. */
+  using OffsetType = typename OutputImageType::OffsetType;
+  using VectorImageType = Image<OffsetType, ImageDimension>;
+
   /** Set if the distance should be squared. */
   itkSetMacro(SquaredDistance, bool);
 
@@ -153,6 +170,24 @@ public:
   itkSetMacro(BackgroundValue, InputPixelType);
   itkGetConstReferenceMacro(BackgroundValue, InputPixelType);
 
+  /** Set/Get whether the vector distance map is computed. Default is off. */
+  itkSetMacro(ComputeVectorDistanceMap, bool);
+  itkGetConstReferenceMacro(ComputeVectorDistanceMap, bool);
+  itkBooleanMacro(ComputeVectorDistanceMap);
+
+  /** Get the vector distance map, from each pixel to its nearest pixel of
+   * the object boundary, in pixels. It is only computed when
+   * ComputeVectorDistanceMap is on. */
+  VectorImageType *
+  GetVectorDistanceMap();
+
+  /** Standard itk::ProcessObject subclass method. */
+  using DataObjectPointer = DataObject::Pointer;
+  using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
+  using Superclass::MakeOutput;
+  DataObjectPointer
+  MakeOutput(DataObjectPointerArraySizeType idx) override;
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(IntConvertibleToInputCheck, (Concept::Convertible<int, InputPixelType>));
@@ -171,33 +206,51 @@ protected:
   void
   GenerateData() override;
 
-  unsigned int
-  SplitRequestedRegion(unsigned int i, unsigned int num, OutputImageRegionType & splitRegion) override;
-
-  void
-  ThreadedGenerateData(const OutputImageRegionType &, ThreadIdType) override;
-
-  void
-  DynamicThreadedGenerateData(const OutputImageRegionType &) override
-  {
-    itkExceptionMacro("This class requires threadId so it must use classic multi-threading model");
-  }
-
 private:
+  /** Number of lines processed together by ComputeAlongDimension(). */
+  static constexpr unsigned int NumberOfLinesPerBlock = 16;
+
+  /** Computes the squared distances along a dimension for the lines of a
+   * region, from the squared distances along the previous dimensions. Along
+   * the first dimension, the distances are computed from the object
+   * boundary, found with the object mask. Along the last dimension, the
+   * final distances are written. The positions along the dimension are
+   * multiplied by the scale. */
+  template <typename TDistance>
   void
-       Voronoi(unsigned int, OutputIndexType idx, OutputImageType * output);
-  bool Remove(OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType);
+  ComputeAlongDimension(unsigned int                  dimension,
+                        const OutputImageRegionType & region,
+                        const unsigned char *         objectMask,
+                        TDistance                     scale,
+                        float                         progressWeight);
+
+  /** Computes the squared distances along a line, in place, given the
+   * squared distances to the nearest boundary pixel in the hyperplanes
+   * crossing the line, negative when there is none. Sets the position of
+   * the nearest site of each pixel, and returns false without changing
+   * anything when the line has no site. */
+  template <typename TDistance>
+  static bool
+  Voronoi(SizeValueType    length,
+          TDistance        scale,
+          TDistance *      distances,
+          SizeValueType    stride,
+          IndexValueType * nearestSites,
+          TDistance *      siteDistances,
+          TDistance *      sitePositions,
+          IndexValueType * sites);
+
+  template <typename TDistance>
+  static bool
+  Remove(TDistance d1, TDistance d2, TDistance df, TDistance x1, TDistance x2, TDistance xf);
 
   InputPixelType   m_BackgroundValue{};
   InputSpacingType m_Spacing{};
 
-  unsigned int m_CurrentDimension{ 0 };
-
   bool m_InsideIsPositive{ false };
   bool m_UseImageSpacing{ true };
   bool m_SquaredDistance{ false };
-
-  const InputImageType * m_InputCache{};
+  bool m_ComputeVectorDistanceMap{ false };
 };
 } // end namespace itk
 
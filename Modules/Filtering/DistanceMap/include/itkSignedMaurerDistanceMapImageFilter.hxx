@@ -18,379 +18,362 @@
 #ifndef itkSignedMaurerDistanceMapImageFilter_hxx
 #define itkSignedMaurerDistanceMapImageFilter_hxx
 
-#include "itkImageRegionIteratorWithIndex.h"
-#include "itkImageRegionIterator.h"
-#include "itkBinaryThresholdImageFilter.h"
-#include "itkBinaryContourImageFilter.h"
-#include "itkProgressReporter.h"
-#include "itkProgressAccumulator.h"
+#include "itkImageScanlineIterator.h"
+#include "itkIndexRange.h"
+#include "itkMakeUniqueForOverwrite.h"
+#include "itkTotalProgressReporter.h"
 #include "itkMath.h"
-#include "vnl/vnl_vector.h"
+
+#include <algorithm> // For fill_n and min.
+#include <cstdint>
+#include <vector>
 
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage>
 SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::SignedMaurerDistanceMapImageFilter()
-  : m_BackgroundValue(InputPixelType{})
-  , m_Spacing()
-  , m_InputCache(nullptr)
 {
-  this->DynamicMultiThreadingOff();
+  // Make the outputs (distance map, distance vectors).
+  ProcessObject::MakeRequiredOutputs(*this, 2);
 }
 
 template <typename TInputImage, typename TOutputImage>
-unsigned int
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::SplitRequestedRegion(unsigned int            i,
-                                                                                    unsigned int            num,
-                                                                                    OutputImageRegionType & splitRegion)
+auto
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::MakeOutput(DataObjectPointerArraySizeType idx)
+  -> DataObjectPointer
 {
-  // Get the output pointer
-  OutputImageType * outputPtr = this->GetOutput();
-
-  // Initialize the splitRegion to the output requested region
-  splitRegion = outputPtr->GetRequestedRegion();
-
-  const OutputSizeType & requestedRegionSize = splitRegion.GetSize();
-
-  OutputIndexType splitIndex = splitRegion.GetIndex();
-  OutputSizeType  splitSize = splitRegion.GetSize();
-
-  // split on the outermost dimension available
-  // and avoid the current dimension
-  int splitAxis = static_cast<int>(outputPtr->GetImageDimension()) - 1;
-  while ((requestedRegionSize[splitAxis] == 1) || (splitAxis == static_cast<int>(m_CurrentDimension)))
+  if (idx == 1)
   {
-    --splitAxis;
-    if (splitAxis < 0)
-    { // cannot split
-      itkDebugMacro("Cannot Split");
-      return 1;
-    }
+    return VectorImageType::New().GetPointer();
   }
 
-  // determine the actual number of pieces that will be generated
-  auto range = static_cast<double>(requestedRegionSize[splitAxis]);
-
-  auto               valuesPerThread = static_cast<unsigned int>(std::ceil(range / static_cast<double>(num)));
-  const unsigned int maxThreadIdUsed =
-    static_cast<unsigned int>(std::ceil(range / static_cast<double>(valuesPerThread))) - 1;
-
-  // Split the region
-  if (i < maxThreadIdUsed)
-  {
-    splitIndex[splitAxis] += i * valuesPerThread;
-    splitSize[splitAxis] = valuesPerThread;
-  }
-  if (i == maxThreadIdUsed)
-  {
-    splitIndex[splitAxis] += i * valuesPerThread;
-    // last thread needs to process the "rest" dimension being split
-    splitSize[splitAxis] = splitSize[splitAxis] - i * valuesPerThread;
-  }
-
-  // set the split region ivars
-  splitRegion.SetIndex(splitIndex);
-  splitRegion.SetSize(splitSize);
-
-  itkDebugMacro("Split Piece: " << splitRegion);
+  return Superclass::MakeOutput(idx);
+}
 
-  return maxThreadIdUsed + 1;
+template <typename TInputImage, typename TOutputImage>
+auto
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::GetVectorDistanceMap() -> VectorImageType *
+{
+  return dynamic_cast<VectorImageType *>(this->ProcessObject::GetOutput(1));
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
 SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateData()
 {
-  const ThreadIdType numberOfWorkUnits = this->GetNumberOfWorkUnits();
-
   OutputImageType *      outputPtr = this->GetOutput();
   const InputImageType * inputPtr = this->GetInput();
-  m_InputCache = this->GetInput();
 
-  // prepare the data
-  this->AllocateOutputs();
+  // prepare the data; the vector distance map is only allocated when it is
+  // computed
+  const OutputImageRegionType region = outputPtr->GetRequestedRegion();
+  outputPtr->SetBufferedRegion(region);
+  outputPtr->Allocate();
+  if (this->m_ComputeVectorDistanceMap)
+  {
+    VectorImageType * vectorMap = this->GetVectorDistanceMap();
+    vectorMap->SetBufferedRegion(region);
+    vectorMap->Allocate();
+  }
+  else
+  {
+    this->GetVectorDistanceMap()->ReleaseData();
+  }
   this->m_Spacing = outputPtr->GetSpacing();
 
-  // store the binary image in an image with a pixel type as small as possible
-  // instead of keeping the native input pixel type to avoid using too much
-  // memory.
-  using BinaryFilterType = BinaryThresholdImageFilter<InputImageType, OutputImageType>;
-
-  auto progressAcc = ProgressAccumulator::New();
-  progressAcc->SetMiniPipelineFilter(this);
-
-  // compute the boundary of the binary object.
-  // To do that, we erode the binary object. The eroded pixels are the ones
-  // on the boundary. We mark them with the value 2
-  auto binaryFilter = BinaryFilterType::New();
-
-  binaryFilter->SetLowerThreshold(this->m_BackgroundValue);
-  binaryFilter->SetUpperThreshold(this->m_BackgroundValue);
-  binaryFilter->SetInsideValue(NumericTraits<OutputPixelType>::max());
-  binaryFilter->SetOutsideValue(OutputPixelType{});
-  binaryFilter->SetInput(inputPtr);
-  binaryFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
-  progressAcc->RegisterInternalFilter(binaryFilter, 0.1f);
-  binaryFilter->GraftOutput(outputPtr);
-  binaryFilter->Update();
-
-  // Dilate the inverted image by 1 pixel to give it the same boundary
-  // as the uninverted inputPtr.
-  using BorderFilterType = BinaryContourImageFilter<OutputImageType, OutputImageType>;
-  auto borderFilter = BorderFilterType::New();
-  borderFilter->SetInput(binaryFilter->GetOutput());
-  borderFilter->SetForegroundValue(OutputPixelType{});
-  borderFilter->SetBackgroundValue(NumericTraits<OutputPixelType>::max());
-  borderFilter->SetFullyConnected(true);
-  borderFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
-  progressAcc->RegisterInternalFilter(borderFilter, 0.23f);
-  borderFilter->Update();
-
-  this->GraftOutput(borderFilter->GetOutput());
-
-  // Set up the multithreaded processing
-  typename ImageSource<OutputImageType>::ThreadStruct str;
-  str.Filter = this;
-
-  this->GetMultiThreader()->SetNumberOfWorkUnits(numberOfWorkUnits);
-  this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
-
-  // multithread the execution
-  for (unsigned int d = 0; d < ImageDimension; ++d)
+  if (region.GetNumberOfPixels() == 0)
   {
-    m_CurrentDimension = d;
-    this->GetMultiThreader()->SingleMethodExecute();
+    return;
   }
-}
 
-template <typename TInputImage, typename TOutputImage>
-void
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
-  const OutputImageRegionType & outputRegionForThread,
-  ThreadIdType                  threadId)
-{
-  OutputImageType * outputImage = this->GetOutput();
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
-  const InputRegionType region = outputRegionForThread;
-  InputSizeType         size = region.GetSize();
-  InputIndexType        startIndex = outputRegionForThread.GetIndex();
+  // store the binary image in a mask with a pixel type as small as possible,
+  // with the same layout as the output buffer
+  const auto objectMask = make_unique_for_overwrite<unsigned char[]>(region.GetNumberOfPixels());
 
-  OutputImageType * outputPtr = this->GetOutput();
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [this, inputPtr, outputPtr, &region, &objectMask](const OutputImageRegionType & maskRegion) {
+      TotalProgressReporter progress(this, region.GetNumberOfPixels(), 100, 0.1f);
 
-  // compute the number of rows first, so we can setup a progress reporter
-  std::vector<InputSizeValueType> NumberOfRows;
-  for (unsigned int i = 0; i < InputImageDimension; ++i)
-  {
-    NumberOfRows.push_back(1);
-    for (unsigned int d = 0; d < InputImageDimension; ++d)
-    {
-      if (d != i)
+      for (ImageScanlineConstIterator<InputImageType> it(inputPtr, maskRegion); !it.IsAtEnd(); it.NextLine())
       {
-        NumberOfRows[i] *= size[d];
+        unsigned char * mask = objectMask.get() + outputPtr->ComputeOffset(it.GetIndex());
+        for (; !it.IsAtEndOfLine(); ++it, ++mask)
+        {
+          *mask = Math::NotExactlyEquals(it.Get(), this->m_BackgroundValue);
+        }
+        progress.Completed(maskRegion.GetSize(0));
       }
-    }
-  }
+    },
+    nullptr);
 
-  // set the progress reporter. Use a pointer to be able to destroy it before
-  // the creation of progress2
-  // so it won't set wrong progress at the end of ThreadedGenerateData()
-  float progressPerDimension = 0.67f / static_cast<float>(ImageDimension);
-  if (!this->m_SquaredDistance)
-  {
-    progressPerDimension = 0.67f / (static_cast<float>(ImageDimension) + 1);
-  }
-  auto progress =
-    std::make_unique<ProgressReporter>(this,
-                                       threadId,
-                                       NumberOfRows[m_CurrentDimension],
-                                       30,
-                                       0.33f + static_cast<float>(m_CurrentDimension * progressPerDimension),
-                                       progressPerDimension);
-
-  // This variable provides the amount by which to divide the dimensionless index in order to get the index for each
-  // dimension.
-  vnl_vector<unsigned int> k(InputImageDimension - 1);
-  unsigned int             count = 0;
-  k[count] = 1;
-  for (unsigned int d = m_CurrentDimension + InputImageDimension - 1; d > m_CurrentDimension + 1; d--)
+  // the squared distances are integers when the positions are
+  bool useIntegers = true;
+  if (this->m_UseImageSpacing)
   {
-    k[count + 1] = k[count] * size[d % InputImageDimension];
-    ++count;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      useIntegers = useIntegers && Math::ExactlyEquals(this->m_Spacing[d], 1.0);
+    }
   }
-  k.flip();
-
-  // The index is defined as the dimensionless index into the pixel.
-  // It must be divided by each dimension size in order to get the index for that dimension.
-  // The result of this division is the offsetIndex, which is the index offset relative to the region of this thread.
-  // The true pixel location (idx) is provided by the sum of the offsetIndex and the startIndex.
-  InputSizeValueType       index;
-  OutputIndexType          offsetIndex{};
-  const InputSizeValueType tempRow = NumberOfRows[m_CurrentDimension];
-  OutputIndexType          idx{};
-
-  for (InputSizeValueType n = 0; n < tempRow; ++n)
+
+  using RealType = typename NumericTraits<OutputPixelType>::RealType;
+  const float progressPerDimension = 0.9f / static_cast<float>(ImageDimension);
+  for (unsigned int d = 0; d < ImageDimension; ++d)
   {
-    index = n;
-    count = 0;
-    for (unsigned int d = m_CurrentDimension + 1; d < m_CurrentDimension + InputImageDimension; ++d)
+    if (useIntegers)
     {
-      offsetIndex[d % InputImageDimension] =
-        static_cast<OutputIndexValueType>(static_cast<double>(index) / static_cast<double>(k[count]));
-      idx[d % InputImageDimension] =
-        offsetIndex[d % InputImageDimension] + static_cast<OutputIndexValueType>(startIndex[d % InputImageDimension]);
-
-      index %= k[count];
-      ++count;
+      this->ComputeAlongDimension<std::int64_t>(d, region, objectMask.get(), 1, progressPerDimension);
+    }
+    else
+    {
+      const auto scale = static_cast<RealType>(this->m_UseImageSpacing ? this->m_Spacing[d] : 1.0);
+      this->ComputeAlongDimension<RealType>(d, region, objectMask.get(), scale, progressPerDimension);
     }
-    this->Voronoi(m_CurrentDimension, idx, outputImage);
-    progress->CompletedPixel();
   }
-  progress.reset();
+}
 
-  if (m_CurrentDimension == ImageDimension - 1 && !this->m_SquaredDistance)
+template <typename TInputImage, typename TOutputImage>
+template <typename TDistance>
+void
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::ComputeAlongDimension(
+  unsigned int                  dimension,
+  const OutputImageRegionType & region,
+  const unsigned char *         objectMask,
+  TDistance                     scale,
+  float                         progressWeight)
+{
+  OutputImageType *       outputPtr = this->GetOutput();
+  OutputPixelType * const outputBuffer = outputPtr->GetBufferPointer();
+  OffsetType * const vectorBuffer =
+    this->m_ComputeVectorDistanceMap ? this->GetVectorDistanceMap()->GetBufferPointer() : nullptr;
+
+  const SizeValueType   length = region.GetSize(dimension);
+  const OffsetValueType stride = outputPtr->GetOffsetTable()[dimension];
+  const bool            isFirstDimension = dimension == 0;
+  const bool            isLastDimension = dimension == ImageDimension - 1;
+
+  using OutputRealType = typename NumericTraits<OutputPixelType>::RealType;
+  const OutputPixelType maximum = NumericTraits<OutputPixelType>::max();
+  const OutputPixelType insideSign = this->m_InsideIsPositive ? OutputPixelType{ 1 } : OutputPixelType{ -1 };
+
+  // Along the first dimension, a pixel of the object is on its boundary when
+  // one of its neighbors is in the background. The neighbors are on the
+  // adjacent lines along the first dimension, the offsets of which are
+  // computed once.
+  std::vector<OffsetType>      neighborLines;
+  std::vector<OffsetValueType> neighborLineOffsets;
+  if (isFirstDimension)
   {
-    using OutputIterator = ImageRegionIterator<OutputImageType>;
-    using InputIterator = ImageRegionConstIterator<InputImageType>;
-
-    const typename OutputImageType::RegionType outputRegion = outputRegionForThread;
-
-    OutputIterator Ot(outputPtr, outputRegion);
-    InputIterator  It(m_InputCache, outputRegion);
-
-    Ot.GoToBegin();
-    It.GoToBegin();
-
-    ProgressReporter progress2(this,
-                               threadId,
-                               outputRegionForThread.GetNumberOfPixels(),
-                               30,
-                               0.33f + static_cast<float>(ImageDimension * progressPerDimension),
-                               progressPerDimension);
-
-    using OutputRealType = typename NumericTraits<OutputPixelType>::RealType;
-
-    while (!Ot.IsAtEnd())
+    SizeValueType numberOfNeighborLines = 1;
+    for (unsigned int d = 1; d < ImageDimension; ++d)
     {
-      // cast to a real type is required on some platforms
-      const auto outputValue =
-        static_cast<OutputPixelType>(std::sqrt(static_cast<OutputRealType>(itk::Math::abs(Ot.Get()))));
+      numberOfNeighborLines *= 3;
+    }
+    for (SizeValueType n = 0; n < numberOfNeighborLines; ++n)
+    {
+      OffsetType      neighborLine{};
+      OffsetValueType neighborLineOffset = 0;
+      SizeValueType   remainder = n;
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        neighborLine[d] = static_cast<OffsetValueType>(remainder % 3) - 1;
+        neighborLineOffset += neighborLine[d] * outputPtr->GetOffsetTable()[d];
+        remainder /= 3;
+      }
+      neighborLines.push_back(neighborLine);
+      neighborLineOffsets.push_back(neighborLineOffset);
+    }
+  }
 
-      if (Math::NotExactlyEquals(It.Get(), this->m_BackgroundValue))
+  const auto computeRegion = [&](const OutputImageRegionType & lineRegion) {
+    TotalProgressReporter progress(this, region.GetNumberOfPixels(), 100, progressWeight);
+
+    // Along the other dimensions than the first one, blocks of adjacent lines
+    // are copied to interleaved buffers, so that the image is accessed by
+    // runs of contiguous pixels.
+    const unsigned int numberOfLines = isFirstDimension ? 1 : NumberOfLinesPerBlock;
+    const auto         distances = make_unique_for_overwrite<TDistance[]>(length * numberOfLines);
+    const auto         nearestSites = make_unique_for_overwrite<IndexValueType[]>(length * numberOfLines);
+    const auto         siteDistances = make_unique_for_overwrite<TDistance[]>(length);
+    const auto         sitePositions = make_unique_for_overwrite<TDistance[]>(length);
+    const auto         sites = make_unique_for_overwrite<IndexValueType[]>(length);
+    const auto         nearBackground = make_unique_for_overwrite<unsigned char[]>(isFirstDimension ? length : 0);
+    const auto         vectors = make_unique_for_overwrite<OffsetType[]>(
+      vectorBuffer != nullptr && !isFirstDimension ? length * numberOfLines : 0);
+    bool hasSites[NumberOfLinesPerBlock];
+
+    const SizeValueType   rowLength = lineRegion.GetSize(0);
+    OutputImageRegionType rowStarts = lineRegion;
+    rowStarts.SetSize(dimension, 1);
+    rowStarts.SetSize(0, 1);
+
+    for (const OutputIndexType & rowStart : ImageRegionIndexRange<ImageDimension>(rowStarts))
+    {
+      const OffsetValueType rowOffset = outputPtr->ComputeOffset(rowStart);
+      for (SizeValueType first = 0; first < (isFirstDimension ? 1 : rowLength); first += numberOfLines)
       {
-        if (this->GetInsideIsPositive())
+        const auto lines = static_cast<unsigned int>(std::min<SizeValueType>(numberOfLines, rowLength - first));
+        const OffsetValueType blockOffset = rowOffset + static_cast<OffsetValueType>(first);
+
+        // the squared distances to the nearest boundary pixel in the
+        // hyperplanes crossing the lines, negative when there is none
+        if (isFirstDimension)
         {
-          Ot.Set(outputValue);
+          // the background pixels of the neighbor lines are first merged,
+          // without branches
+          std::fill_n(nearBackground.get(), length, 0);
+          for (size_t n = 0; n < neighborLines.size(); ++n)
+          {
+            if (!region.IsInside(rowStart + neighborLines[n]))
+            {
+              continue;
+            }
+            const unsigned char * neighborMask = objectMask + blockOffset + neighborLineOffsets[n];
+            for (SizeValueType i = 0; i < length; ++i)
+            {
+              nearBackground[i] |= neighborMask[i] ^ 1;
+            }
+          }
+          const unsigned char * mask = objectMask + blockOffset;
+          for (SizeValueType i = 0; i < length; ++i)
+          {
+            const bool isBoundary = mask[i] && (nearBackground[i] || (i > 0 && nearBackground[i - 1]) ||
+                                                (i + 1 < length && nearBackground[i + 1]));
+            distances[i] = isBoundary ? TDistance{ 0 } : TDistance{ -1 };
+          }
         }
         else
         {
-          Ot.Set(-outputValue);
+          for (SizeValueType i = 0; i < length; ++i)
+          {
+            const OffsetValueType pixelOffset = blockOffset + static_cast<OffsetValueType>(i) * stride;
+            for (unsigned int k = 0; k < lines; ++k)
+            {
+              const OutputPixelType value = outputBuffer[pixelOffset + k];
+              distances[i * lines + k] =
+                Math::ExactlyEquals(value, maximum) ? TDistance{ -1 } : static_cast<TDistance>(value);
+            }
+            if (vectorBuffer != nullptr)
+            {
+              std::copy_n(vectorBuffer + pixelOffset, lines, vectors.get() + i * lines);
+            }
+          }
         }
-      }
-      else
-      {
-        if (this->GetInsideIsPositive())
+
+        for (unsigned int k = 0; k < lines; ++k)
         {
-          Ot.Set(-outputValue);
+          hasSites[k] = Voronoi(length,
+                                scale,
+                                distances.get() + k,
+                                lines,
+                                nearestSites.get() + k,
+                                siteDistances.get(),
+                                sitePositions.get(),
+                                sites.get());
         }
-        else
+
+        for (SizeValueType i = 0; i < length; ++i)
         {
-          Ot.Set(outputValue);
+          const OffsetValueType pixelOffset = blockOffset + static_cast<OffsetValueType>(i) * stride;
+          for (unsigned int k = 0; k < lines; ++k)
+          {
+            const SizeValueType   tileIndex = i * lines + k;
+            const OffsetValueType offset = pixelOffset + k;
+            OutputPixelType value = hasSites[k] ? static_cast<OutputPixelType>(distances[tileIndex]) : maximum;
+            if (isLastDimension && (hasSites[k] || !this->m_SquaredDistance))
+            {
+              if (!this->m_SquaredDistance)
+              {
+                // cast to a real type is required on some platforms
+                value = static_cast<OutputPixelType>(std::sqrt(static_cast<OutputRealType>(value)));
+              }
+              value = objectMask[offset] ? insideSign * value : -insideSign * value;
+            }
+            outputBuffer[offset] = value;
+
+            // the vector to the nearest boundary pixel is the one of the
+            // nearest site, plus the vector to the site
+            if (vectorBuffer != nullptr && hasSites[k])
+            {
+              const IndexValueType site = nearestSites[tileIndex];
+              OffsetType           vector{};
+              if (!isFirstDimension)
+              {
+                vector = vectors[static_cast<SizeValueType>(site) * lines + k];
+              }
+              vector[dimension] += site - static_cast<IndexValueType>(i);
+              vectorBuffer[offset] = vector;
+            }
+            else if (vectorBuffer != nullptr && isFirstDimension)
+            {
+              vectorBuffer[offset] = OffsetType{};
+            }
+          }
         }
+        progress.Completed(length * lines);
       }
-
-      ++Ot;
-      ++It;
-      progress2.CompletedPixel();
     }
-  }
+  };
+
+  this->GetMultiThreader()->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+    dimension, region, computeRegion, nullptr);
 }
 
 template <typename TInputImage, typename TOutputImage>
-void
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned int      d,
-                                                                       OutputIndexType   idx,
-                                                                       OutputImageType * output)
+template <typename TDistance>
+bool
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(SizeValueType    length,
+                                                                       TDistance        scale,
+                                                                       TDistance *      distances,
+                                                                       SizeValueType    stride,
+                                                                       IndexValueType * nearestSites,
+                                                                       TDistance *      siteDistances,
+                                                                       TDistance *      sitePositions,
+                                                                       IndexValueType * sites)
 {
-  const OutputRegionType    oRegion = output->GetRequestedRegion();
-  const OutputSizeValueType nd = oRegion.GetSize()[d];
-
-  vnl_vector<OutputPixelType> g(nd, 0);
-  vnl_vector<OutputPixelType> h(nd, 0);
-
-
-  const InputRegionType iRegion = m_InputCache->GetRequestedRegion();
-  InputIndexType        startIndex = iRegion.GetIndex();
-
-  OutputPixelType di;
-
-  int l = -1;
-
-  for (unsigned int i = 0; i < nd; ++i)
+  // the sites whose parabolas are part of the lower envelope
+  SizeValueType numberOfSites = 0;
+  for (SizeValueType i = 0; i < length; ++i)
   {
-    idx[d] = i + startIndex[d];
-
-    di = output->GetPixel(idx);
-
-    OutputPixelType iw;
-
-    if (this->GetUseImageSpacing())
+    const TDistance di = distances[i * stride];
+    if (di < TDistance{ 0 })
     {
-      iw = static_cast<OutputPixelType>(i) * static_cast<OutputPixelType>(this->m_Spacing[d]);
+      continue;
     }
-    else
+    const TDistance iw = static_cast<TDistance>(i) * scale;
+    while (numberOfSites >= 2 && Remove(siteDistances[numberOfSites - 2],
+                                        siteDistances[numberOfSites - 1],
+                                        di,
+                                        sitePositions[numberOfSites - 2],
+                                        sitePositions[numberOfSites - 1],
+                                        iw))
     {
-      iw = static_cast<OutputPixelType>(i);
-    }
-
-    if (Math::NotExactlyEquals(di, NumericTraits<OutputPixelType>::max()))
-    {
-      if (l < 1)
-      {
-        ++l;
-        g(l) = di;
-        h(l) = iw;
-      }
-      else
-      {
-        while ((l >= 1) && this->Remove(g(l - 1), g(l), di, h(l - 1), h(l), iw))
-        {
-          --l;
-        }
-        ++l;
-        g(l) = di;
-        h(l) = iw;
-      }
+      --numberOfSites;
     }
+    siteDistances[numberOfSites] = di;
+    sitePositions[numberOfSites] = iw;
+    sites[numberOfSites] = static_cast<IndexValueType>(i);
+    ++numberOfSites;
   }
 
-  if (l == -1)
+  if (numberOfSites == 0)
   {
-    return;
+    return false;
   }
 
-  const int ns = l;
-
-  l = 0;
-
-  for (unsigned int i = 0; i < nd; ++i)
+  SizeValueType l = 0;
+  for (SizeValueType i = 0; i < length; ++i)
   {
-    OutputPixelType iw;
-
-    if (this->GetUseImageSpacing())
-    {
-      iw = static_cast<OutputPixelType>(i * this->m_Spacing[d]);
-    }
-    else
-    {
-      iw = static_cast<OutputPixelType>(i);
-    }
-
-    OutputPixelType d1 = itk::Math::abs(g(l)) + (h(l) - iw) * (h(l) - iw);
+    const TDistance iw = static_cast<TDistance>(i) * scale;
 
-    while (l < ns)
+    TDistance d1 = siteDistances[l] + (sitePositions[l] - iw) * (sitePositions[l] - iw);
+    while (l + 1 < numberOfSites)
     {
-      // be sure to compute d2 *only* if l < ns
-      const OutputPixelType d2 = itk::Math::abs(g(l + 1)) + (h(l + 1) - iw) * (h(l + 1) - iw);
+      // be sure to compute d2 *only* if l + 1 < numberOfSites
+      const TDistance d2 = siteDistances[l + 1] + (sitePositions[l + 1] - iw) * (sitePositions[l + 1] - iw);
       // then compare d1 and d2
       if (d1 <= d2)
       {
@@ -399,47 +382,27 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned
       ++l;
       d1 = d2;
     }
-    idx[d] = i + startIndex[d];
-
-    if (Math::NotExactlyEquals(m_InputCache->GetPixel(idx), this->m_BackgroundValue))
-    {
-      if (this->m_InsideIsPositive)
-      {
-        output->SetPixel(idx, d1);
-      }
-      else
-      {
-        output->SetPixel(idx, -d1);
-      }
-    }
-    else
-    {
-      if (this->m_InsideIsPositive)
-      {
-        output->SetPixel(idx, -d1);
-      }
-      else
-      {
-        output->SetPixel(idx, d1);
-      }
-    }
+    distances[i * stride] = d1;
+    nearestSites[i * stride] = sites[l];
   }
+  return true;
 }
 
 template <typename TInputImage, typename TOutputImage>
+template <typename TDistance>
 bool
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Remove(OutputPixelType d1,
-                                                                      OutputPixelType d2,
-                                                                      OutputPixelType df,
-                                                                      OutputPixelType x1,
-                                                                      OutputPixelType x2,
-                                                                      OutputPixelType xf)
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Remove(TDistance d1,
+                                                                      TDistance d2,
+                                                                      TDistance df,
+                                                                      TDistance x1,
+                                                                      TDistance x2,
+                                                                      TDistance xf)
 {
-  const OutputPixelType a = x2 - x1;
-  const OutputPixelType b = xf - x2;
-  const OutputPixelType c = xf - x1;
+  const TDistance a = x2 - x1;
+  const TDistance b = xf - x2;
+  const TDistance c = xf - x1;
 
-  const OutputPixelType value = (c * itk::Math::abs(d2) - b * itk::Math::abs(d1) - a * itk::Math::abs(df) - a * b * c);
+  const TDistance value = (c * d2 - b * d1 - a * df - a * b * c);
 
   return (value > 0);
 }
@@ -457,6 +420,7 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::PrintSelf(std::os
   os << indent << "Inside is positive: " << this->m_InsideIsPositive << std::endl;
   os << indent << "Use image spacing: " << this->m_UseImageSpacing << std::endl;
   os << indent << "Squared distance: " << this->m_SquaredDistance << std::endl;
+  os << indent << "Compute vector distance map: " << this->m_ComputeVectorDistanceMap << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,227 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkIndexRange.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+// An object made of a box and of isolated pixels.
+template <typename TImage>
+typename TImage::Pointer
+CreateObject(const typename TImage::RegionType & region, const typename TImage::SpacingType & spacing)
+{
+  auto image = TImage::New();
+  image->SetRegions(region);
+  image->SetSpacing(spacing);
+  image->Allocate();
+  typename TImage::RegionType box = region;
+  box.ShrinkByRadius(3);
+  box.SetSize(0, box.GetSize(0) / 2);
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const bool isObject = box.IsInside(it.GetIndex()) || generator->GetUniformVariate(0.0, 1.0) < 0.01;
+    it.Set(isObject ? 7 : 2);
+  }
+  return image;
+}
+
+// Compares the output of the filter, computed for a region of the input,
+// with the distances to the pixels of the object which have a neighbor in
+// the background, in the region.
+template <typename TFilter>
+bool
+CompareWithBruteForce(TFilter * filter, const typename TFilter::OutputImageRegionType & region)
+{
+  using InputImageType = typename TFilter::InputImageType;
+  using OutputImageType = typename TFilter::OutputImageType;
+  using IndexType = typename OutputImageType::IndexType;
+  using RegionType = typename OutputImageType::RegionType;
+  using OffsetType = typename OutputImageType::OffsetType;
+  constexpr unsigned int Dimension = OutputImageType::ImageDimension;
+
+  std::cout << "Region: " << region.GetIndex() << ' ' << region.GetSize()
+            << ", squared distance: " << filter->GetSquaredDistance()
+            << ", use image spacing: " << filter->GetUseImageSpacing()
+            << ", inside is positive: " << filter->GetInsideIsPositive() << std::endl;
+
+  // the filter runs again even when the region is inside the previous one
+  filter->GetOutput()->SetRequestedRegion(region);
+  filter->Modified();
+  filter->Update();
+  if (filter->GetOutput()->GetBufferedRegion() != region)
+  {
+    std::cerr << "The buffered region " << filter->GetOutput()->GetBufferedRegion() << " is not the requested one"
+              << std::endl;
+    return false;
+  }
+
+  const InputImageType * input = filter->GetInput();
+  const auto             isObject = [input, filter](const IndexType & index) {
+    return input->GetPixel(index) != filter->GetBackgroundValue();
+  };
+
+  std::vector<IndexType> boundary;
+  for (const IndexType & index : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    if (!isObject(index))
+    {
+      continue;
+    }
+    RegionType neighborhood({ index }, itk::MakeFilled<typename RegionType::SizeType>(1));
+    neighborhood.PadByRadius(1);
+    neighborhood.Crop(region);
+    for (const IndexType & neighbor : itk::ImageRegionIndexRange<Dimension>(neighborhood))
+    {
+      if (!isObject(neighbor))
+      {
+        boundary.push_back(index);
+        break;
+      }
+    }
+  }
+
+  const auto spacing = filter->GetUseImageSpacing() ? input->GetSpacing()
+                                                    : itk::MakeFilled<typename InputImageType::SpacingType>(1.0);
+  const auto squaredDistance = [&spacing](const IndexType & index1, const IndexType & index2) {
+    double distance = 0.0;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const double difference = static_cast<double>(index1[d] - index2[d]) * spacing[d];
+      distance += difference * difference;
+    }
+    return distance;
+  };
+
+  const OutputImageType * output = filter->GetOutput();
+  const auto *            vectorMap = filter->GetVectorDistanceMap();
+  for (const IndexType & index : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    double expected = itk::NumericTraits<double>::max();
+    for (const IndexType & boundaryIndex : boundary)
+    {
+      expected = std::min(expected, squaredDistance(index, boundaryIndex));
+    }
+    if (!filter->GetSquaredDistance())
+    {
+      expected = std::sqrt(expected);
+    }
+    if (isObject(index) != filter->GetInsideIsPositive())
+    {
+      expected = -expected;
+    }
+    const double value = output->GetPixel(index);
+    if (std::abs(value - expected) > 1e-5 * (1.0 + std::abs(expected)))
+    {
+      std::cerr << "Different distances at " << index << ": " << value << " != " << expected << std::endl;
+      return false;
+    }
+
+    if (filter->GetComputeVectorDistanceMap())
+    {
+      const OffsetType vector = vectorMap->GetPixel(index);
+      const IndexType  nearest = index + vector;
+      const double     distance = squaredDistance(index, nearest);
+      if (!region.IsInside(nearest) || std::find(boundary.begin(), boundary.end(), nearest) == boundary.end() ||
+          std::abs((filter->GetSquaredDistance() ? distance : std::sqrt(distance)) - std::abs(expected)) >
+            1e-5 * (1.0 + std::abs(expected)))
+      {
+        std::cerr << "The vector " << vector << " at " << index << " does not lead to a nearest boundary pixel"
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <unsigned int VDimension>
+bool
+TestDimension(const itk::ImageRegion<VDimension> & region, const itk::Vector<double, VDimension> & spacing)
+{
+  using InputImageType = itk::Image<short, VDimension>;
+  using OutputImageType = itk::Image<float, VDimension>;
+  using FilterType = itk::SignedMaurerDistanceMapImageFilter<InputImageType, OutputImageType>;
+
+  const auto input = CreateObject<InputImageType>(region, spacing);
+  auto       filter = FilterType::New();
+  filter->SetInput(input);
+  filter->SetBackgroundValue(2);
+  filter->ComputeVectorDistanceMapOn();
+
+  // a requested region which does not start at the start of the input, and
+  // whose size is not a multiple of the number of lines processed together
+  typename OutputImageType::RegionType requestedRegion = region;
+  requestedRegion.ShrinkByRadius(1);
+  requestedRegion.SetSize(0, requestedRegion.GetSize(0) - 3);
+
+  bool success = true;
+  for (const bool squaredDistance : { false, true })
+  {
+    for (const bool useImageSpacing : { false, true })
+    {
+      for (const bool insideIsPositive : { false, true })
+      {
+        filter->SetSquaredDistance(squaredDistance);
+        filter->SetUseImageSpacing(useImageSpacing);
+        filter->SetInsideIsPositive(insideIsPositive);
+        success = CompareWithBruteForce(filter.GetPointer(), region) && success;
+        success = CompareWithBruteForce(filter.GetPointer(), requestedRegion) && success;
+      }
+    }
+  }
+
+  // the vector distance map is not computed by default
+  filter->ComputeVectorDistanceMapOff();
+  filter->Update();
+  if (filter->GetVectorDistanceMap()->GetBufferPointer() != nullptr)
+  {
+    std::cerr << "The vector distance map is allocated" << std::endl;
+    success = false;
+  }
+
+  return success;
+}
+} // namespace
+
+int
+itkSignedMaurerDistanceMapImageFilterBruteForceTest(int, char *[])
+{
+  using RegionType2D = itk::ImageRegion<2>;
+  using RegionType3D = itk::ImageRegion<3>;
+
+  bool success = true;
+  success = TestDimension<2>(RegionType2D({ { -5, 3 } }, { { 41, 29 } }), itk::MakeVector(1.0, 1.0)) && success;
+  success = TestDimension<2>(RegionType2D({ { -5, 3 } }, { { 41, 29 } }), itk::MakeVector(0.5, 1.25)) && success;
+  success =
+    TestDimension<3>(RegionType3D({ { 2, -1, 0 } }, { { 23, 19, 13 } }), itk::MakeVector(1.0, 1.0, 1.0)) && success;
+  success =
+    TestDimension<3>(RegionType3D({ { 2, -1, 0 } }, { { 23, 19, 13 } }), itk::MakeVector(0.75, 1.5, 2.0)) && success;
+
+  std::cout << "Test finished." << std::endl;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -33,12 +33,72 @@
 
 #endif
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
 namespace fftw
 {
+#if (defined(ITK_USE_FFTWF) || defined(ITK_USE_FFTWD)) && !defined(ITK_USE_CUFFTW)
+/** The kinds of the transforms of the plan cache. */
+enum class PlanKind : int
+{
+  RealToComplex,
+  ComplexToReal,
+  ComplexToComplex
+};
+
+/** Get the plan of the cache of FFTWGlobalConfiguration for a transform, or
+ * create it with createPlan(workspaceIn, workspaceOut). The arrays given to
+ * createPlan are in a workspace, with the same FFTW alignments as the arrays
+ * of the transform, so the planning does not overwrite the arrays of the
+ * transform and the plan can run on them with the new-array execute functions
+ * of FFTW. */
+template <typename TPixel, typename TInput, typename TOutput, typename TCreatePlan>
+std::shared_ptr<void>
+GetCachedPlan(PlanKind            kind,
+              int                 sign,
+              int                 rank,
+              const int *         n,
+              unsigned int        flags,
+              int                 threads,
+              int                 inAlignment,
+              int                 outAlignment,
+              const TCreatePlan & createPlan,
+              void (*destroyPlan)(void *))
+{
+  std::vector<int> description{ static_cast<int>(sizeof(TPixel)), static_cast<int>(kind), sign, rank };
+  description.insert(description.end(), n, n + rank);
+  description.insert(description.end(), { static_cast<int>(flags), threads, inAlignment, outAlignment });
+
+  // the sizes of the arrays, with the half dimension of the real to complex
+  // and complex to real transforms
+  size_t fullSize = 1;
+  for (int i = 0; i < rank; ++i)
+  {
+    fullSize *= static_cast<size_t>(n[i]);
+  }
+  const size_t halfSize = fullSize / n[rank - 1] * (n[rank - 1] / 2 + 1);
+  const size_t inSize = kind == PlanKind::ComplexToReal ? halfSize : fullSize;
+  const size_t outSize = kind == PlanKind::RealToComplex ? halfSize : fullSize;
+
+  return FFTWGlobalConfiguration::GetCachedPlan(
+    description,
+    [&]() -> void * {
+      constexpr size_t alignment = FFTWGlobalConfiguration::WorkspaceAlignment;
+      const size_t     outOffset = (inAlignment + inSize * sizeof(TInput) + alignment - 1) / alignment * alignment;
+      const size_t     numberOfBytes = outOffset + outAlignment + outSize * sizeof(TOutput);
+      const auto       workspace = FFTWGlobalConfiguration::GetWorkspace(numberOfBytes);
+      auto *           bytes = static_cast<char *>(workspace.get());
+      return createPlan(reinterpret_cast<TInput *>(bytes + inAlignment),
+                        reinterpret_cast<TOutput *>(bytes + outOffset + outAlignment));
+    },
+    destroyPlan);
+}
+#endif
+
 /**
  * \class Interface
  * \brief Wrapper for FFTW API
@@ -373,6 +433,125 @@ public:
   }
 
 
+  /** Compute the transform of in into out with a plan of the cache of
+   * FFTWGlobalConfiguration. Unlike with Plan_dft_r2c(), in and out are not
+   * overwritten by the planning, so the plan rigor does not require a copy of
+   * the input. */
+  static void
+  Execute_dft_r2c(int           rank,
+                  const int *   n,
+                  PixelType *   in,
+                  ComplexType * out,
+                  unsigned int  flags,
+                  int           threads = 1,
+                  bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    if (static_cast<void *>(in) != static_cast<void *>(out))
+    {
+      const std::shared_ptr<void> plan = GetCachedPlan<PixelType, PixelType, ComplexType>(
+        PlanKind::RealToComplex,
+        0,
+        rank,
+        n,
+        flags,
+        threads,
+        fftwf_alignment_of(in),
+        fftwf_alignment_of(reinterpret_cast<PixelType *>(out)),
+        [=](PixelType * workspaceIn, ComplexType * workspaceOut) {
+          return CreatePlan(threads, flags, [=](unsigned int planFlags) {
+            return fftwf_plan_dft_r2c(rank, n, workspaceIn, workspaceOut, planFlags);
+          });
+        },
+        &Self::DestroyCachedPlan);
+      fftwf_execute_dft_r2c(static_cast<PlanType>(plan.get()), in, out);
+      return;
+    }
+#  endif
+    const PlanType plan = Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+    Execute(plan);
+    DestroyPlan(plan);
+  }
+
+  /** Compute the transform of in into out with a plan of the cache of
+   * FFTWGlobalConfiguration. As with any multi-dimensional complex to real
+   * transform of FFTW, the input is destroyed. */
+  static void
+  Execute_dft_c2r(int           rank,
+                  const int *   n,
+                  ComplexType * in,
+                  PixelType *   out,
+                  unsigned int  flags,
+                  int           threads = 1,
+                  bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    if (static_cast<void *>(in) != static_cast<void *>(out))
+    {
+      const std::shared_ptr<void> plan = GetCachedPlan<PixelType, ComplexType, PixelType>(
+        PlanKind::ComplexToReal,
+        0,
+        rank,
+        n,
+        flags,
+        threads,
+        fftwf_alignment_of(reinterpret_cast<PixelType *>(in)),
+        fftwf_alignment_of(out),
+        [=](ComplexType * workspaceIn, PixelType * workspaceOut) {
+          return CreatePlan(threads, flags, [=](unsigned int planFlags) {
+            return fftwf_plan_dft_c2r(rank, n, workspaceIn, workspaceOut, planFlags);
+          });
+        },
+        &Self::DestroyCachedPlan);
+      fftwf_execute_dft_c2r(static_cast<PlanType>(plan.get()), in, out);
+      return;
+    }
+#  endif
+    const PlanType plan = Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+    Execute(plan);
+    DestroyPlan(plan);
+  }
+
+  /** Compute the transform of in into out with a plan of the cache of
+   * FFTWGlobalConfiguration. Unlike with Plan_dft(), in and out are not
+   * overwritten by the planning. */
+  static void
+  Execute_dft(int           rank,
+              const int *   n,
+              ComplexType * in,
+              ComplexType * out,
+              int           sign,
+              unsigned int  flags,
+              int           threads = 1,
+              bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    if (in != out)
+    {
+      const std::shared_ptr<void> plan = GetCachedPlan<PixelType, ComplexType, ComplexType>(
+        PlanKind::ComplexToComplex,
+        sign,
+        rank,
+        n,
+        flags,
+        threads,
+        fftwf_alignment_of(reinterpret_cast<PixelType *>(in)),
+        fftwf_alignment_of(reinterpret_cast<PixelType *>(out)),
+        [=](ComplexType * workspaceIn, ComplexType * workspaceOut) {
+          return CreatePlan(threads, flags, [=](unsigned int planFlags) {
+            return fftwf_plan_dft(rank, n, workspaceIn, workspaceOut, sign, planFlags);
+          });
+        },
+        &Self::DestroyCachedPlan);
+      fftwf_execute_dft(static_cast<PlanType>(plan.get()), in, out);
+      return;
+    }
+#  endif
+    const PlanType plan = Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+    Execute(plan);
+    DestroyPlan(plan);
+  }
+
   static void
   Execute(PlanType p)
   {
@@ -386,6 +565,34 @@ public:
 #  endif
     fftwf_destroy_plan(p);
   }
+
+#  ifndef ITK_USE_CUFFTW
+private:
+  /** Create a plan for the cache, with the wisdom if there is some. Called
+   * with the lock mutex held. */
+  template <typename TPlanFunction>
+  static void *
+  CreatePlan(int threads, unsigned int flags, const TPlanFunction & planFunction)
+  {
+    fftwf_plan_with_nthreads(threads);
+    // don't add FFTW_WISDOM_ONLY if the plan rigor is FFTW_ESTIMATE
+    PlanType plan = planFunction((flags & FFTW_ESTIMATE) ? flags : (flags | FFTW_WISDOM_ONLY));
+    if (plan == nullptr)
+    {
+      // no wisdom available for that plan
+      plan = planFunction(flags);
+      FFTWGlobalConfiguration::SetNewWisdomAvailable(true);
+    }
+    itkAssertOrThrowMacro(plan != nullptr, "PLAN_CREATION_FAILED ");
+    return static_cast<void *>(plan);
+  }
+
+  static void
+  DestroyCachedPlan(void * p)
+  {
+    fftwf_destroy_plan(static_cast<PlanType>(p));
+  }
+#  endif
 };
 
 #endif // ITK_USE_FFTWF
@@ -702,6 +909,125 @@ public:
   }
 
 
+  /** Compute the transform of in into out with a plan of the cache of
+   * FFTWGlobalConfiguration. Unlike with Plan_dft_r2c(), in and out are not
+   * overwritten by the planning, so the plan rigor does not require a copy of
+   * the input. */
+  static void
+  Execute_dft_r2c(int           rank,
+                  const int *   n,
+                  PixelType *   in,
+                  ComplexType * out,
+                  unsigned int  flags,
+                  int           threads = 1,
+                  bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    if (static_cast<void *>(in) != static_cast<void *>(out))
+    {
+      const std::shared_ptr<void> plan = GetCachedPlan<PixelType, PixelType, ComplexType>(
+        PlanKind::RealToComplex,
+        0,
+        rank,
+        n,
+        flags,
+        threads,
+        fftw_alignment_of(in),
+        fftw_alignment_of(reinterpret_cast<PixelType *>(out)),
+        [=](PixelType * workspaceIn, ComplexType * workspaceOut) {
+          return CreatePlan(threads, flags, [=](unsigned int planFlags) {
+            return fftw_plan_dft_r2c(rank, n, workspaceIn, workspaceOut, planFlags);
+          });
+        },
+        &Self::DestroyCachedPlan);
+      fftw_execute_dft_r2c(static_cast<PlanType>(plan.get()), in, out);
+      return;
+    }
+#  endif
+    const PlanType plan = Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+    Execute(plan);
+    DestroyPlan(plan);
+  }
+
+  /** Compute the transform of in into out with a plan of the cache of
+   * FFTWGlobalConfiguration. As with any multi-dimensional complex to real
+   * transform of FFTW, the input is destroyed. */
+  static void
+  Execute_dft_c2r(int           rank,
+                  const int *   n,
+                  ComplexType * in,
+                  PixelType *   out,
+                  unsigned int  flags,
+                  int           threads = 1,
+                  bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    if (static_cast<void *>(in) != static_cast<void *>(out))
+    {
+      const std::shared_ptr<void> plan = GetCachedPlan<PixelType, ComplexType, PixelType>(
+        PlanKind::ComplexToReal,
+        0,
+        rank,
+        n,
+        flags,
+        threads,
+        fftw_alignment_of(reinterpret_cast<PixelType *>(in)),
+        fftw_alignment_of(out),
+        [=](ComplexType * workspaceIn, PixelType * workspaceOut) {
+          return CreatePlan(threads, flags, [=](unsigned int planFlags) {
+            return fftw_plan_dft_c2r(rank, n, workspaceIn, workspaceOut, planFlags);
+          });
+        },
+        &Self::DestroyCachedPlan);
+      fftw_execute_dft_c2r(static_cast<PlanType>(plan.get()), in, out);
+      return;
+    }
+#  endif
+    const PlanType plan = Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+    Execute(plan);
+    DestroyPlan(plan);
+  }
+
+  /** Compute the transform of in into out with a plan of the cache of
+   * FFTWGlobalConfiguration. Unlike with Plan_dft(), in and out are not
+   * overwritten by the planning. */
+  static void
+  Execute_dft(int           rank,
+              const int *   n,
+              ComplexType * in,
+              ComplexType * out,
+              int           sign,
+              unsigned int  flags,
+              int           threads = 1,
+              bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    if (in != out)
+    {
+      const std::shared_ptr<void> plan = GetCachedPlan<PixelType, ComplexType, ComplexType>(
+        PlanKind::ComplexToComplex,
+        sign,
+        rank,
+        n,
+        flags,
+        threads,
+        fftw_alignment_of(reinterpret_cast<PixelType *>(in)),
+        fftw_alignment_of(reinterpret_cast<PixelType *>(out)),
+        [=](ComplexType * workspaceIn, ComplexType * workspaceOut) {
+          return CreatePlan(threads, flags, [=](unsigned int planFlags) {
+            return fftw_plan_dft(rank, n, workspaceIn, workspaceOut, sign, planFlags);
+          });
+        },
+        &Self::DestroyCachedPlan);
+      fftw_execute_dft(static_cast<PlanType>(plan.get()), in, out);
+      return;
+    }
+#  endif
+    const PlanType plan = Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+    Execute(plan);
+    DestroyPlan(plan);
+  }
+
   static void
   Execute(PlanType p)
   {
@@ -715,6 +1041,34 @@ public:
 #  endif
     fftw_destroy_plan(p);
   }
+
+#  ifndef ITK_USE_CUFFTW
+private:
+  /** Create a plan for the cache, with the wisdom if there is some. Called
+   * with the lock mutex held. */
+  template <typename TPlanFunction>
+  static void *
+  CreatePlan(int threads, unsigned int flags, const TPlanFunction & planFunction)
+  {
+    fftw_plan_with_nthreads(threads);
+    // don't add FFTW_WISDOM_ONLY if the plan rigor is FFTW_ESTIMATE
+    PlanType plan = planFunction((flags & FFTW_ESTIMATE) ? flags : (flags | FFTW_WISDOM_ONLY));
+    if (plan == nullptr)
+    {
+      // no wisdom available for that plan
+      plan = planFunction(flags);
+      FFTWGlobalConfiguration::SetNewWisdomAvailable(true);
+    }
+    itkAssertOrThrowMacro(plan != nullptr, "PLAN_CREATION_FAILED ");
+    return static_cast<void *>(plan);
+  }
+
+  static void
+  DestroyCachedPlan(void * p)
+  {
+    fftw_destroy_plan(static_cast<PlanType>(p));
+  }
+#  endif
 };
 
 #endif
@@ -35,6 +35,10 @@
 #  endif
 #  include <algorithm>
 #  include <cctype>
+#  include <functional>
+#  include <list>
+#  include <memory>
+#  include <vector>
 
 struct FFTWGlobalConfigurationGlobals;
 
@@ -348,6 +352,43 @@ public:
   static bool
   ExportDefaultWisdomFile();
 
+  /** The alignment, in bytes, of the workspaces. */
+  static constexpr size_t WorkspaceAlignment = 64;
+
+  /**
+   * \brief Set/Get the maximum number of plans kept by the cache of plans.
+   *
+   * The plans of the N-dimensional transforms are kept in a cache shared by
+   * the whole process, so that the filters which run the same transforms
+   * again, as the iterative deconvolution filters do, do not plan them
+   * again. The least recently used plans are destroyed first, and 0
+   * disables the cache. Defaults to 16.
+   */
+  static void
+  SetMaximumNumberOfCachedPlans(const SizeValueType v);
+  static SizeValueType
+  GetMaximumNumberOfCachedPlans();
+
+  /** Destroy the plans of the cache, and free the workspaces which are not in use. */
+  static void
+  ClearPlanCache();
+
+  /** Get the plan of the cache for a transform, or create it with createPlan
+   * and add it to the cache. The description identifies the transform: its
+   * kind, sizes, flags, number of threads and the alignment of its arrays.
+   * createPlan is called with the lock mutex held. The plan is destroyed
+   * with destroyPlan once it has left the cache and is no longer used. */
+  static std::shared_ptr<void>
+  GetCachedPlan(const std::vector<int> &        description,
+                const std::function<void *()> & createPlan,
+                void (*destroyPlan)(void *));
+
+  /** Get a workspace of at least the given number of bytes, aligned on
+   * WorkspaceAlignment. The workspace is kept for the next transforms when
+   * it is released, so its memory is reused from one transform to the next. */
+  static std::shared_ptr<void>
+  GetWorkspace(const size_t numberOfBytes);
+
 private:
   FFTWGlobalConfiguration();           // This will process env variables
   ~FFTWGlobalConfiguration() override; // This will write cache file if requested.
@@ -367,6 +408,10 @@ private:
 
   static FFTWGlobalConfigurationGlobals * m_PimplGlobals;
 
+  /** Free the workspaces which are not in use. */
+  void
+  FreeWorkspaces();
+
   std::mutex  m_Mutex;
   bool        m_NewWisdomAvailable{ false };
   int         m_PlanRigor{ 0 };
@@ -376,6 +421,14 @@ private:
   // m_WriteWisdomCache Controls the behavior of default
   // wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
+
+  // The cached plans, from the most recently used one, with their descriptions
+  SizeValueType                                                 m_MaximumNumberOfCachedPlans{ 16 };
+  std::list<std::pair<std::vector<int>, std::shared_ptr<void>>> m_CachedPlans{};
+
+  // The workspaces which are not in use, with their sizes
+  std::mutex                             m_WorkspaceMutex{};
+  std::vector<std::pair<size_t, void *>> m_FreeWorkspaces{};
 };
 } // namespace itk
 #endif
@@ -75,50 +75,42 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
   // FFTW_PRESERVE_INPUT flag at this time. So if the input can't be
   // destroyed, we have to copy the input data to a buffer before
   // running the IFFT.
-  typename FFTWProxyType::ComplexType * const in = [&]() -> typename FFTWProxyType::ComplexType * {
-    if (m_CanUseDestructiveAlgorithm)
-    {
-      // Ok, so lets use the input buffer directly, to save some memory.
-      return const_cast<typename FFTWProxyType::ComplexType *>(
-        reinterpret_cast<const typename FFTWProxyType::ComplexType *>(inputPtr->GetBufferPointer()));
-    }
-    else
-    {
-      // We must use a buffer where fftw can work and destroy what it wants.
-      return new typename FFTWProxyType::ComplexType[totalInputSize];
-    }
-  }();
-  OutputPixelType *                out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
-
-  int sizes[ImageDimension];
-  for (unsigned int i = 0; i < ImageDimension; ++i)
-  {
-    sizes[(ImageDimension - 1) - i] = outputSize[i];
-  }
-  plan = FFTWProxyType::Plan_dft_c2r(ImageDimension,
-                                     sizes,
-                                     in,
-                                     out,
-                                     m_PlanRigor,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
-                                     !m_CanUseDestructiveAlgorithm);
+  // Ok, so lets use the input buffer directly, to save some memory.
+  auto * in = const_cast<typename FFTWProxyType::ComplexType *>(
+    reinterpret_cast<const typename FFTWProxyType::ComplexType *>(inputPtr->GetBufferPointer()));
+  std::shared_ptr<void> inputCopy;
   if (!m_CanUseDestructiveAlgorithm)
   {
+    // We must use a buffer where fftw can work and destroy what it wants.
+#ifndef ITK_USE_CUFFTW
+    // A workspace of FFTWGlobalConfiguration is reused from one transform to the next.
+    inputCopy = FFTWGlobalConfiguration::GetWorkspace(totalInputSize * sizeof(typename FFTWProxyType::ComplexType));
+#else
+    inputCopy.reset(new typename FFTWProxyType::ComplexType[totalInputSize],
+                    std::default_delete<typename FFTWProxyType::ComplexType[]>());
+#endif
     // complex<double> and double[2] types are compatible memory layouts.
     // The reinterpret_cast is used here to
     // make the "C" fftw library compatible with the c++ complex<double>.
-    std::copy_n(
-      inputPtr->GetBufferPointer(), totalInputSize, reinterpret_cast<typename InputImageType::PixelType *>(in));
+    std::copy_n(inputPtr->GetBufferPointer(),
+                totalInputSize,
+                reinterpret_cast<typename InputImageType::PixelType *>(inputCopy.get()));
+    in = static_cast<typename FFTWProxyType::ComplexType *>(inputCopy.get());
   }
-  FFTWProxyType::Execute(plan);
+  OutputPixelType * out = outputPtr->GetBufferPointer();
 
-  // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
-  if (!m_CanUseDestructiveAlgorithm)
+  int sizes[ImageDimension];
+  for (unsigned int i = 0; i < ImageDimension; ++i)
   {
-    delete[] in;
+    sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
+  FFTWProxyType::Execute_dft_c2r(ImageDimension,
+                                 sizes,
+                                 in,
+                                 out,
+                                 m_PlanRigor,
+                                 MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
+                                 !m_CanUseDestructiveAlgorithm);
 }
 
 template <typename TInputImage, typename TOutputImage>
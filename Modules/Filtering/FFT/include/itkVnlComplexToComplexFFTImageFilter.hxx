@@ -61,16 +61,9 @@ VnlComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGene
   using VclPixelType = std::complex<typename PixelType::value_type>;
   auto * outputBuffer = static_cast<VclPixelType *>(output->GetBufferPointer());
 
-  // call the proper transform, based on compile type template parameter
-  VnlFFTCommon::VnlFFTTransform<Image<typename PixelType::value_type, ImageDimension>> vnlfft(imageSize);
-  if (this->GetTransformDirection() == Superclass::TransformDirectionEnum::INVERSE)
-  {
-    vnlfft.transform(outputBuffer, 1);
-  }
-  else
-  {
-    vnlfft.transform(outputBuffer, -1);
-  }
+  const int direction = this->GetTransformDirection() == Superclass::TransformDirectionEnum::INVERSE ? 1 : -1;
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  VnlFFTCommon::Transform(outputBuffer, imageSize, direction, this->GetMultiThreader());
 }
 
 
@@ -19,8 +19,13 @@
 #define itkVnlFFTCommon_h
 
 #include "itkIntTypes.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSize.h"
 
 #include "vnl/algo/vnl_fft_base.h"
+#include "vnl/algo/vnl_fft_prime_factors.h"
+
+#include <complex>
 
 namespace itk
 {
@@ -52,6 +57,59 @@ struct VnlFFTCommon
     //: constructor takes size of signal.
     VnlFFTTransform(const typename TImage::SizeType & s);
   };
+
+  /** Number of lines transformed together by TransformAlongDimension(),
+   * RealToHalfHermitianForward() and HalfHermitianToRealInverse(). */
+  static constexpr SizeValueType NumberOfLinesPerBatch = 64;
+
+  /** Throws if vnl_fft_gpfa cannot transform lines of the given length, with
+   * prime factors other than 2, 3 and 5. */
+  template <typename TValue>
+  static void
+  VerifyFactors(const vnl_fft_prime_factors<TValue> & factors, SizeValueType length);
+
+  /** Transforms in place all the lines of a buffer of complex values along
+   * a dimension, by batches of adjacent lines, in parallel. The direction
+   * is -1 for the forward transform and +1 for the inverse one, which is
+   * not normalized. */
+  template <typename TValue, unsigned int VDimension>
+  static void
+  TransformAlongDimension(std::complex<TValue> *   buffer,
+                          const Size<VDimension> & bufferSize,
+                          unsigned int             dimension,
+                          int                      direction,
+                          MultiThreaderBase *      multiThreader);
+
+  /** Transforms in place a buffer of complex values along all its
+   * dimensions. */
+  template <typename TValue, unsigned int VDimension>
+  static void
+  Transform(std::complex<TValue> *   buffer,
+            const Size<VDimension> & size,
+            int                      direction,
+            MultiThreaderBase *      multiThreader);
+
+  /** Computes the half of the forward transform of a real image. The lines
+   * along the first dimension are transformed two at a time, as the real
+   * and imaginary parts of a complex line, and only the half of the
+   * transform is transformed along the other dimensions. The output has
+   * size[0] / 2 + 1 values along the first dimension. */
+  template <typename TValue, unsigned int VDimension>
+  static void
+  RealToHalfHermitianForward(const TValue *           input,
+                             std::complex<TValue> *   output,
+                             const Size<VDimension> & size,
+                             MultiThreaderBase *      multiThreader);
+
+  /** Computes the normalized inverse transform of the half of a Hermitian
+   * image, which has size[0] / 2 + 1 values along the first dimension. The
+   * lines along the first dimension are transformed two at a time. */
+  template <typename TValue, unsigned int VDimension>
+  static void
+  HalfHermitianToRealInverse(const std::complex<TValue> * input,
+                             TValue *                     output,
+                             const Size<VDimension> &     size,
+                             MultiThreaderBase *          multiThreader);
 };
 } // namespace itk
 
@@ -18,6 +18,11 @@
 #ifndef itkVnlFFTCommon_hxx
 #define itkVnlFFTCommon_hxx
 
+#include "itkMakeUniqueForOverwrite.h"
+#include "vnl/algo/vnl_fft.h"
+#include "vnl/algo/vnl_fft_prime_factors.h"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -48,6 +53,316 @@ VnlFFTCommon::VnlFFTTransform<TImage>::VnlFFTTransform(const typename TImage::Si
   }
 }
 
+template <typename TValue>
+void
+VnlFFTCommon::VerifyFactors(const vnl_fft_prime_factors<TValue> & factors, SizeValueType length)
+{
+  if (length > 1 && !factors)
+  {
+    itkGenericExceptionMacro("Cannot transform lines of length " << length
+                                                                   << ", which is not a product of 2's, 3's and 5's.");
+  }
+}
+
+template <typename TValue, unsigned int VDimension>
+void
+VnlFFTCommon::TransformAlongDimension(std::complex<TValue> *   buffer,
+                                      const Size<VDimension> & bufferSize,
+                                      unsigned int             dimension,
+                                      int                      direction,
+                                      MultiThreaderBase *      multiThreader)
+{
+  const SizeValueType length = bufferSize[dimension];
+  if (length <= 1)
+  {
+    return;
+  }
+
+  // the lines start at the offsets o * length * stride + j, with o smaller
+  // than numberOfBlocks and j smaller than stride
+  SizeValueType stride = 1;
+  SizeValueType numberOfBlocks = 1;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    if (d < dimension)
+    {
+      stride *= bufferSize[d];
+    }
+    else if (d > dimension)
+    {
+      numberOfBlocks *= bufferSize[d];
+    }
+  }
+
+  // The lines transformed together are adjacent along the first dimension,
+  // or, along the first dimension, the rows of consecutive blocks.
+  const SizeValueType linesPerBlock = stride == 1 ? numberOfBlocks : stride;
+  const SizeValueType batchesPerBlock = (linesPerBlock + NumberOfLinesPerBatch - 1) / NumberOfLinesPerBatch;
+  const SizeValueType numberOfBatches = stride == 1 ? batchesPerBlock : numberOfBlocks * batchesPerBlock;
+  const auto          increment = static_cast<long>(2 * stride);
+  const auto          jump = static_cast<long>(stride == 1 ? 2 * length : 2);
+
+  const vnl_fft_prime_factors<TValue> factors(static_cast<int>(length));
+  VerifyFactors(factors, length);
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBatches,
+    [&](SizeValueType batch) {
+      const SizeValueType block = stride == 1 ? 0 : batch / batchesPerBlock;
+      const SizeValueType firstLine = (batch % batchesPerBlock) * NumberOfLinesPerBatch;
+      const SizeValueType numberOfLines = std::min(NumberOfLinesPerBatch, linesPerBlock - firstLine);
+
+      // This relies on std::complex<T> being layout compatible with T[2].
+      auto * data = reinterpret_cast<TValue *>(buffer + block * length * stride +
+                                               firstLine * (stride == 1 ? length : 1));
+      long   info = 0;
+      vnl_fft_gpfa(data,
+                   data + 1,
+                   factors.trigs(),
+                   increment,
+                   jump,
+                   static_cast<long>(length),
+                   static_cast<long>(numberOfLines),
+                   direction,
+                   factors.pqr(),
+                   &info);
+      itkAssertInDebugAndIgnoreInReleaseMacro(info == 0);
+    },
+    nullptr);
+}
+
+template <typename TValue, unsigned int VDimension>
+void
+VnlFFTCommon::Transform(std::complex<TValue> *   buffer,
+                        const Size<VDimension> & size,
+                        int                      direction,
+                        MultiThreaderBase *      multiThreader)
+{
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    TransformAlongDimension(buffer, size, d, direction, multiThreader);
+  }
+}
+
+template <typename TValue, unsigned int VDimension>
+void
+VnlFFTCommon::RealToHalfHermitianForward(const TValue *           input,
+                                         std::complex<TValue> *   output,
+                                         const Size<VDimension> & size,
+                                         MultiThreaderBase *      multiThreader)
+{
+  using ComplexType = std::complex<TValue>;
+
+  const SizeValueType length = size[0];
+  const SizeValueType halfLength = length / 2 + 1;
+  SizeValueType       numberOfRows = 1;
+  for (unsigned int d = 1; d < VDimension; ++d)
+  {
+    numberOfRows *= size[d];
+  }
+
+  // The rows are transformed by pairs, the first one as the real part and
+  // the second one as the imaginary part of a complex row. The transforms of
+  // the two rows are then the Hermitian and anti-Hermitian parts of the
+  // transform of the complex row.
+  const SizeValueType numberOfPairs = (numberOfRows + 1) / 2;
+  const SizeValueType numberOfBatches = (numberOfPairs + NumberOfLinesPerBatch - 1) / NumberOfLinesPerBatch;
+
+  const vnl_fft_prime_factors<TValue> factors(static_cast<int>(length));
+  VerifyFactors(factors, length);
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBatches,
+    [&](SizeValueType batch) {
+      const SizeValueType firstPair = batch * NumberOfLinesPerBatch;
+      const SizeValueType numberOfLines = std::min(NumberOfLinesPerBatch, numberOfPairs - firstPair);
+      const auto          lines = make_unique_for_overwrite<ComplexType[]>(numberOfLines * length);
+
+      for (SizeValueType p = 0; p < numberOfLines; ++p)
+      {
+        const SizeValueType  row = 2 * (firstPair + p);
+        const TValue * const realPart = input + row * length;
+        ComplexType * const  line = lines.get() + p * length;
+        if (row + 1 < numberOfRows)
+        {
+          const TValue * const imaginaryPart = realPart + length;
+          for (SizeValueType i = 0; i < length; ++i)
+          {
+            line[i] = ComplexType(realPart[i], imaginaryPart[i]);
+          }
+        }
+        else
+        {
+          std::copy_n(realPart, length, line);
+        }
+      }
+
+      if (length > 1)
+      {
+        auto * data = reinterpret_cast<TValue *>(lines.get());
+        long   info = 0;
+        vnl_fft_gpfa(data,
+                     data + 1,
+                     factors.trigs(),
+                     2,
+                     static_cast<long>(2 * length),
+                     static_cast<long>(length),
+                     static_cast<long>(numberOfLines),
+                     -1,
+                     factors.pqr(),
+                     &info);
+        itkAssertInDebugAndIgnoreInReleaseMacro(info == 0);
+      }
+
+      for (SizeValueType p = 0; p < numberOfLines; ++p)
+      {
+        const SizeValueType       row = 2 * (firstPair + p);
+        const ComplexType * const line = lines.get() + p * length;
+        ComplexType * const       first = output + row * halfLength;
+        ComplexType * const       second = row + 1 < numberOfRows ? first + halfLength : nullptr;
+        for (SizeValueType k = 0; k < halfLength; ++k)
+        {
+          const ComplexType value = line[k];
+          const ComplexType mirror = std::conj(line[k == 0 ? 0 : length - k]);
+          first[k] = (value + mirror) * TValue{ 0.5 };
+          if (second != nullptr)
+          {
+            second[k] = (value - mirror) * ComplexType(0, -0.5);
+          }
+        }
+      }
+    },
+    nullptr);
+
+  Size<VDimension> halfSize = size;
+  halfSize[0] = halfLength;
+  for (unsigned int d = 1; d < VDimension; ++d)
+  {
+    TransformAlongDimension(output, halfSize, d, -1, multiThreader);
+  }
+}
+
+template <typename TValue, unsigned int VDimension>
+void
+VnlFFTCommon::HalfHermitianToRealInverse(const std::complex<TValue> * input,
+                                         TValue *                     output,
+                                         const Size<VDimension> &     size,
+                                         MultiThreaderBase *          multiThreader)
+{
+  using ComplexType = std::complex<TValue>;
+
+  const SizeValueType length = size[0];
+  const SizeValueType halfLength = length / 2 + 1;
+  SizeValueType       numberOfRows = 1;
+  for (unsigned int d = 1; d < VDimension; ++d)
+  {
+    numberOfRows *= size[d];
+  }
+
+  // the half of the transform is first transformed along the other
+  // dimensions than the first one
+  Size<VDimension> halfSize = size;
+  halfSize[0] = halfLength;
+  const auto halfTransform = make_unique_for_overwrite<ComplexType[]>(halfLength * numberOfRows);
+  std::copy_n(input, halfLength * numberOfRows, halfTransform.get());
+  for (unsigned int d = 1; d < VDimension; ++d)
+  {
+    TransformAlongDimension(halfTransform.get(), halfSize, d, 1, multiThreader);
+  }
+
+  // The rows, completed by Hermitian symmetry, are then transformed by
+  // pairs, the first one as the real part and the second one as the
+  // imaginary part of a complex row. Only the real part of the values
+  // which are their own mirror is kept, as when taking the real part of the
+  // transform of each row.
+  const SizeValueType numberOfPairs = (numberOfRows + 1) / 2;
+  const SizeValueType numberOfBatches = (numberOfPairs + NumberOfLinesPerBatch - 1) / NumberOfLinesPerBatch;
+  const auto          normalization = static_cast<TValue>(length * numberOfRows);
+
+  const vnl_fft_prime_factors<TValue> factors(static_cast<int>(length));
+  VerifyFactors(factors, length);
+
+  const auto hermitianValue = [length, halfLength](const ComplexType * row, SizeValueType k) {
+    if (k == 0 || 2 * k == length)
+    {
+      return ComplexType(row[k].real());
+    }
+    return k < halfLength ? row[k] : std::conj(row[length - k]);
+  };
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBatches,
+    [&](SizeValueType batch) {
+      const SizeValueType firstPair = batch * NumberOfLinesPerBatch;
+      const SizeValueType numberOfLines = std::min(NumberOfLinesPerBatch, numberOfPairs - firstPair);
+      const auto          lines = make_unique_for_overwrite<ComplexType[]>(numberOfLines * length);
+
+      for (SizeValueType p = 0; p < numberOfLines; ++p)
+      {
+        const SizeValueType       row = 2 * (firstPair + p);
+        const ComplexType * const first = halfTransform.get() + row * halfLength;
+        ComplexType * const       line = lines.get() + p * length;
+        if (row + 1 < numberOfRows)
+        {
+          const ComplexType * const second = first + halfLength;
+          for (SizeValueType k = 0; k < length; ++k)
+          {
+            const ComplexType firstValue = hermitianValue(first, k);
+            const ComplexType secondValue = hermitianValue(second, k);
+            line[k] = ComplexType(firstValue.real() - secondValue.imag(), firstValue.imag() + secondValue.real());
+          }
+        }
+        else
+        {
+          for (SizeValueType k = 0; k < length; ++k)
+          {
+            line[k] = hermitianValue(first, k);
+          }
+        }
+      }
+
+      if (length > 1)
+      {
+        auto * data = reinterpret_cast<TValue *>(lines.get());
+        long   info = 0;
+        vnl_fft_gpfa(data,
+                     data + 1,
+                     factors.trigs(),
+                     2,
+                     static_cast<long>(2 * length),
+                     static_cast<long>(length),
+                     static_cast<long>(numberOfLines),
+                     1,
+                     factors.pqr(),
+                     &info);
+        itkAssertInDebugAndIgnoreInReleaseMacro(info == 0);
+      }
+
+      for (SizeValueType p = 0; p < numberOfLines; ++p)
+      {
+        const SizeValueType       row = 2 * (firstPair + p);
+        const ComplexType * const line = lines.get() + p * length;
+        TValue * const            first = output + row * length;
+        for (SizeValueType i = 0; i < length; ++i)
+        {
+          first[i] = line[i].real() / normalization;
+        }
+        if (row + 1 < numberOfRows)
+        {
+          TValue * const second = first + length;
+          for (SizeValueType i = 0; i < length; ++i)
+          {
+            second[i] = line[i].imag() / normalization;
+          }
+        }
+      }
+    },
+    nullptr);
+}
+
 } // end namespace itk
 
 #endif // itkVnlFFTCommon_hxx
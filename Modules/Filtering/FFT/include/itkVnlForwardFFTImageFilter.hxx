@@ -18,7 +18,6 @@
 #ifndef itkVnlForwardFFTImageFilter_hxx
 #define itkVnlForwardFFTImageFilter_hxx
 
-#include "itkImageRegionIteratorWithIndex.h"
 #include "itkProgressReporter.h"
 #include "itkVnlFFTCommon.h"
 
@@ -47,7 +46,6 @@ VnlForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
   outputPtr->Allocate();
 
-  unsigned int vectorSize = 1;
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
     if (!VnlFFTCommon::IsDimensionSizeLegal(inputSize[i]))
@@ -57,28 +55,15 @@ VnlForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
                         << ". VnlForwardFFTImageFilter operates only on images whose size in each dimension has only a "
                            "combination of 2,3, and 5 as prime factors.");
     }
-    vectorSize *= inputSize[i];
   }
 
+  // the input is transformed in place in the output buffer
   const InputPixelType * in = inputPtr->GetBufferPointer();
-  SignalVectorType       signal(vectorSize);
-  for (unsigned int i = 0; i < vectorSize; ++i)
-  {
-    signal[i] = in[i];
-  }
-
-  // call the proper transform, based on compile type template parameter
-  VnlFFTCommon::VnlFFTTransform<InputImageType> vnlfft(inputSize);
-  vnlfft.transform(signal.data_block(), -1);
+  OutputPixelType *      out = outputPtr->GetBufferPointer();
+  std::copy_n(in, outputPtr->GetBufferedRegion().GetNumberOfPixels(), out);
 
-  // Copy the VNL output back to the ITK image.
-  for (ImageRegionIteratorWithIndex<TOutputImage> oIt(outputPtr, outputPtr->GetLargestPossibleRegion()); !oIt.IsAtEnd();
-       ++oIt)
-  {
-    const typename OutputImageType::IndexType       index = oIt.GetIndex();
-    const typename OutputImageType::OffsetValueType offset = inputPtr->ComputeOffset(index);
-    oIt.Set(signal[offset]);
-  }
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  VnlFFTCommon::Transform(out, inputSize, -1, this->GetMultiThreader());
 }
 
 template <typename TInputImage, typename TOutputImage>
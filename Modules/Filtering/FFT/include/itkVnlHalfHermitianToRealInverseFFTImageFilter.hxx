@@ -18,8 +18,8 @@
 #ifndef itkVnlHalfHermitianToRealInverseFFTImageFilter_hxx
 #define itkVnlHalfHermitianToRealInverseFFTImageFilter_hxx
 
-#include "itkImageRegionIteratorWithIndex.h"
 #include "itkProgressReporter.h"
+#include "itkVnlFFTCommon.h"
 
 namespace itk
 {
@@ -41,16 +41,12 @@ VnlHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::Generate
   // reports the beginning and the end of the process.
   const ProgressReporter progress(this, 0, 1);
 
-  const InputSizeType   inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
-  const InputIndexType  inputIndex = inputPtr->GetLargestPossibleRegion().GetIndex();
-  const OutputSizeType  outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
-  const OutputIndexType outputIndex = outputPtr->GetLargestPossibleRegion().GetIndex();
+  const OutputSizeType outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
 
   // Allocate output buffer memory
   outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
   outputPtr->Allocate();
 
-  unsigned int vectorSize = 1;
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
     if (!VnlFFTCommon::IsDimensionSizeLegal(outputSize[i]))
@@ -60,54 +56,14 @@ VnlHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::Generate
                         << ". VnlHalfHermitianToRealInverseFFTImageFilter operates only on images whose size in each "
                            "dimension has only a combination of 2,3, and 5 as prime factors.");
     }
-    vectorSize *= outputSize[i];
   }
 
-  // VNL requires the full complex result of the transform, so we
-  // produce it here from the half complex image assumed when the output is real.
-  SignalVectorType signal(vectorSize);
-
-  const OutputIndexValueType maxXIndex = inputIndex[0] + static_cast<OutputIndexValueType>(inputSize[0]);
-  unsigned int               si = 0;
-  for (ImageRegionIteratorWithIndex<OutputImageType> oIt(outputPtr, outputPtr->GetLargestPossibleRegion());
-       !oIt.IsAtEnd();
-       ++oIt)
-  {
-    typename OutputImageType::IndexType index = oIt.GetIndex();
-    if (index[0] >= maxXIndex)
-    {
-      // Flip the indices in each dimension
-      for (unsigned int i = 0; i < ImageDimension; ++i)
-      {
-        if (index[i] != outputIndex[i])
-        {
-          index[i] = outputSize[i] - index[i] + 2 * outputIndex[i];
-        }
-      }
-      signal[si] = std::conj(inputPtr->GetPixel(index));
-    }
-    else
-    {
-      signal[si] = inputPtr->GetPixel(index);
-    }
-    ++si;
-  }
-
-  OutputPixelType * out = outputPtr->GetBufferPointer();
-
-  // call the proper transform, based on compile type template parameter
-  VnlFFTCommon::VnlFFTTransform<OutputImageType> vnlfft(outputSize);
-  vnlfft.transform(signal.data_block(), 1);
-
-  // Copy the VNL output back to the ITK image. Extract the real part
-  // of the signal. Ideally, the normalization by the number of
-  // elements should have been accounted for by the VNL inverse
-  // Fourier transform, but it is not. So, we take care of it by
-  // dividing the signal by the vectorSize.
-  for (unsigned int i = 0; i < vectorSize; ++i)
-  {
-    out[i] = signal[i].real() / vectorSize;
-  }
+  // The input is the half of the transform of the output, which is
+  // completed by Hermitian symmetry along the first dimension. The result is
+  // normalized by the number of pixels.
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  VnlFFTCommon::HalfHermitianToRealInverse(
+    inputPtr->GetBufferPointer(), outputPtr->GetBufferPointer(), outputSize, this->GetMultiThreader());
 }
 
 template <typename TInputImage, typename TOutputImage>
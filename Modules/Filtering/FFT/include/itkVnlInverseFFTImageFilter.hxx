@@ -49,7 +49,7 @@ VnlInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   const InputPixelType * in = inputPtr->GetBufferPointer();
 
-  unsigned int vectorSize = 1;
+  SizeValueType vectorSize = 1;
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
     if (!VnlFFTCommon::IsDimensionSizeLegal(outputSize[i]))
@@ -62,17 +62,12 @@ VnlInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     vectorSize *= outputSize[i];
   }
 
-  SignalVectorType signal(vectorSize);
-  for (unsigned int i = 0; i < vectorSize; ++i)
-  {
-    signal[i] = in[i];
-  }
+  SignalVectorType signal(in, vectorSize);
 
   OutputPixelType * out = outputPtr->GetBufferPointer();
 
-  // call the proper transform, based on compile type template parameter
-  VnlFFTCommon::VnlFFTTransform<OutputImageType> vnlfft(outputSize);
-  vnlfft.transform(signal.data_block(), 1);
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  VnlFFTCommon::Transform(signal.data_block(), outputSize, 1, this->GetMultiThreader());
 
   // Copy the VNL output back to the ITK image.
   // Extract the real part of the signal.
@@ -80,7 +75,7 @@ VnlInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   // should have been accounted for by the VNL inverse Fourier transform,
   // but it is not.  So, we take care of it by dividing the signal by
   // the vectorSize.
-  for (unsigned int i = 0; i < vectorSize; ++i)
+  for (SizeValueType i = 0; i < vectorSize; ++i)
   {
     out[i] = signal[i].real() / vectorSize;
   }
@@ -18,8 +18,8 @@
 #ifndef itkVnlRealToHalfHermitianForwardFFTImageFilter_hxx
 #define itkVnlRealToHalfHermitianForwardFFTImageFilter_hxx
 
-#include "itkImageRegionIteratorWithIndex.h"
 #include "itkProgressReporter.h"
+#include "itkVnlFFTCommon.h"
 
 namespace itk
 {
@@ -46,7 +46,6 @@ VnlRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generate
   outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
   outputPtr->Allocate();
 
-  unsigned int vectorSize = 1;
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
     if (!VnlFFTCommon::IsDimensionSizeLegal(inputSize[i]))
@@ -56,28 +55,12 @@ VnlRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generate
                         << "only on images whose size in each dimension has a prime "
                         << "factorization consisting of only 2s, 3s, or 5s.");
     }
-    vectorSize *= inputSize[i];
   }
 
-  const InputPixelType * in = inputPtr->GetBufferPointer();
-  SignalVectorType       signal(vectorSize);
-  for (unsigned int i = 0; i < vectorSize; ++i)
-  {
-    signal[i] = in[i];
-  }
-
-  // call the proper transform, based on compile type template parameter
-  VnlFFTCommon::VnlFFTTransform<InputImageType> vnlfft(inputSize);
-  vnlfft.transform(signal.data_block(), -1);
-
-  // Copy the VNL output back to the ITK image.
-  for (ImageRegionIteratorWithIndex<TOutputImage> oIt(outputPtr, outputPtr->GetLargestPossibleRegion()); !oIt.IsAtEnd();
-       ++oIt)
-  {
-    const typename OutputImageType::IndexType       index = oIt.GetIndex();
-    const typename OutputImageType::OffsetValueType offset = inputPtr->ComputeOffset(index);
-    oIt.Set(signal[offset]);
-  }
+  // only the half of the transform is computed
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  VnlFFTCommon::RealToHalfHermitianForward(
+    inputPtr->GetBufferPointer(), outputPtr->GetBufferPointer(), inputSize, this->GetMultiThreader());
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -38,6 +38,7 @@
 #  endif
 
 #  include "itkObjectFactory.h"
+#  include <new>
 
 namespace itk
 {
@@ -485,6 +486,10 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
 
 FFTWGlobalConfiguration::~FFTWGlobalConfiguration()
 {
+  // The plans must be destroyed before the cleanup of FFTW
+  m_CachedPlans.clear();
+  this->FreeWorkspaces();
+
   if (this->m_WriteWisdomCache && this->m_NewWisdomAvailable)
   {
     const std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -824,6 +829,136 @@ FFTWGlobalConfiguration::GetWisdomCacheBase()
   return GetInstance()->m_WisdomCacheBase;
 }
 
+void
+FFTWGlobalConfiguration::SetMaximumNumberOfCachedPlans(const SizeValueType v)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  // The plans which leave the cache are destroyed once the lock is released
+  std::list<std::pair<std::vector<int>, std::shared_ptr<void>>> removedPlans;
+  const std::lock_guard<std::mutex>                             lockGuard(GetLockMutex());
+  GetInstance()->m_MaximumNumberOfCachedPlans = v;
+  auto & cachedPlans = GetInstance()->m_CachedPlans;
+  while (cachedPlans.size() > v)
+  {
+    removedPlans.splice(removedPlans.end(), cachedPlans, std::prev(cachedPlans.end()));
+  }
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetMaximumNumberOfCachedPlans()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return GetInstance()->m_MaximumNumberOfCachedPlans;
+}
+
+void
+FFTWGlobalConfiguration::ClearPlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::list<std::pair<std::vector<int>, std::shared_ptr<void>>> removedPlans;
+  {
+    const std::lock_guard<std::mutex> lockGuard(GetLockMutex());
+    removedPlans.swap(GetInstance()->m_CachedPlans);
+  }
+  removedPlans.clear();
+  GetInstance()->FreeWorkspaces();
+}
+
+std::shared_ptr<void>
+FFTWGlobalConfiguration::GetCachedPlan(const std::vector<int> &        description,
+                                       const std::function<void *()> & createPlan,
+                                       void (*destroyPlan)(void *))
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Self * const instance = GetInstance();
+
+  // The plans which leave the cache are destroyed once the lock is released
+  std::list<std::pair<std::vector<int>, std::shared_ptr<void>>> removedPlans;
+  const std::lock_guard<std::mutex>                             lockGuard(instance->m_Mutex);
+
+  auto & cachedPlans = instance->m_CachedPlans;
+  auto   it = std::find_if(cachedPlans.begin(), cachedPlans.end(), [&description](const auto & cachedPlan) {
+    return cachedPlan.first == description;
+  });
+  if (it != cachedPlans.end())
+  {
+    cachedPlans.splice(cachedPlans.begin(), cachedPlans, it);
+    return it->second;
+  }
+
+  std::mutex &                mutex = instance->m_Mutex;
+  const std::shared_ptr<void> plan(createPlan(), [destroyPlan, &mutex](void * p) {
+    const std::lock_guard<std::mutex> destroyLockGuard(mutex);
+    destroyPlan(p);
+  });
+  if (instance->m_MaximumNumberOfCachedPlans > 0)
+  {
+    cachedPlans.emplace_front(description, plan);
+    while (cachedPlans.size() > instance->m_MaximumNumberOfCachedPlans)
+    {
+      removedPlans.splice(removedPlans.end(), cachedPlans, std::prev(cachedPlans.end()));
+    }
+  }
+  return plan;
+}
+
+std::shared_ptr<void>
+FFTWGlobalConfiguration::GetWorkspace(const size_t numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Self * const instance = GetInstance();
+
+  std::pair<size_t, void *> workspace(0, nullptr);
+  {
+    // Take the smallest free workspace which is large enough
+    const std::lock_guard<std::mutex> lockGuard(instance->m_WorkspaceMutex);
+    auto &                            freeWorkspaces = instance->m_FreeWorkspaces;
+    auto                              best = freeWorkspaces.end();
+    for (auto it = freeWorkspaces.begin(); it != freeWorkspaces.end(); ++it)
+    {
+      if (it->first >= numberOfBytes && (best == freeWorkspaces.end() || it->first < best->first))
+      {
+        best = it;
+      }
+    }
+    if (best != freeWorkspaces.end())
+    {
+      workspace = *best;
+      freeWorkspaces.erase(best);
+    }
+  }
+  if (workspace.second == nullptr)
+  {
+    workspace.first = std::max<size_t>(numberOfBytes, 1);
+    workspace.second = ::operator new(workspace.first, std::align_val_t{ WorkspaceAlignment });
+  }
+
+  return std::shared_ptr<void>(workspace.second, [instance, size = workspace.first](void * p) {
+    // Keep a few workspaces, the largest ones, for the next transforms
+    constexpr size_t                  maximumNumberOfFreeWorkspaces = 4;
+    const std::lock_guard<std::mutex> lockGuard(instance->m_WorkspaceMutex);
+    auto &                            freeWorkspaces = instance->m_FreeWorkspaces;
+    freeWorkspaces.emplace_back(size, p);
+    if (freeWorkspaces.size() > maximumNumberOfFreeWorkspaces)
+    {
+      const auto smallest = std::min_element(freeWorkspaces.begin(), freeWorkspaces.end());
+      ::operator delete(smallest->second, std::align_val_t{ WorkspaceAlignment });
+      freeWorkspaces.erase(smallest);
+    }
+  });
+}
+
+void
+FFTWGlobalConfiguration::FreeWorkspaces()
+{
+  const std::lock_guard<std::mutex> lockGuard(m_WorkspaceMutex);
+  for (const auto & workspace : m_FreeWorkspaces)
+  {
+    ::operator delete(workspace.second, std::align_val_t{ WorkspaceAlignment });
+  }
+  m_FreeWorkspaces.clear();
+}
+
 } // end namespace itk
 
 #endif
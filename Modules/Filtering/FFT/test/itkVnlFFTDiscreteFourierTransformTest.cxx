@@ -0,0 +1,215 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkVnlForwardFFTImageFilter.h"
+#include "itkVnlInverseFFTImageFilter.h"
+#include "itkVnlRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkVnlHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkVnlComplexToComplexFFTImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkIndexRange.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkMath.h"
+
+#include <cmath>
+#include <complex>
+
+namespace
+{
+
+using ComplexType = std::complex<double>;
+
+// The discrete Fourier transform, at an index, of an image whose values are
+// given by a function of the index.
+template <unsigned int VDimension, typename TFunction>
+ComplexType
+DiscreteFourierTransform(const itk::Size<VDimension> & size,
+                         const itk::Index<VDimension> & frequency,
+                         int                            direction,
+                         TFunction                      value)
+{
+  ComplexType sum = 0.0;
+  for (const itk::Index<VDimension> & index : itk::ZeroBasedIndexRange<VDimension>(size))
+  {
+    double phase = 0.0;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      phase += static_cast<double>(index[d] * frequency[d]) / static_cast<double>(size[d]);
+    }
+    sum += value(index) * std::polar(1.0, direction * 2.0 * itk::Math::pi * phase);
+  }
+  return sum;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+CreateRandomImage(const typename TImage::SizeType & size)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if constexpr (std::is_arithmetic_v<typename TImage::PixelType>)
+    {
+      it.Set(generator->GetUniformVariate(-1.0, 1.0));
+    }
+    else
+    {
+      it.Set({ generator->GetUniformVariate(-1.0, 1.0), generator->GetUniformVariate(-1.0, 1.0) });
+    }
+  }
+  return image;
+}
+
+template <typename TImage, typename TFunction>
+bool
+CheckImage(const char * name, const TImage * image, TFunction expectedValue)
+{
+  constexpr double tolerance = 1e-9;
+  for (const auto & index : itk::ZeroBasedIndexRange<TImage::ImageDimension>(image->GetBufferedRegion().GetSize()))
+  {
+    const ComplexType value = image->GetPixel(index);
+    const ComplexType expected = expectedValue(index);
+    if (std::abs(value - expected) > tolerance * (1.0 + std::abs(expected)))
+    {
+      std::cerr << name << ": different values at " << index << ": " << value << " != " << expected << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The forward and inverse transforms of the VNL filters are the discrete
+// Fourier transforms, for sizes of which the lines are transformed in
+// several batches, and numbers of lines which are odd.
+template <unsigned int VDimension>
+bool
+TestSize(const itk::Size<VDimension> & size)
+{
+  using RealImageType = itk::Image<double, VDimension>;
+  using ComplexImageType = itk::Image<ComplexType, VDimension>;
+  using IndexType = itk::Index<VDimension>;
+
+  std::cout << "Size: " << size << std::endl;
+
+  const auto real = CreateRandomImage<RealImageType>(size);
+  const auto complex = CreateRandomImage<ComplexImageType>(size);
+  const auto realValue = [&real](const IndexType & index) { return ComplexType(real->GetPixel(index)); };
+  const auto complexValue = [&complex](const IndexType & index) { return complex->GetPixel(index); };
+  const auto forward = [&size](auto value) {
+    return [&size, value](const IndexType & frequency) { return DiscreteFourierTransform(size, frequency, -1, value); };
+  };
+  const double numberOfPixels = static_cast<double>(real->GetBufferedRegion().GetNumberOfPixels());
+  const auto   inverse = [&size, numberOfPixels](auto value) {
+    return [&size, numberOfPixels, value](const IndexType & index) {
+      return DiscreteFourierTransform(size, index, 1, value) / numberOfPixels;
+    };
+  };
+
+  bool success = true;
+
+  auto forwardFilter = itk::VnlForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  forwardFilter->SetInput(real);
+  forwardFilter->Update();
+  success = CheckImage("VnlForwardFFTImageFilter", forwardFilter->GetOutput(), forward(realValue)) && success;
+
+  auto halfForwardFilter = itk::VnlRealToHalfHermitianForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  halfForwardFilter->SetInput(real);
+  halfForwardFilter->Update();
+  success =
+    CheckImage("VnlRealToHalfHermitianForwardFFTImageFilter", halfForwardFilter->GetOutput(), forward(realValue)) &&
+    success;
+
+  // the inverse transforms of a transform which is not Hermitian give the
+  // real part of the inverse transform of its Hermitian part
+  auto inverseFilter = itk::VnlInverseFFTImageFilter<ComplexImageType, RealImageType>::New();
+  inverseFilter->SetInput(complex);
+  inverseFilter->Update();
+  const auto realPart = [](auto value) {
+    return [value](const IndexType & index) { return ComplexType(value(index).real()); };
+  };
+  success =
+    CheckImage("VnlInverseFFTImageFilter", inverseFilter->GetOutput(), realPart(inverse(complexValue))) && success;
+
+  auto halfInverseFilter = itk::VnlHalfHermitianToRealInverseFFTImageFilter<ComplexImageType, RealImageType>::New();
+  halfInverseFilter->SetInput(halfForwardFilter->GetOutput());
+  halfInverseFilter->SetActualXDimensionIsOdd(size[0] % 2 == 1);
+  halfInverseFilter->Update();
+  success = CheckImage("VnlHalfHermitianToRealInverseFFTImageFilter", halfInverseFilter->GetOutput(), realValue) &&
+            success;
+
+  // the half of a transform which is not Hermitian, completed by symmetry
+  auto halfComplex = ComplexImageType::New();
+  halfComplex->SetRegions(halfForwardFilter->GetOutput()->GetBufferedRegion());
+  halfComplex->Allocate();
+  for (itk::ImageRegionIterator<ComplexImageType> it(halfComplex, halfComplex->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    it.Set(complex->GetPixel(it.GetIndex()));
+  }
+  const auto hermitianValue = [&size, &complex](const IndexType & index) {
+    if (static_cast<itk::SizeValueType>(2 * index[0]) <= size[0])
+    {
+      return complex->GetPixel(index);
+    }
+    IndexType mirror;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      mirror[d] = index[d] == 0 ? 0 : static_cast<itk::IndexValueType>(size[d]) - index[d];
+    }
+    return std::conj(complex->GetPixel(mirror));
+  };
+  halfInverseFilter->SetInput(halfComplex);
+  halfInverseFilter->Update();
+  success = CheckImage("VnlHalfHermitianToRealInverseFFTImageFilter",
+                       halfInverseFilter->GetOutput(),
+                       realPart(inverse(hermitianValue))) &&
+            success;
+
+  using ComplexToComplexFilterType = itk::VnlComplexToComplexFFTImageFilter<ComplexImageType>;
+  auto complexFilter = ComplexToComplexFilterType::New();
+  complexFilter->SetInput(complex);
+  complexFilter->Update();
+  success = CheckImage("VnlComplexToComplexFFTImageFilter", complexFilter->GetOutput(), forward(complexValue)) &&
+            success;
+  complexFilter->SetTransformDirection(ComplexToComplexFilterType::TransformDirectionEnum::INVERSE);
+  complexFilter->Update();
+  success = CheckImage("VnlComplexToComplexFFTImageFilter", complexFilter->GetOutput(), inverse(complexValue)) &&
+            success;
+
+  return success;
+}
+} // namespace
+
+int
+itkVnlFFTDiscreteFourierTransformTest(int, char *[])
+{
+  bool success = true;
+  success = TestSize(itk::Size<1>{ { 90 } }) && success;
+  success = TestSize(itk::Size<1>{ { 1 } }) && success;
+  success = TestSize(itk::Size<2>{ { 6, 150 } }) && success;
+  success = TestSize(itk::Size<2>{ { 75, 1 } }) && success;
+  success = TestSize(itk::Size<3>{ { 80, 3, 5 } }) && success;
+  success = TestSize(itk::Size<3>{ { 9, 4, 3 } }) && success;
+
+  std::cout << "Test finished." << std::endl;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
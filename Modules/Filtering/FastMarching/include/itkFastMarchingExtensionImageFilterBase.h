@@ -137,6 +137,13 @@ protected:
   void
   UpdateValue(OutputImageType * oImage, const NodeType & iNode) override;
 
+  /** The auxiliary values are computed while propagating the front. */
+  bool
+  SupportsParallelSolving() const override
+  {
+    return false;
+  }
+
   /** Generate the output image meta information */
   void
   GenerateOutputInformation() override;
@@ -57,6 +57,22 @@ namespace itk
  *
  * Else the output information is copied from the input speed image.
  *
+ * The front is propagated serially by default. When ParallelSolving is on,
+ * the arrival times are computed with a block-based fast iterative method:
+ * the output is divided into blocks, and the active blocks are solved on
+ * several threads until the values converge. Blocks of alternating parity
+ * are solved in turn, so that no two blocks which share a face are solved
+ * at the same time. The nodes are then visited by increasing value to
+ * apply the stopping criterion and to collect the points, as done by the
+ * serial propagation, which gives the same output as long as the alive
+ * points are enclosed by trial or forbidden points. The front is solved
+ * up to the stopping value of the stopping criterion, which must be a
+ * FastMarchingThresholdStoppingCriterion or a
+ * FastMarchingReachedTargetNodesStoppingCriterion: the other criteria, the
+ * topology checks and the subclasses which compute auxiliary values while
+ * propagating the front use the serial propagation instead, with a
+ * warning.
+ *
  * Implementation of this class is based on Chapter 8 of
  * "Level Set Methods and Fast Marching Methods", J.A. Sethian,
  * Cambridge Press, Second edition, 1999.
@@ -159,6 +175,13 @@ public:
   itkGetConstReferenceMacro(OverrideOutputInformation, bool);
   itkBooleanMacro(OverrideOutputInformation);
 
+  /** Set/Get whether the arrival times are computed on several threads,
+   * with the fast iterative method described above, when the stopping
+   * criterion is a threshold or a target nodes criterion. Off by default. */
+  itkSetMacro(ParallelSolving, bool);
+  itkGetConstMacro(ParallelSolving, bool);
+  itkBooleanMacro(ParallelSolving);
+
 protected:
   FastMarchingImageFilterBase();
 
@@ -176,11 +199,24 @@ protected:
   OutputSpacingType   m_OutputSpacing{};
   OutputDirectionType m_OutputDirection{};
   bool                m_OverrideOutputInformation{ false };
+  bool                m_ParallelSolving{ false };
 
   /** Generate the output image meta information. */
   void
   GenerateOutputInformation() override;
 
+  void
+  GenerateData() override;
+
+  /** Whether the front can be propagated with the parallel solving. False
+   * for the subclasses which compute additional values while updating the
+   * nodes. */
+  virtual bool
+  SupportsParallelSolving() const
+  {
+    return true;
+  }
+
   void
   EnlargeOutputRequestedRegion(DataObject * output) override;
 
@@ -270,6 +306,9 @@ protected:
   const InputImageType * m_InputCache{};
 
 private:
+  /** Propagates the front with the parallel fast iterative method. */
+  void
+  ParallelGenerateData();
 };
 } // end namespace itk
 
@@ -21,8 +21,17 @@
 
 
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkConnectedComponentImageFilter.h"
 #include "itkRelabelComponentImageFilter.h"
+#include "itkFastMarchingReachedTargetNodesStoppingCriterion.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -155,15 +164,19 @@ FastMarchingImageFilterBase<TInput, TOutput>::UpdateNeighbors(OutputImageType *
     NodeType neighIndex = iNode;
     for (int s = -1; s < 2; s += 2)
     {
-      if ((v > start) && (v < last))
-      {
-        neighIndex[j] = v + s;
-      }
-      const unsigned char label = m_LabelImage->GetPixel(neighIndex);
+      const typename NodeType::IndexValueType temp = v + s;
 
-      if ((label != Traits::Alive) && (label != Traits::InitialTrial) && (label != Traits::Forbidden))
+      // Make sure neighIndex is not outside from the image
+      if ((temp <= last) && (temp >= start))
       {
-        this->UpdateValue(oImage, neighIndex);
+        neighIndex[j] = temp;
+
+        const unsigned char label = m_LabelImage->GetPixel(neighIndex);
+
+        if ((label != Traits::Alive) && (label != Traits::InitialTrial) && (label != Traits::Forbidden))
+        {
+          this->UpdateValue(oImage, neighIndex);
+        }
       }
     }
 
@@ -972,6 +985,473 @@ FastMarchingImageFilterBase<TInput, TOutput>::InitializeIndices3D()
   }
 }
 
+template <typename TInput, typename TOutput>
+void
+FastMarchingImageFilterBase<TInput, TOutput>::GenerateData()
+{
+  // Only a threshold or a target nodes criterion bounds the parallel
+  // propagation: the other criteria would have the whole output solved
+  // before they are applied.
+  using ThresholdCriterionType = FastMarchingThresholdStoppingCriterion<TInput, TOutput>;
+  using TargetNodesCriterionType = FastMarchingReachedTargetNodesStoppingCriterion<TInput, TOutput>;
+  const bool boundedCriterion =
+    dynamic_cast<ThresholdCriterionType *>(this->m_StoppingCriterion.GetPointer()) != nullptr ||
+    dynamic_cast<TargetNodesCriterionType *>(this->m_StoppingCriterion.GetPointer()) != nullptr;
+  if (m_ParallelSolving && this->SupportsParallelSolving() &&
+      this->m_TopologyCheck == Superclass::TopologyCheckEnum::Nothing && boundedCriterion)
+  {
+    this->ParallelGenerateData();
+  }
+  else
+  {
+    if (m_ParallelSolving)
+    {
+      itkWarningMacro("ParallelSolving requires a threshold or target nodes stopping criterion, no topology check "
+                      "and a filter which does not compute auxiliary values; the front is propagated serially.");
+    }
+    Superclass::GenerateData();
+  }
+}
+
+template <typename TInput, typename TOutput>
+void
+FastMarchingImageFilterBase<TInput, TOutput>::ParallelGenerateData()
+{
+  OutputImageType * output = this->GetOutput();
+
+  this->Initialize(output);
+
+  // The trial points are ordered below, together with the solved nodes.
+  while (!this->m_Heap.empty())
+  {
+    this->m_Heap.pop();
+  }
+
+  OutputPixelType * const   values = output->GetBufferPointer();
+  unsigned char * const     labels = m_LabelImage->GetBufferPointer();
+  const OffsetValueType *   strides = output->GetOffsetTable();
+  const OutputPixelType     largeValue = this->m_LargeValue;
+  const SizeValueType       numberOfNodes = m_BufferedRegion.GetNumberOfPixels();
+  MultiThreaderBase * const multiThreader = this->GetMultiThreader();
+  std::exception_ptr        exception;
+  std::mutex                exceptionMutex;
+
+  const auto captureException = [&exception, &exceptionMutex]() {
+    const std::lock_guard<std::mutex> lock(exceptionMutex);
+    if (!exception)
+    {
+      exception = std::current_exception();
+    }
+  };
+  const auto rethrowException = [&exception]() {
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
+  };
+
+  // Arrival time of a node, as the serial propagation computes it from
+  // its alive neighbors. neighborKind gives the kind of each neighbor:
+  // NotUsed, AlwaysUsed for the initial alive points, or Propagating for
+  // the nodes which update their neighbors once alive. A node which has no
+  // propagating neighbor is not reached by the front.
+  enum class NeighborKind : uint8_t
+  {
+    NotUsed,
+    AlwaysUsed,
+    Propagating
+  };
+  const auto solveNode = [this, output, values, strides, largeValue](
+                           const NodeType & node, const OffsetValueType offset, const auto & neighborKind) {
+    InternalNodeStructureArray nodesUsed;
+    bool                       reached = false;
+    for (unsigned int j = 0; j < ImageDimension; ++j)
+    {
+      nodesUsed[j].m_Node = node;
+      nodesUsed[j].m_Value = largeValue;
+      nodesUsed[j].m_Axis = j;
+      for (int s = -1; s < 2; s += 2)
+      {
+        const IndexValueType neighbor = node[j] + s;
+        if (neighbor >= m_StartIndex[j] && neighbor <= m_LastIndex[j])
+        {
+          const OffsetValueType neighborOffset = offset + s * strides[j];
+          const NeighborKind    kind = neighborKind(neighborOffset);
+          if (kind != NeighborKind::NotUsed && values[neighborOffset] < nodesUsed[j].m_Value)
+          {
+            reached = reached || kind == NeighborKind::Propagating;
+            nodesUsed[j].m_Value = values[neighborOffset];
+          }
+        }
+      }
+    }
+    return reached ? this->Solve(output, node, nodesUsed) : static_cast<double>(largeValue);
+  };
+  const auto propagationKind = [labels](const OffsetValueType neighborOffset) {
+    switch (labels[neighborOffset])
+    {
+      case Traits::Alive:
+        return NeighborKind::AlwaysUsed;
+      case Traits::Forbidden:
+        return NeighborKind::NotUsed;
+      default:
+        return NeighborKind::Propagating;
+    }
+  };
+
+  // Fast iterative method: the buffered region is divided into blocks, and
+  // each active block is swept until its nodes converge. A block whose
+  // face nodes change activates its neighbors across these faces. Blocks
+  // of alternating parity are solved in turn, so that the nodes read
+  // across the faces of a block are not written at the same time.
+  constexpr SizeValueType blockEdge = ImageDimension == 1 ? 1024 : (ImageDimension == 2 ? 32 : 8);
+  Size<ImageDimension>    numberOfBlocks;
+  OffsetValueType         blockStrides[ImageDimension];
+  OffsetValueType         totalNumberOfBlocks = 1;
+  for (unsigned int j = 0; j < ImageDimension; ++j)
+  {
+    numberOfBlocks[j] = (m_BufferedRegion.GetSize(j) + blockEdge - 1) / blockEdge;
+    blockStrides[j] = totalNumberOfBlocks;
+    totalNumberOfBlocks *= numberOfBlocks[j];
+  }
+  const auto blockIndexOf = [&numberOfBlocks](OffsetValueType block) {
+    Index<ImageDimension> blockIndex;
+    for (unsigned int j = 0; j < ImageDimension; ++j)
+    {
+      blockIndex[j] = block % static_cast<OffsetValueType>(numberOfBlocks[j]);
+      block /= static_cast<OffsetValueType>(numberOfBlocks[j]);
+    }
+    return blockIndex;
+  };
+
+  // The nodes popped after the stopping value of the criterion are never
+  // alive, so the front does not need to be propagated beyond them. For a
+  // threshold criterion, the stopping value is the threshold. For a target
+  // nodes criterion, it is the value of the last target to be reached plus
+  // the target offset: the values only decrease, so the limit is lowered
+  // after each wave, once enough targets have been reached.
+  using ThresholdCriterionType = FastMarchingThresholdStoppingCriterion<TInput, TOutput>;
+  using TargetNodesCriterionType = FastMarchingReachedTargetNodesStoppingCriterion<TInput, TOutput>;
+  OutputPixelType              propagationLimit = largeValue;
+  std::vector<OffsetValueType> targetOffsets;
+  size_t                       numberOfTargetsToBeReached = 0;
+  OutputPixelType              targetOffset{};
+  if (auto * const thresholdCriterion =
+        dynamic_cast<ThresholdCriterionType *>(this->m_StoppingCriterion.GetPointer()))
+  {
+    propagationLimit = std::min(largeValue, thresholdCriterion->GetThreshold());
+  }
+  else
+  {
+    auto * const targetNodesCriterion =
+      static_cast<TargetNodesCriterionType *>(this->m_StoppingCriterion.GetPointer());
+    for (const NodeType & target : targetNodesCriterion->GetTargetNodes())
+    {
+      if (m_BufferedRegion.IsInside(target))
+      {
+        targetOffsets.push_back(output->ComputeOffset(target));
+      }
+    }
+    numberOfTargetsToBeReached = targetNodesCriterion->GetNumberOfTargetsToBeReached();
+    targetOffset = targetNodesCriterion->GetTargetOffset();
+  }
+  std::vector<OutputPixelType> targetValues;
+  const auto                   updateTargetPropagationLimit = [&]() {
+    if (numberOfTargetsToBeReached == 0 || numberOfTargetsToBeReached > targetOffsets.size())
+    {
+      return;
+    }
+    targetValues.clear();
+    for (const OffsetValueType offset : targetOffsets)
+    {
+      targetValues.push_back(values[offset]);
+    }
+    const auto lastReached = targetValues.begin() + (numberOfTargetsToBeReached - 1);
+    std::nth_element(targetValues.begin(), lastReached, targetValues.end());
+    if (*lastReached < largeValue && targetOffset < largeValue - *lastReached)
+    {
+      propagationLimit = std::min(propagationLimit, static_cast<OutputPixelType>(*lastReached + targetOffset));
+    }
+  };
+
+  // Sweeps a block until it converges, and returns a mask of the faces on
+  // which nodes have changed: bit 2j for the lower face along j, and bit
+  // 2j+1 for the upper one.
+  const auto solveBlock = [&](const OffsetValueType block) {
+    const Index<ImageDimension> blockIndex = blockIndexOf(block);
+    NodeType                    blockStart;
+    NodeType                    blockLast;
+    for (unsigned int j = 0; j < ImageDimension; ++j)
+    {
+      blockStart[j] = m_StartIndex[j] + blockIndex[j] * static_cast<IndexValueType>(blockEdge);
+      blockLast[j] = std::min(blockStart[j] + static_cast<IndexValueType>(blockEdge) - 1, m_LastIndex[j]);
+    }
+
+    std::vector<NodeType>        nodes;
+    std::vector<OffsetValueType> offsets;
+    NodeType                     node = blockStart;
+    while (true)
+    {
+      OffsetValueType offset = 0;
+      for (unsigned int j = 0; j < ImageDimension; ++j)
+      {
+        offset += (node[j] - m_StartIndex[j]) * strides[j];
+      }
+      if (labels[offset] == Traits::Far)
+      {
+        nodes.push_back(node);
+        offsets.push_back(offset);
+      }
+      unsigned int j = 0;
+      while (j < ImageDimension && node[j] == blockLast[j])
+      {
+        node[j] = blockStart[j];
+        ++j;
+      }
+      if (j == ImageDimension)
+      {
+        break;
+      }
+      ++node[j];
+    }
+
+    // The values only decrease, which guarantees the convergence.
+    unsigned int faces = 0;
+    bool         changed = true;
+    for (unsigned int sweep = 0; changed; ++sweep)
+    {
+      changed = false;
+      for (size_t n = 0; n < nodes.size(); ++n)
+      {
+        const size_t          i = (sweep % 2 == 0) ? n : nodes.size() - 1 - n;
+        const OffsetValueType offset = offsets[i];
+        const auto            value = static_cast<OutputPixelType>(solveNode(nodes[i], offset, propagationKind));
+        if (value < values[offset])
+        {
+          values[offset] = value;
+          changed = true;
+          if (value <= propagationLimit)
+          {
+            for (unsigned int j = 0; j < ImageDimension; ++j)
+            {
+              faces |= (nodes[i][j] == blockStart[j] ? 1u : 0u) << (2 * j);
+              faces |= (nodes[i][j] == blockLast[j] ? 1u : 0u) << (2 * j + 1);
+            }
+          }
+        }
+      }
+    }
+    return faces;
+  };
+
+  std::vector<bool> active(totalNumberOfBlocks, false);
+  const auto        activateNeighborBlocks = [&](const OffsetValueType block, const unsigned int faces) {
+    const Index<ImageDimension> blockIndex = blockIndexOf(block);
+    for (unsigned int j = 0; j < ImageDimension; ++j)
+    {
+      if ((faces & (1u << (2 * j))) && blockIndex[j] > 0)
+      {
+        active[block - blockStrides[j]] = true;
+      }
+      if ((faces & (1u << (2 * j + 1))) && blockIndex[j] + 1 < static_cast<IndexValueType>(numberOfBlocks[j]))
+      {
+        active[block + blockStrides[j]] = true;
+      }
+    }
+  };
+  for (SizeValueType offset = 0; offset < numberOfNodes; ++offset)
+  {
+    if (labels[offset] == Traits::InitialTrial)
+    {
+      const NodeType  node = output->ComputeIndex(static_cast<OffsetValueType>(offset));
+      OffsetValueType block = 0;
+      for (unsigned int j = 0; j < ImageDimension; ++j)
+      {
+        block += ((node[j] - m_StartIndex[j]) / static_cast<IndexValueType>(blockEdge)) * blockStrides[j];
+      }
+      active[block] = true;
+      activateNeighborBlocks(block, ~0u);
+    }
+  }
+
+  std::vector<OffsetValueType> blocks;
+  std::vector<unsigned int>    faces;
+  bool                         anyActive = true;
+  while (anyActive)
+  {
+    for (OffsetValueType parity = 0; parity < 2; ++parity)
+    {
+      blocks.clear();
+      for (OffsetValueType block = 0; block < totalNumberOfBlocks; ++block)
+      {
+        if (active[block])
+        {
+          const Index<ImageDimension> blockIndex = blockIndexOf(block);
+          OffsetValueType             sum = 0;
+          for (unsigned int j = 0; j < ImageDimension; ++j)
+          {
+            sum += blockIndex[j];
+          }
+          if (sum % 2 == parity)
+          {
+            active[block] = false;
+            blocks.push_back(block);
+          }
+        }
+      }
+      if (blocks.empty())
+      {
+        continue;
+      }
+      faces.assign(blocks.size(), 0);
+      multiThreader->ParallelizeArray(
+        0,
+        blocks.size(),
+        [&](SizeValueType i) {
+          try
+          {
+            faces[i] = solveBlock(blocks[i]);
+          }
+          catch (...)
+          {
+            captureException();
+          }
+        },
+        nullptr);
+      rethrowException();
+      for (size_t i = 0; i < blocks.size(); ++i)
+      {
+        activateNeighborBlocks(blocks[i], faces[i]);
+      }
+    }
+    updateTargetPropagationLimit();
+    anyActive = std::find(active.cbegin(), active.cend(), true) != active.cend();
+  }
+
+  // The reached nodes are then made alive by increasing value, as the
+  // serial propagation pops them from its heap.
+  using CandidateType = std::pair<OutputPixelType, OffsetValueType>;
+  std::vector<CandidateType> candidates;
+  for (SizeValueType offset = 0; offset < numberOfNodes; ++offset)
+  {
+    if ((labels[offset] == Traits::Far && values[offset] < largeValue) || labels[offset] == Traits::InitialTrial)
+    {
+      candidates.emplace_back(values[offset], static_cast<OffsetValueType>(offset));
+    }
+  }
+  const SizeValueType numberOfChunks = std::max<SizeValueType>(
+    1, std::min<SizeValueType>(multiThreader->GetNumberOfWorkUnits(), candidates.size() / 4096));
+  std::vector<size_t> chunkBounds(numberOfChunks + 1);
+  for (SizeValueType i = 0; i <= numberOfChunks; ++i)
+  {
+    chunkBounds[i] = candidates.size() * i / numberOfChunks;
+  }
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType i) { std::sort(candidates.begin() + chunkBounds[i], candidates.begin() + chunkBounds[i + 1]); },
+    nullptr);
+  for (SizeValueType width = 1; width < numberOfChunks; width *= 2)
+  {
+    multiThreader->ParallelizeArray(
+      0,
+      (numberOfChunks + 2 * width - 1) / (2 * width),
+      [&](SizeValueType i) {
+        const SizeValueType first = 2 * width * i;
+        if (first + width < numberOfChunks)
+        {
+          std::inplace_merge(candidates.begin() + chunkBounds[first],
+                             candidates.begin() + chunkBounds[first + width],
+                             candidates.begin() + chunkBounds[std::min(first + 2 * width, numberOfChunks)]);
+        }
+      },
+      nullptr);
+  }
+
+  ProgressReporter  progress(this, 0, this->GetTotalNumberOfNodes());
+  OutputPixelType   current_value = 0.;
+  std::vector<bool> popped(numberOfNodes, false);
+  size_t            numberOfPoppedNodes = 0;
+
+  this->m_StoppingCriterion->Reinitialize();
+
+  try
+  {
+    for (; numberOfPoppedNodes < candidates.size(); ++numberOfPoppedNodes)
+    {
+      const OffsetValueType offset = candidates[numberOfPoppedNodes].second;
+      current_value = candidates[numberOfPoppedNodes].first;
+      const NodePairType current_node_pair(output->ComputeIndex(offset), current_value);
+
+      this->m_StoppingCriterion->SetCurrentNodePair(current_node_pair);
+      if (this->m_StoppingCriterion->IsSatisfied())
+      {
+        break;
+      }
+      if (this->m_CollectPoints)
+      {
+        this->m_ProcessedPoints->push_back(current_node_pair);
+      }
+      labels[offset] = Traits::Alive;
+      popped[offset] = true;
+      progress.CompletedPixel();
+    }
+  }
+  catch (const ProcessAborted &)
+  {
+    throw ProcessAborted(__FILE__, __LINE__);
+  }
+
+  this->m_TargetReachedValue = current_value;
+
+  // When the propagation stops early, the nodes which are not alive are
+  // left as the serial propagation leaves them: the neighbors of the
+  // popped nodes are trial nodes, solved from their alive neighbors only.
+  if (numberOfPoppedNodes < candidates.size())
+  {
+    const auto aliveKind = [labels, &popped](const OffsetValueType neighborOffset) {
+      if (labels[neighborOffset] != Traits::Alive)
+      {
+        return NeighborKind::NotUsed;
+      }
+      return popped[neighborOffset] ? NeighborKind::Propagating : NeighborKind::AlwaysUsed;
+    };
+    const auto updateFarNodes = [&](const OutputRegionType & region) {
+      for (ImageRegionIteratorWithIndex<OutputImageType> it(output, region); !it.IsAtEnd(); ++it)
+      {
+        const NodeType        node = it.GetIndex();
+        const OffsetValueType offset = output->ComputeOffset(node);
+        if (labels[offset] == Traits::Far)
+        {
+          it.Set(static_cast<OutputPixelType>(solveNode(node, offset, aliveKind)));
+        }
+      }
+    };
+    multiThreader->template ParallelizeImageRegion<ImageDimension>(
+      m_BufferedRegion,
+      [&](const OutputRegionType & region) {
+        try
+        {
+          updateFarNodes(region);
+        }
+        catch (...)
+        {
+          captureException();
+        }
+      },
+      nullptr);
+    rethrowException();
+
+    for (SizeValueType offset = 0; offset < numberOfNodes; ++offset)
+    {
+      if (labels[offset] == Traits::Far && values[offset] < largeValue)
+      {
+        labels[offset] = Traits::Trial;
+      }
+    }
+  }
+}
+
 template <typename TInput, typename TOutput>
 void
 FastMarchingImageFilterBase<TInput, TOutput>::PrintSelf(std::ostream & os, Indent indent) const
@@ -988,6 +1468,7 @@ FastMarchingImageFilterBase<TInput, TOutput>::PrintSelf(std::ostream & os, Inden
   os << indent << "OutputDirection: " << m_OutputDirection << std::endl;
 
   os << indent << "OverrideOutputInformation: " << m_OverrideOutputInformation << std::endl;
+  os << indent << "ParallelSolving: " << m_ParallelSolving << std::endl;
 
   itkPrintSelfObjectMacro(LabelImage);
 
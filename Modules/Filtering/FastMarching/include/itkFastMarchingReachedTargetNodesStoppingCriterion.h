@@ -119,6 +119,29 @@ public:
     this->Modified();
   }
 
+  /** \brief Get Target Nodes*/
+  const std::vector<NodeType> &
+  GetTargetNodes() const
+  {
+    return m_TargetNodes;
+  }
+
+  /** \brief Get the number of target nodes to be reached, as given by the
+   * TargetCondition. */
+  size_t
+  GetNumberOfTargetsToBeReached() const
+  {
+    if (m_TargetCondition == TargetConditionEnum::OneTarget)
+    {
+      return 1;
+    }
+    if (m_TargetCondition == TargetConditionEnum::AllTargets)
+    {
+      return m_TargetNodes.size();
+    }
+    return m_NumberOfTargetsToBeReached;
+  }
+
   /** \brief Set the current node */
   void
   SetCurrentNode(const NodeType & iNode) override
@@ -104,6 +104,13 @@ protected:
   void
   UpdateNeighbors(OutputImageType * oImage, const NodeType & iNode) override;
 
+  /** The auxiliary values are computed while propagating the front. */
+  bool
+  SupportsParallelSolving() const override
+  {
+    return false;
+  }
+
   virtual void
   ComputeGradient(OutputImageType * oImage, const NodeType & iNode);
 };
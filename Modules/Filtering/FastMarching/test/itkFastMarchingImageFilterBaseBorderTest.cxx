@@ -0,0 +1,79 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFastMarchingImageFilterBase.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkTestingMacros.h"
+
+// The front enters the image from trial points on its border: the neighbors
+// inside the image of a border node are updated along every axis.
+int
+itkFastMarchingImageFilterBaseBorderTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 2;
+  using ImageType = itk::Image<float, Dimension>;
+  using FastMarchingType = itk::FastMarchingImageFilterBase<ImageType, ImageType>;
+  using CriterionType = itk::FastMarchingThresholdStoppingCriterion<ImageType, ImageType>;
+
+  auto criterion = CriterionType::New();
+  criterion->SetThreshold(100.0);
+
+  auto marcher = FastMarchingType::New();
+  marcher->SetStoppingCriterion(criterion);
+  marcher->SetSpeedConstant(1.0);
+  marcher->SetOutputSize(ImageType::SizeType{ { 16, 12 } });
+
+  // A corner, and a node on the last column.
+  auto                       trial = FastMarchingType::NodePairContainerType::New();
+  const ImageType::IndexType corner{ { 0, 0 } };
+  const ImageType::IndexType lastColumn{ { 15, 6 } };
+  trial->push_back(FastMarchingType::NodePairType(corner, 0.0));
+  trial->push_back(FastMarchingType::NodePairType(lastColumn, 0.0));
+  marcher->SetTrialPoints(trial);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(marcher->Update());
+  const ImageType * output = marcher->GetOutput();
+
+  // Along the border and along the rows, the arrival time is the distance.
+  bool passed = true;
+  for (const auto & expected : { std::make_pair(ImageType::IndexType{ { 1, 0 } }, 1.0),
+                                 std::make_pair(ImageType::IndexType{ { 0, 1 } }, 1.0),
+                                 std::make_pair(ImageType::IndexType{ { 4, 0 } }, 4.0),
+                                 std::make_pair(ImageType::IndexType{ { 0, 3 } }, 3.0),
+                                 std::make_pair(ImageType::IndexType{ { 14, 6 } }, 1.0),
+                                 std::make_pair(ImageType::IndexType{ { 15, 11 } }, 5.0),
+                                 std::make_pair(ImageType::IndexType{ { 12, 6 } }, 3.0) })
+  {
+    const double value = output->GetPixel(expected.first);
+    if (itk::Math::abs(value - expected.second) > 1e-4)
+    {
+      std::cerr << "Error at index " << expected.first << ": expected " << expected.second << ", but got " << value
+                << std::endl;
+      passed = false;
+    }
+  }
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,247 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFastMarchingImageFilterBase.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkFastMarchingReachedTargetNodesStoppingCriterion.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+#include <functional>
+
+// Compares the parallel solving of FastMarchingImageFilterBase with its
+// serial propagation: the output values, the labels, the target reached
+// value and the processed points must be the same.
+namespace
+{
+
+template <unsigned int VDimension>
+bool
+CompareParallelAndSerialSolving(
+  const typename itk::Image<float, VDimension>::SizeType & size,
+  const std::function<typename itk::FastMarchingStoppingCriterionBase<itk::Image<float, VDimension>,
+                                                                      itk::Image<float, VDimension>>::Pointer()> &
+    makeCriterion)
+{
+  using ImageType = itk::Image<float, VDimension>;
+  using FastMarchingType = itk::FastMarchingImageFilterBase<ImageType, ImageType>;
+  using NodePairType = typename FastMarchingType::NodePairType;
+  using NodePairContainerType = typename FastMarchingType::NodePairContainerType;
+  using IndexType = typename ImageType::IndexType;
+
+  auto speed = ImageType::New();
+  speed->SetRegions(size);
+  speed->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(1234);
+  for (itk::ImageRegionIterator<ImageType> it(speed, speed->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(generator->GetUniformVariate(0.5, 2.0)));
+  }
+
+  const auto randomIndex = [&generator, &size]() {
+    IndexType index;
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      index[j] = generator->GetIntegerVariate(static_cast<unsigned long>(size[j] - 1));
+    }
+    return index;
+  };
+  auto alive = NodePairContainerType::New();
+  auto trial = NodePairContainerType::New();
+  auto forbidden = NodePairContainerType::New();
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    trial->push_back(NodePairType(randomIndex(), static_cast<float>(i)));
+
+    // An alive point, enclosed by trial points.
+    IndexType index = randomIndex();
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      index[j] = std::max<itk::IndexValueType>(1, std::min<itk::IndexValueType>(index[j], size[j] - 2));
+    }
+    alive->push_back(NodePairType(index, 0.0));
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      for (const int s : { -1, 1 })
+      {
+        IndexType neighbor = index;
+        neighbor[j] += s;
+        trial->push_back(NodePairType(neighbor, 1.0));
+      }
+    }
+  }
+  // A trial point in a corner, which propagates into the image.
+  trial->push_back(NodePairType(IndexType{}, 3.0));
+  for (unsigned int i = 0; i < 20; ++i)
+  {
+    forbidden->push_back(NodePairType(randomIndex(), 0.0));
+  }
+  // A wall of forbidden points, which the front goes around.
+  for (itk::IndexValueType i = 0; i < static_cast<itk::IndexValueType>(size[1]) - 3; ++i)
+  {
+    IndexType index{};
+    index[0] = size[0] / 2;
+    index[1] = i;
+    forbidden->push_back(NodePairType(index, 0.0));
+  }
+
+  typename FastMarchingType::Pointer marchers[2];
+  for (const bool parallelSolving : { false, true })
+  {
+    auto marcher = FastMarchingType::New();
+    marcher->SetInput(speed);
+    marcher->SetAlivePoints(alive);
+    marcher->SetTrialPoints(trial);
+    marcher->SetForbiddenPoints(forbidden);
+    marcher->SetStoppingCriterion(makeCriterion());
+    marcher->SetCollectPoints(true);
+    marcher->SetParallelSolving(parallelSolving);
+    ITK_TRY_EXPECT_NO_EXCEPTION(marcher->Update());
+    marchers[parallelSolving] = marcher;
+  }
+
+  const ImageType * const serialOutput = marchers[0]->GetOutput();
+  const ImageType * const parallelOutput = marchers[1]->GetOutput();
+  const auto              tolerance = [](double value) { return 1e-4 * std::max(1.0, std::abs(value)); };
+
+  bool          passed = true;
+  unsigned long numberOfDifferences = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(serialOutput, serialOutput->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const IndexType index = it.GetIndex();
+    const double    serialValue = it.Get();
+    const double    parallelValue = parallelOutput->GetPixel(index);
+    if (std::abs(serialValue - parallelValue) > tolerance(serialValue) ||
+        marchers[0]->GetLabelImage()->GetPixel(index) != marchers[1]->GetLabelImage()->GetPixel(index))
+    {
+      if (numberOfDifferences++ < 10)
+      {
+        std::cerr << "At " << index << ": serial value " << serialValue << " and label "
+                  << static_cast<int>(marchers[0]->GetLabelImage()->GetPixel(index)) << ", parallel value "
+                  << parallelValue << " and label " << static_cast<int>(marchers[1]->GetLabelImage()->GetPixel(index))
+                  << std::endl;
+      }
+      passed = false;
+    }
+  }
+  if (numberOfDifferences > 0)
+  {
+    std::cerr << numberOfDifferences << " nodes differ." << std::endl;
+  }
+
+  const double serialTarget = marchers[0]->GetTargetReachedValue();
+  const double parallelTarget = marchers[1]->GetTargetReachedValue();
+  if (std::abs(serialTarget - parallelTarget) > tolerance(serialTarget))
+  {
+    std::cerr << "TargetReachedValue: serial " << serialTarget << ", parallel " << parallelTarget << std::endl;
+    passed = false;
+  }
+
+  const NodePairContainerType * const serialPoints = marchers[0]->GetProcessedPoints();
+  const NodePairContainerType * const parallelPoints = marchers[1]->GetProcessedPoints();
+  if (serialPoints->Size() != parallelPoints->Size())
+  {
+    std::cerr << "Number of processed points: serial " << serialPoints->Size() << ", parallel "
+              << parallelPoints->Size() << std::endl;
+    passed = false;
+  }
+  else
+  {
+    for (itk::SizeValueType i = 0; i < serialPoints->Size(); ++i)
+    {
+      const double serialValue = serialPoints->ElementAt(i).GetValue();
+      if (std::abs(serialValue - parallelPoints->ElementAt(i).GetValue()) > tolerance(serialValue))
+      {
+        std::cerr << "Processed point " << i << ": serial " << serialPoints->ElementAt(i).GetNode() << ' '
+                  << serialValue << ", parallel " << parallelPoints->ElementAt(i).GetNode() << ' '
+                  << parallelPoints->ElementAt(i).GetValue() << std::endl;
+        passed = false;
+        break;
+      }
+    }
+  }
+  return passed;
+}
+
+} // namespace
+
+int
+itkFastMarchingImageFilterBaseParallelTest(int, char *[])
+{
+  using ImageType2D = itk::Image<float, 2>;
+  using ImageType3D = itk::Image<float, 3>;
+
+  bool passed = true;
+
+  std::cout << "2-D, without stopping criterion" << std::endl;
+  passed &= CompareParallelAndSerialSolving<2>(ImageType2D::SizeType{ { 150, 97 } }, []() {
+    auto criterion = itk::FastMarchingThresholdStoppingCriterion<ImageType2D, ImageType2D>::New();
+    criterion->SetThreshold(itk::NumericTraits<float>::max());
+    return criterion;
+  });
+
+  std::cout << "3-D, with a threshold" << std::endl;
+  passed &= CompareParallelAndSerialSolving<3>(ImageType3D::SizeType{ { 41, 30, 23 } }, []() {
+    auto criterion = itk::FastMarchingThresholdStoppingCriterion<ImageType3D, ImageType3D>::New();
+    criterion->SetThreshold(12.0);
+    return criterion;
+  });
+
+  std::cout << "2-D, with a target node" << std::endl;
+  passed &= CompareParallelAndSerialSolving<2>(ImageType2D::SizeType{ { 80, 70 } }, []() {
+    using CriterionType = itk::FastMarchingReachedTargetNodesStoppingCriterion<ImageType2D, ImageType2D>;
+    auto criterion = CriterionType::New();
+    criterion->SetTargetCondition(CriterionType::TargetConditionEnum::OneTarget);
+    criterion->SetTargetNodes({ ImageType2D::IndexType{ { 60, 50 } } });
+    return criterion;
+  });
+
+  std::cout << "3-D, with all target nodes and a target offset" << std::endl;
+  passed &= CompareParallelAndSerialSolving<3>(ImageType3D::SizeType{ { 41, 30, 23 } }, []() {
+    using CriterionType = itk::FastMarchingReachedTargetNodesStoppingCriterion<ImageType3D, ImageType3D>;
+    auto criterion = CriterionType::New();
+    criterion->SetTargetCondition(CriterionType::TargetConditionEnum::AllTargets);
+    criterion->SetTargetNodes({ ImageType3D::IndexType{ { 5, 25, 4 } }, ImageType3D::IndexType{ { 35, 10, 18 } } });
+    criterion->SetTargetOffset(2.0);
+    return criterion;
+  });
+
+  std::cout << "2-D, with some target nodes" << std::endl;
+  passed &= CompareParallelAndSerialSolving<2>(ImageType2D::SizeType{ { 150, 97 } }, []() {
+    using CriterionType = itk::FastMarchingReachedTargetNodesStoppingCriterion<ImageType2D, ImageType2D>;
+    auto criterion = CriterionType::New();
+    criterion->SetTargetCondition(CriterionType::TargetConditionEnum::SomeTargets);
+    criterion->SetNumberOfTargetsToBeReached(2);
+    criterion->SetTargetNodes({ ImageType2D::IndexType{ { 10, 90 } },
+                                ImageType2D::IndexType{ { 140, 5 } },
+                                ImageType2D::IndexType{ { 100, 60 } } });
+    return criterion;
+  });
+
+  if (!passed)
+  {
+    std::cerr << "Test failed: the parallel solving differs from the serial propagation." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
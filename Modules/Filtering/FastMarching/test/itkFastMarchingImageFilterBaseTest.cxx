@@ -42,6 +42,9 @@ FastMarchingImageFilterBaseTestFunction()
   constexpr bool overrideOutputInformation = true;
   ITK_TEST_SET_GET_BOOLEAN(fastMarchingFilter, OverrideOutputInformation, overrideOutputInformation);
 
+  constexpr bool parallelSolving = true;
+  ITK_TEST_SET_GET_BOOLEAN(fastMarchingFilter, ParallelSolving, parallelSolving);
+
   auto outputSize = FastMarchingImageFilterType::OutputSizeType::Filled(32);
   fastMarchingFilter->SetOutputSize(outputSize);
   ITK_TEST_SET_GET_VALUE(outputSize, fastMarchingFilter->GetOutputSize());
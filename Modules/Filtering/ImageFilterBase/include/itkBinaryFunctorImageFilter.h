@@ -36,6 +36,12 @@ namespace itk
  * the pipeline. The SetConstant() and GetConstant() methods are provided as shortcuts
  * to set or get the constant value without manipulating the decorator.
  *
+ * When the images have the same dimension and store their pixels directly in
+ * their buffers, as Image does, the functor is applied over chunks of
+ * contiguous pixels through pointers. Each work unit then calls its own copy
+ * of a functor whose operator() is const, while a functor which can only be
+ * called as non-const is shared by all the work units.
+ *
  * \sa BinaryGeneratorImagFilter
  * \sa UnaryFunctorImageFilter TernaryFunctorImageFilter
  *
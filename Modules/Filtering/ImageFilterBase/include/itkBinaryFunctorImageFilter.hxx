@@ -18,8 +18,10 @@
 #ifndef itkBinaryFunctorImageFilter_hxx
 #define itkBinaryFunctorImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
+#include <type_traits>
 
 
 namespace itk
@@ -178,6 +180,80 @@ BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::D
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if constexpr (ImageAlgorithm::SupportsDirectPixelAccess<TInputImage1> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TInputImage2> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TOutputImage>)
+  {
+    using IndexType = typename OutputImageRegionType::IndexType;
+
+    // Local copies of the functor and of the constants, which the output
+    // pixels cannot alias. A functor which can only be called as non-const
+    // is shared by the work units instead, as in the loop over the iterators.
+    using LocalFunctorType = std::conditional_t<
+      std::is_invocable_v<const FunctorType &, const Input1ImagePixelType &, const Input2ImagePixelType &>,
+      const FunctorType,
+      FunctorType &>;
+    LocalFunctorType localFunctor = m_Functor;
+    if (inputPtr1 && inputPtr2)
+    {
+      ImageAlgorithm::ForEachContiguousChunk(
+        outputRegionForThread,
+        [inputPtr1, inputPtr2, outputPtr, &localFunctor, &progress](const IndexType & index,
+                                                                    SizeValueType     numberOfPixels) {
+          const Input1ImagePixelType * in1 = inputPtr1->GetBufferPointer() + inputPtr1->ComputeOffset(index);
+          const Input2ImagePixelType * in2 = inputPtr2->GetBufferPointer() + inputPtr2->ComputeOffset(index);
+          OutputImagePixelType *       out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+          for (SizeValueType i = 0; i < numberOfPixels; ++i)
+          {
+            out[i] = localFunctor(in1[i], in2[i]);
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr1,
+        inputPtr2,
+        outputPtr);
+      return;
+    }
+    if (inputPtr1)
+    {
+      const Input2ImagePixelType input2Value = this->GetConstant2();
+      ImageAlgorithm::ForEachContiguousChunk(
+        outputRegionForThread,
+        [inputPtr1, outputPtr, &localFunctor, &input2Value, &progress](const IndexType & index,
+                                                                       SizeValueType     numberOfPixels) {
+          const Input1ImagePixelType * in1 = inputPtr1->GetBufferPointer() + inputPtr1->ComputeOffset(index);
+          OutputImagePixelType *       out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+          for (SizeValueType i = 0; i < numberOfPixels; ++i)
+          {
+            out[i] = localFunctor(in1[i], input2Value);
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr1,
+        outputPtr);
+      return;
+    }
+    if (inputPtr2)
+    {
+      const Input1ImagePixelType input1Value = this->GetConstant1();
+      ImageAlgorithm::ForEachContiguousChunk(
+        outputRegionForThread,
+        [inputPtr2, outputPtr, &localFunctor, &input1Value, &progress](const IndexType & index,
+                                                                       SizeValueType     numberOfPixels) {
+          const Input2ImagePixelType * in2 = inputPtr2->GetBufferPointer() + inputPtr2->ComputeOffset(index);
+          OutputImagePixelType *       out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+          for (SizeValueType i = 0; i < numberOfPixels; ++i)
+          {
+            out[i] = localFunctor(input1Value, in2[i]);
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr2,
+        outputPtr);
+      return;
+    }
+  }
+
   if (inputPtr1 && inputPtr2)
   {
     ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
@@ -18,6 +18,7 @@
 #ifndef itkBinaryGeneratorImageFilter_hxx
 #define itkBinaryGeneratorImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
 
@@ -186,6 +187,75 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if constexpr (ImageAlgorithm::SupportsDirectPixelAccess<TInputImage1> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TInputImage2> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TOutputImage>)
+  {
+    using IndexType = typename OutputImageRegionType::IndexType;
+
+    // Local copies of the functor and of the constants, which the output
+    // pixels cannot alias
+    const TFunctor localFunctor = functor;
+    if (inputPtr1 && inputPtr2)
+    {
+      ImageAlgorithm::ForEachContiguousChunk(
+        outputRegionForThread,
+        [inputPtr1, inputPtr2, outputPtr, &localFunctor, &progress](const IndexType & index,
+                                                                    SizeValueType     numberOfPixels) {
+          const Input1ImagePixelType * in1 = inputPtr1->GetBufferPointer() + inputPtr1->ComputeOffset(index);
+          const Input2ImagePixelType * in2 = inputPtr2->GetBufferPointer() + inputPtr2->ComputeOffset(index);
+          OutputImagePixelType *       out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+          for (SizeValueType i = 0; i < numberOfPixels; ++i)
+          {
+            out[i] = localFunctor(in1[i], in2[i]);
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr1,
+        inputPtr2,
+        outputPtr);
+      return;
+    }
+    if (inputPtr1)
+    {
+      const Input2ImagePixelType input2Value = this->GetConstant2();
+      ImageAlgorithm::ForEachContiguousChunk(
+        outputRegionForThread,
+        [inputPtr1, outputPtr, &localFunctor, &input2Value, &progress](const IndexType & index,
+                                                                       SizeValueType     numberOfPixels) {
+          const Input1ImagePixelType * in1 = inputPtr1->GetBufferPointer() + inputPtr1->ComputeOffset(index);
+          OutputImagePixelType *       out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+          for (SizeValueType i = 0; i < numberOfPixels; ++i)
+          {
+            out[i] = localFunctor(in1[i], input2Value);
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr1,
+        outputPtr);
+      return;
+    }
+    if (inputPtr2)
+    {
+      const Input1ImagePixelType input1Value = this->GetConstant1();
+      ImageAlgorithm::ForEachContiguousChunk(
+        outputRegionForThread,
+        [inputPtr2, outputPtr, &localFunctor, &input1Value, &progress](const IndexType & index,
+                                                                       SizeValueType     numberOfPixels) {
+          const Input2ImagePixelType * in2 = inputPtr2->GetBufferPointer() + inputPtr2->ComputeOffset(index);
+          OutputImagePixelType *       out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+          for (SizeValueType i = 0; i < numberOfPixels; ++i)
+          {
+            out[i] = localFunctor(input1Value, in2[i]);
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr2,
+        outputPtr);
+      return;
+    }
+  }
+
   if (inputPtr1 && inputPtr2)
   {
     ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFunctorComposition_h
+#define itkFunctorComposition_h
+
+#include "itkMacro.h"
+
+#include <tuple>
+#include <type_traits>
+
+namespace itk
+{
+namespace Functor
+{
+/** \class Composition
+ * \brief Composes pixel-wise functors into a single one.
+ *
+ * The composition is called with the pixels of the inputs of a pixel-wise
+ * filter. The first functor receives the pixel of the first input, and
+ * each following functor receives the result of the previous one. A
+ * functor which can also take the pixels of the other inputs receives them
+ * after that value, as the mask functor of MaskImageFilter does.
+ *
+ * A chain of pixel-wise filters can then run as a single
+ * UnaryGeneratorImageFilter, BinaryGeneratorImageFilter or
+ * TernaryGeneratorImageFilter, in one pass over the images and without
+ * intermediate images. For example, a rescaling followed by a clamping, a
+ * cast and a masking:
+   \code
+     using FilterType = itk::BinaryGeneratorImageFilter<FloatImageType, MaskImageType, ShortImageType>;
+     auto fused = FilterType::New();
+     fused->SetInput1(image);
+     fused->SetInput2(mask);
+     fused->SetFunctor(itk::Functor::MakeComposition(
+       [](float value) { return 2.0f * value + 10.0f; },
+       clampFilter->GetFunctor(),
+       [](double value) { return static_cast<short>(value); },
+       itk::Functor::MaskInput<short, unsigned char, short>()));
+   \endcode
+ * The composition is equivalent to the chain of filters, except that the
+ * intermediate values are not rounded to the pixel types of intermediate
+ * images, and that the functors are evaluated for all the pixels, even the
+ * ones masked by a later functor.
+ *
+ * \sa MakeComposition FusedFunctorImageFilter
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TFirstFunctor, typename... TFunctors>
+class Composition
+{
+public:
+  Composition() = default;
+
+  explicit Composition(const TFirstFunctor & firstFunctor, const TFunctors &... functors)
+    : m_Functors(firstFunctor, functors...)
+  {}
+
+  bool
+  operator==(const Composition & other) const
+  {
+    return m_Functors == other.m_Functors;
+  }
+
+  ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(Composition);
+
+  template <typename TInput, typename... TOtherInputs>
+  auto
+  operator()(const TInput & input, const TOtherInputs &... otherInputs) const
+  {
+    return this->Apply<0>(input, otherInputs...);
+  }
+
+private:
+  static constexpr size_t NumberOfFunctors = 1 + sizeof...(TFunctors);
+
+  template <size_t VStage, typename TValue, typename... TOtherInputs>
+  auto
+  Apply(const TValue & value, const TOtherInputs &... otherInputs) const
+  {
+    const auto & functor = std::get<VStage>(m_Functors);
+    if constexpr (VStage + 1 == NumberOfFunctors)
+    {
+      return Call(functor, value, otherInputs...);
+    }
+    else
+    {
+      return this->Apply<VStage + 1>(Call(functor, value, otherInputs...), otherInputs...);
+    }
+  }
+
+  template <typename TFunctor, typename TValue, typename... TOtherInputs>
+  static auto
+  Call(const TFunctor & functor, const TValue & value, const TOtherInputs &... otherInputs)
+  {
+    if constexpr (sizeof...(TOtherInputs) > 0 && std::is_invocable_v<const TFunctor &, TValue, TOtherInputs...>)
+    {
+      return functor(value, otherInputs...);
+    }
+    else
+    {
+      return functor(value);
+    }
+  }
+
+  std::tuple<TFirstFunctor, TFunctors...> m_Functors{};
+};
+
+/** Composes pixel-wise functors, the first one being applied first.
+ * \sa Composition */
+template <typename TFirstFunctor, typename... TFunctors>
+Composition<TFirstFunctor, TFunctors...>
+MakeComposition(const TFirstFunctor & firstFunctor, const TFunctors &... functors)
+{
+  return Composition<TFirstFunctor, TFunctors...>(firstFunctor, functors...);
+}
+} // namespace Functor
+} // namespace itk
+
+#endif
@@ -252,6 +252,22 @@ protected:
   }
 
 private:
+  /** Number of lines filtered together by FilterBlocksOfLines(). */
+  static constexpr unsigned int NumberOfLinesPerBlock = 16;
+
+  /** Filters the lines of a region by blocks of adjacent lines, which are
+   * transposed into tiles where the pixels of the lines are interleaved.
+   * The recursion then runs over the lines of a block at once, and the
+   * buffers are read and written by contiguous runs of pixels even when
+   * consecutive pixels along the direction are far apart in memory. Used
+   * for images of scalars with more than one dimension. */
+  void
+  FilterBlocksOfLines(const OutputImageRegionType & region);
+
+  /** Same as FilterDataArray, for the interleaved lines of a tile. */
+  void
+  FilterDataBlock(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
+
   /** Direction in which the filter is to be applied
    * this should be in the range [0,ImageDimension-1]. */
   unsigned int m_Direction{ 0 };
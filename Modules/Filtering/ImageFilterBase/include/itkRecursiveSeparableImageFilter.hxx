@@ -19,9 +19,13 @@
 #define itkRecursiveSeparableImageFilter_hxx
 
 #include "itkObjectFactory.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageLinearIteratorWithIndex.h"
+#include "itkIndexRange.h"
 #include "itkMakeUniqueForOverwrite.h"
 
+#include <algorithm>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage>
@@ -165,6 +169,122 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataArray(RealTy
   }
 }
 
+/**
+ * Apply Recursive Filter to interleaved lines
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataBlock(RealType * const       outs,
+                                                                          const RealType * const data,
+                                                                          RealType * const       scratch,
+                                                                          const SizeValueType    ln) const
+{
+  constexpr unsigned int L = NumberOfLinesPerBlock;
+
+  // local copies of the coefficients, which the compiler cannot otherwise
+  // keep in registers while writing to the tiles
+  const ScalarRealType n0 = m_N0;
+  const ScalarRealType n1 = m_N1;
+  const ScalarRealType n2 = m_N2;
+  const ScalarRealType n3 = m_N3;
+  const ScalarRealType d1 = m_D1;
+  const ScalarRealType d2 = m_D2;
+  const ScalarRealType d3 = m_D3;
+  const ScalarRealType d4 = m_D4;
+  const ScalarRealType m1 = m_M1;
+  const ScalarRealType m2 = m_M2;
+  const ScalarRealType m3 = m_M3;
+  const ScalarRealType m4 = m_M4;
+
+  /**
+   * Causal direction pass, with the borders initialized line by line
+   */
+  for (unsigned int k = 0; k < L; ++k)
+  {
+    const RealType * const d = data + k;
+    RealType * const       o = outs + k;
+    const RealType         outV1 = d[0];
+
+    MathEMAMAMAM(o[0], outV1, n0, outV1, n1, outV1, n2, outV1, n3);
+    MathEMAMAMAM(o[L], d[L], n0, outV1, n1, outV1, n2, outV1, n3);
+    MathEMAMAMAM(o[2 * L], d[2 * L], n0, d[L], n1, outV1, n2, outV1, n3);
+    MathEMAMAMAM(o[3 * L], d[3 * L], n0, d[2 * L], n1, d[L], n2, outV1, n3);
+
+    MathSMAMAMAM(o[0], outV1, m_BN1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(o[L], o[0], d1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(o[2 * L], o[L], d1, o[0], d2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(o[3 * L], o[2 * L], d1, o[L], d2, o[0], d3, outV1, m_BN4);
+  }
+
+  for (SizeValueType i = 4; i < ln; ++i)
+  {
+    const RealType * const data0 = data + i * L;
+    const RealType * const data1 = data0 - L;
+    const RealType * const data2 = data1 - L;
+    const RealType * const data3 = data2 - L;
+    RealType * const       out0 = outs + i * L;
+    const RealType * const out1 = out0 - L;
+    const RealType * const out2 = out1 - L;
+    const RealType * const out3 = out2 - L;
+    const RealType * const out4 = out3 - L;
+    for (unsigned int k = 0; k < L; ++k)
+    {
+      MathEMAMAMAM(out0[k], data0[k], n0, data1[k], n1, data2[k], n2, data3[k], n3);
+      MathSMAMAMAM(out0[k], out1[k], d1, out2[k], d2, out3[k], d3, out4[k], d4);
+    }
+  }
+
+  /**
+   * AntiCausal direction pass, with the borders initialized line by line
+   */
+  const SizeValueType last1 = (ln - 1) * L;
+  const SizeValueType last2 = (ln - 2) * L;
+  const SizeValueType last3 = (ln - 3) * L;
+  const SizeValueType last4 = (ln - 4) * L;
+  for (unsigned int k = 0; k < L; ++k)
+  {
+    const RealType * const d = data + k;
+    RealType * const       o = scratch + k;
+    const RealType         outV2 = d[last1];
+
+    MathEMAMAMAM(o[last1], outV2, m1, outV2, m2, outV2, m3, outV2, m4);
+    MathEMAMAMAM(o[last2], d[last1], m1, outV2, m2, outV2, m3, outV2, m4);
+    MathEMAMAMAM(o[last3], d[last2], m1, d[last1], m2, outV2, m3, outV2, m4);
+    MathEMAMAMAM(o[last4], d[last3], m1, d[last2], m2, d[last1], m3, outV2, m4);
+
+    MathSMAMAMAM(o[last1], outV2, m_BM1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(o[last2], o[last1], d1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(o[last3], o[last2], d1, o[last1], d2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(o[last4], o[last3], d1, o[last2], d2, o[last1], d3, outV2, m_BM4);
+  }
+
+  for (SizeValueType i = ln - 4; i > 0; --i)
+  {
+    const RealType * const data0 = data + i * L;
+    const RealType * const data1 = data0 + L;
+    const RealType * const data2 = data1 + L;
+    const RealType * const data3 = data2 + L;
+    RealType * const       out0 = scratch + (i - 1) * L;
+    const RealType * const out1 = out0 + L;
+    const RealType * const out2 = out1 + L;
+    const RealType * const out3 = out2 + L;
+    const RealType * const out4 = out3 + L;
+    for (unsigned int k = 0; k < L; ++k)
+    {
+      MathEMAMAMAM(out0[k], data0[k], m1, data1[k], m2, data2[k], m3, data3[k], m4);
+      MathSMAMAMAM(out0[k], out1[k], d1, out2[k], d2, out3[k], d3, out4[k], d4);
+    }
+  }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  for (SizeValueType i = 0; i < ln * L; ++i)
+  {
+    outs[i] += scratch[i];
+  }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -263,6 +383,17 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
 {
   using OutputPixelType = typename TOutputImage::PixelType;
 
+  if constexpr (std::is_arithmetic_v<InputPixelType> && std::is_arithmetic_v<OutputPixelType> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TInputImage> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TOutputImage>)
+  {
+    if (TOutputImage::ImageDimension > 1)
+    {
+      this->FilterBlocksOfLines(outputRegionForThread);
+      return;
+    }
+  }
+
   using InputConstIteratorType = ImageLinearConstIteratorWithIndex<TInputImage>;
   using OutputIteratorType = ImageLinearIteratorWithIndex<TOutputImage>;
 
@@ -311,6 +442,98 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterBlocksOfLines(const OutputImageRegionType & region)
+{
+  using OutputPixelType = typename TOutputImage::PixelType;
+  constexpr unsigned int L = NumberOfLinesPerBlock;
+
+  const TInputImage * const inputImage = this->GetInputImage();
+  TOutputImage * const      outputImage = this->GetOutput();
+
+  // the lines of a block are adjacent along the first axis, or along the
+  // second one when filtering along the first axis
+  const unsigned int  direction = this->m_Direction;
+  const unsigned int  blockAxis = direction == 0 ? 1 : 0;
+  const SizeValueType ln = region.GetSize(direction);
+  const SizeValueType numberOfBlockLines = region.GetSize(blockAxis);
+
+  const OffsetValueType inputStride = inputImage->GetOffsetTable()[direction];
+  const OffsetValueType outputStride = outputImage->GetOffsetTable()[direction];
+  const OffsetValueType inputLineStride = inputImage->GetOffsetTable()[blockAxis];
+  const OffsetValueType outputLineStride = outputImage->GetOffsetTable()[blockAxis];
+
+  // the lanes of a partial block which are not read keep finite values
+  const auto inps = std::make_unique<RealType[]>(ln * L);
+  const auto outs = make_unique_for_overwrite<RealType[]>(ln * L);
+  const auto scratch = make_unique_for_overwrite<RealType[]>(ln * L);
+
+  // the first pixel of each row of blocks
+  OutputImageRegionType rowStarts = region;
+  rowStarts.SetSize(direction, 1);
+  rowStarts.SetSize(blockAxis, 1);
+
+  for (const auto & rowStart : ImageRegionIndexRange<TOutputImage::ImageDimension>(rowStarts))
+  {
+    const InputPixelType * const inputRow = inputImage->GetBufferPointer() + inputImage->ComputeOffset(rowStart);
+    OutputPixelType * const      outputRow = outputImage->GetBufferPointer() + outputImage->ComputeOffset(rowStart);
+
+    for (SizeValueType first = 0; first < numberOfBlockLines; first += L)
+    {
+      const SizeValueType numberOfLines = std::min<SizeValueType>(L, numberOfBlockLines - first);
+
+      // transpose the lines into the tile, in the order of the buffer
+      const InputPixelType * const in = inputRow + static_cast<OffsetValueType>(first) * inputLineStride;
+      if (direction == 0)
+      {
+        for (SizeValueType k = 0; k < numberOfLines; ++k)
+        {
+          const InputPixelType * const line = in + static_cast<OffsetValueType>(k) * inputLineStride;
+          for (SizeValueType i = 0; i < ln; ++i)
+          {
+            inps[i * L + k] = line[i];
+          }
+        }
+      }
+      else
+      {
+        for (SizeValueType i = 0; i < ln; ++i)
+        {
+          std::copy_n(in + static_cast<OffsetValueType>(i) * inputStride, numberOfLines, inps.get() + i * L);
+        }
+      }
+
+      this->FilterDataBlock(outs.get(), inps.get(), scratch.get(), ln);
+
+      OutputPixelType * const out = outputRow + static_cast<OffsetValueType>(first) * outputLineStride;
+      if (direction == 0)
+      {
+        for (SizeValueType k = 0; k < numberOfLines; ++k)
+        {
+          OutputPixelType * const line = out + static_cast<OffsetValueType>(k) * outputLineStride;
+          for (SizeValueType i = 0; i < ln; ++i)
+          {
+            line[i] = static_cast<OutputPixelType>(outs[i * L + k]);
+          }
+        }
+      }
+      else
+      {
+        for (SizeValueType i = 0; i < ln; ++i)
+        {
+          OutputPixelType * const position = out + static_cast<OffsetValueType>(i) * outputStride;
+          const RealType * const  tileRow = outs.get() + i * L;
+          for (SizeValueType k = 0; k < numberOfLines; ++k)
+          {
+            position[k] = static_cast<OutputPixelType>(tileRow[k]);
+          }
+        }
+      }
+    }
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 RecursiveSeparableImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
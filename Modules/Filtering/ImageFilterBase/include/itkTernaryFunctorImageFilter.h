@@ -30,6 +30,12 @@ namespace itk
  * and the type of the output image.  It is also parameterized by the
  * operation to be applied, using a Functor style.
  *
+ * When the images have the same dimension and store their pixels directly in
+ * their buffers, as Image does, the functor is applied over chunks of
+ * contiguous pixels through pointers. Each work unit then calls its own copy
+ * of a functor whose operator() is const, while a functor which can only be
+ * called as non-const is shared by all the work units.
+ *
  * \sa BinaryFunctorImageFilter UnaryFunctorImageFilter
  *
  * \ingroup IntensityImageFilters MultiThreaded
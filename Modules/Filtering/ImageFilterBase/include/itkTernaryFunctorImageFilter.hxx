@@ -18,8 +18,10 @@
 #ifndef itkTernaryFunctorImageFilter_hxx
 #define itkTernaryFunctorImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
+#include <type_traits>
 
 namespace itk
 {
@@ -130,6 +132,46 @@ TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if constexpr (ImageAlgorithm::SupportsDirectPixelAccess<TInputImage1> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TInputImage2> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TInputImage3> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TOutputImage>)
+  {
+    if (inputPtr1 && inputPtr2 && inputPtr3)
+    {
+      // A local copy of the functor, which the output pixels cannot alias.
+      // A functor which can only be called as non-const is shared by the
+      // work units instead, as in the loop over the iterators.
+      using LocalFunctorType = std::conditional_t<std::is_invocable_v<const FunctorType &,
+                                                                      const Input1ImagePixelType &,
+                                                                      const Input2ImagePixelType &,
+                                                                      const Input3ImagePixelType &>,
+                                                  const FunctorType,
+                                                  FunctorType &>;
+      LocalFunctorType localFunctor = m_Functor;
+      ImageAlgorithm::ForEachContiguousChunk(
+        outputRegionForThread,
+        [&inputPtr1, &inputPtr2, &inputPtr3, &outputPtr, &localFunctor, &progress](
+          const typename OutputImageRegionType::IndexType & index,
+          SizeValueType                                     numberOfPixels) {
+          const Input1ImagePixelType * in1 = inputPtr1->GetBufferPointer() + inputPtr1->ComputeOffset(index);
+          const Input2ImagePixelType * in2 = inputPtr2->GetBufferPointer() + inputPtr2->ComputeOffset(index);
+          const Input3ImagePixelType * in3 = inputPtr3->GetBufferPointer() + inputPtr3->ComputeOffset(index);
+          OutputImagePixelType *       out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+          for (SizeValueType i = 0; i < numberOfPixels; ++i)
+          {
+            out[i] = localFunctor(in1[i], in2[i], in3[i]);
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr1.GetPointer(),
+        inputPtr2.GetPointer(),
+        inputPtr3.GetPointer(),
+        outputPtr.GetPointer());
+      return;
+    }
+  }
+
   ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
   ImageScanlineConstIterator inputIt2(inputPtr2, outputRegionForThread);
   ImageScanlineConstIterator inputIt3(inputPtr3, outputRegionForThread);
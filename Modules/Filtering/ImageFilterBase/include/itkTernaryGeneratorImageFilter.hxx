@@ -18,6 +18,7 @@
 #ifndef itkTernaryGeneratorImageFilter_hxx
 #define itkTernaryGeneratorImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
 
@@ -254,6 +255,38 @@ TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputIma
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if constexpr (ImageAlgorithm::SupportsDirectPixelAccess<TInputImage1> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TInputImage2> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TInputImage3> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TOutputImage>)
+  {
+    if (inputPtr1 && inputPtr2 && inputPtr3)
+    {
+      // A local copy of the functor, which the output pixels cannot alias
+      const TFunctor localFunctor = functor;
+      ImageAlgorithm::ForEachContiguousChunk(
+        outputRegionForThread,
+        [inputPtr1, inputPtr2, inputPtr3, &outputPtr, &localFunctor, &progress](
+          const typename OutputImageRegionType::IndexType & index,
+          SizeValueType                                     numberOfPixels) {
+          const Input1ImagePixelType * in1 = inputPtr1->GetBufferPointer() + inputPtr1->ComputeOffset(index);
+          const Input2ImagePixelType * in2 = inputPtr2->GetBufferPointer() + inputPtr2->ComputeOffset(index);
+          const Input3ImagePixelType * in3 = inputPtr3->GetBufferPointer() + inputPtr3->ComputeOffset(index);
+          OutputImagePixelType *       out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+          for (SizeValueType i = 0; i < numberOfPixels; ++i)
+          {
+            out[i] = localFunctor(in1[i], in2[i], in3[i]);
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr1,
+        inputPtr2,
+        inputPtr3,
+        outputPtr.GetPointer());
+      return;
+    }
+  }
+
   std::unique_ptr<ImageScanlineConstIterator<TInputImage1>> inputIt1;
   std::unique_ptr<ImageScanlineConstIterator<TInputImage2>> inputIt2;
   std::unique_ptr<ImageScanlineConstIterator<TInputImage3>> inputIt3;
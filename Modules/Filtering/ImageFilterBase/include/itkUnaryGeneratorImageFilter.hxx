@@ -18,6 +18,7 @@
 #ifndef itkUnaryGeneratorImageFilter_hxx
 #define itkUnaryGeneratorImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 #include "itkTotalProgressReporter.h"
@@ -93,6 +94,32 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
 
   this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
 
+  if constexpr (TInputImage::ImageDimension == TOutputImage::ImageDimension &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TInputImage> &&
+                ImageAlgorithm::SupportsDirectPixelAccess<TOutputImage>)
+  {
+    if (inputRegionForThread == outputRegionForThread)
+    {
+      // A local copy of the functor, which the output pixels cannot alias
+      const TFunctor localFunctor = functor;
+      ImageAlgorithm::ForEachContiguousChunk(
+        outputRegionForThread,
+        [inputPtr, outputPtr, &localFunctor, &progress](const typename OutputImageRegionType::IndexType & index,
+                                                        SizeValueType numberOfPixels) {
+          const InputImagePixelType * in = inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(index);
+          OutputImagePixelType *      out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+          for (SizeValueType i = 0; i < numberOfPixels; ++i)
+          {
+            out[i] = localFunctor(in[i]);
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr,
+        outputPtr);
+      return;
+    }
+  }
+
   // Define the iterators
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
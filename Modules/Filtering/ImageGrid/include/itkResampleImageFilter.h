@@ -69,6 +69,14 @@ namespace itk
  * ProcessObject::GenerateInputRequestedRegion() and
  * ProcessObject::GenerateOutputInformation().
  *
+ * When the transform is linear, the filter maps each output scan line to a
+ * line of the input. If the input is an Image of scalar pixels and the
+ * interpolator is a LinearInterpolateImageFunction (up to dimension 3) or a
+ * NearestNeighborInterpolateImageFunction, the pixels of the line which fall
+ * inside the input buffer are interpolated inline from the buffer, with the
+ * same results as the interpolator. Other interpolators, including
+ * subclasses of these two, are evaluated through their virtual interface.
+ *
  * This filter is implemented as a multithreaded filter.  It provides a
  * DynamicThreadedGenerateData() method for its implementation.
  * \warning For multithreading, the TransformPoint method of the
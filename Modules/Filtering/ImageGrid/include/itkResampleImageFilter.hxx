@@ -26,9 +26,13 @@
 #include "itkSpecialCoordinatesImage.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkImageAlgorithm.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 
 #include <algorithm>   // For max.
+#include <cmath>
 #include <type_traits> // For is_same.
+#include <typeinfo>
+#include <vector>
 
 namespace itk
 {
@@ -383,44 +387,58 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 
 
   // Create an iterator that will walk the output region for this thread.
-  using OutputIterator = ImageRegionIteratorWithIndex<TOutputImage>;
+  using OutputIterator = ImageScanlineIterator<TOutputImage>;
 
   using OutputType = typename InterpolatorType::OutputType;
 
-  // Walk the output region
-  for (OutputIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); ++outIt)
-  {
-    // Determine the index of the current output pixel
-
-    OutputPointType outputPoint; // Coordinates of current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
-
-    // Compute corresponding input pixel position
-    const InputPointType inputPoint = transformPtr->TransformPoint(outputPoint);
+  // The points of a line of the output region are transformed together
+  const SizeValueType                                  lineLength = outputRegionForThread.GetSize(0);
+  std::vector<typename TransformType::InputPointType>  outputPoints(lineLength);
+  std::vector<typename TransformType::OutputPointType> inputPoints(lineLength);
 
-    ContinuousInputIndexType inputIndex;
-    const bool               isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+  using OutputCoordinateType = typename OutputPointType::ValueType;
 
-    OutputType value;
-    // Evaluate input at right position and copy to the output
-    if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
+  // Walk the output region
+  for (OutputIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
+  {
+    // Determine the coordinates of the output pixels of the line
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType i = 0; i < lineLength; ++i, ++index[0])
     {
-      value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-      outIt.Set(Self::CastPixelWithBoundsChecking(value));
+      outputPoints[i] = outputPtr->template TransformIndexToPhysicalPoint<OutputCoordinateType>(index);
     }
-    else
+
+    // Compute corresponding input pixel positions
+    transformPtr->TransformPoints(outputPoints.data(), inputPoints.data(), lineLength);
+
+    for (SizeValueType i = 0; i < lineLength; ++i, ++outIt)
     {
-      if (m_Extrapolator.IsNull())
+      const InputPointType     inputPoint = inputPoints[i];
+      ContinuousInputIndexType inputIndex;
+      const bool               isInsideInput =
+        inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+
+      OutputType value;
+      // Evaluate input at right position and copy to the output
+      if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
       {
-        outIt.Set(m_DefaultPixelValue); // default background value
+        value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
+        outIt.Set(Self::CastPixelWithBoundsChecking(value));
       }
       else
       {
-        value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
-        outIt.Set(Self::CastPixelWithBoundsChecking(value));
+        if (m_Extrapolator.IsNull())
+        {
+          outIt.Set(m_DefaultPixelValue); // default background value
+        }
+        else
+        {
+          value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
+          outIt.Set(Self::CastPixelWithBoundsChecking(value));
+        }
       }
     }
-    progress.CompletedPixel();
+    progress.Completed(lineLength);
   }
 }
 
@@ -464,6 +482,33 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
   };
 
+  // The linear and the nearest neighbor interpolators of scalar images are
+  // evaluated inline from the input buffer, over the span of each scan line
+  // which maps inside the buffer. This avoids a virtual call and a bounds
+  // check per pixel, and gives the same values as the interpolators.
+  enum class InlineInterpolation : uint8_t
+  {
+    None,
+    Linear,
+    NearestNeighbor
+  };
+  constexpr bool canInterpolateInline =
+    std::is_same_v<InputImageType, Image<InputPixelType, InputImageDimension>> && std::is_arithmetic_v<InputPixelType>;
+  [[maybe_unused]] InlineInterpolation inlineInterpolation = InlineInterpolation::None;
+  if constexpr (canInterpolateInline)
+  {
+    const std::type_info & interpolatorType = typeid(*m_Interpolator);
+    if (interpolatorType == typeid(LinearInterpolatorType) && InputImageDimension <= 3)
+    {
+      inlineInterpolation = InlineInterpolation::Linear;
+    }
+    else if (interpolatorType ==
+             typeid(NearestNeighborInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>))
+    {
+      inlineInterpolation = InlineInterpolation::NearestNeighbor;
+    }
+  }
+
   // Create an iterator that will walk the output region for this thread.
   for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
@@ -477,42 +522,177 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
     index[0] += firstSizeValueOfLargestPossibleRegion;
     const auto vectorFromStartIndex = transformIndex(index) - startIndex;
 
-    IndexValueType scanlineIndex = outIt.GetIndex()[0];
-
-
-    while (!outIt.IsAtEndOfLine())
-    {
+    IndexValueType       scanlineIndex = outIt.GetIndex()[0];
+    const IndexValueType scanlineEnd = scanlineIndex + static_cast<IndexValueType>(outputRegionForThread.GetSize(0));
 
+    const auto inputIndexAt = [&](const IndexValueType scanlineIndexValue) {
       // Perform linear interpolation from startIndex, along vectorFromStartIndex
       const double alpha =
-        (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
+        (scanlineIndexValue - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
 
       ContinuousInputIndexType inputIndex(startIndex);
       for (unsigned int i = 0; i < InputImageDimension; ++i)
       {
         inputIndex[i] += alpha * vectorFromStartIndex[i];
       }
+      return inputIndex;
+    };
 
-      // Evaluate input at right position and copy to the output
-      if (m_Interpolator->IsInsideBuffer(inputIndex))
+    const auto resampleUpTo = [&](const IndexValueType end) {
+      for (; scanlineIndex < end; ++scanlineIndex, ++outIt)
       {
-        outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+        const ContinuousInputIndexType inputIndex = inputIndexAt(scanlineIndex);
+
+        // Evaluate input at right position and copy to the output
+        if (m_Interpolator->IsInsideBuffer(inputIndex))
+        {
+          outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+        }
+        else
+        {
+          if (m_Extrapolator.IsNull())
+          {
+            outIt.Set(defaultValue); // default background value
+          }
+          else
+          {
+            outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
+          }
+        }
       }
-      else
+    };
+
+    if constexpr (canInterpolateInline)
+    {
+      if (inlineInterpolation != InlineInterpolation::None)
       {
-        if (m_Extrapolator.IsNull())
+        // The continuous index is monotonic along the scan line, so the pixels
+        // inside the buffer form a span. Estimate it from the intersection of
+        // the line with the buffer, then shrink it until its end pixels pass
+        // the test of the interpolator, so that all of its pixels do.
+        const auto & startContinuousIndex = m_Interpolator->GetStartContinuousIndex();
+        const auto & endContinuousIndex = m_Interpolator->GetEndContinuousIndex();
+        double       alphaBegin = -NumericTraits<double>::max();
+        double alphaEnd = NumericTraits<double>::max();
+        for (unsigned int i = 0; i < InputImageDimension; ++i)
+        {
+          if (vectorFromStartIndex[i] != 0.0)
+          {
+            double alpha0 = (startContinuousIndex[i] - startIndex[i]) / vectorFromStartIndex[i];
+            double alpha1 = (endContinuousIndex[i] - startIndex[i]) / vectorFromStartIndex[i];
+            if (alpha0 > alpha1)
+            {
+              std::swap(alpha0, alpha1);
+            }
+            alphaBegin = std::max(alphaBegin, alpha0);
+            alphaEnd = std::min(alphaEnd, alpha1);
+          }
+          else if (!(startIndex[i] >= startContinuousIndex[i] && startIndex[i] < endContinuousIndex[i]))
+          {
+            alphaEnd = alphaBegin;
+          }
+        }
+        const auto toScanlineIndex = [&](const double alpha) {
+          return firstIndexValueOfLargestPossibleRegion + alpha * firstSizeValueOfLargestPossibleRegion;
+        };
+        const auto clampToScanline = [&](const double value) {
+          return static_cast<IndexValueType>(
+            std::clamp(value, static_cast<double>(scanlineIndex), static_cast<double>(scanlineEnd)));
+        };
+        IndexValueType spanBegin = clampToScanline(std::ceil(toScanlineIndex(alphaBegin)));
+        IndexValueType spanEnd =
+          alphaBegin < alphaEnd ? clampToScanline(std::floor(toScanlineIndex(alphaEnd)) + 1.0) : spanBegin;
+        while (spanBegin < spanEnd && !m_Interpolator->IsInsideBuffer(inputIndexAt(spanBegin)))
         {
-          outIt.Set(defaultValue); // default background value
+          ++spanBegin;
+        }
+        while (spanEnd > spanBegin && !m_Interpolator->IsInsideBuffer(inputIndexAt(spanEnd - 1)))
+        {
+          --spanEnd;
+        }
+
+        resampleUpTo(spanBegin);
+
+        using RealType = typename NumericTraits<InputPixelType>::RealType;
+        const InputPixelType * const buffer = inputPtr->GetBufferPointer();
+        const auto &                 bufferedIndex = inputPtr->GetBufferedRegion().GetIndex();
+        const OffsetValueType *      offsetTable = inputPtr->GetOffsetTable();
+        const auto                   interpolatorStartIndex = m_Interpolator->GetStartIndex();
+        const auto                   interpolatorEndIndex = m_Interpolator->GetEndIndex();
+
+        if (inlineInterpolation == InlineInterpolation::Linear)
+        {
+          // The corners of the neighborhood, bit i of a corner selecting the
+          // upper neighbor along dimension i. The corners are blended along
+          // the first dimension, then the second one and so on, skipping the
+          // dimensions of zero distance or without upper neighbor, as done
+          // by LinearInterpolateImageFunction.
+          constexpr unsigned int numberOfCorners = 1u << std::min(InputImageDimension, 3u);
+          for (; scanlineIndex < spanEnd; ++scanlineIndex, ++outIt)
+          {
+            const ContinuousInputIndexType inputIndex = inputIndexAt(scanlineIndex);
+
+            OffsetValueType            offset = 0;
+            TInterpolatorPrecisionType distances[InputImageDimension];
+            unsigned int               skippedDimensions = 0;
+            for (unsigned int i = 0; i < InputImageDimension; ++i)
+            {
+              const IndexValueType base =
+                std::max(Math::Floor<IndexValueType>(inputIndex[i]), interpolatorStartIndex[i]);
+              distances[i] = inputIndex[i] - static_cast<TInterpolatorPrecisionType>(base);
+              if (!(distances[i] > 0.0) || base >= interpolatorEndIndex[i])
+              {
+                skippedDimensions |= 1u << i;
+              }
+              offset += (base - bufferedIndex[i]) * offsetTable[i];
+            }
+
+            RealType values[numberOfCorners];
+            for (unsigned int corner = 0; corner < numberOfCorners; ++corner)
+            {
+              if ((corner & skippedDimensions) == 0)
+              {
+                OffsetValueType cornerOffset = offset;
+                for (unsigned int i = 0; i < InputImageDimension; ++i)
+                {
+                  if (corner & (1u << i))
+                  {
+                    cornerOffset += offsetTable[i];
+                  }
+                }
+                values[corner] = buffer[cornerOffset];
+              }
+            }
+            for (unsigned int i = 0; i < InputImageDimension; ++i)
+            {
+              const bool blended = (skippedDimensions & (1u << i)) == 0;
+              for (unsigned int corner = 0; corner < (numberOfCorners >> (i + 1)); ++corner)
+              {
+                const RealType lower = values[2 * corner];
+                values[corner] = blended ? lower + (values[2 * corner + 1] - lower) * distances[i] : lower;
+              }
+            }
+            outIt.Set(Self::CastPixelWithBoundsChecking(static_cast<InterpolatorOutputType>(values[0])));
+          }
         }
         else
         {
-          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
+          for (; scanlineIndex < spanEnd; ++scanlineIndex, ++outIt)
+          {
+            const ContinuousInputIndexType inputIndex = inputIndexAt(scanlineIndex);
+
+            OffsetValueType offset = 0;
+            for (unsigned int i = 0; i < InputImageDimension; ++i)
+            {
+              offset += (Math::Round<IndexValueType>(inputIndex[i]) - bufferedIndex[i]) * offsetTable[i];
+            }
+            outIt.Set(Self::CastPixelWithBoundsChecking(static_cast<InterpolatorOutputType>(buffer[offset])));
+          }
         }
       }
-
-      ++outIt;
-      ++scanlineIndex;
     }
+
+    resampleUpTo(scanlineEnd);
     progress.Completed(outputRegionForThread.GetSize()[0]);
   }
 }
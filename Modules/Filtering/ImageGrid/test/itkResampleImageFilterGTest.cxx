@@ -20,6 +20,10 @@
 #include "itkResampleImageFilter.h"
 
 #include "itkImage.h"
+#include "itkAffineTransform.h"
+#include "itkImageBufferRange.h"
+#include "itkNearestNeighborExtrapolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 
 // Google Test header file:
 #include <gtest/gtest.h>
@@ -111,6 +115,97 @@ Expect_ResampleImageFilter_thows_on_incomplete_configuration(const TPixel inputP
   EXPECT_EQ(TestThrowErrorOnEmptyResampleSpace(inputPixel, true), inputPixel);
 }
 
+
+// An interpolator which the filter does not evaluate inline, unlike its
+// superclass, so that it is evaluated through its virtual interface.
+template <typename TInterpolator>
+class NonInlineInterpolator : public TInterpolator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(NonInlineInterpolator);
+
+  using Self = NonInlineInterpolator;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+protected:
+  NonInlineInterpolator() = default;
+  ~NonInlineInterpolator() override = default;
+};
+
+
+// Expects that the resampling of an image through an affine transform is the
+// same with the interpolator evaluated inline and through its virtual interface.
+template <typename TImage, template <typename, typename> class TInterpolator>
+void
+Expect_ResampleImageFilter_inline_interpolation_is_the_same(const bool useExtrapolator)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+  using FilterType = itk::ResampleImageFilter<TImage, TImage>;
+  using InterpolatorType = TInterpolator<TImage, double>;
+
+  // A random image, whose buffer does not start at the zero index.
+  const auto                   image = TImage::New();
+  typename TImage::RegionType  region;
+  typename TImage::SpacingType spacing;
+  for (unsigned int i = 0; i < Dimension; ++i)
+  {
+    region.SetIndex(i, 3 - static_cast<itk::IndexValueType>(i));
+    region.SetSize(i, 17 + 4 * i);
+    spacing[i] = 0.8 + 0.3 * i;
+  }
+  image->SetRegions(region);
+  image->SetSpacing(spacing);
+  image->Allocate();
+  std::default_random_engine randomEngine;
+  for (auto & pixel : itk::MakeImageBufferRange(image.GetPointer()))
+  {
+    pixel = static_cast<typename TImage::PixelType>(std::uniform_real_distribution<>{ -100.0, 100.0 }(randomEngine));
+  }
+
+  // A rotation, scaling and translation, which maps part of the output
+  // outside of the input, with scan lines along and across the input rows.
+  for (const double angle : { 0.0, 0.35, 1.5707963267948966, 2.9 })
+  {
+    const auto transform = itk::AffineTransform<double, Dimension>::New();
+    transform->Rotate(0, 1, angle);
+    transform->Scale(1.1);
+    typename itk::AffineTransform<double, Dimension>::OutputVectorType translation;
+    translation.Fill(-2.5);
+    transform->Translate(translation);
+
+    const auto resample = [&](typename InterpolatorType::Pointer interpolator) {
+      const auto filter = FilterType::New();
+      filter->SetInput(image);
+      filter->SetTransform(transform);
+      filter->SetInterpolator(interpolator);
+      if (useExtrapolator)
+      {
+        filter->SetExtrapolator(itk::NearestNeighborExtrapolateImageFunction<TImage, double>::New());
+      }
+      filter->SetDefaultPixelValue(static_cast<typename TImage::PixelType>(-7));
+      filter->SetSize(TImage::SizeType::Filled(31));
+      typename TImage::PointType origin;
+      origin.Fill(-6.0);
+      filter->SetOutputOrigin(origin);
+      filter->SetOutputSpacing(typename TImage::SpacingType(0.9));
+      filter->Update();
+      return typename TImage::Pointer(filter->GetOutput());
+    };
+
+    const auto inlineOutput = resample(InterpolatorType::New());
+    const auto virtualOutput = resample(NonInlineInterpolator<InterpolatorType>::New().GetPointer());
+    const auto inlinePixels = itk::MakeImageBufferRange(inlineOutput.GetPointer());
+    const auto virtualPixels = itk::MakeImageBufferRange(virtualOutput.GetPointer());
+    ASSERT_EQ(inlinePixels.size(), virtualPixels.size());
+    for (size_t i = 0; i < inlinePixels.size(); ++i)
+    {
+      EXPECT_NEAR(inlinePixels[i], virtualPixels[i], 1e-9) << "angle " << angle << ", pixel " << i;
+    }
+  }
+}
+
 } // namespace
 
 // Compile time check of mixing transform and precision types
@@ -172,3 +267,18 @@ TEST(ResampleImageFilter, Expect_ResampleImageFilter_thows_on_incomplete_configu
 {
   Expect_ResampleImageFilter_thows_on_incomplete_configuration(128.0);
 }
+
+
+TEST(ResampleImageFilter, InlineInterpolationIsTheSameAsTheInterpolator)
+{
+  Expect_ResampleImageFilter_inline_interpolation_is_the_same<itk::Image<float, 2>,
+                                                              itk::LinearInterpolateImageFunction>(false);
+  Expect_ResampleImageFilter_inline_interpolation_is_the_same<itk::Image<double, 3>,
+                                                              itk::LinearInterpolateImageFunction>(true);
+  Expect_ResampleImageFilter_inline_interpolation_is_the_same<itk::Image<short, 3>,
+                                                              itk::LinearInterpolateImageFunction>(false);
+  Expect_ResampleImageFilter_inline_interpolation_is_the_same<itk::Image<float, 2>,
+                                                              itk::NearestNeighborInterpolateImageFunction>(true);
+  Expect_ResampleImageFilter_inline_interpolation_is_the_same<itk::Image<unsigned char, 3>,
+                                                              itk::NearestNeighborInterpolateImageFunction>(false);
+}
@@ -0,0 +1,458 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFusedFunctorImageFilter_h
+#define itkFusedFunctorImageFilter_h
+
+#include "itkInPlaceImageFilter.h"
+#include "itkImageAlgorithm.h"
+#include "itkCastImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkIntensityWindowingImageFilter.h"
+#include "itkMaskImageFilter.h"
+#include "itkMaskNegatedImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkSigmoidImageFilter.h"
+
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace itk
+{
+namespace FusedFunctorImageFilterDetail
+{
+/** \class Stage
+ * \brief The operation of a filter, as a stage of a FusedFunctorImageFilter.
+ *
+ * A stage takes the parameters of its filter when it is constructed, and
+ * computes the output pixel of the filter from its input pixel. A stage
+ * which also reads the pixels of another image, as the mask of
+ * MaskImageFilter, returns that image from GetImages(), and reads the pixels
+ * of the chunk set by SetChunk().
+ *
+ * The stage is only defined for the filters supported by
+ * FusedFunctorImageFilter.
+ *
+ * \ingroup ITKImageIntensity
+ */
+template <typename TFilter>
+class Stage
+{
+  static_assert(sizeof(TFilter) == 0, "FusedFunctorImageFilter does not support this filter.");
+};
+
+/** \class PixelStage
+ * \brief Base of the stages which only read the pixel computed by the previous stage.
+ * \ingroup ITKImageIntensity
+ */
+class PixelStage
+{
+public:
+  static std::tuple<>
+  GetImages()
+  {
+    return {};
+  }
+
+  template <typename TIndex>
+  void
+  SetChunk(const TIndex &)
+  {}
+};
+
+/** \class FunctorStage
+ * \brief Stage of a filter which holds all its parameters in its functor.
+ * \ingroup ITKImageIntensity
+ */
+template <typename TFilter>
+class FunctorStage : public PixelStage
+{
+public:
+  using InputPixelType = typename TFilter::InputImageType::PixelType;
+  using OutputPixelType = typename TFilter::OutputImageType::PixelType;
+
+  explicit FunctorStage(const TFilter & filter)
+    : m_Functor(filter.GetFunctor())
+  {}
+
+  OutputPixelType
+  operator()(const InputPixelType & value, SizeValueType) const
+  {
+    return m_Functor(value);
+  }
+
+private:
+  typename TFilter::FunctorType m_Functor;
+};
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+class Stage<UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>>
+  : public FunctorStage<UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>>
+{
+public:
+  using FunctorStage<UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>>::FunctorStage;
+};
+
+template <typename TInputImage, typename TOutputImage>
+class Stage<ClampImageFilter<TInputImage, TOutputImage>>
+  : public FunctorStage<ClampImageFilter<TInputImage, TOutputImage>>
+{
+public:
+  using FunctorStage<ClampImageFilter<TInputImage, TOutputImage>>::FunctorStage;
+};
+
+template <typename TInputImage, typename TOutputImage>
+class Stage<SigmoidImageFilter<TInputImage, TOutputImage>>
+  : public FunctorStage<SigmoidImageFilter<TInputImage, TOutputImage>>
+{
+public:
+  using FunctorStage<SigmoidImageFilter<TInputImage, TOutputImage>>::FunctorStage;
+};
+
+/** The IntensityWindowingImageFilter computes its functor before running. */
+template <typename TInputImage, typename TOutputImage>
+class Stage<IntensityWindowingImageFilter<TInputImage, TOutputImage>> : public PixelStage
+{
+public:
+  using FilterType = IntensityWindowingImageFilter<TInputImage, TOutputImage>;
+  using InputPixelType = typename TInputImage::PixelType;
+  using OutputPixelType = typename TOutputImage::PixelType;
+  using RealType = typename FilterType::RealType;
+
+  explicit Stage(const FilterType & filter)
+  {
+    const auto scale =
+      (static_cast<RealType>(filter.GetOutputMaximum()) - static_cast<RealType>(filter.GetOutputMinimum())) /
+      (static_cast<RealType>(filter.GetWindowMaximum()) - static_cast<RealType>(filter.GetWindowMinimum()));
+    m_Functor.SetOutputMinimum(filter.GetOutputMinimum());
+    m_Functor.SetOutputMaximum(filter.GetOutputMaximum());
+    m_Functor.SetWindowMinimum(filter.GetWindowMinimum());
+    m_Functor.SetWindowMaximum(filter.GetWindowMaximum());
+    m_Functor.SetFactor(scale);
+    m_Functor.SetOffset(static_cast<RealType>(filter.GetOutputMinimum()) -
+                        static_cast<RealType>(filter.GetWindowMinimum()) * scale);
+  }
+
+  OutputPixelType
+  operator()(const InputPixelType & value, SizeValueType) const
+  {
+    return m_Functor(value);
+  }
+
+private:
+  Functor::IntensityWindowingTransform<InputPixelType, OutputPixelType> m_Functor{};
+};
+
+/** The ShiftScaleImageFilter is not a functor filter. Its stage does not
+ * count the overflows and the underflows. */
+template <typename TInputImage, typename TOutputImage>
+class Stage<ShiftScaleImageFilter<TInputImage, TOutputImage>> : public PixelStage
+{
+public:
+  using FilterType = ShiftScaleImageFilter<TInputImage, TOutputImage>;
+  using InputPixelType = typename TInputImage::PixelType;
+  using OutputPixelType = typename TOutputImage::PixelType;
+  using RealType = typename FilterType::RealType;
+
+  explicit Stage(const FilterType & filter)
+    : m_Shift(filter.GetShift())
+    , m_Scale(filter.GetScale())
+  {}
+
+  OutputPixelType
+  operator()(const InputPixelType & value, SizeValueType) const
+  {
+    const RealType result = (static_cast<RealType>(value) + m_Shift) * m_Scale;
+    if (result < NumericTraits<OutputPixelType>::NonpositiveMin())
+    {
+      return NumericTraits<OutputPixelType>::NonpositiveMin();
+    }
+    if (result > static_cast<RealType>(NumericTraits<OutputPixelType>::max()))
+    {
+      return NumericTraits<OutputPixelType>::max();
+    }
+    return static_cast<OutputPixelType>(result);
+  }
+
+private:
+  RealType m_Shift;
+  RealType m_Scale;
+};
+
+/** The CastImageFilter is not a functor filter. Its stage only supports the
+ * pixel types which can be converted with a static_cast. */
+template <typename TInputImage, typename TOutputImage>
+class Stage<CastImageFilter<TInputImage, TOutputImage>> : public PixelStage
+{
+public:
+  using FilterType = CastImageFilter<TInputImage, TOutputImage>;
+  using InputPixelType = typename TInputImage::PixelType;
+  using OutputPixelType = typename TOutputImage::PixelType;
+
+  static_assert(mpl::is_static_castable<InputPixelType, OutputPixelType>::value,
+                "FusedFunctorImageFilter only supports the casts done with a static_cast.");
+
+  explicit Stage(const FilterType &) {}
+
+  OutputPixelType
+  operator()(const InputPixelType & value, SizeValueType) const
+  {
+    return static_cast<OutputPixelType>(value);
+  }
+};
+
+/** \class MaskStage
+ * \brief Stage of MaskImageFilter and MaskNegatedImageFilter, which read the pixels of the mask image.
+ * \ingroup ITKImageIntensity
+ */
+template <typename TFilter, typename TFunctor>
+class MaskStage
+{
+public:
+  using MaskImageType = typename TFilter::MaskImageType;
+  using InputPixelType = typename TFilter::InputImageType::PixelType;
+  using OutputPixelType = typename TFilter::OutputImageType::PixelType;
+  using MaskPixelType = typename MaskImageType::PixelType;
+
+  static_assert(ImageAlgorithm::SupportsDirectPixelAccess<MaskImageType>,
+                "FusedFunctorImageFilter requires a mask image which stores its pixels directly in its buffer.");
+
+  explicit MaskStage(TFilter & filter)
+    : m_MaskImage(filter.GetMaskImage())
+  {
+    if (m_MaskImage == nullptr)
+    {
+      itkGenericExceptionMacro("The mask image of " << filter.GetNameOfClass() << " is not set.");
+    }
+    m_Functor.SetOutsideValue(filter.GetOutsideValue());
+    m_Functor.SetMaskingValue(filter.GetMaskingValue());
+  }
+
+  std::tuple<const MaskImageType *>
+  GetImages() const
+  {
+    return std::tuple<const MaskImageType *>(m_MaskImage);
+  }
+
+  template <typename TIndex>
+  void
+  SetChunk(const TIndex & index)
+  {
+    m_MaskPixels = m_MaskImage->GetBufferPointer() + m_MaskImage->ComputeOffset(index);
+  }
+
+  OutputPixelType
+  operator()(const InputPixelType & value, SizeValueType i) const
+  {
+    return m_Functor(value, m_MaskPixels[i]);
+  }
+
+private:
+  TFunctor              m_Functor{};
+  const MaskImageType * m_MaskImage;
+  const MaskPixelType * m_MaskPixels{ nullptr };
+};
+
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+class Stage<MaskImageFilter<TInputImage, TMaskImage, TOutputImage>>
+  : public MaskStage<MaskImageFilter<TInputImage, TMaskImage, TOutputImage>,
+                     typename MaskImageFilter<TInputImage, TMaskImage, TOutputImage>::FunctorType>
+{
+public:
+  using MaskStage<MaskImageFilter<TInputImage, TMaskImage, TOutputImage>,
+                  typename MaskImageFilter<TInputImage, TMaskImage, TOutputImage>::FunctorType>::MaskStage;
+};
+
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+class Stage<MaskNegatedImageFilter<TInputImage, TMaskImage, TOutputImage>>
+  : public MaskStage<MaskNegatedImageFilter<TInputImage, TMaskImage, TOutputImage>,
+                     typename MaskNegatedImageFilter<TInputImage, TMaskImage, TOutputImage>::FunctorType>
+{
+public:
+  using MaskStage<MaskNegatedImageFilter<TInputImage, TMaskImage, TOutputImage>,
+                  typename MaskNegatedImageFilter<TInputImage, TMaskImage, TOutputImage>::FunctorType>::MaskStage;
+};
+
+/** The input image type of the first filter of a chain. */
+template <typename... TFilters>
+using FirstInputImageType = typename std::tuple_element_t<0, std::tuple<TFilters...>>::InputImageType;
+
+/** The output image type of the last filter of a chain. */
+template <typename... TFilters>
+using LastOutputImageType =
+  typename std::tuple_element_t<sizeof...(TFilters) - 1, std::tuple<TFilters...>>::OutputImageType;
+} // namespace FusedFunctorImageFilterDetail
+
+/** \class FusedFunctorImageFilter
+ * \brief Runs a chain of pixel-wise filters as a single filter.
+ *
+ * The filters of the chain are not run. The fused filter takes their
+ * parameters, and computes the output of the last filter from its input in
+ * one pass over the images, without the intermediate images of the chain.
+ * The input of the fused filter replaces the input of the first filter, and
+ * the inputs of the other filters are ignored, except for the mask images,
+ * which become inputs of the fused filter.
+   \code
+     using FusedType = itk::FusedFunctorImageFilter<ShiftScaleType, ClampType, CastType, MaskType>;
+     auto fused = FusedType::New();
+     fused->SetInput(reader->GetOutput());
+     fused->SetFilters(shiftScale, clamp, cast, mask);
+   \endcode
+ * The fused filter is modified when one of the filters is, so that it takes
+ * their new parameters at its next update. Each filter computes its output
+ * pixel type, so the output is the same as the one of the chain.
+ *
+ * The supported filters are UnaryFunctorImageFilter, ClampImageFilter,
+ * SigmoidImageFilter, IntensityWindowingImageFilter, ShiftScaleImageFilter,
+ * CastImageFilter, MaskImageFilter and MaskNegatedImageFilter. The
+ * ShiftScaleImageFilter does not count its overflows and underflows when
+ * it is fused. The output image type of each filter must be the input image
+ * type of the next one, and the images must store their pixels directly in
+ * their buffers, as Image does.
+ *
+ * \sa Functor::Composition
+ * \ingroup IntensityImageFilters MultiThreaded
+ * \ingroup ITKImageIntensity
+ */
+template <typename... TFilters>
+class ITK_TEMPLATE_EXPORT FusedFunctorImageFilter
+  : public InPlaceImageFilter<FusedFunctorImageFilterDetail::FirstInputImageType<TFilters...>,
+                              FusedFunctorImageFilterDetail::LastOutputImageType<TFilters...>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FusedFunctorImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = FusedFunctorImageFilter;
+  using Superclass = InPlaceImageFilter<FusedFunctorImageFilterDetail::FirstInputImageType<TFilters...>,
+                                        FusedFunctorImageFilterDetail::LastOutputImageType<TFilters...>>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(FusedFunctorImageFilter);
+
+  /** Some convenient type alias. */
+  using InputImageType = typename Superclass::InputImageType;
+  using InputImagePixelType = typename InputImageType::PixelType;
+  using OutputImageType = typename Superclass::OutputImageType;
+  using OutputImagePixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
+
+  /** The number of fused filters. */
+  static constexpr size_t NumberOfFilters = sizeof...(TFilters);
+
+  /** Set the filters to fuse, in the order of the chain. */
+  void
+  SetFilters(TFilters *... filters);
+
+  /** Get one of the fused filters. */
+  template <size_t VIndex>
+  std::tuple_element_t<VIndex, std::tuple<TFilters...>> *
+  GetFilter() const
+  {
+    return std::get<VIndex>(m_Filters);
+  }
+
+  /** The fused filter is modified when one of the filters is. */
+  ModifiedTimeType
+  GetMTime() const override;
+
+  /** Set the mask images of the filters as inputs, before updating the
+   * information of the pipeline. */
+  void
+  UpdateOutputInformation() override;
+
+protected:
+  FusedFunctorImageFilter();
+  ~FusedFunctorImageFilter() override = default;
+
+  void
+  VerifyPreconditions() const override;
+
+  void
+  BeforeThreadedGenerateData() override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  void
+  AfterThreadedGenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  using FiltersType = std::tuple<TFilters...>;
+  using StagesType = std::tuple<FusedFunctorImageFilterDetail::Stage<TFilters>...>;
+
+  template <size_t... VIndices>
+  static constexpr bool
+  AreChained(std::index_sequence<VIndices...>)
+  {
+    return (std::is_same_v<typename std::tuple_element_t<VIndices, FiltersType>::OutputImageType,
+                           typename std::tuple_element_t<VIndices + 1, FiltersType>::InputImageType> &&
+            ...);
+  }
+
+  static_assert(AreChained(std::make_index_sequence<NumberOfFilters - 1>()),
+                "The output image type of each filter must be the input image type of the next one.");
+  static_assert(ImageAlgorithm::SupportsDirectPixelAccess<InputImageType> &&
+                  ImageAlgorithm::SupportsDirectPixelAccess<OutputImageType>,
+                "FusedFunctorImageFilter requires images which store their pixels directly in their buffers.");
+
+  /** Whether all the filters are set. */
+  bool
+  HasFilters() const;
+
+  /** Take the parameters of the filters. */
+  StagesType
+  MakeStages() const;
+
+  /** Compute the output pixel of the chain of stages, from the stage VStage. */
+  template <size_t VStage>
+  static auto
+  ApplyStages(const StagesType &                                                      stages,
+              const typename std::tuple_element_t<VStage, StagesType>::InputPixelType & value,
+              SizeValueType                                                           i)
+  {
+    const auto result = std::get<VStage>(stages)(value, i);
+    if constexpr (VStage + 1 == NumberOfFilters)
+    {
+      return result;
+    }
+    else
+    {
+      return ApplyStages<VStage + 1>(stages, result, i);
+    }
+  }
+
+  std::tuple<typename TFilters::Pointer...> m_Filters{};
+  std::optional<StagesType>                m_Stages{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkFusedFunctorImageFilter.hxx"
+#endif
+
+#endif
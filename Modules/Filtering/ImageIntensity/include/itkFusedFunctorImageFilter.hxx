@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFusedFunctorImageFilter_hxx
+#define itkFusedFunctorImageFilter_hxx
+
+#include "itkTotalProgressReporter.h"
+#include <algorithm>
+
+namespace itk
+{
+template <typename... TFilters>
+FusedFunctorImageFilter<TFilters...>::FusedFunctorImageFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+  this->InPlaceOff();
+  this->DynamicMultiThreadingOn();
+}
+
+template <typename... TFilters>
+void
+FusedFunctorImageFilter<TFilters...>::SetFilters(TFilters *... filters)
+{
+  const std::tuple<typename TFilters::Pointer...> newFilters(filters...);
+  if (newFilters != m_Filters)
+  {
+    m_Filters = newFilters;
+    this->Modified();
+  }
+}
+
+template <typename... TFilters>
+ModifiedTimeType
+FusedFunctorImageFilter<TFilters...>::GetMTime() const
+{
+  ModifiedTimeType mtime = Superclass::GetMTime();
+  std::apply(
+    [&mtime](const auto &... filter) { ((mtime = filter ? std::max(mtime, filter->GetMTime()) : mtime), ...); },
+    m_Filters);
+  return mtime;
+}
+
+template <typename... TFilters>
+void
+FusedFunctorImageFilter<TFilters...>::UpdateOutputInformation()
+{
+  if (this->HasFilters())
+  {
+    // The images read by the stages follow the pipeline as the inputs after
+    // the first one.
+    const StagesType stages = this->MakeStages();
+    const auto images = std::apply([](const auto &... stage) { return std::tuple_cat(stage.GetImages()...); }, stages);
+    std::apply(
+      [this](const auto *... image) {
+        unsigned int index = 1;
+        (this->SetNthInput(index++, const_cast<DataObject *>(static_cast<const DataObject *>(image))), ...);
+      },
+      images);
+  }
+  Superclass::UpdateOutputInformation();
+}
+
+template <typename... TFilters>
+void
+FusedFunctorImageFilter<TFilters...>::VerifyPreconditions() const
+{
+  Superclass::VerifyPreconditions();
+
+  if (!this->HasFilters())
+  {
+    itkExceptionMacro("The filters to fuse are not all set.");
+  }
+}
+
+template <typename... TFilters>
+bool
+FusedFunctorImageFilter<TFilters...>::HasFilters() const
+{
+  return std::apply([](const auto &... filter) { return ((filter != nullptr) && ...); }, m_Filters);
+}
+
+template <typename... TFilters>
+auto
+FusedFunctorImageFilter<TFilters...>::MakeStages() const -> StagesType
+{
+  return std::apply([](const auto &... filter) { return StagesType(*filter...); }, m_Filters);
+}
+
+template <typename... TFilters>
+void
+FusedFunctorImageFilter<TFilters...>::BeforeThreadedGenerateData()
+{
+  m_Stages = this->MakeStages();
+}
+
+template <typename... TFilters>
+void
+FusedFunctorImageFilter<TFilters...>::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  const InputImageType * inputPtr = this->GetInput();
+  OutputImageType *      outputPtr = this->GetOutput();
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  // A copy of the stages for this work unit, which holds its position in the
+  // images read by the stages
+  StagesType stages = *m_Stages;
+
+  const auto chunkFunction = [inputPtr, outputPtr, &stages, &progress](
+                               const typename OutputImageRegionType::IndexType & index, SizeValueType numberOfPixels) {
+    const InputImagePixelType * in = inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(index);
+    OutputImagePixelType *      out = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+    std::apply([&index](auto &... stage) { (stage.SetChunk(index), ...); }, stages);
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      out[i] = ApplyStages<0>(stages, in[i], i);
+    }
+    progress.Completed(numberOfPixels);
+  };
+
+  // The chunks are contiguous in the images read by the stages too
+  const auto images = std::apply([](const auto &... stage) { return std::tuple_cat(stage.GetImages()...); }, stages);
+  std::apply(
+    [&outputRegionForThread, &chunkFunction, inputPtr, outputPtr](const auto *... image) {
+      ImageAlgorithm::ForEachContiguousChunk(outputRegionForThread, chunkFunction, inputPtr, outputPtr, image...);
+    },
+    images);
+}
+
+template <typename... TFilters>
+void
+FusedFunctorImageFilter<TFilters...>::AfterThreadedGenerateData()
+{
+  m_Stages.reset();
+}
+
+template <typename... TFilters>
+void
+FusedFunctorImageFilter<TFilters...>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Filters:";
+  std::apply([&os](const auto &... filter) { ((os << ' ' << (filter ? filter->GetNameOfClass() : "(null)")), ...); },
+             m_Filters);
+  os << std::endl;
+}
+} // end namespace itk
+
+#endif
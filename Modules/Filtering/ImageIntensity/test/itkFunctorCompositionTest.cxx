@@ -0,0 +1,128 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFunctorComposition.h"
+#include "itkBinaryGeneratorImageFilter.h"
+#include "itkUnaryGeneratorImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkMaskImageFilter.h"
+#include "itkArithmeticOpsFunctors.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+// A chain of pixel-wise filters and the composition of their functors,
+// run as a single filter, produce the same image.
+int
+itkFunctorCompositionTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+  using FloatImageType = itk::Image<float, Dimension>;
+  using MaskImageType = itk::Image<unsigned char, Dimension>;
+  using ShortImageType = itk::Image<short, Dimension>;
+
+  const FloatImageType::SizeType size = { { 37, 23, 11 } };
+  auto                           image = FloatImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto mask = MaskImageType::New();
+  mask->SetRegions(size);
+  mask->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  itk::ImageRegionIterator<MaskImageType> maskIt(mask, mask->GetBufferedRegion());
+  for (itk::ImageRegionIterator<FloatImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it, ++maskIt)
+  {
+    it.Set(static_cast<float>(generator->GetUniformVariate(-1000.0, 1000.0)));
+    maskIt.Set(generator->GetIntegerVariate(3) == 0 ? 0 : 1);
+  }
+
+  // the chain of filters
+  constexpr double shift = 12.5;
+  constexpr double scale = 20.25;
+  auto             shiftScale = itk::ShiftScaleImageFilter<FloatImageType, FloatImageType>::New();
+  shiftScale->SetInput(image);
+  shiftScale->SetShift(shift);
+  shiftScale->SetScale(scale);
+  auto clamp = itk::ClampImageFilter<FloatImageType, FloatImageType>::New();
+  clamp->SetInput(shiftScale->GetOutput());
+  clamp->SetBounds(-20000.0f, 15000.0f);
+  auto cast = itk::CastImageFilter<FloatImageType, ShortImageType>::New();
+  cast->SetInput(clamp->GetOutput());
+  auto maskFilter = itk::MaskImageFilter<ShortImageType, MaskImageType, ShortImageType>::New();
+  maskFilter->SetInput(cast->GetOutput());
+  maskFilter->SetMaskImage(mask);
+  maskFilter->SetOutsideValue(-1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(maskFilter->Update());
+
+  // the same operations, in a single pass
+  itk::Functor::MaskInput<short, unsigned char, short> maskFunctor;
+  maskFunctor.SetOutsideValue(-1);
+  const auto composition = itk::Functor::MakeComposition(
+    [](float value) { return static_cast<float>((static_cast<double>(value) + shift) * scale); },
+    clamp->GetFunctor(),
+    [](float value) { return static_cast<short>(value); },
+    maskFunctor);
+
+  auto fused = itk::BinaryGeneratorImageFilter<FloatImageType, MaskImageType, ShortImageType>::New();
+  fused->SetInput1(image);
+  fused->SetInput2(mask);
+  fused->SetFunctor(composition);
+  ITK_TRY_EXPECT_NO_EXCEPTION(fused->Update());
+
+  itk::SizeValueType numberOfMaskedPixels = 0;
+  for (itk::ImageRegionConstIterator<ShortImageType> it(maskFilter->GetOutput(), mask->GetBufferedRegion()),
+       fusedIt(fused->GetOutput(), mask->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it, ++fusedIt)
+  {
+    if (it.Get() != fusedIt.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Different pixels at " << it.GetIndex() << ": " << it.Get() << " != " << fusedIt.Get()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    numberOfMaskedPixels += it.Get() == -1;
+  }
+  ITK_TEST_EXPECT_TRUE(numberOfMaskedPixels > 0);
+
+  // a unary chain of functors
+  using AddType = itk::Functor::Add2<float, float, float>;
+  const auto unaryComposition =
+    itk::Functor::MakeComposition(clamp->GetFunctor(), [](float value) { return value / 2.0f; });
+  auto unaryFused = itk::UnaryGeneratorImageFilter<FloatImageType, FloatImageType>::New();
+  unaryFused->SetInput(image);
+  unaryFused->SetFunctor(unaryComposition);
+  ITK_TRY_EXPECT_NO_EXCEPTION(unaryFused->Update());
+  const FloatImageType::IndexType index = { { 3, 5, 7 } };
+  ITK_TEST_EXPECT_EQUAL(unaryFused->GetOutput()->GetPixel(index), clamp->GetFunctor()(image->GetPixel(index)) / 2.0f);
+
+  // compositions of comparable functors are comparable
+  const auto additions = itk::Functor::MakeComposition(AddType(), clamp->GetFunctor());
+  auto       otherClamp = clamp->GetFunctor();
+  otherClamp.SetBounds(0.0f, 1.0f);
+  ITK_TEST_EXPECT_TRUE(additions == itk::Functor::MakeComposition(AddType(), clamp->GetFunctor()));
+  ITK_TEST_EXPECT_TRUE(additions != itk::Functor::MakeComposition(AddType(), otherClamp));
+  ITK_TEST_EXPECT_EQUAL(additions(1.5f, 2.0f), 3.5f);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
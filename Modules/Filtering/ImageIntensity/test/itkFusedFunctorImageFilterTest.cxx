@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFusedFunctorImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+template <typename TImage>
+bool
+SameImages(const TImage * image, const TImage * otherImage)
+{
+  itk::ImageRegionConstIterator<TImage> otherIt(otherImage, image->GetBufferedRegion());
+  for (itk::ImageRegionConstIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it, ++otherIt)
+  {
+    if (it.Get() != otherIt.Get())
+    {
+      std::cerr << "Different pixels at " << it.GetIndex() << ": " << it.Get() << " != " << otherIt.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+// A chain of pixel-wise filters and the same filters, fused and run as a
+// single filter, produce the same image.
+int
+itkFusedFunctorImageFilterTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+  using FloatImageType = itk::Image<float, Dimension>;
+  using MaskImageType = itk::Image<unsigned char, Dimension>;
+  using ShortImageType = itk::Image<short, Dimension>;
+
+  const FloatImageType::SizeType size = { { 37, 23, 11 } };
+  auto                           image = FloatImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto mask = MaskImageType::New();
+  mask->SetRegions(size);
+  mask->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  itk::ImageRegionIterator<MaskImageType> maskIt(mask, mask->GetBufferedRegion());
+  for (itk::ImageRegionIterator<FloatImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it, ++maskIt)
+  {
+    it.Set(static_cast<float>(generator->GetUniformVariate(-1000.0, 1000.0)));
+    maskIt.Set(generator->GetIntegerVariate(3) == 0 ? 0 : 1);
+  }
+
+  // the chain of filters
+  using ShiftScaleType = itk::ShiftScaleImageFilter<FloatImageType, FloatImageType>;
+  using ClampType = itk::ClampImageFilter<FloatImageType, FloatImageType>;
+  using CastType = itk::CastImageFilter<FloatImageType, ShortImageType>;
+  using MaskType = itk::MaskImageFilter<ShortImageType, MaskImageType, ShortImageType>;
+  auto shiftScale = ShiftScaleType::New();
+  shiftScale->SetInput(image);
+  shiftScale->SetShift(12.5);
+  shiftScale->SetScale(20.25);
+  auto clamp = ClampType::New();
+  clamp->SetInput(shiftScale->GetOutput());
+  clamp->SetBounds(-20000.0f, 15000.0f);
+  auto cast = CastType::New();
+  cast->SetInput(clamp->GetOutput());
+  auto maskFilter = MaskType::New();
+  maskFilter->SetInput(cast->GetOutput());
+  maskFilter->SetMaskImage(mask);
+  maskFilter->SetOutsideValue(-1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(maskFilter->Update());
+
+  // the same filters, fused
+  using FusedType = itk::FusedFunctorImageFilter<ShiftScaleType, ClampType, CastType, MaskType>;
+  auto fused = FusedType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(fused, FusedFunctorImageFilter, InPlaceImageFilter);
+  fused->SetInput(image);
+  ITK_TRY_EXPECT_EXCEPTION(fused->Update());
+  fused->SetFilters(shiftScale, clamp, cast, maskFilter);
+  ITK_TEST_EXPECT_EQUAL(fused->GetFilter<2>(), cast.GetPointer());
+  ITK_TRY_EXPECT_NO_EXCEPTION(fused->Update());
+  ITK_TEST_EXPECT_TRUE(SameImages(maskFilter->GetOutput(), fused->GetOutput()));
+  ITK_TEST_EXPECT_EQUAL(fused->GetNumberOfIndexedInputs(), 2);
+
+  // the fused filter takes the new parameters and the new mask of the filters
+  auto otherMask = MaskImageType::New();
+  otherMask->SetRegions(size);
+  otherMask->AllocateInitialized();
+  otherMask->FillBuffer(1);
+  otherMask->SetPixel({ { 3, 5, 7 } }, 0);
+  shiftScale->SetShift(-40.0);
+  clamp->SetBounds(-5000.0f, 20000.0f);
+  maskFilter->SetMaskImage(otherMask);
+  maskFilter->SetOutsideValue(7);
+  ITK_TRY_EXPECT_NO_EXCEPTION(maskFilter->Update());
+  ITK_TRY_EXPECT_NO_EXCEPTION(fused->Update());
+  ITK_TEST_EXPECT_TRUE(SameImages(maskFilter->GetOutput(), fused->GetOutput()));
+  ITK_TEST_EXPECT_EQUAL(fused->GetOutput()->GetPixel({ { 3, 5, 7 } }), 7);
+
+  // a chain of filters which keep the pixel type, run in place
+  using WindowingType = itk::IntensityWindowingImageFilter<FloatImageType, FloatImageType>;
+  using SigmoidType = itk::SigmoidImageFilter<FloatImageType, FloatImageType>;
+  using MaskNegatedType = itk::MaskNegatedImageFilter<FloatImageType, MaskImageType, FloatImageType>;
+  auto windowing = WindowingType::New();
+  windowing->SetInput(image);
+  windowing->SetWindowMinimum(-500.0f);
+  windowing->SetWindowMaximum(700.0f);
+  windowing->SetOutputMinimum(-3.0f);
+  windowing->SetOutputMaximum(5.0f);
+  auto sigmoid = SigmoidType::New();
+  sigmoid->SetInput(windowing->GetOutput());
+  sigmoid->SetAlpha(2.0);
+  sigmoid->SetBeta(0.5);
+  auto maskNegated = MaskNegatedType::New();
+  maskNegated->SetInput(sigmoid->GetOutput());
+  maskNegated->SetMaskImage(mask);
+  ITK_TRY_EXPECT_NO_EXCEPTION(maskNegated->Update());
+
+  auto copy = FloatImageType::New();
+  copy->SetRegions(size);
+  copy->Allocate();
+  const FloatImageType::RegionType region = image->GetBufferedRegion();
+  itk::ImageAlgorithm::Copy(image.GetPointer(), copy.GetPointer(), region, region);
+  const float * copyBuffer = copy->GetBufferPointer();
+
+  auto inPlace = itk::FusedFunctorImageFilter<WindowingType, SigmoidType, MaskNegatedType>::New();
+  inPlace->SetInput(copy);
+  inPlace->SetFilters(windowing, sigmoid, maskNegated);
+  inPlace->InPlaceOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(inPlace->Update());
+  ITK_TEST_EXPECT_EQUAL(inPlace->GetOutput()->GetBufferPointer(), copyBuffer);
+  ITK_TEST_EXPECT_TRUE(SameImages(maskNegated->GetOutput(), inPlace->GetOutput()));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -31,6 +31,9 @@ namespace itk
  * LabelImageToLabelMapFilter converts a label image to a label collection image.
  * The labels are the same in the input and the output image.
  *
+ * The lines of all the label objects of the output are stored in one
+ * contiguous array, sorted by label, as done by LabelMap::FlattenLines().
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -128,7 +131,11 @@ protected:
 private:
   OutputImagePixelType m_BackgroundValue{};
 
-  typename std::vector<OutputImagePointer> m_TemporaryImages{};
+  using LineType = typename LabelObjectType::LineType;
+  using LabelLineType = std::pair<OutputImagePixelType, LineType>;
+
+  /** The lines found by each thread, in raster order. */
+  std::vector<std::vector<LabelLineType>> m_TemporaryLines{};
 }; // end of class
 } // end namespace itk
 
@@ -22,6 +22,9 @@
 #include "itkTotalProgressReporter.h"
 #include "itkImageLinearConstIteratorWithIndex.h"
 
+#include <algorithm>
+#include <memory>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage>
@@ -58,25 +61,11 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelImageToLabelMapFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
-  // init the temp images - one per thread
-  m_TemporaryImages.resize(this->GetNumberOfWorkUnits());
-
-  for (ThreadIdType i = 0; i < this->GetNumberOfWorkUnits(); ++i)
-  {
-    if (i == 0)
-    {
-      // the first one is the output image
-      m_TemporaryImages[0] = this->GetOutput();
-    }
-    else
-    {
-      // the other must be created
-      m_TemporaryImages[i] = OutputImageType::New();
-    }
+  // init the temp line containers - one per thread
+  m_TemporaryLines.clear();
+  m_TemporaryLines.resize(this->GetNumberOfWorkUnits());
 
-    // set the minimum data needed to create the objects properly
-    m_TemporaryImages[i]->SetBackgroundValue(m_BackgroundValue);
-  }
+  this->GetOutput()->SetBackgroundValue(m_BackgroundValue);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -87,6 +76,8 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
 {
   TotalProgressReporter progress(this, this->GetInput()->GetRequestedRegion().GetNumberOfPixels());
 
+  std::vector<LabelLineType> & lines = m_TemporaryLines[threadId];
+
   using InputLineIteratorType = ImageLinearConstIteratorWithIndex<InputImageType>;
   InputLineIteratorType it(this->GetInput(), regionForThread);
   it.SetDirection(0);
@@ -112,7 +103,7 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
           ++it;
         }
         // create the run length object to go in the vector
-        m_TemporaryImages[threadId]->SetLine(idx, length, value);
+        lines.emplace_back(static_cast<OutputImagePixelType>(value), LineType(idx, length));
       }
       else
       {
@@ -130,34 +121,48 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData
 {
   OutputImageType * output = this->GetOutput();
 
-  // merge the lines from the temporary images in the output image
-  // don't use the first image - that's the output image
-  for (ThreadIdType i = 1; i < this->GetNumberOfWorkUnits(); ++i)
+  // merge the lines of the threads - the regions of the threads are in
+  // raster order, and so are the lines of each label after a stable sort
+  SizeValueType numberOfLines = 0;
+  for (const auto & threadLines : m_TemporaryLines)
+  {
+    numberOfLines += threadLines.size();
+  }
+  std::vector<LabelLineType> labelLines;
+  labelLines.reserve(numberOfLines);
+  for (auto & threadLines : m_TemporaryLines)
+  {
+    labelLines.insert(labelLines.end(), threadLines.begin(), threadLines.end());
+    std::vector<LabelLineType>().swap(threadLines);
+  }
+  m_TemporaryLines.clear();
+  std::stable_sort(labelLines.begin(),
+                   labelLines.end(),
+                   [](const LabelLineType & a, const LabelLineType & b) { return a.first < b.first; });
+
+  // store all the lines in a single array, shared by the label objects
+  const auto lines = std::make_shared<typename LabelObjectType::LineContainerType>();
+  lines->reserve(numberOfLines);
+  for (const auto & labelLine : labelLines)
+  {
+    lines->push_back(labelLine.second);
+  }
+
+  SizeValueType firstLine = 0;
+  while (firstLine < numberOfLines)
   {
-    for (typename OutputImageType::Iterator it(m_TemporaryImages[i]); !it.IsAtEnd(); ++it)
+    const OutputImagePixelType label = labelLines[firstLine].first;
+    SizeValueType              lastLine = firstLine + 1;
+    while (lastLine < numberOfLines && labelLines[lastLine].first == label)
     {
-      LabelObjectType * labelObject = it.GetLabelObject();
-      if (output->HasLabel(labelObject->GetLabel()))
-      {
-        // merge the lines in the output's object
-        LabelObjectType *                           lo = output->GetLabelObject(labelObject->GetLabel());
-        typename LabelObjectType::ConstLineIterator lit(labelObject);
-        while (!lit.IsAtEnd())
-        {
-          lo->AddLine(lit.GetLine());
-          ++lit;
-        }
-      }
-      else
-      {
-        // simply take the object
-        output->AddLabelObject(labelObject);
-      }
+      ++lastLine;
     }
+    const auto labelObject = LabelObjectType::New();
+    labelObject->SetLabel(label);
+    labelObject->SetSharedLines(lines, firstLine, lastLine - firstLine);
+    output->AddLabelObject(labelObject);
+    firstLine = lastLine;
   }
-
-  // release the data in the temp images
-  m_TemporaryImages.clear();
 }
 
 template <typename TInputImage, typename TOutputImage>
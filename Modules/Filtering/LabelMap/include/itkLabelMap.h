@@ -309,6 +309,17 @@ public:
   void
   Optimize();
 
+  /**
+   * Move the lines of all the label objects in one contiguous array, sorted
+   * by label, where each label object refers to its range of lines. This
+   * avoids an allocation per label object, and makes the iteration over the
+   * lines of many small objects cache friendly. A label object gets its own
+   * copy of its lines when they are modified, so the label objects can still
+   * be modified independently, in parallel.
+   */
+  void
+  FlattenLines();
+
   /**
    * \class ConstIterator
    * \brief A forward iterator over the LabelObjects of a LabelMap
@@ -31,6 +31,7 @@
 #include "itkProcessObject.h"
 
 #include <algorithm>
+#include <memory>
 
 namespace itk
 {
@@ -529,6 +530,39 @@ LabelMap<TLabelObject>::Optimize()
   this->Modified();
 }
 
+
+template <typename TLabelObject>
+void
+LabelMap<TLabelObject>::FlattenLines()
+{
+  using LineContainerType = typename LabelObjectType::LineContainerType;
+
+  SizeValueType numberOfLines = 0;
+  for (auto it = m_LabelObjectContainer.begin(); it != m_LabelObjectContainer.end(); ++it)
+  {
+    numberOfLines += it->second->GetNumberOfLines();
+  }
+
+  const auto lines = std::make_shared<LineContainerType>();
+  lines->reserve(numberOfLines);
+  for (auto it = m_LabelObjectContainer.begin(); it != m_LabelObjectContainer.end(); ++it)
+  {
+    for (typename LabelObjectType::ConstLineIterator lit(it->second); !lit.IsAtEnd(); ++lit)
+    {
+      lines->push_back(lit.GetLine());
+    }
+  }
+
+  SizeValueType firstLine = 0;
+  for (auto it = m_LabelObjectContainer.begin(); it != m_LabelObjectContainer.end(); ++it)
+  {
+    const SizeValueType numberOfObjectLines = it->second->GetNumberOfLines();
+    it->second->SetSharedLines(lines, firstLine, numberOfObjectLines);
+    firstLine += numberOfObjectLines;
+  }
+  this->Modified();
+}
+
 } // end namespace itk
 
 #endif
@@ -29,6 +29,7 @@
 #define itkLabelMapFilter_h
 
 #include "itkImageToImageFilter.h"
+#include <atomic>
 #include <mutex>
 
 namespace itk
@@ -43,6 +44,10 @@ namespace itk
  * With that class, the developer doesn't need to take care of iterating over all the objects in
  * the image, or to manage by hand the threads.
  *
+ * The label objects are taken by the threads from a list made before the
+ * threaded processing, with an atomic counter, so no lock is held while
+ * distributing the objects.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -135,7 +140,8 @@ protected:
   std::mutex m_LabelObjectContainerLock{};
 
 private:
-  typename InputImageType::Iterator m_LabelObjectIterator{};
+  typename InputImageType::LabelObjectVectorType m_LabelObjects{};
+  std::atomic<SizeValueType>                     m_NextLabelObject{ 0 };
 };
 } // end namespace itk
 
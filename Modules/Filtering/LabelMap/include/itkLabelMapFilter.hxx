@@ -68,13 +68,15 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
-  m_LabelObjectIterator = typename InputImageType::Iterator(this->GetLabelMap());
+  m_LabelObjects = this->GetLabelMap()->GetLabelObjects();
+  m_NextLabelObject = 0;
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData()
 {
+  m_LabelObjects.clear();
   this->UpdateProgress(1.0);
 }
 
@@ -82,35 +84,15 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(const OutputImageRegionType &)
 {
-  const auto            numberOfLabelObjects = this->GetLabelMap()->GetNumberOfLabelObjects();
+  const auto            numberOfLabelObjects = static_cast<SizeValueType>(m_LabelObjects.size());
   TotalProgressReporter progress(this, numberOfLabelObjects, numberOfLabelObjects);
-  while (true)
-  {
-    LabelObjectType * labelObject;
-    // begin mutex lock
-    {
-      const std::lock_guard<std::mutex> lockGuard(m_LabelObjectContainerLock);
-
-      if (m_LabelObjectIterator.IsAtEnd())
-      {
-        // mutex lock holder deleted
-        return;
-      }
-
-      // get the label object
-      labelObject = m_LabelObjectIterator.GetLabelObject();
-
-      // increment the iterator now, so it will not be invalidated if the object
-      // is destroyed
-      ++m_LabelObjectIterator;
 
-      // unlock the mutex, so the other threads can get an object
-    }
-    // end mutex lock
-
-
-    // and run the user defined method for that object
-    this->ThreadedProcessLabelObject(labelObject);
+  // the list holds a reference to the objects, so they are not destroyed
+  // while being processed, even if they are removed from the label map
+  for (SizeValueType i = m_NextLabelObject++; i < numberOfLabelObjects; i = m_NextLabelObject++)
+  {
+    // run the user defined method for that object
+    this->ThreadedProcessLabelObject(m_LabelObjects[i]);
 
     progress.CompletedPixel();
   }
@@ -18,9 +18,11 @@
 #ifndef itkLabelObject_h
 #define itkLabelObject_h
 
-#include <deque>
+#include <memory>
+#include <vector>
 #include "itkLightObject.h"
 #include "itkLabelObjectLine.h"
+#include "itkLabelObjectAllocator.h"
 #include "itkWeakPointer.h"
 #include "itkObjectFactory.h"
 
@@ -43,6 +45,18 @@ namespace itk
  * All the subclasses of LabelObject have to reimplement the CopyAttributesFrom() and CopyAllFrom() method.
  * No need to reimplement CopyLinesFrom() since all derived class share the same type line data members.
  *
+ * The lines are stored in a contiguous array. They may also be a range of
+ * a line array shared with other label objects, as set up by
+ * LabelMap::FlattenLines(). In that case, the lines are copied to the
+ * object the first time they are modified.
+ *
+ * \note LineContainerType is a std::vector, and no longer a std::deque as
+ * in earlier versions of ITK. Unlike with a std::deque, AddLine() may
+ * reallocate the lines, which invalidates the references returned by
+ * GetLine() and the iterators over the lines. The first modification of
+ * shared lines invalidates them too. Code which keeps such a reference
+ * across AddLine() has to keep the index of the line instead.
+ *
  * The pixels locations belonging to the LabelObject can be obtained using:
    \code
    for(unsigned int pixelId = 0; pixelId < labelObject->Size(); pixelId++)
@@ -81,6 +95,20 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(LabelObject);
 
+  /** The label objects, and the objects of the subclasses, are allocated
+   * by LabelObjectAllocator. */
+  static void *
+  operator new(size_t size)
+  {
+    return LabelObjectAllocator::Allocate(size);
+  }
+
+  static void
+  operator delete(void * pointer, size_t size)
+  {
+    LabelObjectAllocator::Deallocate(pointer, size);
+  }
+
   static constexpr unsigned int ImageDimension = VImageDimension;
 
   using IndexType = Index<VImageDimension>;
@@ -88,6 +116,8 @@ public:
   using LabelType = TLabel;
   using LineType = LabelObjectLine<VImageDimension>;
   using LengthType = typename LineType::LengthType;
+  /** A std::vector, see the note of the class about reference invalidation. */
+  using LineContainerType = std::vector<LineType>;
   using AttributeType = unsigned int;
   using SizeValueType = itk::SizeValueType;
 
@@ -131,13 +161,15 @@ public:
   RemoveIndex(const IndexType & idx);
 
   /**
-   * Add a new line to the object, without any check.
+   * Add a new line to the object, without any check. The references to the
+   * lines, and the iterators over them, may be invalidated.
    */
   void
   AddLine(const IndexType & idx, const LengthType & length);
 
   /**
-   * Add a new line to the object, without any check.
+   * Add a new line to the object, without any check. The references to the
+   * lines, and the iterators over them, may be invalidated.
    */
   void
   AddLine(const LineType & line);
@@ -148,9 +180,17 @@ public:
   const LineType &
   GetLine(SizeValueType i) const;
 
+  /** Returns a line which may be modified. The lines shared with other
+   * label objects are copied to the object first. Same as
+   * GetModifiableLine(). */
   LineType &
   GetLine(SizeValueType i);
 
+  /** Returns a line which may be modified. The lines shared with other
+   * label objects are copied to the object first. */
+  LineType &
+  GetModifiableLine(SizeValueType i);
+
   /**
    * Returns the number of pixels contained in the object.
    *
@@ -203,6 +243,21 @@ public:
   void
   Shift(OffsetType offset);
 
+  /** Use the lines [first, first + numberOfLines) of a line array
+   * shared with other label objects, instead of the lines of the object.
+   * The lines are copied to the object when they are modified. */
+  void
+  SetSharedLines(const std::shared_ptr<const LineContainerType> & lines,
+                 SizeValueType                                    first,
+                 SizeValueType                                    numberOfLines);
+
+  /** Return true if the lines are a range of a shared line array. */
+  bool
+  HasSharedLines() const
+  {
+    return m_SharedLines != nullptr;
+  }
+
   /**
    * \class ConstLineIterator
    * \brief A forward iterator over the lines of a LabelObject
@@ -215,8 +270,8 @@ public:
 
     ConstLineIterator(const Self * lo)
     {
-      m_Begin = lo->m_LineContainer.begin();
-      m_End = lo->m_LineContainer.end();
+      m_Begin = lo->LinesBegin();
+      m_End = lo->LinesEnd();
       m_Iterator = m_Begin;
     }
 
@@ -278,11 +333,10 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
-    using InternalIteratorType = typename LineContainerType::const_iterator;
-    InternalIteratorType m_Iterator;
-    InternalIteratorType m_Begin;
-    InternalIteratorType m_End;
+    using InternalIteratorType = const LineType *;
+    InternalIteratorType m_Iterator{};
+    InternalIteratorType m_Begin{};
+    InternalIteratorType m_End{};
   };
 
   /**
@@ -303,8 +357,8 @@ public:
 
     ConstIndexIterator(const Self * lo)
     {
-      m_Begin = lo->m_LineContainer.begin();
-      m_End = lo->m_LineContainer.end();
+      m_Begin = lo->LinesBegin();
+      m_End = lo->LinesEnd();
       GoToBegin();
     }
 
@@ -376,8 +430,7 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
-    using InternalIteratorType = typename LineContainerType::const_iterator;
+    using InternalIteratorType = const LineType *;
     void
     NextValidLine()
     {
@@ -404,10 +457,28 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
-  using LineContainerType = typename std::deque<LineType>;
+  const LineType *
+  LinesBegin() const
+  {
+    return m_SharedLines ? m_SharedLines->data() + m_FirstSharedLine : m_LineContainer.data();
+  }
+
+  const LineType *
+  LinesEnd() const
+  {
+    return this->LinesBegin() + this->GetNumberOfLines();
+  }
+
+  /** Copy the shared lines to the line container of the object, before
+   * a modification. */
+  void
+  MakeLinesUnique();
 
-  LineContainerType m_LineContainer{};
-  LabelType         m_Label{};
+  LineContainerType                        m_LineContainer{};
+  std::shared_ptr<const LineContainerType> m_SharedLines{};
+  SizeValueType                            m_FirstSharedLine{};
+  SizeValueType                            m_NumberOfSharedLines{};
+  LabelType                                m_Label{};
 };
 } // end namespace itk
 
@@ -81,9 +81,9 @@ template <typename TLabel, unsigned int VImageDimension>
 bool
 LabelObject<TLabel, VImageDimension>::HasIndex(const IndexType & idx) const
 {
-  auto end = m_LineContainer.end();
+  const LineType * end = this->LinesEnd();
 
-  for (auto it = m_LineContainer.begin(); it != end; ++it)
+  for (const LineType * it = this->LinesBegin(); it != end; ++it)
   {
     if (it->HasIndex(idx))
     {
@@ -98,6 +98,12 @@ template <typename TLabel, unsigned int VImageDimension>
 bool
 LabelObject<TLabel, VImageDimension>::RemoveIndex(const IndexType & idx)
 {
+  if (m_SharedLines && !this->HasIndex(idx))
+  {
+    return false;
+  }
+  this->MakeLinesUnique();
+
   auto it = m_LineContainer.begin();
 
   while (it != m_LineContainer.end())
@@ -152,6 +158,7 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::AddIndex(const IndexType & idx)
 {
+  this->MakeLinesUnique();
   if (!m_LineContainer.empty())
   {
     // can we use the last line to add that index ?
@@ -185,6 +192,7 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::AddLine(const LineType & line)
 {
+  this->MakeLinesUnique();
   m_LineContainer.push_back(line);
 }
 
@@ -192,6 +200,10 @@ template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::GetNumberOfLines() const -> SizeValueType
 {
+  if (m_SharedLines)
+  {
+    return m_NumberOfSharedLines;
+  }
   return static_cast<typename LabelObject<TLabel, VImageDimension>::SizeValueType>(m_LineContainer.size());
 }
 
@@ -199,13 +211,21 @@ template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::GetLine(SizeValueType i) const -> const LineType &
 {
-  return m_LineContainer[i];
+  return this->LinesBegin()[i];
 }
 
 template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::GetLine(SizeValueType i) -> LineType &
 {
+  return this->GetModifiableLine(i);
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+LabelObject<TLabel, VImageDimension>::GetModifiableLine(SizeValueType i) -> LineType &
+{
+  this->MakeLinesUnique();
   return m_LineContainer[i];
 }
 
@@ -213,9 +233,9 @@ template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::Size() const -> SizeValueType
 {
-  int size = 0;
+  SizeValueType size = 0;
 
-  for (auto it = m_LineContainer.begin(); it != m_LineContainer.end(); ++it)
+  for (const LineType *it = this->LinesBegin(), *end = this->LinesEnd(); it != end; ++it)
   {
     size += it->GetLength();
   }
@@ -226,7 +246,7 @@ template <typename TLabel, unsigned int VImageDimension>
 bool
 LabelObject<TLabel, VImageDimension>::Empty() const
 {
-  return this->m_LineContainer.empty();
+  return this->GetNumberOfLines() == 0;
 }
 
 template <typename TLabel, unsigned int VImageDimension>
@@ -235,9 +255,10 @@ LabelObject<TLabel, VImageDimension>::GetIndex(SizeValueType offset) const -> In
 {
   SizeValueType o = offset;
 
-  auto it = this->m_LineContainer.begin();
+  const LineType * it = this->LinesBegin();
+  const LineType * end = this->LinesEnd();
 
-  while (it != m_LineContainer.end())
+  while (it != end)
   {
     const SizeValueType size = it->GetLength();
 
@@ -265,7 +286,7 @@ LabelObject<TLabel, VImageDimension>::CopyLinesFrom(const TSourceLabelObject * s
 {
   itkAssertOrThrowMacro((src != nullptr), "Null Pointer");
   // clear original lines and copy lines
-  m_LineContainer.clear();
+  this->Clear();
   for (size_t i = 0; i < src->GetNumberOfLines(); ++i)
   {
     this->AddLine(src->GetLine(static_cast<SizeValueType>(i)));
@@ -303,11 +324,11 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::Optimize()
 {
-  if (!m_LineContainer.empty())
+  if (!this->Empty())
   {
     // first copy the lines in another container and clear the current one
-    LineContainerType lineContainer = m_LineContainer;
-    m_LineContainer.clear();
+    LineContainerType lineContainer(this->LinesBegin(), this->LinesEnd());
+    this->Clear();
 
     // reorder the lines
     const typename Functor::LabelObjectLineComparator<LineType> comparator;
@@ -364,6 +385,7 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::Shift(OffsetType offset)
 {
+  this->MakeLinesUnique();
   for (auto it = m_LineContainer.begin(); it != m_LineContainer.end(); ++it)
   {
     LineType & line = *it;
@@ -376,6 +398,33 @@ void
 LabelObject<TLabel, VImageDimension>::Clear()
 {
   m_LineContainer.clear();
+  m_SharedLines.reset();
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+LabelObject<TLabel, VImageDimension>::SetSharedLines(const std::shared_ptr<const LineContainerType> & lines,
+                                                     SizeValueType                                    first,
+                                                     SizeValueType                                    numberOfLines)
+{
+  itkAssertOrThrowMacro((lines != nullptr), "Null Pointer");
+  itkAssertOrThrowMacro((first + numberOfLines <= lines->size()), "Lines out of the shared line array");
+  m_LineContainer.clear();
+  m_LineContainer.shrink_to_fit();
+  m_SharedLines = lines;
+  m_FirstSharedLine = first;
+  m_NumberOfSharedLines = numberOfLines;
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+LabelObject<TLabel, VImageDimension>::MakeLinesUnique()
+{
+  if (m_SharedLines)
+  {
+    m_LineContainer.assign(this->LinesBegin(), this->LinesEnd());
+    m_SharedLines.reset();
+  }
 }
 
 template <typename TLabel, unsigned int VImageDimension>
@@ -384,6 +433,9 @@ LabelObject<TLabel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "LineContainer: " << &m_LineContainer << std::endl;
+  os << indent << "SharedLines: " << m_SharedLines.get() << std::endl;
+  os << indent << "FirstSharedLine: " << m_FirstSharedLine << std::endl;
+  os << indent << "NumberOfSharedLines: " << m_NumberOfSharedLines << std::endl;
   os << indent << "Label: " << static_cast<typename NumericTraits<LabelType>::PrintType>(m_Label) << std::endl;
 }
 } // end namespace itk
@@ -0,0 +1,61 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelObjectAllocator_h
+#define itkLabelObjectAllocator_h
+
+#include "ITKLabelMapExport.h"
+#include <cstddef>
+
+namespace itk
+{
+
+/**
+ * \class LabelObjectAllocator
+ * \brief Allocates the label objects in blocks shared by many objects.
+ *
+ * The label objects of a label map are created and destroyed together,
+ * by the hundreds of thousands for a cell segmentation. LabelObject and its
+ * subclasses take their memory from this allocator: the objects of the
+ * same size are carved from 64 KiB chunks, so the objects created one
+ * after the other are contiguous in memory, and there is no allocation
+ * from the heap for most of them. A chunk goes back to the heap when all
+ * its objects are destroyed, except the last chunk of each size, which is
+ * kept for the next objects. Objects larger than 2 KiB are allocated from
+ * the heap.
+ *
+ * Allocate() and Deallocate() may be called concurrently.
+ *
+ * \sa LabelObject
+ * \ingroup ITKLabelMap
+ */
+class ITKLabelMap_EXPORT LabelObjectAllocator
+{
+public:
+  /** Returns memory for an object of the given size, aligned on 16 bytes. */
+  static void *
+  Allocate(std::size_t size);
+
+  /** Releases the memory of an object. size must be the one passed to
+   * Allocate(). */
+  static void
+  Deallocate(void * pointer, std::size_t size) noexcept;
+};
+
+} // namespace itk
+
+#endif
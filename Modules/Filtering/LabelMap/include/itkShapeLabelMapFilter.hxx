@@ -786,7 +786,8 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ComputeOrientedBoundingBox(LabelObject
   VNLMatrixType pixelLocations(ImageDimension, labelObject->GetNumberOfLines() * 2);
   for (unsigned int l = 0; l < numLines; ++l)
   {
-    const typename LabelObjectType::LineType line = labelObject->GetLine(l);
+    // read the line through a const object, so shared lines are not copied
+    const typename LabelObjectType::LineType & line = static_cast<const LabelObjectType *>(labelObject)->GetLine(l);
 
     // add start index of line as physical point relative to centroid
     IndexType                     idx = line.GetIndex();
@@ -0,0 +1,175 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkLabelObjectAllocator.h"
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace itk
+{
+namespace
+{
+
+constexpr std::size_t BlockAlignment = 16;
+constexpr std::size_t MaximumBlockSize = 2048;
+constexpr std::size_t ChunkSize = std::size_t{ 1 } << 16;
+constexpr std::size_t NumberOfSizeClasses = MaximumBlockSize / BlockAlignment;
+
+// A chunk is aligned on its size, so the chunk of a block is found by
+// masking the address of the block. Its blocks follow this header.
+struct Chunk
+{
+  Chunk *     m_Previous;
+  Chunk *     m_Next;
+  void *      m_FreeBlock;
+  char *      m_UnusedBlock;
+  std::size_t m_NumberOfBlocks;
+  bool        m_Available;
+};
+
+constexpr std::size_t ChunkHeaderSize = (sizeof(Chunk) + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+
+// The chunks of a block size which have free blocks, in a doubly linked list.
+struct SizeClass
+{
+  std::mutex m_Mutex;
+  Chunk *    m_Available{ nullptr };
+};
+
+std::array<SizeClass, NumberOfSizeClasses> &
+GetSizeClasses()
+{
+  // Never destroyed, as label objects may be released after the static
+  // objects of the library.
+  static auto * const sizeClasses = new std::array<SizeClass, NumberOfSizeClasses>();
+  return *sizeClasses;
+}
+
+void
+LinkChunk(SizeClass & sizeClass, Chunk * chunk)
+{
+  chunk->m_Previous = nullptr;
+  chunk->m_Next = sizeClass.m_Available;
+  if (sizeClass.m_Available)
+  {
+    sizeClass.m_Available->m_Previous = chunk;
+  }
+  sizeClass.m_Available = chunk;
+  chunk->m_Available = true;
+}
+
+void
+UnlinkChunk(SizeClass & sizeClass, Chunk * chunk)
+{
+  if (chunk->m_Previous)
+  {
+    chunk->m_Previous->m_Next = chunk->m_Next;
+  }
+  else
+  {
+    sizeClass.m_Available = chunk->m_Next;
+  }
+  if (chunk->m_Next)
+  {
+    chunk->m_Next->m_Previous = chunk->m_Previous;
+  }
+  chunk->m_Available = false;
+}
+
+} // namespace
+
+void *
+LabelObjectAllocator::Allocate(std::size_t size)
+{
+  if (size == 0 || size > MaximumBlockSize)
+  {
+    return ::operator new(size);
+  }
+  const std::size_t blockSize = (size + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+  SizeClass &       sizeClass = GetSizeClasses()[blockSize / BlockAlignment - 1];
+
+  const std::lock_guard<std::mutex> lock(sizeClass.m_Mutex);
+
+  Chunk * chunk = sizeClass.m_Available;
+  if (!chunk)
+  {
+    chunk = static_cast<Chunk *>(::operator new(ChunkSize, std::align_val_t{ ChunkSize }));
+    chunk->m_FreeBlock = nullptr;
+    chunk->m_UnusedBlock = reinterpret_cast<char *>(chunk) + ChunkHeaderSize;
+    chunk->m_NumberOfBlocks = 0;
+    LinkChunk(sizeClass, chunk);
+  }
+
+  void * block;
+  if (chunk->m_FreeBlock)
+  {
+    block = chunk->m_FreeBlock;
+    chunk->m_FreeBlock = *static_cast<void **>(block);
+  }
+  else
+  {
+    block = chunk->m_UnusedBlock;
+    chunk->m_UnusedBlock += blockSize;
+  }
+  ++chunk->m_NumberOfBlocks;
+
+  const bool chunkIsFull =
+    !chunk->m_FreeBlock && chunk->m_UnusedBlock + blockSize > reinterpret_cast<char *>(chunk) + ChunkSize;
+  if (chunkIsFull)
+  {
+    UnlinkChunk(sizeClass, chunk);
+  }
+  return block;
+}
+
+void
+LabelObjectAllocator::Deallocate(void * pointer, std::size_t size) noexcept
+{
+  if (size == 0 || size > MaximumBlockSize)
+  {
+    ::operator delete(pointer);
+    return;
+  }
+  if (!pointer)
+  {
+    return;
+  }
+  const std::size_t blockSize = (size + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+  SizeClass &       sizeClass = GetSizeClasses()[blockSize / BlockAlignment - 1];
+  auto * const      chunk = reinterpret_cast<Chunk *>(reinterpret_cast<std::uintptr_t>(pointer) & ~(ChunkSize - 1));
+
+  const std::lock_guard<std::mutex> lock(sizeClass.m_Mutex);
+
+  *static_cast<void **>(pointer) = chunk->m_FreeBlock;
+  chunk->m_FreeBlock = pointer;
+  --chunk->m_NumberOfBlocks;
+  if (!chunk->m_Available)
+  {
+    LinkChunk(sizeClass, chunk);
+  }
+  else if (chunk->m_NumberOfBlocks == 0 && (chunk->m_Previous || chunk->m_Next))
+  {
+    // keep a single empty chunk for each size
+    UnlinkChunk(sizeClass, chunk);
+    ::operator delete(chunk, std::align_val_t{ ChunkSize });
+  }
+}
+
+} // namespace itk
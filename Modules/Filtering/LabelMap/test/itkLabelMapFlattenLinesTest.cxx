@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkLabelImageToShapeLabelMapFilter.h"
+#include "itkLabelMapToLabelImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+// The label objects of a flattened label map share a line array, and get
+// their own lines when they are modified.
+int
+itkLabelMapFlattenLinesTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 2;
+
+  using ImageType = itk::Image<unsigned short, Dimension>;
+  using LabelObjectType = itk::LabelObject<unsigned short, Dimension>;
+  using LabelMapType = itk::LabelMap<LabelObjectType>;
+  using IndexType = LabelObjectType::IndexType;
+
+  // a map built by hand
+  auto map = LabelMapType::New();
+  map->SetRegions(ImageType::SizeType{ { 20, 20 } });
+  map->Allocate();
+  map->SetLine(IndexType{ { 2, 3 } }, 5, 1);
+  map->SetLine(IndexType{ { 0, 4 } }, 3, 1);
+  map->SetLine(IndexType{ { 4, 5 } }, 10, 2);
+  map->SetLine(IndexType{ { 1, 7 } }, 2, 3);
+  map->SetLine(IndexType{ { 9, 7 } }, 1, 3);
+
+  map->FlattenLines();
+  ITK_TEST_EXPECT_TRUE(map->GetLabelObject(1)->HasSharedLines());
+  ITK_TEST_EXPECT_TRUE(map->GetLabelObject(3)->HasSharedLines());
+  ITK_TEST_EXPECT_EQUAL(map->GetLabelObject(1)->GetNumberOfLines(), 2);
+  ITK_TEST_EXPECT_EQUAL(map->GetLabelObject(1)->Size(), 8);
+  ITK_TEST_EXPECT_EQUAL(map->GetLabelObject(2)->Size(), 10);
+  ITK_TEST_EXPECT_EQUAL(map->GetLabelObject(3)->GetIndex(2), (IndexType{ { 9, 7 } }));
+  ITK_TEST_EXPECT_EQUAL(map->GetPixel(IndexType{ { 1, 4 } }), 1);
+  ITK_TEST_EXPECT_EQUAL(map->GetPixel(IndexType{ { 3, 5 } }), 0);
+
+  // the modification of an object does not change the other ones
+  map->SetPixel(IndexType{ { 3, 5 } }, 2);
+  map->RemovePixel(IndexType{ { 4, 3 } }, 1);
+  ITK_TEST_EXPECT_TRUE(!map->GetLabelObject(1)->HasSharedLines());
+  ITK_TEST_EXPECT_TRUE(map->GetLabelObject(3)->HasSharedLines());
+  ITK_TEST_EXPECT_EQUAL(map->GetLabelObject(1)->Size(), 7);
+  ITK_TEST_EXPECT_EQUAL(map->GetLabelObject(1)->GetNumberOfLines(), 3);
+  ITK_TEST_EXPECT_EQUAL(map->GetLabelObject(2)->Size(), 11);
+  ITK_TEST_EXPECT_EQUAL(map->GetLabelObject(3)->Size(), 3);
+  ITK_TEST_EXPECT_EQUAL(map->GetPixel(IndexType{ { 4, 3 } }), 0);
+
+  map->GetLabelObject(3)->Shift(LabelObjectType::OffsetType{ { 1, 1 } });
+  ITK_TEST_EXPECT_EQUAL(map->GetPixel(IndexType{ { 10, 8 } }), 3);
+  ITK_TEST_EXPECT_EQUAL(map->GetPixel(IndexType{ { 9, 7 } }), 0);
+
+  // a label image with many small objects, converted with several threads
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 200, 150 } });
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(1234);
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<ImageType::PixelType>(generator->GetIntegerVariate(300)));
+  }
+
+  using ToLabelMapType = itk::LabelImageToLabelMapFilter<ImageType, LabelMapType>;
+  auto toLabelMap = ToLabelMapType::New();
+  toLabelMap->SetInput(image);
+  toLabelMap->SetNumberOfWorkUnits(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(toLabelMap->Update());
+
+  const LabelMapType * labelMap = toLabelMap->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(labelMap->GetNumberOfLabelObjects(), 300);
+  for (LabelMapType::ConstIterator it(labelMap); !it.IsAtEnd(); ++it)
+  {
+    const LabelObjectType * labelObject = it.GetLabelObject();
+    ITK_TEST_EXPECT_TRUE(labelObject->HasSharedLines());
+    // the lines are in raster order
+    for (itk::SizeValueType i = 1; i < labelObject->GetNumberOfLines(); ++i)
+    {
+      const IndexType & previous = labelObject->GetLine(i - 1).GetIndex();
+      const IndexType & current = labelObject->GetLine(i).GetIndex();
+      ITK_TEST_EXPECT_TRUE(previous[1] < current[1] || (previous[1] == current[1] && previous[0] < current[0]));
+    }
+  }
+
+  using ToLabelImageType = itk::LabelMapToLabelImageFilter<LabelMapType, ImageType>;
+  auto toLabelImage = ToLabelImageType::New();
+  toLabelImage->SetInput(labelMap);
+  ITK_TRY_EXPECT_NO_EXCEPTION(toLabelImage->Update());
+  for (itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion()),
+       outIt(toLabelImage->GetOutput(), image->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it, ++outIt)
+  {
+    ITK_TEST_EXPECT_EQUAL(it.Get(), outIt.Get());
+  }
+
+  // the shape attributes computed from the shared lines, in parallel
+  using ShapeFilterType = itk::LabelImageToShapeLabelMapFilter<ImageType>;
+  auto shapeFilter = ShapeFilterType::New();
+  shapeFilter->SetInput(image);
+  shapeFilter->SetComputeOrientedBoundingBox(true);
+  shapeFilter->SetNumberOfWorkUnits(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(shapeFilter->Update());
+  itk::SizeValueType numberOfPixels = 0;
+  for (const auto & labelObject : shapeFilter->GetOutput()->GetLabelObjects())
+  {
+    ITK_TEST_EXPECT_EQUAL(labelObject->GetNumberOfPixels(), labelObject->Size());
+    numberOfPixels += labelObject->GetNumberOfPixels();
+  }
+  itk::SizeValueType numberOfBackgroundPixels = 0;
+  for (itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    numberOfBackgroundPixels += it.Get() == 0;
+  }
+  ITK_TEST_EXPECT_EQUAL(numberOfPixels + numberOfBackgroundPixels, image->GetBufferedRegion().GetNumberOfPixels());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkLabelObjectAllocator.h"
+#include "itkShapeLabelObject.h"
+#include "itkStatisticsLabelObject.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+
+namespace
+{
+
+template <typename TLabelObject>
+std::vector<typename TLabelObject::Pointer>
+CreateLabelObjects(unsigned int numberOfObjects)
+{
+  std::vector<typename TLabelObject::Pointer> labelObjects;
+  for (unsigned int label = 0; label < numberOfObjects; ++label)
+  {
+    labelObjects.push_back(TLabelObject::New());
+    labelObjects.back()->SetLabel(label);
+  }
+  return labelObjects;
+}
+
+template <typename TPointers>
+void
+ExpectDistinctAlignedObjects(const TPointers & labelObjects)
+{
+  std::set<const void *> addresses;
+  for (const auto & labelObject : labelObjects)
+  {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(labelObject.GetPointer()) % 16, 0u);
+    addresses.insert(labelObject.GetPointer());
+  }
+  EXPECT_EQ(addresses.size(), labelObjects.size());
+}
+
+} // namespace
+
+
+TEST(LabelObjectAllocator, AllocatesLabelObjectsOfSeveralSizes)
+{
+  using LabelObjectType = itk::LabelObject<unsigned short, 2>;
+  using ShapeLabelObjectType = itk::ShapeLabelObject<unsigned short, 3>;
+  using StatisticsLabelObjectType = itk::StatisticsLabelObject<unsigned short, 3>;
+
+  // more than a chunk of each size
+  const auto labelObjects = CreateLabelObjects<LabelObjectType>(5000);
+  const auto shapeLabelObjects = CreateLabelObjects<ShapeLabelObjectType>(500);
+  const auto statisticsLabelObjects = CreateLabelObjects<StatisticsLabelObjectType>(500);
+
+  ExpectDistinctAlignedObjects(labelObjects);
+  ExpectDistinctAlignedObjects(shapeLabelObjects);
+  ExpectDistinctAlignedObjects(statisticsLabelObjects);
+
+  for (unsigned int i = 0; i < labelObjects.size(); ++i)
+  {
+    EXPECT_EQ(labelObjects[i]->GetLabel(), i);
+  }
+  for (unsigned int i = 0; i < shapeLabelObjects.size(); ++i)
+  {
+    EXPECT_EQ(shapeLabelObjects[i]->GetLabel(), i);
+    EXPECT_EQ(statisticsLabelObjects[i]->GetLabel(), i);
+  }
+}
+
+
+TEST(LabelObjectAllocator, ReusesTheReleasedObjects)
+{
+  using LabelObjectType = itk::ShapeLabelObject<unsigned char, 2>;
+
+  auto labelObjects = CreateLabelObjects<LabelObjectType>(3000);
+
+  // release half of the objects in a random order, and create them again
+  std::mt19937 randomGenerator(1234);
+  std::shuffle(labelObjects.begin(), labelObjects.end(), randomGenerator);
+  labelObjects.resize(labelObjects.size() / 2);
+  auto newLabelObjects = CreateLabelObjects<LabelObjectType>(1500);
+  labelObjects.insert(labelObjects.end(), newLabelObjects.begin(), newLabelObjects.end());
+  ExpectDistinctAlignedObjects(labelObjects);
+
+  // release all of them, which gives back the chunks
+  labelObjects.clear();
+  newLabelObjects.clear();
+  ExpectDistinctAlignedObjects(CreateLabelObjects<LabelObjectType>(100));
+}
+
+
+TEST(LabelObjectAllocator, FallsBackToTheHeapForLargeObjects)
+{
+  void * const small = itk::LabelObjectAllocator::Allocate(40);
+  void * const large = itk::LabelObjectAllocator::Allocate(1 << 20);
+  ASSERT_NE(small, nullptr);
+  ASSERT_NE(large, nullptr);
+  std::fill_n(static_cast<char *>(large), 1 << 20, 0);
+  itk::LabelObjectAllocator::Deallocate(large, 1 << 20);
+  itk::LabelObjectAllocator::Deallocate(small, 40);
+}
@@ -81,6 +81,7 @@ ClosingByReconstructionImageFilter<TInputImage, TOutputImage, TKernel>::Generate
   erode->SetMarkerImage(dilate->GetOutput());
   erode->SetMaskImage(this->GetInput());
   erode->SetFullyConnected(m_FullyConnected);
+  erode->SetParallelPropagation(m_ParallelPropagation);
 
   if (m_PreserveIntensities)
   {
@@ -116,6 +117,7 @@ ClosingByReconstructionImageFilter<TInputImage, TOutputImage, TKernel>::Generate
     erodeAgain->SetMaskImage(this->GetInput());
     erodeAgain->SetMarkerImage(tempImage);
     erodeAgain->SetFullyConnected(m_FullyConnected);
+    erodeAgain->SetParallelPropagation(m_ParallelPropagation);
     erodeAgain->GraftOutput(this->GetOutput());
     progress->RegisterInternalFilter(erodeAgain, 0.25f);
     erodeAgain->Update();
@@ -139,6 +141,7 @@ ClosingByReconstructionImageFilter<TInputImage, TOutputImage, TKernel>::PrintSel
 
   os << indent << "Kernel: " << m_Kernel << std::endl;
   itkPrintSelfBooleanMacro(FullyConnected);
+  itkPrintSelfBooleanMacro(ParallelPropagation);
   os << indent << "PreserveIntensities: " << m_PreserveIntensities << std::endl;
 }
 } // end namespace itk
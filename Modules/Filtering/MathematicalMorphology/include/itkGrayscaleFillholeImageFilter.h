@@ -96,6 +96,16 @@ public:
   itkGetConstReferenceMacro(FullyConnected, bool);
   itkBooleanMacro(FullyConnected);
 
+  /**
+   * Set/Get whether the internal ReconstructionByErosionImageFilter
+   * propagates on several work units. Default is
+   * ParallelPropagationOff.
+   * \sa ReconstructionImageFilter::SetParallelPropagation()
+   */
+  itkSetMacro(ParallelPropagation, bool);
+  itkGetConstReferenceMacro(ParallelPropagation, bool);
+  itkBooleanMacro(ParallelPropagation);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(InputOStreamWritableCheck, (Concept::OStreamWritable<InputImagePixelType>));
@@ -127,6 +137,7 @@ private:
   unsigned long m_NumberOfIterationsUsed{ 1 };
 
   bool m_FullyConnected{};
+  bool m_ParallelPropagation{ false };
 }; // end of class
 } // end namespace itk
 
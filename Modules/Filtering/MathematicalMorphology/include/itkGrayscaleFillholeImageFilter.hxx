@@ -120,6 +120,7 @@ GrayscaleFillholeImageFilter<TInputImage, TOutputImage>::GenerateData()
   erode->SetMarkerImage(markerPtr);
   erode->SetMaskImage(this->GetInput());
   erode->SetFullyConnected(m_FullyConnected);
+  erode->SetParallelPropagation(m_ParallelPropagation);
 
   // graft our output to the erode filter to force the proper regions
   // to be generated
@@ -142,6 +143,7 @@ GrayscaleFillholeImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream
 
   os << indent << "Number of iterations used to produce current output: " << m_NumberOfIterationsUsed << std::endl;
   itkPrintSelfBooleanMacro(FullyConnected);
+  itkPrintSelfBooleanMacro(ParallelPropagation);
 }
 } // end namespace itk
 #endif
@@ -110,6 +110,16 @@ public:
   itkGetConstReferenceMacro(FullyConnected, bool);
   itkBooleanMacro(FullyConnected);
 
+  /**
+   * Set/Get whether the internal ReconstructionByDilationImageFilter
+   * propagates on several work units. Default is
+   * ParallelPropagationOff.
+   * \sa ReconstructionImageFilter::SetParallelPropagation()
+   */
+  itkSetMacro(ParallelPropagation, bool);
+  itkGetConstReferenceMacro(ParallelPropagation, bool);
+  itkBooleanMacro(ParallelPropagation);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(InputOStreamWritableCheck, (Concept::OStreamWritable<InputImagePixelType>));
@@ -141,6 +151,7 @@ private:
   unsigned long m_NumberOfIterationsUsed{ 1 };
 
   bool m_FullyConnected{};
+  bool m_ParallelPropagation{ false };
 }; // end of class
 } // end namespace itk
 
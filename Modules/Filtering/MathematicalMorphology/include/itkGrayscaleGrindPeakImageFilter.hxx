@@ -130,6 +130,7 @@ GrayscaleGrindPeakImageFilter<TInputImage, TOutputImage>::GenerateData()
   dilate->SetMarkerImage(markerPtr);
   dilate->SetMaskImage(this->GetInput());
   dilate->SetFullyConnected(m_FullyConnected);
+  dilate->SetParallelPropagation(m_ParallelPropagation);
 
   // graft our output to the dilate filter to force the proper regions
   // to be generated
@@ -152,6 +153,7 @@ GrayscaleGrindPeakImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream
 
   os << indent << "Number of iterations used to produce current output: " << m_NumberOfIterationsUsed << std::endl;
   itkPrintSelfBooleanMacro(FullyConnected);
+  itkPrintSelfBooleanMacro(ParallelPropagation);
 }
 } // end namespace itk
 #endif
@@ -92,6 +92,16 @@ public:
   itkGetConstReferenceMacro(FullyConnected, bool);
   itkBooleanMacro(FullyConnected);
 
+  /**
+   * Set/Get whether the internal HMinimaImageFilter
+   * propagates on several work units. Default is
+   * ParallelPropagationOff.
+   * \sa HMinimaImageFilter::SetParallelPropagation()
+   */
+  itkSetMacro(ParallelPropagation, bool);
+  itkGetConstReferenceMacro(ParallelPropagation, bool);
+  itkBooleanMacro(ParallelPropagation);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(InputEqualityComparableCheck, (Concept::EqualityComparable<InputImagePixelType>));
@@ -125,6 +135,7 @@ private:
   InputImagePixelType m_Height{};
   unsigned long       m_NumberOfIterationsUsed{ 1 };
   bool                m_FullyConnected{ false };
+  bool                m_ParallelPropagation{ false };
 }; // end of class
 } // end namespace itk
 
@@ -71,6 +71,7 @@ HConcaveImageFilter<TInputImage, TOutputImage>::GenerateData()
   hmin->SetInput(this->GetInput());
   hmin->SetHeight(m_Height);
   hmin->SetFullyConnected(m_FullyConnected);
+  hmin->SetParallelPropagation(m_ParallelPropagation);
 
   // Need to subtract the input from the H-Minima image
   auto subtract = SubtractImageFilter<TInputImage, TInputImage, TOutputImage>::New();
@@ -104,6 +105,7 @@ HConcaveImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Ind
      << static_cast<typename NumericTraits<InputImagePixelType>::PrintType>(m_Height) << std::endl;
   os << indent << "Number of iterations used to produce current output: " << m_NumberOfIterationsUsed << std::endl;
   itkPrintSelfBooleanMacro(FullyConnected);
+  itkPrintSelfBooleanMacro(ParallelPropagation);
 }
 } // end namespace itk
 #endif
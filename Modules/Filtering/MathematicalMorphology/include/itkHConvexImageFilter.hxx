@@ -72,6 +72,7 @@ HConvexImageFilter<TInputImage, TOutputImage>::GenerateData()
   hmax->SetInput(this->GetInput());
   hmax->SetHeight(m_Height);
   hmax->SetFullyConnected(m_FullyConnected);
+  hmax->SetParallelPropagation(m_ParallelPropagation);
 
   // Need to subtract the H-Maxima image from the input
   auto subtract = SubtractImageFilter<TInputImage, TInputImage, TOutputImage>::New();
@@ -105,6 +106,7 @@ HConvexImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Inde
      << static_cast<typename NumericTraits<InputImagePixelType>::PrintType>(m_Height) << std::endl;
   os << indent << "Number of iterations used to produce current output: " << m_NumberOfIterationsUsed << std::endl;
   itkPrintSelfBooleanMacro(FullyConnected);
+  itkPrintSelfBooleanMacro(ParallelPropagation);
 }
 } // end namespace itk
 #endif
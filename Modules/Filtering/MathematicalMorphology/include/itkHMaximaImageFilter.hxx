@@ -84,6 +84,7 @@ HMaximaImageFilter<TInputImage, TOutputImage>::GenerateData()
   dilate->SetMarkerImage(shift->GetOutput());
   dilate->SetMaskImage(this->GetInput());
   dilate->SetFullyConnected(m_FullyConnected);
+  dilate->SetParallelPropagation(m_ParallelPropagation);
 
   // Must cast to the output type
   auto cast = CastImageFilter<TInputImage, TOutputImage>::New();
@@ -113,6 +114,7 @@ HMaximaImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Inde
      << static_cast<typename NumericTraits<InputImagePixelType>::PrintType>(m_Height) << std::endl;
   os << indent << "Number of iterations used to produce current output: " << m_NumberOfIterationsUsed << std::endl;
   itkPrintSelfBooleanMacro(FullyConnected);
+  itkPrintSelfBooleanMacro(ParallelPropagation);
 }
 } // end namespace itk
 #endif
@@ -84,6 +84,7 @@ HMinimaImageFilter<TInputImage, TOutputImage>::GenerateData()
   erode->SetMarkerImage(shift->GetOutput());
   erode->SetMaskImage(this->GetInput());
   erode->SetFullyConnected(m_FullyConnected);
+  erode->SetParallelPropagation(m_ParallelPropagation);
 
   // Must cast to the output type
   auto cast = CastImageFilter<TInputImage, TOutputImage>::New();
@@ -113,6 +114,7 @@ HMinimaImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Inde
      << static_cast<typename NumericTraits<InputImagePixelType>::PrintType>(m_Height) << std::endl;
   os << indent << "Number of iterations used to produce current output: " << m_NumberOfIterationsUsed << std::endl;
   itkPrintSelfBooleanMacro(FullyConnected);
+  itkPrintSelfBooleanMacro(ParallelPropagation);
 }
 } // end namespace itk
 #endif
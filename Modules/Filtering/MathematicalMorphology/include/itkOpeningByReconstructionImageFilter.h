@@ -104,6 +104,16 @@ public:
   itkGetConstReferenceMacro(FullyConnected, bool);
   itkBooleanMacro(FullyConnected);
 
+  /**
+   * Set/Get whether the internal ReconstructionByDilationImageFilter
+   * propagates on several work units. Default is
+   * ParallelPropagationOff.
+   * \sa ReconstructionImageFilter::SetParallelPropagation()
+   */
+  itkSetMacro(ParallelPropagation, bool);
+  itkGetConstReferenceMacro(ParallelPropagation, bool);
+  itkBooleanMacro(ParallelPropagation);
+
   /**
    * Set/Get whether the original intensities of the image retained for
    * those pixels unaffected by the opening by reconstruction. If Off,
@@ -141,6 +151,7 @@ private:
   /** kernel or structuring element to use. */
   KernelType m_Kernel{};
   bool       m_FullyConnected{};
+  bool       m_ParallelPropagation{ false };
   bool       m_PreserveIntensities{};
 }; // end of class
 } // end namespace itk
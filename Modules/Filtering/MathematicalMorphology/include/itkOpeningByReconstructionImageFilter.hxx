@@ -80,6 +80,7 @@ OpeningByReconstructionImageFilter<TInputImage, TOutputImage, TKernel>::Generate
   dilate->SetMarkerImage(erode->GetOutput());
   dilate->SetMaskImage(this->GetInput());
   dilate->SetFullyConnected(m_FullyConnected);
+  dilate->SetParallelPropagation(m_ParallelPropagation);
 
   progress->RegisterInternalFilter(erode, 0.5f);
   progress->RegisterInternalFilter(dilate, 0.25f);
@@ -117,6 +118,7 @@ OpeningByReconstructionImageFilter<TInputImage, TOutputImage, TKernel>::Generate
     dilateAgain->SetMaskImage(this->GetInput());
     dilateAgain->SetMarkerImage(tempImage);
     dilateAgain->SetFullyConnected(m_FullyConnected);
+    dilateAgain->SetParallelPropagation(m_ParallelPropagation);
     dilateAgain->GraftOutput(this->GetOutput());
     progress->RegisterInternalFilter(dilateAgain, 0.25f);
     dilateAgain->Update();
@@ -139,6 +141,7 @@ OpeningByReconstructionImageFilter<TInputImage, TOutputImage, TKernel>::PrintSel
 
   os << indent << "Kernel: " << m_Kernel << std::endl;
   itkPrintSelfBooleanMacro(FullyConnected);
+  itkPrintSelfBooleanMacro(ParallelPropagation);
   os << indent << "PreserveIntensities: " << m_PreserveIntensities << std::endl;
 }
 } // end namespace itk
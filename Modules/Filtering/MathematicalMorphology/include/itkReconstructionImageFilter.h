@@ -43,6 +43,18 @@ namespace itk
  * applications and efficient algorithms" -- IEEE Transactions on
  * Image processing, Vol 2, No 2, pp 176-201, April 1993
  *
+ * When ParallelPropagation is on and more than one work unit is
+ * available, the image is split into tiles which are reconstructed with
+ * the same propagation steps, reading the pixels of the neighboring
+ * tiles as a fixed border. A tile is processed again whenever a
+ * neighboring tile changes the pixels on their common border, until no
+ * tile changes. Non adjacent tiles are processed in parallel. The
+ * reconstruction is unique, so the output is the same as with the serial
+ * propagation; UseInternalCopy is not used by this parallel path.
+ * ParallelPropagation is off by default: tiles near the regional maxima
+ * of the marker may be processed many times, so the parallel path only
+ * pays off on large images with several processors.
+ *
  * \author Richard Beare. Department of Medicine, Monash University,
  * Melbourne, Australia.
  *
@@ -131,6 +143,14 @@ public:
   itkGetConstReferenceMacro(UseInternalCopy, bool);
   itkBooleanMacro(UseInternalCopy);
 
+  /**
+   * Set/Get whether the image is reconstructed tile by tile on several
+   * work units. Default is ParallelPropagationOff.
+   */
+  itkSetMacro(ParallelPropagation, bool);
+  itkGetConstReferenceMacro(ParallelPropagation, bool);
+  itkBooleanMacro(ParallelPropagation);
+
 protected:
   ReconstructionImageFilter();
   ~ReconstructionImageFilter() override = default;
@@ -156,8 +176,13 @@ protected:
   typename TInputImage::PixelType m_MarkerValue{};
 
 private:
+  /** Tile parallel reconstruction, used when ParallelPropagation is on. */
+  void
+  ParallelGenerateData();
+
   bool m_FullyConnected{};
   bool m_UseInternalCopy{};
+  bool m_ParallelPropagation{ false };
 
   using FaceCalculatorType = typename itk::NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<OutputImageType>;
 
@@ -25,6 +25,10 @@
 #include "itkConstantPadImageFilter.h"
 #include "itkCropImageFilter.h"
 
+#include "itkTiledPropagation.h"
+
+#include <atomic>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage, typename TCompare>
@@ -89,6 +93,13 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
     itkExceptionMacro("Marker and mask must have the same size.");
   }
 
+  if (m_ParallelPropagation && this->GetNumberOfWorkUnits() > 1 &&
+      maskImage->GetBufferedRegion() == output->GetBufferedRegion())
+  {
+    this->ParallelGenerateData();
+    return;
+  }
+
   // create padded versions of the marker image and the mask image
   using PadType = typename itk::ConstantPadImageFilter<InputImageType, InputImageType>;
 
@@ -334,6 +345,156 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
   }
 }
 
+template <typename TInputImage, typename TOutputImage, typename TCompare>
+void
+ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::ParallelGenerateData()
+{
+  static constexpr unsigned int ImageDimension = OutputImageDimension;
+
+  TCompare compare;
+
+  const MarkerImageType * const markerImage = this->GetMarkerImage();
+  const MaskImageType * const   maskImage = this->GetMaskImage();
+  OutputImageType * const       output = this->GetOutput();
+  const OutputImageRegionType   region = output->GetBufferedRegion();
+  MultiThreaderBase * const     multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // copy the marker to the output, checking the preconditions
+  std::atomic<bool> markerBeyondMask(false);
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [&](const OutputImageRegionType & subRegion) {
+      ImageRegionConstIterator<MarkerImageType> markerIt(markerImage, subRegion);
+      ImageRegionConstIterator<MaskImageType>   maskIt(maskImage, subRegion);
+      OutputIteratorType                        outIt(output, subRegion);
+      for (; !outIt.IsAtEnd(); ++markerIt, ++maskIt, ++outIt)
+      {
+        const auto V = static_cast<OutputImagePixelType>(markerIt.Get());
+        if (compare(V, static_cast<OutputImagePixelType>(maskIt.Get())))
+        {
+          markerBeyondMask = true;
+        }
+        outIt.Set(V);
+      }
+    },
+    nullptr);
+  if (markerBeyondMask)
+  {
+    if (compare(0, 1))
+    {
+      itkExceptionMacro("Marker pixels must be <= mask pixels.");
+    }
+    else
+    {
+      itkExceptionMacro("Marker pixels must be >= mask pixels.");
+    }
+  }
+  this->UpdateProgress(0.1f);
+
+  OutputImagePixelType * const     values = output->GetBufferPointer();
+  const MaskImagePixelType * const maskValues = maskImage->GetBufferPointer();
+
+  using PropagationType = TiledPropagation<ImageDimension>;
+  const PropagationType propagation(region, output->GetOffsetTable(), m_FullyConnected);
+  const auto &          offsets = propagation.GetOffsets();
+  const auto &          bufferOffsets = propagation.GetBufferOffsets();
+
+  // Each tile is reconstructed with the raster, antiraster and fifo
+  // steps, with the pixels of the neighbor tiles as a fixed border.
+  const auto reconstructTile = [&](typename PropagationType::Tile & tile) {
+    const auto setValue = [&tile, values](OffsetValueType offset, const OutputImageIndexType & index, auto value) {
+      values[offset] = value;
+      if (tile.IsOnBorder(index))
+      {
+        tile.MarkChanged(index);
+      }
+    };
+    // propagates the previous or later neighbors and clamps to the mask
+    const auto rasterStep = [&](const OutputImageIndexType & index, const std::vector<unsigned int> & neighbors) {
+      const OffsetValueType offset = output->ComputeOffset(index);
+      const bool            onBorder = tile.IsOnBorder(index);
+      OutputImagePixelType  V = values[offset];
+      for (const unsigned int n : neighbors)
+      {
+        if (onBorder && !propagation.IsInRegion(index + offsets[n]))
+        {
+          continue;
+        }
+        const OutputImagePixelType VN = values[offset + bufferOffsets[n]];
+        if (compare(VN, V))
+        {
+          V = VN;
+        }
+      }
+      const auto iV = static_cast<OutputImagePixelType>(maskValues[offset]);
+      if (compare(V, iV))
+      {
+        V = iV;
+      }
+      if (Math::NotExactlyEquals(V, values[offset]))
+      {
+        setValue(offset, index, V);
+      }
+      return V;
+    };
+
+    tile.ForEachIndex(true, [&](const OutputImageIndexType & index) {
+      rasterStep(index, propagation.GetPreviousNeighbors());
+    });
+
+    // the antiraster step puts in the fifo the pixels which may still
+    // raise a later neighbor in the tile
+    std::queue<OutputImageIndexType> indexFifo;
+    tile.ForEachIndex(false, [&](const OutputImageIndexType & index) {
+      const OutputImagePixelType V = rasterStep(index, propagation.GetLaterNeighbors());
+      const OffsetValueType      offset = output->ComputeOffset(index);
+      const bool                 onBorder = tile.IsOnBorder(index);
+      for (const unsigned int n : propagation.GetLaterNeighbors())
+      {
+        if (onBorder && !tile.Contains(index + offsets[n]))
+        {
+          continue;
+        }
+        const OutputImagePixelType VN = values[offset + bufferOffsets[n]];
+        const auto                 iN = static_cast<OutputImagePixelType>(maskValues[offset + bufferOffsets[n]]);
+        if (compare(V, VN) && compare(iN, VN))
+        {
+          indexFifo.push(index);
+          break;
+        }
+      }
+    });
+
+    while (!indexFifo.empty())
+    {
+      const OutputImageIndexType index = indexFifo.front();
+      indexFifo.pop();
+      const OffsetValueType      offset = output->ComputeOffset(index);
+      const bool                 onBorder = tile.IsOnBorder(index);
+      const OutputImagePixelType V = values[offset];
+      for (unsigned int n = 0; n < offsets.size(); ++n)
+      {
+        const OutputImageIndexType neighbor = index + offsets[n];
+        if (onBorder && !tile.Contains(neighbor))
+        {
+          continue;
+        }
+        const OffsetValueType      neighborOffset = offset + bufferOffsets[n];
+        const OutputImagePixelType VN = values[neighborOffset];
+        const auto                 iN = static_cast<OutputImagePixelType>(maskValues[neighborOffset]);
+        // candidate for dilation via flooding
+        if (compare(V, VN) && Math::NotAlmostEquals(iN, VN))
+        {
+          setValue(neighborOffset, neighbor, compare(iN, V) ? V : iN);
+          indexFifo.push(neighbor);
+        }
+      }
+    }
+  };
+  propagation.Run(multiThreader, reconstructTile);
+}
+
 template <typename TInputImage, typename TOutputImage, typename TCompare>
 void
 ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::PrintSelf(std::ostream & os, Indent indent) const
@@ -343,6 +504,7 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::PrintSelf(std::o
   itkPrintSelfBooleanMacro(FullyConnected);
   os << indent << "MarkerValue: " << m_MarkerValue << std::endl;
   os << indent << "UseInternalCopy: " << m_UseInternalCopy << std::endl;
+  itkPrintSelfBooleanMacro(ParallelPropagation);
 }
 } // namespace itk
 #endif
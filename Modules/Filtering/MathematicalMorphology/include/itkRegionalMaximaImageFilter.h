@@ -94,6 +94,16 @@ public:
   itkGetConstMacro(FullyConnected, bool);
   itkBooleanMacro(FullyConnected);
 
+  /**
+   * Set/Get whether the internal ValuedRegionalMaximaImageFilter
+   * propagates on several work units. Default is
+   * ParallelPropagationOff.
+   * \sa ValuedRegionalExtremaImageFilter::SetParallelPropagation()
+   */
+  itkSetMacro(ParallelPropagation, bool);
+  itkGetConstReferenceMacro(ParallelPropagation, bool);
+  itkBooleanMacro(ParallelPropagation);
+
   /**
    * Set/Get the value in the output image to consider as "foreground".
    * Defaults to maximum value of PixelType.
@@ -146,6 +156,7 @@ protected:
 
 private:
   bool                 m_FullyConnected{ false };
+  bool                 m_ParallelPropagation{ false };
   bool                 m_FlatIsMaxima{ true };
   OutputImagePixelType m_ForegroundValue{};
   OutputImagePixelType m_BackgroundValue{};
@@ -79,6 +79,7 @@ RegionalMaximaImageFilter<TInputImage, TOutputImage>::GenerateData()
   auto regionalMax = ValuedRegionalMaximaImageFilter<TInputImage, TInputImage>::New();
   regionalMax->SetInput(input);
   regionalMax->SetFullyConnected(m_FullyConnected);
+  regionalMax->SetParallelPropagation(m_ParallelPropagation);
   progress->RegisterInternalFilter(regionalMax, 0.67f);
   regionalMax->Update();
 
@@ -130,6 +131,8 @@ RegionalMaximaImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & o
   Superclass::PrintSelf(os, indent);
 
   itkPrintSelfBooleanMacro(FullyConnected);
+
+  itkPrintSelfBooleanMacro(ParallelPropagation);
   os << indent << "FlatIsMaxima: " << m_FlatIsMaxima << std::endl;
   os << indent
      << "ForegroundValue: " << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(m_ForegroundValue)
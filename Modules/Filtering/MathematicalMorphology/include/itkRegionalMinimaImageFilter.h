@@ -92,6 +92,16 @@ public:
   itkGetConstReferenceMacro(FullyConnected, bool);
   itkBooleanMacro(FullyConnected);
 
+  /**
+   * Set/Get whether the internal ValuedRegionalMinimaImageFilter
+   * propagates on several work units. Default is
+   * ParallelPropagationOff.
+   * \sa ValuedRegionalExtremaImageFilter::SetParallelPropagation()
+   */
+  itkSetMacro(ParallelPropagation, bool);
+  itkGetConstReferenceMacro(ParallelPropagation, bool);
+  itkBooleanMacro(ParallelPropagation);
+
   /**
    * Set/Get the value in the output image to consider as "foreground".
    * Defaults to maximum value of PixelType.
@@ -144,6 +154,7 @@ protected:
 
 private:
   bool                 m_FullyConnected{ false };
+  bool                 m_ParallelPropagation{ false };
   bool                 m_FlatIsMinima{ true };
   OutputImagePixelType m_ForegroundValue{};
   OutputImagePixelType m_BackgroundValue{};
@@ -80,6 +80,7 @@ RegionalMinimaImageFilter<TInputImage, TOutputImage>::GenerateData()
   auto regionalMin = ValuedRegionalMinimaImageFilter<TInputImage, TInputImage>::New();
   regionalMin->SetInput(input);
   regionalMin->SetFullyConnected(m_FullyConnected);
+  regionalMin->SetParallelPropagation(m_ParallelPropagation);
   progress->RegisterInternalFilter(regionalMin, 0.67f);
   regionalMin->Update();
 
@@ -134,6 +135,8 @@ RegionalMinimaImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & o
   Superclass::PrintSelf(os, indent);
 
   itkPrintSelfBooleanMacro(FullyConnected);
+
+  itkPrintSelfBooleanMacro(ParallelPropagation);
   os << indent << "FlatIsMinima: " << m_FlatIsMinima << std::endl;
   os << indent
      << "ForegroundValue: " << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(m_ForegroundValue)
@@ -0,0 +1,453 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkTiledPropagation_h
+#define itkTiledPropagation_h
+
+#include "itkImageRegion.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+/** \class TiledPropagation
+ * \brief Runs a propagation over an image region as a set of tiles
+ * processed in parallel, until no tile changes.
+ *
+ * The region is split into tiles. Each tile is processed by a user
+ * function which may read the pixels of the neighbor tiles but only
+ * writes its own pixels, and records the changes of the pixels on its
+ * border. The neighbor tiles next to these pixels are then processed
+ * again, until no tile is left. Tiles with the same parity of their
+ * position on every axis are not adjacent, so they are processed in
+ * parallel. When the propagation has a unique fixpoint, as the
+ * geodesic reconstruction or the flat zone flooding, the result does
+ * not depend on the order of the tiles.
+ *
+ * The class also gives the face or fully connected neighbor offsets,
+ * in the image buffer and split in the ones before and after the
+ * center in raster order.
+ *
+ * \ingroup ITKMathematicalMorphology
+ */
+template <unsigned int VDimension>
+class TiledPropagation
+{
+public:
+  using IndexType = Index<VDimension>;
+  using OffsetType = Offset<VDimension>;
+  using SizeType = Size<VDimension>;
+  using RegionType = ImageRegion<VDimension>;
+
+  /** A tile, given to the user function. */
+  class Tile
+  {
+  public:
+    Tile(const RegionType & region, bool firstVisit, bool fullyConnected)
+      : m_Region(region)
+      , m_FirstVisit(firstVisit)
+      , m_FullyConnected(fullyConnected)
+      , m_ChangedDirections(NumberOfDirections(), false)
+    {
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        m_First[j] = region.GetIndex(j);
+        m_Last[j] = m_First[j] + static_cast<IndexValueType>(region.GetSize(j)) - 1;
+      }
+    }
+
+    const RegionType &
+    GetRegion() const
+    {
+      return m_Region;
+    }
+
+    /** Whether the tile is processed for the first time. */
+    bool
+    IsFirstVisit() const
+    {
+      return m_FirstVisit;
+    }
+
+    bool
+    Contains(const IndexType & index) const
+    {
+      return TiledPropagation::IsInside(index, m_First, m_Last);
+    }
+
+    /** Whether some neighbor of the pixel is outside of the tile. */
+    bool
+    IsOnBorder(const IndexType & index) const
+    {
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        if (index[j] == m_First[j] || index[j] == m_Last[j])
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /** Records the change of a pixel of the tile, so that the neighbor
+     * tiles next to it are processed again. */
+    void
+    MarkChanged(const IndexType & index)
+    {
+      int sides[VDimension];
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        sides[j] = index[j] == m_First[j] ? -1 : (index[j] == m_Last[j] ? 1 : 0);
+      }
+      // every direction made of the sides of the pixel on some axes
+      for (unsigned int axes = 1; axes < (1u << VDimension); ++axes)
+      {
+        SizeValueType direction = 0;
+        SizeValueType weight = 1;
+        unsigned int  numberOfAxes = 0;
+        bool          onSides = true;
+        for (unsigned int j = 0; j < VDimension; ++j)
+        {
+          int side = 0;
+          if (axes & (1u << j))
+          {
+            side = sides[j];
+            onSides = onSides && side != 0;
+            ++numberOfAxes;
+          }
+          direction += static_cast<SizeValueType>(side + 1) * weight;
+          weight *= 3;
+        }
+        if (onSides && (m_FullyConnected || numberOfAxes == 1))
+        {
+          m_ChangedDirections[direction] = true;
+        }
+      }
+    }
+
+    /** Calls func(index) for the pixels of the tile, in raster order or
+     * in reverse raster order. */
+    template <typename TFunction>
+    void
+    ForEachIndex(bool forward, TFunction && func) const
+    {
+      IndexType index = forward ? m_First : m_Last;
+      for (;;)
+      {
+        func(static_cast<const IndexType &>(index));
+        unsigned int j = 0;
+        if (forward)
+        {
+          while (j < VDimension && index[j] == m_Last[j])
+          {
+            index[j] = m_First[j];
+            ++j;
+          }
+          if (j == VDimension)
+          {
+            return;
+          }
+          ++index[j];
+        }
+        else
+        {
+          while (j < VDimension && index[j] == m_First[j])
+          {
+            index[j] = m_Last[j];
+            ++j;
+          }
+          if (j == VDimension)
+          {
+            return;
+          }
+          --index[j];
+        }
+      }
+    }
+
+  private:
+    friend class TiledPropagation;
+
+    RegionType        m_Region;
+    IndexType         m_First;
+    IndexType         m_Last;
+    bool              m_FirstVisit;
+    bool              m_FullyConnected;
+    std::vector<bool> m_ChangedDirections;
+  };
+
+  TiledPropagation(const RegionType & region, const OffsetValueType * strides, bool fullyConnected)
+    : m_Region(region)
+    , m_FullyConnected(fullyConnected)
+  {
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      m_RegionLast[j] = region.GetIndex(j) + static_cast<IndexValueType>(region.GetSize(j)) - 1;
+      m_NumberOfTiles[j] = (region.GetSize(j) + TileEdge - 1) / TileEdge;
+    }
+
+    OffsetType offset;
+    offset.Fill(-1);
+    for (;;)
+    {
+      unsigned int numberOfAxes = 0;
+      int          lastStep = 0;
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        if (offset[j] != 0)
+        {
+          ++numberOfAxes;
+          lastStep = offset[j];
+        }
+      }
+      if (numberOfAxes > 0 && (fullyConnected || numberOfAxes == 1))
+      {
+        OffsetValueType bufferOffset = 0;
+        for (unsigned int j = 0; j < VDimension; ++j)
+        {
+          bufferOffset += offset[j] * strides[j];
+        }
+        (lastStep < 0 ? m_PreviousNeighbors : m_LaterNeighbors).push_back(static_cast<unsigned int>(m_Offsets.size()));
+        m_Offsets.push_back(offset);
+        m_BufferOffsets.push_back(bufferOffset);
+      }
+      unsigned int j = 0;
+      while (j < VDimension && offset[j] == 1)
+      {
+        offset[j++] = -1;
+      }
+      if (j == VDimension)
+      {
+        break;
+      }
+      ++offset[j];
+    }
+  }
+
+  /** The neighbor offsets, as indices and in the image buffer. */
+  const std::vector<OffsetType> &
+  GetOffsets() const
+  {
+    return m_Offsets;
+  }
+  const std::vector<OffsetValueType> &
+  GetBufferOffsets() const
+  {
+    return m_BufferOffsets;
+  }
+
+  /** The positions in GetOffsets() of the neighbors before and after
+   * the center in raster order. */
+  const std::vector<unsigned int> &
+  GetPreviousNeighbors() const
+  {
+    return m_PreviousNeighbors;
+  }
+  const std::vector<unsigned int> &
+  GetLaterNeighbors() const
+  {
+    return m_LaterNeighbors;
+  }
+
+  bool
+  IsInRegion(const IndexType & index) const
+  {
+    return IsInside(index, m_Region.GetIndex(), m_RegionLast);
+  }
+
+  /** Processes the tiles with process(tile), all of them once and then
+   * the ones next to the changes of the others, until no tile is left.
+   * An exception thrown by process is rethrown once the running tiles
+   * are done. */
+  template <typename TProcess>
+  void
+  Run(MultiThreaderBase * multiThreader, TProcess && process) const
+  {
+    SizeValueType numberOfTiles = 1;
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      numberOfTiles *= m_NumberOfTiles[j];
+    }
+    std::vector<bool>          active(numberOfTiles, true);
+    std::vector<bool>          visited(numberOfTiles, false);
+    std::vector<SizeValueType> tiles;
+    std::vector<Tile>          processed;
+    std::exception_ptr         exception;
+    std::mutex                 exceptionMutex;
+
+    while (std::find(active.cbegin(), active.cend(), true) != active.cend())
+    {
+      for (unsigned int parity = 0; parity < (1u << VDimension); ++parity)
+      {
+        tiles.clear();
+        processed.clear();
+        for (SizeValueType tile = 0; tile < numberOfTiles; ++tile)
+        {
+          if (active[tile] && this->GetParity(this->GetTilePosition(tile)) == parity)
+          {
+            active[tile] = false;
+            tiles.push_back(tile);
+            processed.emplace_back(this->GetTileRegion(tile), !visited[tile], m_FullyConnected);
+            visited[tile] = true;
+          }
+        }
+        if (tiles.empty())
+        {
+          continue;
+        }
+        multiThreader->ParallelizeArray(
+          0,
+          tiles.size(),
+          [&](SizeValueType i) {
+            try
+            {
+              process(processed[i]);
+            }
+            catch (...)
+            {
+              const std::lock_guard<std::mutex> lock(exceptionMutex);
+              if (!exception)
+              {
+                exception = std::current_exception();
+              }
+            }
+          },
+          nullptr);
+        if (exception)
+        {
+          std::rethrow_exception(exception);
+        }
+        for (size_t i = 0; i < tiles.size(); ++i)
+        {
+          this->ActivateNeighbors(tiles[i], processed[i].m_ChangedDirections, active);
+        }
+      }
+    }
+  }
+
+private:
+  /** Edge of the tiles, for about 4096 pixels per tile. */
+  static constexpr SizeValueType TileEdge = VDimension == 1 ? 4096 : (VDimension == 2 ? 64 : 16);
+
+  /** The directions to the neighbor tiles are base 3 numbers, with the
+   * digit 0, 1 or 2 for a step of -1, 0 or 1 on each axis. */
+  static SizeValueType
+  NumberOfDirections()
+  {
+    SizeValueType result = 1;
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      result *= 3;
+    }
+    return result;
+  }
+
+  static bool
+  IsInside(const IndexType & index, const IndexType & first, const IndexType & last)
+  {
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      if (index[j] < first[j] || index[j] > last[j])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  IndexType
+  GetTilePosition(SizeValueType tile) const
+  {
+    IndexType position;
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      position[j] = static_cast<IndexValueType>(tile % m_NumberOfTiles[j]);
+      tile /= m_NumberOfTiles[j];
+    }
+    return position;
+  }
+
+  static unsigned int
+  GetParity(const IndexType & position)
+  {
+    unsigned int parity = 0;
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      parity |= static_cast<unsigned int>(position[j] & 1) << j;
+    }
+    return parity;
+  }
+
+  RegionType
+  GetTileRegion(SizeValueType tile) const
+  {
+    const IndexType position = this->GetTilePosition(tile);
+    RegionType      region;
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      const SizeValueType start = static_cast<SizeValueType>(position[j]) * TileEdge;
+      region.SetIndex(j, m_Region.GetIndex(j) + static_cast<IndexValueType>(start));
+      region.SetSize(j, std::min(TileEdge, m_Region.GetSize(j) - start));
+    }
+    return region;
+  }
+
+  void
+  ActivateNeighbors(SizeValueType tile, const std::vector<bool> & changedDirections, std::vector<bool> & active) const
+  {
+    const IndexType position = this->GetTilePosition(tile);
+    for (SizeValueType direction = 0; direction < changedDirections.size(); ++direction)
+    {
+      if (!changedDirections[direction])
+      {
+        continue;
+      }
+      SizeValueType digits = direction;
+      SizeValueType neighbor = 0;
+      SizeValueType weight = 1;
+      bool          inside = true;
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        const IndexValueType neighborPosition = position[j] + static_cast<IndexValueType>(digits % 3) - 1;
+        digits /= 3;
+        inside = inside && neighborPosition >= 0 && neighborPosition < static_cast<IndexValueType>(m_NumberOfTiles[j]);
+        neighbor += static_cast<SizeValueType>(neighborPosition) * weight;
+        weight *= m_NumberOfTiles[j];
+      }
+      if (inside)
+      {
+        active[neighbor] = true;
+      }
+    }
+  }
+
+  RegionType                   m_Region;
+  IndexType                    m_RegionLast;
+  SizeType                     m_NumberOfTiles;
+  bool                         m_FullyConnected;
+  std::vector<OffsetType>      m_Offsets;
+  std::vector<OffsetValueType> m_BufferOffsets;
+  std::vector<unsigned int>    m_PreviousNeighbors;
+  std::vector<unsigned int>    m_LaterNeighbors;
+};
+} // end namespace itk
+
+#endif
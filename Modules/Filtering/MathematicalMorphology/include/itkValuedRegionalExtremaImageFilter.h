@@ -57,6 +57,15 @@ namespace itk
  *
  * The implementation uses the functor model from itkMaximumImageFilter.
  *
+ * When ParallelPropagation is on and more than one work unit is
+ * available, the flooding is done by tiles in parallel: a tile floods
+ * its own pixels, and is flooded again when a neighboring tile marks the
+ * flat zones which cross their common border. A flat zone is marked as
+ * soon as one of its pixels has a "better" neighbor, so the output is
+ * the same as with the serial flooding. ParallelPropagation is off by
+ * default, as large flat zones crossing many tiles are flooded again
+ * and again.
+ *
  *
  * This code was contributed in the Insight Journal paper:
  * "Finding regional extrema - methods and performance"
@@ -129,6 +138,14 @@ public:
    */
   itkGetConstMacro(Flat, bool);
 
+  /**
+   * Set/Get whether the image is flooded tile by tile on several work
+   * units. Default is ParallelPropagationOff.
+   */
+  itkSetMacro(ParallelPropagation, bool);
+  itkGetConstReferenceMacro(ParallelPropagation, bool);
+  itkBooleanMacro(ParallelPropagation);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(InputHasPixelTraitsCheck, (Concept::HasPixelTraits<InputImagePixelType>));
@@ -156,10 +173,15 @@ protected:
   GenerateData() override;
 
 private:
+  /** Tile parallel flooding, used when ParallelPropagation is on. */
+  void
+  ParallelGenerateData();
+
   typename TInputImage::PixelType m_MarkerValue{};
 
   bool m_FullyConnected{ false };
   bool m_Flat{ false };
+  bool m_ParallelPropagation{ false };
 
   using OutIndexType = typename OutputImageType::IndexType;
   using InIndexType = typename InputImageType::IndexType;
@@ -22,6 +22,10 @@
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "itkConnectedComponentAlgorithm.h"
+#include "itkTiledPropagation.h"
+
+#include <atomic>
+#include <vector>
 
 
 namespace itk
@@ -71,6 +75,13 @@ ValuedRegionalExtremaImageFilter<TInputImage, TOutputImage, TFunction1, TFunctio
   const InputImageType * input = this->GetInput();
   OutputImageType *      output = this->GetOutput();
 
+  if (m_ParallelPropagation && this->GetNumberOfWorkUnits() > 1 &&
+      input->GetBufferedRegion() == output->GetBufferedRegion())
+  {
+    this->ParallelGenerateData();
+    return;
+  }
+
   // 2 phases
   ProgressReporter progress(this, 0, this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() * 2);
 
@@ -205,6 +216,147 @@ ValuedRegionalExtremaImageFilter<TInputImage, TOutputImage, TFunction1, TFunctio
 }
 
 
+template <typename TInputImage, typename TOutputImage, typename TFunction1, typename TFunction2>
+void
+ValuedRegionalExtremaImageFilter<TInputImage, TOutputImage, TFunction1, TFunction2>::ParallelGenerateData()
+{
+  const InputImageType * const  input = this->GetInput();
+  OutputImageType * const       output = this->GetOutput();
+  const OutputImageRegionType   region = output->GetRequestedRegion();
+  MultiThreaderBase * const     multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // copy input to output, and check whether the image is flat
+  const InputImagePixelType firstValue = input->GetPixel(region.GetIndex());
+  std::atomic<bool>         flat(true);
+  multiThreader->template ParallelizeImageRegion<OutputImageDimension>(
+    region,
+    [input, output, firstValue, &flat](const OutputImageRegionType & subRegion) {
+      ImageRegionConstIterator<TInputImage> inIt(input, subRegion);
+      ImageRegionIterator<TOutputImage>     outIt(output, subRegion);
+      bool                                  subRegionFlat = true;
+      for (; !outIt.IsAtEnd(); ++inIt, ++outIt)
+      {
+        const InputImagePixelType currentValue = inIt.Get();
+        outIt.Set(static_cast<OutputImagePixelType>(currentValue));
+        subRegionFlat = subRegionFlat && currentValue == firstValue;
+      }
+      if (!subRegionFlat)
+      {
+        flat = false;
+      }
+    },
+    nullptr);
+  this->m_Flat = flat;
+  this->UpdateProgress(0.5f);
+
+  // if the image is flat, there is no need to do the work:
+  // the image will be unchanged
+  if (this->m_Flat)
+  {
+    return;
+  }
+
+  const InputImagePixelType * const inValues = input->GetBufferPointer();
+  using PropagationType = TiledPropagation<OutputImageDimension>;
+  const PropagationType propagation(region, output->GetOffsetTable(), m_FullyConnected);
+  const auto &          offsets = propagation.GetOffsets();
+  const auto &          bufferOffsets = propagation.GetBufferOffsets();
+
+  // the pixels of the flat zones which are not regional minima
+  std::vector<unsigned char> marked(region.GetNumberOfPixels(), 0);
+
+  // Each tile floods, from the pixels with a smaller neighbor, the
+  // parts of their flat zones in the tile. The tile is flooded again
+  // from its border when a neighbor tile floods the same zones.
+  const auto floodTile = [&](typename PropagationType::Tile & tile) {
+    TFunction1                compareIn;
+    TFunction2                compareOut;
+    std::vector<OutIndexType> indexStack;
+    const auto mark = [&tile, &marked, &indexStack](OffsetValueType offset, const OutIndexType & index) {
+      marked[offset] = 1;
+      if (tile.IsOnBorder(index))
+      {
+        tile.MarkChanged(index);
+      }
+      indexStack.push_back(index);
+    };
+
+    tile.ForEachIndex(true, [&](const OutIndexType & index) {
+      const bool onBorder = tile.IsOnBorder(index);
+      if (!onBorder && !tile.IsFirstVisit())
+      {
+        return;
+      }
+      const OffsetValueType offset = output->ComputeOffset(index);
+      const auto            Cent = inValues[offset];
+      // if the output pixel value = the marker value then we have
+      // already visited this pixel and don't need to do so again
+      if (marked[offset] || !compareOut(static_cast<OutputImagePixelType>(Cent), m_MarkerValue))
+      {
+        return;
+      }
+      bool flood = false;
+      for (unsigned int n = 0; n < offsets.size() && !flood; ++n)
+      {
+        const OutIndexType neighbor = index + offsets[n];
+        if (onBorder && !propagation.IsInRegion(neighbor))
+        {
+          flood = compareIn(m_MarkerValue, Cent);
+          continue;
+        }
+        const InputImagePixelType Adjacent = inValues[offset + bufferOffsets[n]];
+        flood = compareIn(Adjacent, Cent) ||
+                (onBorder && Adjacent == Cent && marked[offset + bufferOffsets[n]] && !tile.Contains(neighbor));
+      }
+      if (!flood)
+      {
+        return;
+      }
+
+      // flood the flat zone in the tile
+      mark(offset, index);
+      while (!indexStack.empty())
+      {
+        const OutIndexType idx = indexStack.back();
+        indexStack.pop_back();
+        const OffsetValueType idxOffset = output->ComputeOffset(idx);
+        const bool            idxOnBorder = tile.IsOnBorder(idx);
+        for (unsigned int n = 0; n < offsets.size(); ++n)
+        {
+          const OutIndexType    neighbor = idx + offsets[n];
+          const OffsetValueType neighborOffset = idxOffset + bufferOffsets[n];
+          if ((!idxOnBorder || tile.Contains(neighbor)) && !marked[neighborOffset] && inValues[neighborOffset] == Cent)
+          {
+            mark(neighborOffset, neighbor);
+          }
+        }
+      }
+    });
+  };
+  propagation.Run(multiThreader, floodTile);
+
+  // set the flooded flat zones to the marker value
+  OutputImagePixelType * const outValues = output->GetBufferPointer();
+  const OutputImagePixelType   markerValue = static_cast<OutputImagePixelType>(m_MarkerValue);
+  const SizeValueType          numberOfChunks = multiThreader->GetNumberOfWorkUnits();
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&marked, outValues, markerValue, numberOfChunks](SizeValueType chunk) {
+      const SizeValueType last = marked.size() * (chunk + 1) / numberOfChunks;
+      for (SizeValueType offset = marked.size() * chunk / numberOfChunks; offset < last; ++offset)
+      {
+        if (marked[offset])
+        {
+          outValues[offset] = markerValue;
+        }
+      }
+    },
+    nullptr);
+}
+
+
 template <typename TInputImage, typename TOutputImage, typename TFunction1, typename TFunction2>
 void
 ValuedRegionalExtremaImageFilter<TInputImage, TOutputImage, TFunction1, TFunction2>::PrintSelf(std::ostream & os,
@@ -215,6 +367,7 @@ ValuedRegionalExtremaImageFilter<TInputImage, TOutputImage, TFunction1, TFunctio
   itkPrintSelfBooleanMacro(FullyConnected);
   os << indent << "Flat: " << m_Flat << std::endl;
   os << indent << "MarkerValue: " << m_MarkerValue << std::endl;
+  itkPrintSelfBooleanMacro(ParallelPropagation);
 }
 
 } // end namespace itk
@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFlatStructuringElement.h"
+#include "itkGrayscaleFillholeImageFilter.h"
+#include "itkHMaximaImageFilter.h"
+#include "itkHMinimaImageFilter.h"
+#include "itkOpeningByReconstructionImageFilter.h"
+#include "itkReconstructionByDilationImageFilter.h"
+#include "itkReconstructionByErosionImageFilter.h"
+#include "itkRegionalMaximaImageFilter.h"
+#include "itkValuedRegionalMaximaImageFilter.h"
+#include "itkValuedRegionalMinimaImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+#include "itkGTest.h"
+
+#include <algorithm>
+
+
+namespace
+{
+
+// A noisy image with few gray levels, which has large plateaus and holes
+// spanning several tiles.
+template <typename TImage>
+typename TImage::Pointer
+CreateNoisyImage(const typename TImage::SizeType & size)
+{
+  using PixelType = typename TImage::PixelType;
+
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(5678);
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<PixelType>(20 + generator->GetIntegerVariate(5) * 20));
+  }
+  return image;
+}
+
+// The image shifted by the given height, which is a marker below (or above)
+// the image everywhere.
+template <typename TImage>
+typename TImage::Pointer
+CreateMarker(const TImage * image, int height)
+{
+  using PixelType = typename TImage::PixelType;
+
+  auto marker = TImage::New();
+  marker->SetRegions(image->GetBufferedRegion());
+  marker->Allocate();
+  std::transform(image->GetBufferPointer(),
+                 image->GetBufferPointer() + image->GetBufferedRegion().GetNumberOfPixels(),
+                 marker->GetBufferPointer(),
+                 [height](const PixelType pixel) { return static_cast<PixelType>(pixel + height); });
+  return marker;
+}
+
+// Runs the filter on four work units with the serial and the tile parallel
+// propagations, and expects the same output.
+template <typename TFilter>
+void
+ExpectSameOutputWithParallelPropagation(TFilter * filter)
+{
+  using ImageType = typename TFilter::OutputImageType;
+
+  filter->SetNumberOfWorkUnits(4);
+  filter->ParallelPropagationOff();
+  filter->Update();
+  const typename ImageType::Pointer serialOutput = filter->GetOutput();
+  serialOutput->DisconnectPipeline();
+
+  filter->ParallelPropagationOn();
+  filter->Update();
+  const ImageType * const parallelOutput = filter->GetOutput();
+
+  ASSERT_EQ(parallelOutput->GetBufferedRegion(), serialOutput->GetBufferedRegion());
+  const auto numberOfPixels = serialOutput->GetBufferedRegion().GetNumberOfPixels();
+  const auto mismatch = std::mismatch(serialOutput->GetBufferPointer(),
+                                      serialOutput->GetBufferPointer() + numberOfPixels,
+                                      parallelOutput->GetBufferPointer());
+  EXPECT_EQ(mismatch.first - serialOutput->GetBufferPointer(), static_cast<std::ptrdiff_t>(numberOfPixels))
+    << filter->GetNameOfClass() << ", FullyConnected: " << filter->GetFullyConnected();
+}
+
+template <typename TImage>
+void
+ExpectSameReconstruction(const typename TImage::SizeType & size)
+{
+  const auto image = CreateNoisyImage<TImage>(size);
+
+  for (const bool fullyConnected : { false, true })
+  {
+    auto dilation = itk::ReconstructionByDilationImageFilter<TImage, TImage>::New();
+    dilation->SetMarkerImage(CreateMarker(image.GetPointer(), -20));
+    dilation->SetMaskImage(image);
+    dilation->SetFullyConnected(fullyConnected);
+    ExpectSameOutputWithParallelPropagation(dilation.GetPointer());
+
+    auto erosion = itk::ReconstructionByErosionImageFilter<TImage, TImage>::New();
+    erosion->SetMarkerImage(CreateMarker(image.GetPointer(), 20));
+    erosion->SetMaskImage(image);
+    erosion->SetFullyConnected(fullyConnected);
+    ExpectSameOutputWithParallelPropagation(erosion.GetPointer());
+  }
+}
+
+template <typename TImage>
+void
+ExpectSameRegionalExtrema(const typename TImage::SizeType & size)
+{
+  const auto image = CreateNoisyImage<TImage>(size);
+
+  for (const bool fullyConnected : { false, true })
+  {
+    auto maxima = itk::ValuedRegionalMaximaImageFilter<TImage, TImage>::New();
+    maxima->SetInput(image);
+    maxima->SetFullyConnected(fullyConnected);
+    ExpectSameOutputWithParallelPropagation(maxima.GetPointer());
+    EXPECT_FALSE(maxima->GetFlat());
+
+    auto minima = itk::ValuedRegionalMinimaImageFilter<TImage, TImage>::New();
+    minima->SetInput(image);
+    minima->SetFullyConnected(fullyConnected);
+    ExpectSameOutputWithParallelPropagation(minima.GetPointer());
+    EXPECT_FALSE(minima->GetFlat());
+  }
+}
+
+// The composite filters forward ParallelPropagation to their internal
+// reconstruction or flooding filter.
+template <typename TImage>
+void
+ExpectSameCompositeOutputs(const typename TImage::SizeType & size)
+{
+  const auto image = CreateNoisyImage<TImage>(size);
+
+  auto fillhole = itk::GrayscaleFillholeImageFilter<TImage, TImage>::New();
+  fillhole->SetInput(image);
+  ExpectSameOutputWithParallelPropagation(fillhole.GetPointer());
+
+  auto hmaxima = itk::HMaximaImageFilter<TImage, TImage>::New();
+  hmaxima->SetInput(image);
+  hmaxima->SetHeight(20);
+  ExpectSameOutputWithParallelPropagation(hmaxima.GetPointer());
+
+  auto hminima = itk::HMinimaImageFilter<TImage, TImage>::New();
+  hminima->SetInput(image);
+  hminima->SetHeight(20);
+  ExpectSameOutputWithParallelPropagation(hminima.GetPointer());
+
+  using KernelType = itk::FlatStructuringElement<TImage::ImageDimension>;
+  auto opening = itk::OpeningByReconstructionImageFilter<TImage, TImage, KernelType>::New();
+  opening->SetInput(image);
+  opening->SetKernel(KernelType::Ball(KernelType::RadiusType::Filled(1)));
+  ExpectSameOutputWithParallelPropagation(opening.GetPointer());
+
+  auto maxima = itk::RegionalMaximaImageFilter<TImage, TImage>::New();
+  maxima->SetInput(image);
+  ExpectSameOutputWithParallelPropagation(maxima.GetPointer());
+}
+
+using ImageType2D = itk::Image<unsigned char, 2>;
+using ImageType3D = itk::Image<short, 3>;
+
+} // namespace
+
+
+TEST(MorphologicalReconstructionParallel, ParallelPropagationIsOffByDefault)
+{
+  EXPECT_FALSE((itk::ReconstructionByDilationImageFilter<ImageType2D, ImageType2D>::New()->GetParallelPropagation()));
+  EXPECT_FALSE((itk::ReconstructionByErosionImageFilter<ImageType2D, ImageType2D>::New()->GetParallelPropagation()));
+  EXPECT_FALSE((itk::ValuedRegionalMaximaImageFilter<ImageType2D, ImageType2D>::New()->GetParallelPropagation()));
+  EXPECT_FALSE((itk::ValuedRegionalMinimaImageFilter<ImageType2D, ImageType2D>::New()->GetParallelPropagation()));
+  EXPECT_FALSE((itk::GrayscaleFillholeImageFilter<ImageType2D, ImageType2D>::New()->GetParallelPropagation()));
+  EXPECT_FALSE((itk::HMaximaImageFilter<ImageType2D, ImageType2D>::New()->GetParallelPropagation()));
+  EXPECT_FALSE((itk::RegionalMaximaImageFilter<ImageType2D, ImageType2D>::New()->GetParallelPropagation()));
+}
+
+
+TEST(MorphologicalReconstructionParallel, Reconstruction2D)
+{
+  ExpectSameReconstruction<ImageType2D>(ImageType2D::SizeType{ { 300, 201 } });
+}
+
+
+TEST(MorphologicalReconstructionParallel, Reconstruction3D)
+{
+  ExpectSameReconstruction<ImageType3D>(ImageType3D::SizeType{ { 50, 41, 35 } });
+}
+
+
+TEST(MorphologicalReconstructionParallel, RegionalExtrema2D)
+{
+  ExpectSameRegionalExtrema<ImageType2D>(ImageType2D::SizeType{ { 300, 201 } });
+}
+
+
+TEST(MorphologicalReconstructionParallel, RegionalExtrema3D)
+{
+  ExpectSameRegionalExtrema<ImageType3D>(ImageType3D::SizeType{ { 50, 41, 35 } });
+}
+
+
+TEST(MorphologicalReconstructionParallel, CompositeFilters2D)
+{
+  ExpectSameCompositeOutputs<ImageType2D>(ImageType2D::SizeType{ { 300, 201 } });
+}
+
+
+TEST(MorphologicalReconstructionParallel, FlatImage)
+{
+  auto flat = ImageType2D::New();
+  flat->SetRegions(ImageType2D::SizeType{ { 100, 100 } });
+  flat->Allocate();
+  flat->FillBuffer(7);
+
+  auto maxima = itk::ValuedRegionalMaximaImageFilter<ImageType2D, ImageType2D>::New();
+  maxima->SetInput(flat);
+  ExpectSameOutputWithParallelPropagation(maxima.GetPointer());
+  EXPECT_TRUE(maxima->GetFlat());
+}
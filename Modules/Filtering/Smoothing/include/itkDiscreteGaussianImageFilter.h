@@ -19,10 +19,14 @@
 #define itkDiscreteGaussianImageFilter_h
 
 #include "itkGaussianOperator.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageToImageFilter.h"
 #include "itkImage.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 
+#include <type_traits>
+#include <vector>
+
 namespace itk
 {
 /**
@@ -45,6 +49,17 @@ namespace itk
  * When the Gaussian kernel is small, this filter tends to run faster than
  * itk::RecursiveGaussianImageFilter.
  *
+ * For images of scalars with the default boundary conditions, the separable
+ * convolution runs directly on the buffers, one dimension after the other,
+ * alternating between two intermediate buffers which only cover the region
+ * needed by the next dimension. The kernel being symmetric, the pixels on
+ * both sides are added before being multiplied by their common coefficient,
+ * and the convolution is computed over whole rows of the first dimension at
+ * once. Otherwise, the convolution runs through a pipeline of
+ * NeighborhoodOperatorImageFilter. Either way, the filter streams: the input
+ * requested region is only larger than the output one by the kernel radius,
+ * so a StreamingImageFilter can blur volumes by slabs.
+ *
  * \sa GaussianOperator
  * \sa Image
  * \sa Neighborhood
@@ -353,8 +368,9 @@ protected:
   GenerateInputRequestedRegion() override;
 
   /** Standard pipeline method. While this class does not implement a
-   * ThreadedGenerateData(), its GenerateData() delegates all
-   * calculations to an NeighborhoodOperatorImageFilter.  Since the
+   * ThreadedGenerateData(), its GenerateData() either convolves the
+   * buffers in parallel, or delegates all calculations to an
+   * NeighborhoodOperatorImageFilter.  Since the
    * NeighborhoodOperatorImageFilter is multithreaded, this filter is
    * multithreaded by default. */
   void
@@ -369,6 +385,34 @@ protected:
   GetKernelVarianceArray() const;
 
 private:
+  /** Whether the convolution can run directly on the buffers of the input
+   * and output images. */
+  static constexpr bool SupportsBufferConvolution =
+    std::is_arithmetic_v<InputPixelType> && std::is_arithmetic_v<OutputPixelType> &&
+    ImageAlgorithm::SupportsDirectPixelAccess<TInputImage> && ImageAlgorithm::SupportsDirectPixelAccess<TOutputImage>;
+
+  /** Convolves the requested region of the output, one dimension after the
+   * other, through two intermediate buffers. Returns false, without
+   * changing the output, when the input buffer does not contain the pixels
+   * needed. */
+  bool
+  GenerateDataByBufferConvolution(unsigned int filterDimensionality);
+
+  /** Convolves a dense buffer along a dimension with a symmetric kernel,
+   * given by the coefficients of its center and of one of its sides. The
+   * pixels outside of the source region along the dimension take the value
+   * of the nearest pixel of the region, as with the default boundary
+   * condition. */
+  template <typename TSourcePixel>
+  void
+  ConvolveBuffer(unsigned int                                 dimension,
+                 const std::vector<RealOutputPixelValueType> & coefficients,
+                 const TSourcePixel *                         source,
+                 const typename TOutputImage::RegionType &    sourceRegion,
+                 OutputPixelType *                            destination,
+                 const typename TOutputImage::RegionType &    destinationRegion,
+                 float                                        progressWeight);
+
   /** The variance of the gaussian blurring kernel in each dimensional
     direction. */
   ArrayType m_Variance{};
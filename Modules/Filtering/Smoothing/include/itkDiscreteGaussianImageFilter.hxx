@@ -23,6 +23,12 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressAccumulator.h"
 #include "itkImageAlgorithm.h"
+#include "itkIndexRange.h"
+#include "itkMakeUniqueForOverwrite.h"
+#include "itkTotalProgressReporter.h"
+
+#include <algorithm>
+#include <array>
 
 namespace itk
 {
@@ -178,6 +184,16 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
     return;
   }
 
+  if constexpr (SupportsBufferConvolution)
+  {
+    if (m_InputBoundaryCondition == &m_InputDefaultBoundaryCondition &&
+        m_RealBoundaryCondition == &m_RealDefaultBoundaryCondition &&
+        this->GenerateDataByBufferConvolution(filterDimensionality))
+    {
+      return;
+    }
+  }
+
   // Type definition for the internal neighborhood filter
   //
   // First filter convolves and changes type from input type to real type
@@ -313,6 +329,237 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+bool
+DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateDataByBufferConvolution(
+  const unsigned int filterDimensionality)
+{
+  using RegionType = typename TOutputImage::RegionType;
+
+  const TInputImage * input = this->GetInput();
+  TOutputImage *      output = this->GetOutput();
+
+  // As in the pipeline of NeighborhoodOperatorImageFilter, the last
+  // dimension is filtered first, and the output of the filtering along a
+  // dimension covers the requested region padded by the radius of the
+  // dimensions filtered afterwards.
+  std::vector<std::vector<RealOutputPixelValueType>> coefficients(filterDimensionality);
+  std::vector<RegionType>                            regions(filterDimensionality);
+  for (unsigned int dim = 0; dim < filterDimensionality; ++dim)
+  {
+    KernelType oper;
+    this->GenerateKernel(dim, oper);
+    const unsigned int radius = oper.GetRadius(dim);
+    coefficients[dim].assign(oper.Begin() + radius, oper.End());
+
+    if (dim == 0)
+    {
+      regions[dim] = output->GetRequestedRegion();
+    }
+    else
+    {
+      RadiusType padding{};
+      padding[dim - 1] = coefficients[dim - 1].size() - 1;
+      regions[dim] = regions[dim - 1];
+      regions[dim].PadByRadius(padding);
+      regions[dim].Crop(output->GetLargestPossibleRegion());
+    }
+  }
+
+  RegionType neededRegion = regions[filterDimensionality - 1];
+  neededRegion.SetIndex(filterDimensionality - 1, input->GetBufferedRegion().GetIndex(filterDimensionality - 1));
+  neededRegion.SetSize(filterDimensionality - 1, input->GetBufferedRegion().GetSize(filterDimensionality - 1));
+  if (!input->GetBufferedRegion().IsInside(neededRegion))
+  {
+    return false;
+  }
+
+  // two buffers, the output of each dimension being the input of the next
+  // one, and the last one being written to the output
+  const auto buffer1 = make_unique_for_overwrite<OutputPixelType[]>(
+    filterDimensionality > 1 ? regions[filterDimensionality - 1].GetNumberOfPixels() : 0);
+  const auto buffer2 = make_unique_for_overwrite<OutputPixelType[]>(
+    filterDimensionality > 2 ? regions[filterDimensionality - 2].GetNumberOfPixels() : 0);
+
+  const float progressWeight = 1.0f / filterDimensionality;
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  const unsigned int lastDimension = filterDimensionality - 1;
+  OutputPixelType *  destination = lastDimension == 0 ? output->GetBufferPointer() : buffer1.get();
+  this->ConvolveBuffer(lastDimension,
+                       coefficients[lastDimension],
+                       input->GetBufferPointer(),
+                       input->GetBufferedRegion(),
+                       destination,
+                       regions[lastDimension],
+                       progressWeight);
+
+  for (unsigned int dim = lastDimension; dim > 0; --dim)
+  {
+    const OutputPixelType * source = destination;
+    destination = dim == 1 ? output->GetBufferPointer() : (source == buffer1.get() ? buffer2.get() : buffer1.get());
+    this->ConvolveBuffer(
+      dim - 1, coefficients[dim - 1], source, regions[dim], destination, regions[dim - 1], progressWeight);
+  }
+  return true;
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TSourcePixel>
+void
+DiscreteGaussianImageFilter<TInputImage, TOutputImage>::ConvolveBuffer(
+  const unsigned int                            dimension,
+  const std::vector<RealOutputPixelValueType> & coefficients,
+  const TSourcePixel *                          source,
+  const typename TOutputImage::RegionType &     sourceRegion,
+  OutputPixelType *                             destination,
+  const typename TOutputImage::RegionType &     destinationRegion,
+  const float                                   progressWeight)
+{
+  using RegionType = typename TOutputImage::RegionType;
+  using IndexType = typename RegionType::IndexType;
+  using RealType = RealOutputPixelValueType;
+
+  const SizeValueType radius = coefficients.size() - 1;
+
+  // offsets of the pixels in the dense buffers
+  const auto computeOffsetTable = [](const RegionType & region) {
+    std::array<OffsetValueType, ImageDimension> offsetTable;
+    OffsetValueType                             offset = 1;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      offsetTable[dim] = offset;
+      offset *= static_cast<OffsetValueType>(region.GetSize(dim));
+    }
+    return offsetTable;
+  };
+  const auto sourceOffsetTable = computeOffsetTable(sourceRegion);
+  const auto destinationOffsetTable = computeOffsetTable(destinationRegion);
+  const auto computeOffset = [](const RegionType & region, const auto & offsetTable, const IndexType & index) {
+    OffsetValueType offset = 0;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      offset += (index[dim] - region.GetIndex(dim)) * offsetTable[dim];
+    }
+    return offset;
+  };
+
+  // the range of the source along the dimension, to which the indices are
+  // clamped
+  const IndexValueType first = sourceRegion.GetIndex(dimension);
+  const IndexValueType last = first + static_cast<IndexValueType>(sourceRegion.GetSize(dimension)) - 1;
+
+  const auto convolveRegion = [&](const RegionType & region) {
+    TotalProgressReporter progress(this, destinationRegion.GetNumberOfPixels(), 100, progressWeight);
+
+    const SizeValueType rowLength = region.GetSize(0);
+    RegionType          rowStarts = region;
+    rowStarts.SetSize(0, 1);
+
+    if (dimension == 0)
+    {
+      // each row, extended on both sides by the values at its ends, is
+      // convolved without any test at the borders
+      const SizeValueType paddedLength = rowLength + 2 * radius;
+      const auto          paddedRow = make_unique_for_overwrite<RealType[]>(paddedLength);
+      const auto          sums = make_unique_for_overwrite<RealType[]>(rowLength);
+
+      for (const IndexType & rowStart : ImageRegionIndexRange<ImageDimension>(rowStarts))
+      {
+        IndexType sourceRowStart = rowStart;
+        sourceRowStart[0] = first;
+        const TSourcePixel * const sourceRow =
+          source + computeOffset(sourceRegion, sourceOffsetTable, sourceRowStart);
+
+        const IndexValueType paddedFirst = rowStart[0] - static_cast<IndexValueType>(radius);
+        for (SizeValueType i = 0; i < paddedLength; ++i)
+        {
+          const IndexValueType index = std::clamp(paddedFirst + static_cast<IndexValueType>(i), first, last);
+          paddedRow[i] = static_cast<RealType>(sourceRow[index - first]);
+        }
+
+        const RealType * const center = paddedRow.get() + radius;
+        for (SizeValueType i = 0; i < rowLength; ++i)
+        {
+          sums[i] = coefficients[0] * center[i];
+        }
+        for (SizeValueType j = 1; j <= radius; ++j)
+        {
+          const RealType         coefficient = coefficients[j];
+          const RealType * const before = center - j;
+          const RealType * const after = center + j;
+          for (SizeValueType i = 0; i < rowLength; ++i)
+          {
+            sums[i] += coefficient * (before[i] + after[i]);
+          }
+        }
+
+        OutputPixelType * const destinationRow =
+          destination + computeOffset(destinationRegion, destinationOffsetTable, rowStart);
+        for (SizeValueType i = 0; i < rowLength; ++i)
+        {
+          destinationRow[i] = static_cast<OutputPixelType>(sums[i]);
+        }
+        progress.Completed(rowLength);
+      }
+    }
+    else
+    {
+      // the rows along the first dimension are convolved at once, the
+      // clamping of the indices along the dimension only changing which
+      // rows of the source are read. The rows are visited along the
+      // dimension, so that consecutive rows mostly read the same rows of
+      // the source.
+      const auto           sums = make_unique_for_overwrite<RealType[]>(rowLength);
+      const IndexValueType regionFirst = region.GetIndex(dimension);
+      const IndexValueType regionEnd = regionFirst + static_cast<IndexValueType>(region.GetSize(dimension));
+
+      RegionType columnStarts = rowStarts;
+      columnStarts.SetSize(dimension, 1);
+      for (const IndexType & columnStart : ImageRegionIndexRange<ImageDimension>(columnStarts))
+      {
+        const auto sourceRow = [&](IndexValueType index) {
+          IndexType sourceRowStart = columnStart;
+          sourceRowStart[dimension] = std::clamp(index, first, last);
+          return source + computeOffset(sourceRegion, sourceOffsetTable, sourceRowStart);
+        };
+
+        IndexType rowStart = columnStart;
+        for (IndexValueType position = regionFirst; position < regionEnd; ++position)
+        {
+          const TSourcePixel * const center = sourceRow(position);
+          for (SizeValueType i = 0; i < rowLength; ++i)
+          {
+            sums[i] = coefficients[0] * static_cast<RealType>(center[i]);
+          }
+          for (SizeValueType j = 1; j <= radius; ++j)
+          {
+            const RealType             coefficient = coefficients[j];
+            const TSourcePixel * const before = sourceRow(position - static_cast<IndexValueType>(j));
+            const TSourcePixel * const after = sourceRow(position + static_cast<IndexValueType>(j));
+            for (SizeValueType i = 0; i < rowLength; ++i)
+            {
+              sums[i] += coefficient * (static_cast<RealType>(before[i]) + static_cast<RealType>(after[i]));
+            }
+          }
+
+          rowStart[dimension] = position;
+          OutputPixelType * const destinationRow =
+            destination + computeOffset(destinationRegion, destinationOffsetTable, rowStart);
+          for (SizeValueType i = 0; i < rowLength; ++i)
+          {
+            destinationRow[i] = static_cast<OutputPixelType>(sums[i]);
+          }
+          progress.Completed(rowLength);
+        }
+      }
+    }
+  };
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    destinationRegion, convolveRegion, nullptr);
+}
+
 #if !defined(ITK_LEGACY_REMOVE)
 template <typename TInputImage, typename TOutputImage>
 unsigned int
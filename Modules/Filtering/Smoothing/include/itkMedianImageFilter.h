@@ -20,9 +20,45 @@
 
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
+#include "ITKSmoothingExport.h"
+
+#include <type_traits>
 
 namespace itk
 {
+/** \class MedianImageFilterEnums
+ * \brief Contains all enum classes used by MedianImageFilter class.
+ * \ingroup ITKSmoothing
+ */
+class MedianImageFilterEnums
+{
+public:
+  /**
+   * \class Algorithm
+   * \ingroup ITKSmoothing
+   * The algorithm which computes the median of each neighborhood.
+   *
+   * Sort selects the median of the neighborhood pixels copied to a buffer,
+   * for any pixel type, in O(r^d) per pixel.
+   *
+   * Histogram slides a histogram of the neighborhood along the rows of the
+   * image, in O(r^(d-1)) per pixel, for integral pixel types of at most 16
+   * bits. Other pixel types fall back to Sort.
+   *
+   * Automatic selects Histogram for these pixel types when the neighborhood
+   * is large enough for it to be faster, and Sort otherwise.
+   */
+  enum class Algorithm : uint8_t
+  {
+    Automatic = 0,
+    Sort,
+    Histogram,
+  };
+};
+// Define how to print enumeration
+extern ITKSmoothing_EXPORT std::ostream &
+operator<<(std::ostream & out, const MedianImageFilterEnums::Algorithm value);
+
 /**
  * \class MedianImageFilter
  * \brief Applies a median filter to an image
@@ -36,6 +72,12 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * For integral pixel types of at most 16 bits, such as the ones of CT
+ * images, the median can be found from a histogram of the neighborhood,
+ * updated as the neighborhood slides along each row. This makes large
+ * radii practical. The choice is made according to the pixel type and the
+ * radius, unless an algorithm is set with SetAlgorithm().
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -84,6 +126,13 @@ public:
 
   using InputSizeType = typename InputImageType::SizeType;
 
+  using AlgorithmEnum = MedianImageFilterEnums::Algorithm;
+
+  /** Set/Get the algorithm which computes the medians. Defaults to
+   * Automatic. */
+  itkSetEnumMacro(Algorithm, AlgorithmEnum);
+  itkGetEnumMacro(Algorithm, AlgorithmEnum);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
@@ -108,6 +157,28 @@ protected:
    *     ImageToImageFilter::GenerateData() */
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Whether the pixels are integral values of at most 16 bits, in a
+   * buffer, whose medians can be computed with a histogram. */
+  static constexpr bool HistogramPixelType =
+    std::is_same_v<InputImageType, Image<InputPixelType, InputImageDimension>> && std::is_integral_v<InputPixelType> &&
+    !std::is_same_v<InputPixelType, bool> && sizeof(InputPixelType) <= 2;
+
+  /** Whether the medians are computed with a sliding histogram, according
+   * to the algorithm, the pixel type and the radius. */
+  bool
+  UsesHistogram() const;
+
+  /** Computes the medians of outputRegionForThread with a histogram which
+   * slides along the rows of the region. */
+  void
+  HistogramThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
+
+  AlgorithmEnum m_Algorithm{ AlgorithmEnum::Automatic };
 };
 } // end namespace itk
 
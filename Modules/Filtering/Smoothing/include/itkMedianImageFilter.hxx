@@ -19,6 +19,7 @@
 #define itkMedianImageFilter_hxx
 
 #include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
+#include "itkImageScanlineIterator.h"
 #include "itkImageNeighborhoodOffsets.h"
 #include "itkImageRegionRange.h"
 #include "itkIndexRange.h"
@@ -44,6 +45,12 @@ void
 MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  if (this->UsesHistogram())
+  {
+    this->HistogramThreadedGenerateData(outputRegionForThread);
+    return;
+  }
+
   // Allocate output
   OutputImageType *      output = this->GetOutput();
   const InputImageType * input = this->GetInput();
@@ -104,6 +111,181 @@ MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
     }
   }
 }
+
+template <typename TInputImage, typename TOutputImage>
+bool
+MedianImageFilter<TInputImage, TOutputImage>::UsesHistogram() const
+{
+  if constexpr (HistogramPixelType)
+  {
+    if (m_Algorithm == AlgorithmEnum::Automatic)
+    {
+      // The histogram pays off once the neighborhood has more pixels than
+      // its columns which enter and leave at each step, and than the bins
+      // which may be scanned to find the median: from a 3x3 neighborhood
+      // for 8 bits, and from a 5x5 one for 16 bits.
+      const auto    radius = this->GetRadius();
+      SizeValueType neighborhoodSize = 1;
+      for (unsigned int i = 0; i < InputImageDimension; ++i)
+      {
+        neighborhoodSize *= 2 * radius[i] + 1;
+      }
+      return radius[0] > 0 && neighborhoodSize >= (sizeof(InputPixelType) == 1 ? 9 : 25);
+    }
+    return m_Algorithm == AlgorithmEnum::Histogram;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+MedianImageFilter<TInputImage, TOutputImage>::HistogramThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  if constexpr (HistogramPixelType)
+  {
+    OutputImageType *      output = this->GetOutput();
+    const InputImageType * input = this->GetInput();
+
+    const auto radius = this->GetRadius();
+
+    // The bins are grouped in blocks, whose counts let the search for the
+    // median skip the empty parts of the histogram.
+    constexpr unsigned int  numberOfBits = 8 * sizeof(InputPixelType);
+    constexpr SizeValueType numberOfBins = SizeValueType{ 1 } << numberOfBits;
+    constexpr SizeValueType blockSize = SizeValueType{ 1 } << (numberOfBits / 2);
+    constexpr auto          lowestValue = static_cast<int64_t>(NumericTraits<InputPixelType>::NonpositiveMin());
+    std::vector<SizeValueType> binCounts(numberOfBins);
+    std::vector<SizeValueType> blockCounts(numberOfBins / blockSize);
+
+    // The neighborhood is a window of columns along the first dimension,
+    // each column holding the pixels of a row offset. The indices are
+    // clamped to the buffer, as done by the zero flux Neumann boundary
+    // condition of the sorting algorithm.
+    InputSizeType rowRadius = radius;
+    rowRadius[0] = 0;
+    const auto rowOffsets = GenerateRectangularImageNeighborhoodOffsets<InputImageDimension>(rowRadius);
+    std::vector<OffsetValueType> rowBufferOffsets(rowOffsets.size());
+    const SizeValueType          rank = rowOffsets.size() * (2 * radius[0] + 1) / 2;
+
+    const InputPixelType * const buffer = input->GetBufferPointer();
+    const auto &                 bufferedRegion = input->GetBufferedRegion();
+    const OffsetValueType *      offsetTable = input->GetOffsetTable();
+    const auto clampedIndexValue = [&bufferedRegion](const IndexValueType indexValue, const unsigned int dimension) {
+      return std::clamp(indexValue - bufferedRegion.GetIndex(dimension),
+                        IndexValueType{ 0 },
+                        static_cast<IndexValueType>(bufferedRegion.GetSize(dimension)) - 1);
+    };
+
+    const auto addColumn = [&](const IndexValueType column, const SizeValueType medianBin, SizeValueType & countBelow) {
+      for (const OffsetValueType rowBufferOffset : rowBufferOffsets)
+      {
+        const auto bin = static_cast<SizeValueType>(buffer[rowBufferOffset + column] - lowestValue);
+        ++binCounts[bin];
+        ++blockCounts[bin / blockSize];
+        countBelow += bin < medianBin;
+      }
+    };
+    const auto removeColumn = [&](const IndexValueType column,
+                                  const SizeValueType  medianBin,
+                                  SizeValueType &      countBelow) {
+      for (const OffsetValueType rowBufferOffset : rowBufferOffsets)
+      {
+        const auto bin = static_cast<SizeValueType>(buffer[rowBufferOffset + column] - lowestValue);
+        --binCounts[bin];
+        --blockCounts[bin / blockSize];
+        countBelow -= bin < medianBin;
+      }
+    };
+
+    TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+    const auto radius0 = static_cast<IndexValueType>(radius[0]);
+    for (ImageScanlineIterator<OutputImageType> outIt(output, outputRegionForThread); !outIt.IsAtEnd();
+         outIt.NextLine())
+    {
+      const auto lineIndex = outIt.GetIndex();
+      for (size_t j = 0; j < rowOffsets.size(); ++j)
+      {
+        rowBufferOffsets[j] = 0;
+        for (unsigned int i = 1; i < InputImageDimension; ++i)
+        {
+          rowBufferOffsets[j] += clampedIndexValue(lineIndex[i] + rowOffsets[j][i], i) * offsetTable[i];
+        }
+      }
+
+      // The median bin, and the number of pixels in the bins below it.
+      SizeValueType medianBin = 0;
+      SizeValueType countBelow = 0;
+      for (IndexValueType x = lineIndex[0] - radius0; x <= lineIndex[0] + radius0; ++x)
+      {
+        addColumn(clampedIndexValue(x, 0), medianBin, countBelow);
+      }
+
+      const IndexValueType lineEnd = lineIndex[0] + static_cast<IndexValueType>(outputRegionForThread.GetSize(0));
+      for (IndexValueType x = lineIndex[0]; x < lineEnd; ++x)
+      {
+        if (x > lineIndex[0])
+        {
+          const IndexValueType leavingColumn = clampedIndexValue(x - radius0 - 1, 0);
+          const IndexValueType enteringColumn = clampedIndexValue(x + radius0, 0);
+          if (leavingColumn != enteringColumn)
+          {
+            removeColumn(leavingColumn, medianBin, countBelow);
+            addColumn(enteringColumn, medianBin, countBelow);
+          }
+        }
+
+        while (countBelow > rank)
+        {
+          if (medianBin % blockSize == 0 && blockCounts[medianBin / blockSize - 1] == 0)
+          {
+            medianBin -= blockSize;
+          }
+          else
+          {
+            --medianBin;
+            countBelow -= binCounts[medianBin];
+          }
+        }
+        while (countBelow + binCounts[medianBin] <= rank)
+        {
+          if (medianBin % blockSize == 0 && blockCounts[medianBin / blockSize] == 0)
+          {
+            medianBin += blockSize;
+          }
+          else
+          {
+            countBelow += binCounts[medianBin];
+            ++medianBin;
+          }
+        }
+        const auto median = static_cast<InputPixelType>(static_cast<int64_t>(medianBin) + lowestValue);
+        outIt.Set(static_cast<OutputPixelType>(median));
+        ++outIt;
+      }
+
+      // Empty the histogram for the next line.
+      for (IndexValueType x = lineEnd - 1 - radius0; x <= lineEnd - 1 + radius0; ++x)
+      {
+        removeColumn(clampedIndexValue(x, 0), medianBin, countBelow);
+      }
+      progress.Completed(outputRegionForThread.GetSize(0));
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+MedianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Algorithm: " << m_Algorithm << std::endl;
+}
 } // end namespace itk
 
 #endif
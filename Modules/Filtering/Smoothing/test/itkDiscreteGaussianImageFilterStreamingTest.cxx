@@ -0,0 +1,169 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+namespace
+{
+
+template <typename TImage>
+typename TImage::Pointer
+CreateRandomImage(const typename TImage::RegionType & region)
+{
+  auto image = TImage::New();
+  image->SetRegions(region);
+  image->SetSpacing(itk::MakeFilled<typename TImage::SpacingType>(0.75));
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  for (itk::ImageRegionIterator<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename TImage::PixelType>(generator->GetIntegerVariate(200)));
+  }
+  return image;
+}
+
+template <typename TImage>
+bool
+ImagesAreClose(const TImage * image1, const TImage * image2, double tolerance)
+{
+  if (image1->GetBufferedRegion() != image2->GetBufferedRegion())
+  {
+    std::cerr << "Different buffered regions: " << image1->GetBufferedRegion() << " and "
+              << image2->GetBufferedRegion() << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIterator<TImage> it1(image1, image1->GetBufferedRegion()),
+       it2(image2, image1->GetBufferedRegion());
+       !it1.IsAtEnd();
+       ++it1, ++it2)
+  {
+    if (std::abs(static_cast<double>(it1.Get()) - static_cast<double>(it2.Get())) > tolerance)
+    {
+      std::cerr << "Different values at " << it1.GetIndex() << ": " << +it1.Get() << " != " << +it2.Get()
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The convolution of the buffers gives the same result as the pipeline of
+// NeighborhoodOperatorImageFilter, which runs when the boundary condition is
+// not the default one, for the whole image, a requested region and by
+// streaming.
+template <typename TInputImage, typename TOutputImage>
+int
+TestBufferConvolution(unsigned int filterDimensionality, double tolerance)
+{
+  using FilterType = itk::DiscreteGaussianImageFilter<TInputImage, TOutputImage>;
+  constexpr unsigned int Dimension = TInputImage::ImageDimension;
+
+  std::cout << "Dimension: " << Dimension << ", FilterDimensionality: " << filterDimensionality << std::endl;
+
+  typename TInputImage::RegionType region;
+  region.SetIndex(itk::MakeFilled<typename TInputImage::IndexType>(-4));
+  region.SetSize(itk::MakeFilled<typename TInputImage::SizeType>(19));
+  region.SetSize(0, 33);
+  const auto input = CreateRandomImage<TInputImage>(region);
+
+  typename FilterType::ArrayType variance;
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    variance[dim] = 0.5 + dim;
+  }
+
+  auto filter = FilterType::New();
+  filter->SetInput(input);
+  filter->SetVariance(variance);
+  filter->SetMaximumKernelWidth(9);
+  filter->SetFilterDimensionality(filterDimensionality);
+
+  // an instance of the default boundary condition other than the default
+  // one of the filter
+  itk::ZeroFluxNeumannBoundaryCondition<TInputImage>  inputBoundaryCondition;
+  itk::ZeroFluxNeumannBoundaryCondition<TOutputImage> realBoundaryCondition;
+  auto                                                referenceFilter = FilterType::New();
+  referenceFilter->SetInput(input);
+  referenceFilter->SetVariance(variance);
+  referenceFilter->SetMaximumKernelWidth(9);
+  referenceFilter->SetFilterDimensionality(filterDimensionality);
+  referenceFilter->SetInputBoundaryCondition(&inputBoundaryCondition);
+  referenceFilter->SetRealBoundaryCondition(&realBoundaryCondition);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+  ITK_TEST_EXPECT_TRUE(ImagesAreClose<TOutputImage>(filter->GetOutput(), referenceFilter->GetOutput(), tolerance));
+
+  typename TOutputImage::RegionType requestedRegion = region;
+  requestedRegion.ShrinkByRadius(3);
+  requestedRegion.SetIndex(1, region.GetIndex(1));
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  referenceFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+  ITK_TEST_EXPECT_TRUE(ImagesAreClose<TOutputImage>(filter->GetOutput(), referenceFilter->GetOutput(), tolerance));
+
+  auto streamer = itk::StreamingImageFilter<TOutputImage, TOutputImage>::New();
+  streamer->SetInput(filter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(5);
+  referenceFilter->GetOutput()->SetRequestedRegion(region);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+  ITK_TEST_EXPECT_TRUE(ImagesAreClose<TOutputImage>(streamer->GetOutput(), referenceFilter->GetOutput(), tolerance));
+
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkDiscreteGaussianImageFilterStreamingTest(int, char *[])
+{
+  using ShortImageType3D = itk::Image<short, 3>;
+  using FloatImageType3D = itk::Image<float, 3>;
+  using UCharImageType2D = itk::Image<unsigned char, 2>;
+  using DoubleImageType4D = itk::Image<double, 4>;
+
+  int result = EXIT_SUCCESS;
+  for (const unsigned int filterDimensionality : { 1, 2, 3 })
+  {
+    if (TestBufferConvolution<ShortImageType3D, FloatImageType3D>(filterDimensionality, 1e-4) == EXIT_FAILURE)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+  // the intermediate results are rounded to the output pixel type
+  if (TestBufferConvolution<UCharImageType2D, UCharImageType2D>(2, 1.0) == EXIT_FAILURE)
+  {
+    result = EXIT_FAILURE;
+  }
+  if (TestBufferConvolution<DoubleImageType4D, DoubleImageType4D>(4, 1e-10) == EXIT_FAILURE)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
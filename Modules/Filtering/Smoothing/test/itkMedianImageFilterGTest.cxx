@@ -23,6 +23,8 @@
 #include "itkImageBufferRange.h"
 
 #include <numeric> // For iota.
+#include <random>
+#include <sstream>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -92,6 +94,50 @@ Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numb
   EXPECT_EQ(outputPixelValues, expectedPixelValues);
 }
 
+
+// Expects that the histogram algorithm gives the same medians as the sorting
+// algorithm, for a random image, a radius, and a requested output region.
+template <typename TImage>
+void
+Expect_histogram_algorithm_gives_same_output_as_sort_algorithm(const typename TImage::RegionType & imageRegion,
+                                                               const typename TImage::SizeType &   radius,
+                                                               const typename TImage::RegionType & requestedRegion)
+{
+  using PixelType = typename TImage::PixelType;
+  using FilterType = itk::MedianImageFilter<TImage, TImage>;
+
+  const auto image = TImage::New();
+  image->SetRegions(imageRegion);
+  image->Allocate();
+  std::mt19937 randomEngine;
+  for (auto & pixel : itk::MakeImageBufferRange(image.GetPointer()))
+  {
+    // Values in a narrow range most of the time, so that both the search
+    // within and across the blocks of the histogram are exercised.
+    pixel = static_cast<PixelType>(randomEngine() % 8 == 0 ? randomEngine() : 100 + randomEngine() % 20);
+  }
+
+  const auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetRadius(radius);
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+
+  filter->SetAlgorithm(FilterType::AlgorithmEnum::Sort);
+  filter->Update();
+  const typename TImage::Pointer sortOutput = filter->GetOutput();
+  sortOutput->DisconnectPipeline();
+
+  filter->SetAlgorithm(FilterType::AlgorithmEnum::Histogram);
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+  const TImage * const histogramOutput = filter->GetOutput();
+
+  ASSERT_EQ(histogramOutput->GetBufferedRegion(), sortOutput->GetBufferedRegion());
+  const auto sortPixels = itk::MakeImageBufferRange(sortOutput.GetPointer());
+  const auto histogramPixels = itk::MakeImageBufferRange(histogramOutput);
+  EXPECT_TRUE(std::equal(sortPixels.cbegin(), sortPixels.cend(), histogramPixels.cbegin()));
+}
+
 } // namespace
 
 
@@ -122,3 +168,42 @@ TEST(MedianImageFilter, ExpectedOutputPixelValuesForSequenceOfNaturalNumbers)
   Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numbers<itk::Image<int, 3>>(
     itk::Size<3>{ { 2, 2, 2 } }, { 3, 3, 3, 4, 5, 6, 6, 6 });
 }
+
+
+// Tests that the histogram algorithm gives the same output as the sorting algorithm.
+TEST(MedianImageFilter, HistogramAlgorithmGivesSameOutputAsSortAlgorithm)
+{
+  using RegionType2D = itk::ImageRegion<2>;
+  using RegionType3D = itk::ImageRegion<3>;
+
+  const RegionType2D region2D(itk::Index<2>{ { -3, 5 } }, itk::Size<2>{ { 37, 29 } });
+  Expect_histogram_algorithm_gives_same_output_as_sort_algorithm<itk::Image<unsigned char>>(
+    region2D, itk::Size<2>{ { 3, 2 } }, region2D);
+  Expect_histogram_algorithm_gives_same_output_as_sort_algorithm<itk::Image<signed char>>(
+    region2D, itk::Size<2>{ { 1, 4 } }, region2D);
+  Expect_histogram_algorithm_gives_same_output_as_sort_algorithm<itk::Image<short>>(
+    region2D, itk::Size<2>{ { 20, 1 } }, RegionType2D(itk::Index<2>{ { 2, 8 } }, itk::Size<2>{ { 15, 9 } }));
+  Expect_histogram_algorithm_gives_same_output_as_sort_algorithm<itk::Image<unsigned short>>(
+    region2D, itk::Size<2>{ { 0, 3 } }, region2D);
+
+  const RegionType3D region3D(itk::Size<3>{ { 21, 18, 15 } });
+  Expect_histogram_algorithm_gives_same_output_as_sort_algorithm<itk::Image<short, 3>>(
+    region3D, itk::Size<3>{ { 2, 3, 2 } }, region3D);
+  Expect_histogram_algorithm_gives_same_output_as_sort_algorithm<itk::Image<unsigned short, 3>>(
+    region3D, itk::Size<3>{ { 4, 1, 3 } }, RegionType3D(itk::Index<3>{ { 3, 0, 10 } }, itk::Size<3>{ { 9, 7, 5 } }));
+}
+
+
+// Tests that the algorithm can be set, and is printed.
+TEST(MedianImageFilter, Algorithm)
+{
+  using FilterType = itk::MedianImageFilter<itk::Image<short, 3>, itk::Image<short, 3>>;
+  const auto filter = FilterType::New();
+  EXPECT_EQ(filter->GetAlgorithm(), FilterType::AlgorithmEnum::Automatic);
+  filter->SetAlgorithm(FilterType::AlgorithmEnum::Histogram);
+  EXPECT_EQ(filter->GetAlgorithm(), FilterType::AlgorithmEnum::Histogram);
+
+  std::ostringstream os;
+  filter->Print(os);
+  EXPECT_NE(os.str().find("itk::MedianImageFilterEnums::Algorithm::Histogram"), std::string::npos);
+}
@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRecursiveGaussianImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkIndexRange.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using InputImageType = itk::Image<short, Dimension>;
+using OutputImageType = itk::Image<float, Dimension>;
+using FilterType = itk::RecursiveGaussianImageFilter<InputImageType, OutputImageType>;
+using LineImageType = itk::Image<short, 1>;
+using LineFilterType = itk::RecursiveGaussianImageFilter<LineImageType, itk::Image<float, 1>>;
+
+// Filtering an image along an axis, by blocks of adjacent lines, gives the
+// same result as filtering each line as a one-dimensional image.
+bool
+TestAlongAxis(const InputImageType *              image,
+              unsigned int                        axis,
+              FilterType::OrderEnumType           order,
+              const OutputImageType::RegionType & requestedRegion)
+{
+  std::cout << "Axis: " << axis << ", order: " << order << std::endl;
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetDirection(axis);
+  filter->SetOrder(order);
+  filter->SetSigma(2.5);
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+
+  const OutputImageType *             output = filter->GetOutput();
+  const OutputImageType::RegionType & outputRegion = output->GetBufferedRegion();
+  const itk::SizeValueType            ln = image->GetBufferedRegion().GetSize(axis);
+  if (outputRegion.GetSize(axis) != ln)
+  {
+    std::cerr << "The buffered region " << outputRegion << " does not span the whole axis" << std::endl;
+    return false;
+  }
+
+  auto line = LineImageType::New();
+  line->SetRegions(LineImageType::SizeType{ { ln } });
+  line->SetSpacing(itk::MakeVector(image->GetSpacing()[axis]));
+  line->Allocate();
+  auto lineFilter = LineFilterType::New();
+  lineFilter->SetInput(line);
+  lineFilter->SetOrder(order);
+  lineFilter->SetSigma(2.5);
+
+  OutputImageType::RegionType lineStarts = outputRegion;
+  lineStarts.SetSize(axis, 1);
+  for (const auto & lineStart : itk::ImageRegionIndexRange<Dimension>(lineStarts))
+  {
+    OutputImageType::IndexType index = lineStart;
+    for (itk::SizeValueType i = 0; i < ln; ++i, ++index[axis])
+    {
+      line->SetPixel({ { static_cast<itk::IndexValueType>(i) } }, image->GetPixel(index));
+    }
+    line->Modified();
+    lineFilter->Update();
+
+    index = lineStart;
+    for (itk::SizeValueType i = 0; i < ln; ++i, ++index[axis])
+    {
+      const float expected = lineFilter->GetOutput()->GetPixel({ { static_cast<itk::IndexValueType>(i) } });
+      if (std::abs(output->GetPixel(index) - expected) > 1e-5f * (1.0f + std::abs(expected)))
+      {
+        std::cerr << "Different values at " << index << ": " << output->GetPixel(index) << " != " << expected
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkRecursiveGaussianImageFilterAlongAxesTest(int, char *[])
+{
+  // the sizes are not multiples of the number of lines filtered together
+  const InputImageType::RegionType region({ { -3, 2, 1 } }, { { 37, 21, 13 } });
+  auto                             image = InputImageType::New();
+  image->SetRegions(region);
+  image->SetSpacing(itk::MakeVector(0.5, 1.0, 2.0));
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  for (itk::ImageRegionIterator<InputImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<short>(generator->GetIntegerVariate(2000)) - 1000);
+  }
+
+  // a requested region smaller than the input, so that the input and the
+  // output buffers have different strides
+  OutputImageType::RegionType requestedRegion = region;
+  requestedRegion.ShrinkByRadius(2);
+  requestedRegion.SetSize(1, 5);
+
+  using OrderEnumType = FilterType::OrderEnumType;
+  for (const unsigned int axis : { 0, 1, 2 })
+  {
+    for (const OrderEnumType order :
+         { OrderEnumType::ZeroOrder, OrderEnumType::FirstOrder, OrderEnumType::SecondOrder })
+    {
+      ITK_TEST_EXPECT_TRUE(TestAlongAxis(image, axis, order, region));
+      ITK_TEST_EXPECT_TRUE(TestAlongAxis(image, axis, order, requestedRegion));
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
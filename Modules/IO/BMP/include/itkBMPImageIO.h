@@ -55,6 +55,13 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(BMPImageIO);
 
+  /** \see ImageIOBase::CanCloneSettings() */
+  bool
+  CanCloneSettings() const override
+  {
+    return true;
+  }
+
   /** Getter for the FileLowerLeft attribute. */
   itkGetConstMacro(FileLowerLeft, bool);
 
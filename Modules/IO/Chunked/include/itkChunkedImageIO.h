@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkChunkedImageIO_h
+#define itkChunkedImageIO_h
+#include "ITKIOChunkedExport.h"
+
+#include "itkStreamingImageIOBase.h"
+#include "itkMultiThreaderBase.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class ChunkedImageIO
+ *
+ * \brief ImageIO for a chunked, compressed, randomly accessible N-D file format.
+ *
+ * The image is divided into a regular grid of fixed-size N-dimensional
+ * chunks, in the spirit of Zarr and OME-NGFF, but stored in a single local
+ * file with the extension ".cki". Each chunk is compressed independently and
+ * located through an index stored after the header, so that any region of
+ * the image can be read by decoding only the chunks it intersects, and
+ * written by encoding only those chunks. Chunks are encoded and decoded in
+ * parallel on the multi-threader of this ImageIO, on at most
+ * MaximumNumberOfWorkUnits work units when it is not 0.
+ *
+ * The file layout, with all numbers stored little endian, is:
+ * - the magic "ITKCKI01";
+ * - the number of dimensions N, the IOComponentEnum, the IOPixelEnum, the
+ *   number of components, the codec (0: raw, 1: zlib) and a reserved
+ *   field, as 32-bit unsigned integers;
+ * - the size of the image and of the chunks, as N 64-bit unsigned integers
+ *   each;
+ * - the spacing, the origin and the N direction vectors, as doubles;
+ * - the number of chunks, followed by the byte offset and byte count of
+ *   each chunk, as 64-bit unsigned integers, with an offset of zero for a
+ *   chunk which was never written (all pixels zero);
+ * - the chunk data.
+ *
+ * Chunks are numbered with the first axis varying fastest. A chunk at the
+ * border of the image only holds the pixels inside the image, and its
+ * pixels are stored with the first axis varying fastest.
+ *
+ * Chunks are compressed with zlib when compression is enabled, see
+ * SetUseCompression, and stored raw otherwise. Both reading and writing
+ * of arbitrary regions are supported, see CanStreamRead and
+ * CanStreamWrite. Writing a region which only partially covers a chunk
+ * decodes the existing chunk first. A chunk whose new encoding does not fit
+ * in its previous place is appended to the file, leaving the previous place
+ * unused. The streamed writing splits are aligned to the chunk boundaries
+ * along the last axis, so that every chunk is encoded once.
+ *
+ * \sa ImageFileWriter ImageFileReader StreamingImageIOBase
+ * \ingroup IOFilters
+ * \ingroup ITKIOChunked
+ */
+class ITKIOChunked_EXPORT ChunkedImageIO : public StreamingImageIOBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ChunkedImageIO);
+
+  /** Standard class type aliases. */
+  using Self = ChunkedImageIO;
+  using Superclass = StreamingImageIOBase;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ChunkedImageIO);
+
+  /** Set/Get the number of pixels of the chunks along the given axis. A
+   * value of zero, the default, selects 64 pixels. The chunks are never
+   * larger than the image. Only used when a new file is written: after
+   * ReadImageInformation, the chunk size is the one of the file. */
+  void
+  SetChunkSize(unsigned int axis, SizeValueType size);
+  SizeValueType
+  GetChunkSize(unsigned int axis) const;
+
+  /** Set/Get the multi-threader which encodes and decodes the chunks. */
+  itkSetObjectMacro(MultiThreader, MultiThreaderBase);
+  itkGetModifiableObjectMacro(MultiThreader, MultiThreaderBase);
+
+  bool
+  SupportsDimension(unsigned long dim) override;
+
+  //-------- This part of the interface deals with reading data. ------
+
+  // See super class for documentation
+  bool
+  CanReadFile(const char *) override;
+
+  // See super class for documentation
+  void
+  ReadImageInformation() override;
+
+  // See super class for documentation
+  void
+  Read(void * buffer) override;
+
+  // -------- This part of the interfaces deals with writing data. -----
+
+  // See super class for documentation
+  bool
+  CanWriteFile(const char *) override;
+
+  // The header is written together with the data.
+  void
+  WriteImageInformation() override
+  {}
+
+  // See super class for documentation
+  void
+  Write(const void * buffer) override;
+
+  /** Overridden to limit the number of splits to the number of chunk
+   * layers along the last axis of the paste region. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  /** Overridden to return splits aligned to the chunk boundaries along
+   * the last axis. */
+  ImageIORegion
+  GetSplitRegionForWriting(unsigned int          ithPiece,
+                           unsigned int          numberOfActualSplits,
+                           const ImageIORegion & pasteRegion,
+                           const ImageIORegion & largestPossibleRegion) override;
+
+protected:
+  ChunkedImageIO();
+  ~ChunkedImageIO() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  InternalSetCompressor(const std::string & _compressor) override;
+
+  /** Returns the size of the header, without the chunk index. */
+  SizeType
+  GetHeaderSize() const override;
+
+private:
+  /** The chunk size of the existing file when pasting into it, else the
+   * chunk size used to write a new file. */
+  std::vector<SizeValueType>
+  GetChunkSizeForWriting() const;
+
+  /** Calls func for each index of [first, last), in contiguous groups run on
+   * the multi-threader, with at most MaximumNumberOfWorkUnits groups when it
+   * is not 0. A single group runs on the calling thread. */
+  void
+  ParallelizeChunks(SizeValueType                                        first,
+                    SizeValueType                                        last,
+                    const MultiThreaderBase::ArrayThreadingFunctorType & func) const;
+
+  std::vector<SizeValueType> m_ChunkSize{};
+  MultiThreaderBase::Pointer m_MultiThreader{};
+};
+} // end namespace itk
+
+#endif // itkChunkedImageIO_h
@@ -0,0 +1,19 @@
+set(DOCUMENTATION "This module contains an ImageIO class for reading and writing
+images in a chunked, compressed file format. The image is divided into
+fixed-size N-dimensional chunks which are compressed independently and located
+through an index, so that arbitrary regions can be read and written without
+decompressing the whole image, and chunks are encoded and decoded in parallel.")
+
+itk_module(
+  ITKIOChunked
+  ENABLE_SHARED
+  DEPENDS
+  ITKIOImageBase
+  PRIVATE_DEPENDS
+  ITKZLIB
+  TEST_DEPENDS
+  ITKTestKernel
+  FACTORY_NAMES
+  ImageIO::Chunked
+  DESCRIPTION
+  "${DOCUMENTATION}")
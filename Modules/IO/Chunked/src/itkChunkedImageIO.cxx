@@ -0,0 +1,965 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkChunkedImageIO.h"
+#include "itkByteSwapper.h"
+#include "itkPrintHelper.h"
+#include "itk_zlib.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace itk
+{
+namespace
+{
+constexpr char          ChunkedImageMagic[] = { 'I', 'T', 'K', 'C', 'K', 'I', '0', '1' };
+constexpr unsigned int  MaximumNumberOfDimensions = 32;
+constexpr SizeValueType DefaultChunkSize = 64;
+
+enum class ChunkCodec : uint32_t
+{
+  Raw = 0,
+  Zlib = 1
+};
+
+struct ChunkLocation
+{
+  uint64_t Offset{ 0 };
+  uint64_t NumberOfBytes{ 0 };
+};
+
+struct ChunkedImageHeader
+{
+  uint32_t                   ComponentType{ 0 };
+  uint32_t                   PixelType{ 0 };
+  uint32_t                   NumberOfComponents{ 0 };
+  ChunkCodec                 Codec{ ChunkCodec::Raw };
+  std::vector<uint64_t>      Size{};
+  std::vector<uint64_t>      ChunkSize{};
+  std::vector<double>        Spacing{};
+  std::vector<double>        Origin{};
+  std::vector<double>        Direction{};
+  std::vector<ChunkLocation> Chunks{};
+
+  unsigned int
+  GetNumberOfDimensions() const
+  {
+    return static_cast<unsigned int>(Size.size());
+  }
+
+  /** Number of chunks along the given axis. */
+  uint64_t
+  GetNumberOfChunks(unsigned int axis) const
+  {
+    return (Size[axis] + ChunkSize[axis] - 1) / ChunkSize[axis];
+  }
+
+  uint64_t
+  GetNumberOfChunks() const
+  {
+    uint64_t numberOfChunks = 1;
+    for (unsigned int i = 0; i < this->GetNumberOfDimensions(); ++i)
+    {
+      numberOfChunks *= this->GetNumberOfChunks(i);
+    }
+    return numberOfChunks;
+  }
+
+  /** The region of the image covered by a chunk. */
+  ImageIORegion
+  GetChunkRegion(uint64_t chunk) const
+  {
+    ImageIORegion region(this->GetNumberOfDimensions());
+    for (unsigned int i = 0; i < this->GetNumberOfDimensions(); ++i)
+    {
+      const uint64_t position = chunk % this->GetNumberOfChunks(i);
+      chunk /= this->GetNumberOfChunks(i);
+      region.SetIndex(i, static_cast<IndexValueType>(position * ChunkSize[i]));
+      region.SetSize(i, std::min(ChunkSize[i], Size[i] - position * ChunkSize[i]));
+    }
+    return region;
+  }
+
+  /** The chunks intersecting a region of the image, in file order. */
+  std::vector<uint64_t>
+  GetChunksInRegion(const ImageIORegion & region) const
+  {
+    const unsigned int    numberOfDimensions = this->GetNumberOfDimensions();
+    std::vector<uint64_t> first(numberOfDimensions);
+    std::vector<uint64_t> last(numberOfDimensions);
+    for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+      if (region.GetSize(i) == 0)
+      {
+        return {};
+      }
+      first[i] = static_cast<uint64_t>(region.GetIndex(i)) / ChunkSize[i];
+      last[i] = (static_cast<uint64_t>(region.GetIndex(i)) + region.GetSize(i) - 1) / ChunkSize[i];
+    }
+
+    std::vector<uint64_t> chunks;
+    std::vector<uint64_t> position = first;
+    while (true)
+    {
+      uint64_t chunk = 0;
+      for (unsigned int i = numberOfDimensions; i > 0; --i)
+      {
+        chunk = chunk * this->GetNumberOfChunks(i - 1) + position[i - 1];
+      }
+      chunks.push_back(chunk);
+
+      unsigned int axis = 0;
+      while (axis < numberOfDimensions && ++position[axis] > last[axis])
+      {
+        position[axis] = first[axis];
+        ++axis;
+      }
+      if (axis == numberOfDimensions)
+      {
+        return chunks;
+      }
+    }
+  }
+
+  /** Byte offset of the chunk index in the file. */
+  std::streamoff
+  GetIndexPosition() const
+  {
+    const std::streamoff numberOfDimensions = this->GetNumberOfDimensions();
+    return sizeof(ChunkedImageMagic) + 6 * sizeof(uint32_t) + 4 * numberOfDimensions * sizeof(uint64_t) +
+           numberOfDimensions * numberOfDimensions * sizeof(double);
+  }
+
+  /** Byte offset of the first chunk in a newly written file. */
+  std::streamoff
+  GetDataPosition() const
+  {
+    return this->GetIndexPosition() + sizeof(uint64_t) +
+           static_cast<std::streamoff>(Chunks.size() * 2 * sizeof(uint64_t));
+  }
+};
+
+template <typename T>
+void
+WriteLittleEndian(std::ostream & os, T value)
+{
+  ByteSwapper<T>::SwapFromSystemToLittleEndian(&value);
+  os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+T
+ReadLittleEndian(std::istream & is)
+{
+  T value{};
+  is.read(reinterpret_cast<char *>(&value), sizeof(T));
+  ByteSwapper<T>::SwapFromSystemToLittleEndian(&value);
+  return value;
+}
+
+void
+WriteChunkIndex(std::ostream & os, const ChunkedImageHeader & header)
+{
+  os.seekp(header.GetIndexPosition(), std::ios::beg);
+  WriteLittleEndian<uint64_t>(os, header.Chunks.size());
+  for (const ChunkLocation & location : header.Chunks)
+  {
+    WriteLittleEndian(os, location.Offset);
+    WriteLittleEndian(os, location.NumberOfBytes);
+  }
+}
+
+void
+WriteHeader(std::ostream & os, const ChunkedImageHeader & header)
+{
+  os.write(ChunkedImageMagic, sizeof(ChunkedImageMagic));
+  WriteLittleEndian<uint32_t>(os, header.GetNumberOfDimensions());
+  WriteLittleEndian(os, header.ComponentType);
+  WriteLittleEndian(os, header.PixelType);
+  WriteLittleEndian(os, header.NumberOfComponents);
+  WriteLittleEndian(os, static_cast<uint32_t>(header.Codec));
+  WriteLittleEndian<uint32_t>(os, 0);
+  for (const auto & values : { header.Size, header.ChunkSize })
+  {
+    for (const uint64_t value : values)
+    {
+      WriteLittleEndian(os, value);
+    }
+  }
+  for (const auto & values : { header.Spacing, header.Origin, header.Direction })
+  {
+    for (const double value : values)
+    {
+      WriteLittleEndian(os, value);
+    }
+  }
+  WriteChunkIndex(os, header);
+}
+
+bool
+ReadMagic(std::istream & is)
+{
+  char magic[sizeof(ChunkedImageMagic)];
+  is.read(magic, sizeof(magic));
+  return is.good() && std::equal(magic, magic + sizeof(magic), ChunkedImageMagic);
+}
+
+ChunkedImageHeader
+ReadHeader(std::istream & is, const std::string & fileName)
+{
+  is.seekg(0, std::ios::end);
+  const auto fileSize = static_cast<uint64_t>(std::max<std::streamoff>(is.tellg(), 0));
+  is.seekg(0, std::ios::beg);
+  if (!ReadMagic(is))
+  {
+    itkGenericExceptionMacro("File is not a chunked image: " << fileName);
+  }
+
+  ChunkedImageHeader header;
+  const auto         numberOfDimensions = ReadLittleEndian<uint32_t>(is);
+  header.ComponentType = ReadLittleEndian<uint32_t>(is);
+  header.PixelType = ReadLittleEndian<uint32_t>(is);
+  header.NumberOfComponents = ReadLittleEndian<uint32_t>(is);
+  header.Codec = static_cast<ChunkCodec>(ReadLittleEndian<uint32_t>(is));
+  ReadLittleEndian<uint32_t>(is);
+  if (!is.good() || numberOfDimensions == 0 || numberOfDimensions > MaximumNumberOfDimensions ||
+      header.ComponentType == 0 || header.ComponentType > static_cast<uint32_t>(IOComponentEnum::LDOUBLE) ||
+      header.PixelType > static_cast<uint32_t>(IOPixelEnum::VARIABLESIZEMATRIX) || header.NumberOfComponents == 0 ||
+      (header.Codec != ChunkCodec::Raw && header.Codec != ChunkCodec::Zlib))
+  {
+    itkGenericExceptionMacro("Invalid header in chunked image: " << fileName);
+  }
+
+  for (auto * values : { &header.Size, &header.ChunkSize })
+  {
+    values->resize(numberOfDimensions);
+    for (uint64_t & value : *values)
+    {
+      value = ReadLittleEndian<uint64_t>(is);
+    }
+  }
+  for (auto * values : { &header.Spacing, &header.Origin })
+  {
+    values->resize(numberOfDimensions);
+    for (double & value : *values)
+    {
+      value = ReadLittleEndian<double>(is);
+    }
+  }
+  header.Direction.resize(numberOfDimensions * numberOfDimensions);
+  for (double & value : header.Direction)
+  {
+    value = ReadLittleEndian<double>(is);
+  }
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    if (header.Size[i] == 0 || header.ChunkSize[i] == 0 || header.ChunkSize[i] > header.Size[i])
+    {
+      itkGenericExceptionMacro("Invalid image or chunk size in chunked image: " << fileName);
+    }
+  }
+
+  const auto numberOfChunks = ReadLittleEndian<uint64_t>(is);
+  if (!is.good() || numberOfChunks != header.GetNumberOfChunks() ||
+      numberOfChunks > (fileSize - std::min<uint64_t>(fileSize, header.GetIndexPosition())) / (2 * sizeof(uint64_t)))
+  {
+    itkGenericExceptionMacro("Invalid chunk index in chunked image: " << fileName);
+  }
+  header.Chunks.resize(numberOfChunks);
+  for (ChunkLocation & location : header.Chunks)
+  {
+    location.Offset = ReadLittleEndian<uint64_t>(is);
+    location.NumberOfBytes = ReadLittleEndian<uint64_t>(is);
+  }
+  if (!is.good())
+  {
+    itkGenericExceptionMacro("Unexpected end of the chunk index in chunked image: " << fileName);
+  }
+
+  // The written chunks lie in the file, after the chunk index.
+  const auto dataPosition = static_cast<uint64_t>(header.GetDataPosition());
+  for (uint64_t chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    const ChunkLocation & location = header.Chunks[chunk];
+    if (location.Offset != 0 && (location.Offset < dataPosition || location.Offset > fileSize ||
+                                 location.NumberOfBytes > fileSize - location.Offset))
+    {
+      itkGenericExceptionMacro("Chunk " << chunk << " lies outside of chunked image: " << fileName);
+    }
+  }
+  return header;
+}
+
+/** The region expressed with the given number of dimensions: the missing
+ * trailing axes are a single slice at index zero. */
+ImageIORegion
+GetRegionWithDimension(const ImageIORegion & region, unsigned int numberOfDimensions)
+{
+  ImageIORegion result(numberOfDimensions);
+  for (unsigned int i = 0; i < numberOfDimensions && i < region.GetImageDimension(); ++i)
+  {
+    result.SetIndex(i, region.GetIndex(i));
+    result.SetSize(i, region.GetSize(i));
+  }
+  for (unsigned int i = region.GetImageDimension(); i < numberOfDimensions; ++i)
+  {
+    result.SetIndex(i, 0);
+    result.SetSize(i, 1);
+  }
+  return result;
+}
+
+/** Copies the pixels in the intersection of two regions, from the buffer
+ * holding the source region to the buffer holding the destination region. */
+void
+CopyIntersection(const char *          source,
+                 const ImageIORegion & sourceRegion,
+                 char *                destination,
+                 const ImageIORegion & destinationRegion,
+                 SizeValueType         pixelSize)
+{
+  const unsigned int         numberOfDimensions = sourceRegion.GetImageDimension();
+  ImageIORegion              intersection(numberOfDimensions);
+  std::vector<SizeValueType> sourceStride(numberOfDimensions);
+  std::vector<SizeValueType> destinationStride(numberOfDimensions);
+  SizeValueType              numberOfLines = 1;
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    const IndexValueType begin = std::max(sourceRegion.GetIndex(i), destinationRegion.GetIndex(i));
+    const IndexValueType end =
+      std::min(sourceRegion.GetIndex(i) + static_cast<IndexValueType>(sourceRegion.GetSize(i)),
+               destinationRegion.GetIndex(i) + static_cast<IndexValueType>(destinationRegion.GetSize(i)));
+    if (end <= begin)
+    {
+      return;
+    }
+    intersection.SetIndex(i, begin);
+    intersection.SetSize(i, static_cast<SizeValueType>(end - begin));
+    sourceStride[i] = (i == 0) ? pixelSize : sourceStride[i - 1] * sourceRegion.GetSize(i - 1);
+    destinationStride[i] = (i == 0) ? pixelSize : destinationStride[i - 1] * destinationRegion.GetSize(i - 1);
+    if (i > 0)
+    {
+      numberOfLines *= intersection.GetSize(i);
+    }
+  }
+
+  const SizeValueType      lineSize = intersection.GetSize(0) * pixelSize;
+  ImageIORegion::IndexType position = intersection.GetIndex();
+  for (SizeValueType line = 0; line < numberOfLines; ++line)
+  {
+    SizeValueType sourceOffset = 0;
+    SizeValueType destinationOffset = 0;
+    for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+      sourceOffset += static_cast<SizeValueType>(position[i] - sourceRegion.GetIndex(i)) * sourceStride[i];
+      destinationOffset +=
+        static_cast<SizeValueType>(position[i] - destinationRegion.GetIndex(i)) * destinationStride[i];
+    }
+    std::memcpy(destination + destinationOffset, source + sourceOffset, lineSize);
+
+    for (unsigned int i = 1; i < numberOfDimensions; ++i)
+    {
+      if (++position[i] < intersection.GetIndex(i) + static_cast<IndexValueType>(intersection.GetSize(i)))
+      {
+        break;
+      }
+      position[i] = intersection.GetIndex(i);
+    }
+  }
+}
+
+/** Swaps the components between the system and the little endian byte
+ * order of the file. */
+void
+SwapFromSystemToLittleEndian(char * buffer, SizeValueType numberOfComponents, unsigned int componentSize)
+{
+  switch (componentSize)
+  {
+    case 2:
+      ByteSwapper<uint16_t>::SwapRangeFromSystemToLittleEndian(reinterpret_cast<uint16_t *>(buffer),
+                                                               numberOfComponents);
+      break;
+    case 4:
+      ByteSwapper<uint32_t>::SwapRangeFromSystemToLittleEndian(reinterpret_cast<uint32_t *>(buffer),
+                                                               numberOfComponents);
+      break;
+    case 8:
+      ByteSwapper<uint64_t>::SwapRangeFromSystemToLittleEndian(reinterpret_cast<uint64_t *>(buffer),
+                                                               numberOfComponents);
+      break;
+    default:
+      break;
+  }
+}
+
+/** Encodes the chunk, returns false on failure. */
+bool
+EncodeChunk(std::vector<char> & chunk, ChunkCodec codec, int compressionLevel, std::vector<char> & encoded)
+{
+  if (codec == ChunkCodec::Raw)
+  {
+    encoded.swap(chunk);
+    return true;
+  }
+  auto numberOfBytes = compressBound(static_cast<uLong>(chunk.size()));
+  encoded.resize(numberOfBytes);
+  if (compress2(reinterpret_cast<Bytef *>(encoded.data()),
+                &numberOfBytes,
+                reinterpret_cast<const Bytef *>(chunk.data()),
+                static_cast<uLong>(chunk.size()),
+                compressionLevel) != Z_OK)
+  {
+    return false;
+  }
+  encoded.resize(numberOfBytes);
+  return true;
+}
+
+/** Decodes the chunk into a buffer of the expected size, returns false on
+ * failure. */
+bool
+DecodeChunk(const std::vector<char> & encoded, ChunkCodec codec, std::vector<char> & chunk)
+{
+  if (codec == ChunkCodec::Raw)
+  {
+    if (encoded.size() != chunk.size())
+    {
+      return false;
+    }
+    std::copy(encoded.begin(), encoded.end(), chunk.begin());
+    return true;
+  }
+  auto numberOfBytes = static_cast<uLongf>(chunk.size());
+  return uncompress(reinterpret_cast<Bytef *>(chunk.data()),
+                    &numberOfBytes,
+                    reinterpret_cast<const Bytef *>(encoded.data()),
+                    static_cast<uLong>(encoded.size())) == Z_OK &&
+         numberOfBytes == chunk.size();
+}
+
+/** Whether an encoded chunk of the given number of bytes can decode to a
+ * chunk of chunkBytes bytes: raw chunks are stored as they are, and zlib
+ * deflates a chunk to at most compressBound() bytes, and at best about 1032
+ * times smaller. */
+bool
+IsValidEncodedSize(ChunkCodec codec, uint64_t encodedBytes, uint64_t chunkBytes)
+{
+  if (codec == ChunkCodec::Raw)
+  {
+    return encodedBytes == chunkBytes;
+  }
+  return chunkBytes <= std::numeric_limits<uLong>::max() / 2 &&
+         encodedBytes <= compressBound(static_cast<uLong>(chunkBytes)) && chunkBytes / 1032 <= encodedBytes;
+}
+
+// long and unsigned long are stored with their fixed size equivalent, as
+// their size depends on the platform.
+IOComponentEnum
+GetFileComponentType(IOComponentEnum componentType)
+{
+  if (componentType == IOComponentEnum::LONG || componentType == IOComponentEnum::ULONG)
+  {
+    const bool isSigned = componentType == IOComponentEnum::LONG;
+    return sizeof(long) == sizeof(long long) ? (isSigned ? IOComponentEnum::LONGLONG : IOComponentEnum::ULONGLONG)
+                                             : (isSigned ? IOComponentEnum::INT : IOComponentEnum::UINT);
+  }
+  return componentType;
+}
+} // namespace
+
+
+ChunkedImageIO::ChunkedImageIO()
+  : m_MultiThreader(MultiThreaderBase::New())
+{
+  this->SetNumberOfDimensions(3);
+
+  this->AddSupportedWriteExtension(".cki");
+  this->AddSupportedReadExtension(".cki");
+
+  this->Self::SetCompressor("");
+  this->Self::SetMaximumCompressionLevel(9);
+  this->Self::SetCompressionLevel(2);
+}
+
+ChunkedImageIO::~ChunkedImageIO() = default;
+
+void
+ChunkedImageIO::SetChunkSize(unsigned int axis, SizeValueType size)
+{
+  if (axis >= m_ChunkSize.size())
+  {
+    m_ChunkSize.resize(axis + 1, 0);
+  }
+  if (m_ChunkSize[axis] != size)
+  {
+    m_ChunkSize[axis] = size;
+    this->Modified();
+  }
+}
+
+SizeValueType
+ChunkedImageIO::GetChunkSize(unsigned int axis) const
+{
+  return axis < m_ChunkSize.size() ? m_ChunkSize[axis] : 0;
+}
+
+bool
+ChunkedImageIO::SupportsDimension(unsigned long dim)
+{
+  return dim > 0 && dim <= MaximumNumberOfDimensions;
+}
+
+void
+ChunkedImageIO::InternalSetCompressor(const std::string & _compressor)
+{
+  if (_compressor.empty() || _compressor == "ZLIB")
+  {
+    return;
+  }
+  this->Superclass::InternalSetCompressor(_compressor);
+}
+
+bool
+ChunkedImageIO::CanReadFile(const char * filename)
+{
+  std::ifstream file;
+  try
+  {
+    this->OpenFileForReading(file, filename);
+  }
+  catch (const ExceptionObject &)
+  {
+    return false;
+  }
+  return ReadMagic(file);
+}
+
+void
+ChunkedImageIO::ReadImageInformation()
+{
+  std::ifstream file;
+  this->OpenFileForReading(file, m_FileName);
+  const ChunkedImageHeader header = ReadHeader(file, m_FileName);
+
+  const unsigned int numberOfDimensions = header.GetNumberOfDimensions();
+  this->SetNumberOfDimensions(numberOfDimensions);
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    this->SetDimensions(i, header.Size[i]);
+    this->SetSpacing(i, header.Spacing[i]);
+    this->SetOrigin(i, header.Origin[i]);
+    this->SetDirection(i,
+                       std::vector<double>(header.Direction.begin() + i * numberOfDimensions,
+                                           header.Direction.begin() + (i + 1) * numberOfDimensions));
+  }
+  this->SetComponentType(static_cast<IOComponentEnum>(header.ComponentType));
+  this->SetPixelType(static_cast<IOPixelEnum>(header.PixelType));
+  this->SetNumberOfComponents(header.NumberOfComponents);
+  m_ChunkSize.assign(header.ChunkSize.begin(), header.ChunkSize.end());
+}
+
+void
+ChunkedImageIO::Read(void * buffer)
+{
+  std::ifstream file;
+  this->OpenFileForReading(file, m_FileName);
+  const ChunkedImageHeader header = ReadHeader(file, m_FileName);
+  if (header.GetNumberOfDimensions() != this->GetNumberOfDimensions())
+  {
+    itkExceptionMacro("The number of dimensions of the file changed since its information was read: " << m_FileName);
+  }
+
+  const ImageIORegion         region = GetRegionWithDimension(m_IORegion, header.GetNumberOfDimensions());
+  const std::vector<uint64_t> chunks = header.GetChunksInRegion(region);
+  const SizeValueType         pixelSize = this->GetPixelSize();
+  const unsigned int          componentSize = this->GetComponentSize();
+  auto * const                outputBuffer = static_cast<char *>(buffer);
+
+  // Chunks which were never written hold zeros.
+  if (std::any_of(
+        chunks.cbegin(), chunks.cend(), [&header](uint64_t chunk) { return header.Chunks[chunk].Offset == 0; }))
+  {
+    std::fill_n(outputBuffer, region.GetNumberOfPixels() * pixelSize, 0);
+  }
+
+  // The chunks are read sequentially and decoded in parallel, a batch at a
+  // time to bound the memory of the encoded chunks.
+  const size_t batchSize = 4 * static_cast<size_t>(m_MultiThreader->GetNumberOfWorkUnits());
+  for (size_t batchBegin = 0; batchBegin < chunks.size(); batchBegin += batchSize)
+  {
+    const size_t                   batchEnd = std::min(batchBegin + batchSize, chunks.size());
+    std::vector<std::vector<char>> encodedChunks(batchEnd - batchBegin);
+    for (size_t i = batchBegin; i < batchEnd; ++i)
+    {
+      const ChunkLocation & location = header.Chunks[chunks[i]];
+      if (location.Offset != 0)
+      {
+        if (!IsValidEncodedSize(
+              header.Codec, location.NumberOfBytes, header.GetChunkRegion(chunks[i]).GetNumberOfPixels() * pixelSize))
+        {
+          itkExceptionMacro("Invalid size of chunk " << chunks[i] << " of file: " << m_FileName);
+        }
+        std::vector<char> & encoded = encodedChunks[i - batchBegin];
+        encoded.resize(location.NumberOfBytes);
+        file.seekg(static_cast<std::streamoff>(location.Offset), std::ios::beg);
+        if (!this->ReadBufferAsBinary(file, encoded.data(), location.NumberOfBytes))
+        {
+          itkExceptionMacro("Could not read chunk " << chunks[i] << " of file: " << m_FileName);
+        }
+      }
+    }
+
+    std::atomic<bool> decodingFailed{ false };
+    this->ParallelizeChunks(
+      batchBegin,
+      batchEnd,
+      [&](SizeValueType i) {
+        if (header.Chunks[chunks[i]].Offset == 0)
+        {
+          return;
+        }
+        const ImageIORegion chunkRegion = header.GetChunkRegion(chunks[i]);
+        std::vector<char>   chunk(chunkRegion.GetNumberOfPixels() * pixelSize);
+        if (!DecodeChunk(encodedChunks[i - batchBegin], header.Codec, chunk))
+        {
+          decodingFailed = true;
+          return;
+        }
+        SwapFromSystemToLittleEndian(chunk.data(), chunk.size() / componentSize, componentSize);
+        CopyIntersection(chunk.data(), chunkRegion, outputBuffer, region, pixelSize);
+      });
+    if (decodingFailed)
+    {
+      itkExceptionMacro("Could not decode the chunks of file, or they do not have the expected size: " << m_FileName);
+    }
+  }
+}
+
+bool
+ChunkedImageIO::CanWriteFile(const char * name)
+{
+  const std::string filename = name;
+
+  if (filename.empty())
+  {
+    return false;
+  }
+
+  return this->HasSupportedWriteExtension(name);
+}
+
+void
+ChunkedImageIO::Write(const void * buffer)
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  if (!this->SupportsDimension(numberOfDimensions))
+  {
+    itkExceptionMacro("Cannot write an image with " << numberOfDimensions << " dimensions to: " << m_FileName);
+  }
+
+  ChunkedImageHeader header;
+  if (this->RequestedToStream() && itksys::SystemTools::FileExists(m_FileName.c_str()))
+  {
+    // Paste into the existing file.
+    std::ifstream file;
+    this->OpenFileForReading(file, m_FileName);
+    header = ReadHeader(file, m_FileName);
+    bool compatible = header.GetNumberOfDimensions() == numberOfDimensions &&
+                      header.ComponentType == static_cast<uint32_t>(GetFileComponentType(this->GetComponentType())) &&
+                      header.NumberOfComponents == this->GetNumberOfComponents();
+    for (unsigned int i = 0; compatible && i < numberOfDimensions; ++i)
+    {
+      compatible = header.Size[i] == this->GetDimensions(i);
+    }
+    if (!compatible)
+    {
+      itkExceptionMacro("Cannot paste into an image of a different size or pixel type: " << m_FileName);
+    }
+  }
+  else
+  {
+    header.ComponentType = static_cast<uint32_t>(GetFileComponentType(this->GetComponentType()));
+    header.PixelType = static_cast<uint32_t>(this->GetPixelType());
+    header.NumberOfComponents = this->GetNumberOfComponents();
+    header.Codec = m_UseCompression ? ChunkCodec::Zlib : ChunkCodec::Raw;
+    for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+      const SizeValueType chunkSize = this->GetChunkSize(i) > 0 ? this->GetChunkSize(i) : DefaultChunkSize;
+      header.Size.push_back(this->GetDimensions(i));
+      header.ChunkSize.push_back(std::min<uint64_t>(chunkSize, this->GetDimensions(i)));
+      header.Spacing.push_back(this->GetSpacing(i));
+      header.Origin.push_back(this->GetOrigin(i));
+      const std::vector<double> direction = this->GetDirection(i);
+      header.Direction.insert(header.Direction.end(), direction.begin(), direction.end());
+    }
+    header.Chunks.resize(header.GetNumberOfChunks());
+
+    std::ofstream file;
+    this->OpenFileForWriting(file, m_FileName);
+    WriteHeader(file, header);
+    if (file.fail())
+    {
+      itkExceptionMacro("Could not write the header of file: " << m_FileName);
+    }
+  }
+
+  const SizeValueType pixelSize = this->GetPixelSize();
+  const unsigned int  componentSize = this->GetComponentSize();
+  SizeValueType       maximumChunkBytes = pixelSize;
+  for (const uint64_t chunkSize : header.ChunkSize)
+  {
+    maximumChunkBytes *= chunkSize;
+  }
+  if (maximumChunkBytes > std::numeric_limits<uLong>::max() / 2)
+  {
+    itkExceptionMacro("The chunks are too large to be compressed: " << maximumChunkBytes << " bytes");
+  }
+
+  std::fstream file(m_FileName.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+  if (!file.is_open())
+  {
+    itkExceptionMacro("Could not open file for writing: " << m_FileName << std::endl
+                                                          << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  file.seekp(0, std::ios::end);
+  auto endPosition = static_cast<uint64_t>(std::max<std::streamoff>(file.tellp(), header.GetDataPosition()));
+
+  const ImageIORegion         region = GetRegionWithDimension(m_IORegion, numberOfDimensions);
+  const std::vector<uint64_t> chunks = header.GetChunksInRegion(region);
+  const auto *                inputBuffer = static_cast<const char *>(buffer);
+  const int                   compressionLevel = this->GetCompressionLevel();
+
+  // The chunks are encoded in parallel and written sequentially, a batch
+  // at a time to bound the memory of the encoded chunks.
+  const size_t batchSize = 4 * static_cast<size_t>(m_MultiThreader->GetNumberOfWorkUnits());
+  for (size_t batchBegin = 0; batchBegin < chunks.size(); batchBegin += batchSize)
+  {
+    const size_t batchEnd = std::min(batchBegin + batchSize, chunks.size());
+
+    // Chunks partially covered by the region keep their pixels outside of it.
+    std::vector<std::vector<char>> encodedChunks(batchEnd - batchBegin);
+    for (size_t i = batchBegin; i < batchEnd; ++i)
+    {
+      const ChunkLocation & location = header.Chunks[chunks[i]];
+      if (location.Offset != 0 && !region.IsInside(header.GetChunkRegion(chunks[i])))
+      {
+        if (!IsValidEncodedSize(
+              header.Codec, location.NumberOfBytes, header.GetChunkRegion(chunks[i]).GetNumberOfPixels() * pixelSize))
+        {
+          itkExceptionMacro("Invalid size of chunk " << chunks[i] << " of file: " << m_FileName);
+        }
+        std::vector<char> & encoded = encodedChunks[i - batchBegin];
+        encoded.resize(location.NumberOfBytes);
+        file.seekg(static_cast<std::streamoff>(location.Offset), std::ios::beg);
+        if (!this->ReadBufferAsBinary(file, encoded.data(), location.NumberOfBytes))
+        {
+          itkExceptionMacro("Could not read chunk " << chunks[i] << " of file: " << m_FileName);
+        }
+      }
+    }
+
+    std::atomic<bool> encodingFailed{ false };
+    this->ParallelizeChunks(
+      batchBegin,
+      batchEnd,
+      [&](SizeValueType i) {
+        const ImageIORegion chunkRegion = header.GetChunkRegion(chunks[i]);
+        std::vector<char>   chunk(chunkRegion.GetNumberOfPixels() * pixelSize, 0);
+        std::vector<char> & encoded = encodedChunks[i - batchBegin];
+        if (!encoded.empty())
+        {
+          if (!DecodeChunk(encoded, header.Codec, chunk))
+          {
+            encodingFailed = true;
+            return;
+          }
+          SwapFromSystemToLittleEndian(chunk.data(), chunk.size() / componentSize, componentSize);
+        }
+        CopyIntersection(inputBuffer, region, chunk.data(), chunkRegion, pixelSize);
+        SwapFromSystemToLittleEndian(chunk.data(), chunk.size() / componentSize, componentSize);
+        if (!EncodeChunk(chunk, header.Codec, compressionLevel, encoded))
+        {
+          encodingFailed = true;
+        }
+      });
+    if (encodingFailed)
+    {
+      itkExceptionMacro("Could not encode the chunks of file: " << m_FileName);
+    }
+
+    for (size_t i = batchBegin; i < batchEnd; ++i)
+    {
+      const std::vector<char> & encoded = encodedChunks[i - batchBegin];
+      ChunkLocation &           location = header.Chunks[chunks[i]];
+      if (location.Offset == 0 || encoded.size() > location.NumberOfBytes)
+      {
+        location.Offset = endPosition;
+        endPosition += encoded.size();
+      }
+      location.NumberOfBytes = encoded.size();
+      file.seekp(static_cast<std::streamoff>(location.Offset), std::ios::beg);
+      if (!this->WriteBufferAsBinary(file, encoded.data(), encoded.size()))
+      {
+        itkExceptionMacro("Could not write chunk " << chunks[i] << " of file: " << m_FileName);
+      }
+    }
+  }
+
+  WriteChunkIndex(file, header);
+  if (file.fail())
+  {
+    itkExceptionMacro("Could not write the chunk index of file: " << m_FileName);
+  }
+}
+
+std::vector<SizeValueType>
+ChunkedImageIO::GetChunkSizeForWriting() const
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  if (itksys::SystemTools::FileExists(m_FileName.c_str()))
+  {
+    std::ifstream file(m_FileName.c_str(), std::ios::in | std::ios::binary);
+    try
+    {
+      const ChunkedImageHeader header = ReadHeader(file, m_FileName);
+      if (header.GetNumberOfDimensions() == numberOfDimensions)
+      {
+        return { header.ChunkSize.begin(), header.ChunkSize.end() };
+      }
+    }
+    catch (const ExceptionObject &)
+    {
+      // Not a chunked image, it will be overwritten.
+    }
+  }
+
+  std::vector<SizeValueType> chunkSize(numberOfDimensions);
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    chunkSize[i] = std::min(this->GetChunkSize(i) > 0 ? this->GetChunkSize(i) : DefaultChunkSize,
+                            static_cast<SizeValueType>(this->GetDimensions(i)));
+  }
+  return chunkSize;
+}
+
+void
+ChunkedImageIO::ParallelizeChunks(SizeValueType                                        first,
+                                  SizeValueType                                        last,
+                                  const MultiThreaderBase::ArrayThreadingFunctorType & func) const
+{
+  SizeValueType numberOfGroups = std::min<SizeValueType>(m_MultiThreader->GetNumberOfWorkUnits(), last - first);
+  if (this->GetMaximumNumberOfWorkUnits() > 0)
+  {
+    numberOfGroups = std::min<SizeValueType>(numberOfGroups, this->GetMaximumNumberOfWorkUnits());
+  }
+  m_MultiThreader->ParallelizeArray(
+    0,
+    numberOfGroups,
+    [first, last, numberOfGroups, &func](SizeValueType group) {
+      const SizeValueType groupEnd = first + (last - first) * (group + 1) / numberOfGroups;
+      for (SizeValueType i = first + (last - first) * group / numberOfGroups; i < groupEnd; ++i)
+      {
+        func(i);
+      }
+    },
+    nullptr);
+}
+
+unsigned int
+ChunkedImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                                  const ImageIORegion & pasteRegion,
+                                                  const ImageIORegion & largestPossibleRegion)
+{
+  const unsigned int numberOfSplits =
+    Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+
+  // Split along the last axis spanning several chunk layers.
+  const std::vector<SizeValueType> chunkSize = this->GetChunkSizeForWriting();
+  for (unsigned int i = std::min<unsigned int>(pasteRegion.GetImageDimension(), chunkSize.size()); i > 0; --i)
+  {
+    const SizeValueType first = static_cast<SizeValueType>(pasteRegion.GetIndex(i - 1)) / chunkSize[i - 1];
+    const SizeValueType last =
+      (static_cast<SizeValueType>(pasteRegion.GetIndex(i - 1)) + pasteRegion.GetSize(i - 1) - 1) / chunkSize[i - 1];
+    if (pasteRegion.GetSize(i - 1) > 0 && last > first)
+    {
+      return static_cast<unsigned int>(std::min<SizeValueType>(numberOfSplits, last - first + 1));
+    }
+  }
+  return 1;
+}
+
+ImageIORegion
+ChunkedImageIO::GetSplitRegionForWriting(unsigned int          ithPiece,
+                                         unsigned int          numberOfActualSplits,
+                                         const ImageIORegion & pasteRegion,
+                                         const ImageIORegion & itkNotUsed(largestPossibleRegion))
+{
+  ImageIORegion splitRegion = pasteRegion;
+  if (numberOfActualSplits <= 1)
+  {
+    return splitRegion;
+  }
+
+  const std::vector<SizeValueType> chunkSize = this->GetChunkSizeForWriting();
+  for (unsigned int i = std::min<unsigned int>(pasteRegion.GetImageDimension(), chunkSize.size()); i > 0; --i)
+  {
+    const unsigned int  axis = i - 1;
+    const auto          begin = static_cast<SizeValueType>(pasteRegion.GetIndex(axis));
+    const SizeValueType end = begin + pasteRegion.GetSize(axis);
+    const SizeValueType first = begin / chunkSize[axis];
+    const SizeValueType last = (end - 1) / chunkSize[axis];
+    if (pasteRegion.GetSize(axis) > 0 && last > first)
+    {
+      // Distribute the chunk layers evenly over the splits.
+      const SizeValueType numberOfLayers = last - first + 1;
+      const SizeValueType splitBegin =
+        std::max(begin, (first + ithPiece * numberOfLayers / numberOfActualSplits) * chunkSize[axis]);
+      const SizeValueType splitEnd =
+        std::min(end, (first + (ithPiece + 1) * numberOfLayers / numberOfActualSplits) * chunkSize[axis]);
+      splitRegion.SetIndex(axis, static_cast<IndexValueType>(splitBegin));
+      splitRegion.SetSize(axis, splitEnd - splitBegin);
+      return splitRegion;
+    }
+  }
+  return splitRegion;
+}
+
+ImageIOBase::SizeType
+ChunkedImageIO::GetHeaderSize() const
+{
+  ChunkedImageHeader header;
+  header.Size.resize(this->GetNumberOfDimensions());
+  return static_cast<SizeType>(header.GetIndexPosition());
+}
+
+void
+ChunkedImageIO::PrintSelf(std::ostream & os, Indent indent) const
+{
+  using namespace print_helper;
+
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ChunkSize: " << m_ChunkSize << std::endl;
+  itkPrintSelfObjectMacro(MultiThreader);
+}
+
+} // end namespace itk
@@ -0,0 +1,394 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkChunkedImageIO.h"
+#include "itkChunkedImageIOFactory.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkVectorImage.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKChunkedImageIOTest : public ::testing::Test
+{
+  using ImageType = itk::Image<short, 3>;
+  using RegionType = ImageType::RegionType;
+
+  void
+  SetUp() override
+  {
+    itk::ObjectFactoryBase::RegisterInternalFactoryOnce<itk::ChunkedImageIOFactory>();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+
+    m_Image = ImageType::New();
+    m_Image->SetRegions(ImageType::SizeType{ { 37, 29, 11 } });
+    m_Image->Allocate();
+    m_Image->SetSpacing(itk::MakeVector(0.5, 0.75, 2.0));
+    m_Image->SetOrigin(itk::MakePoint(-3.0, 4.0, 10.5));
+    ImageType::DirectionType direction;
+    direction.Fill(0.0);
+    direction(0, 1) = 1.0;
+    direction(1, 0) = -1.0;
+    direction(2, 2) = 1.0;
+    m_Image->SetDirection(direction);
+    // Runs of equal values, so that the image compresses.
+    int value = 0;
+    for (auto & pixel : itk::MakeImageBufferRange(m_Image.GetPointer()))
+    {
+      pixel = static_cast<short>(value++ / 4 - 1000);
+    }
+  }
+
+  static itk::ChunkedImageIO::Pointer
+  MakeImageIO()
+  {
+    auto imageIO = itk::ChunkedImageIO::New();
+    imageIO->SetChunkSize(0, 8);
+    imageIO->SetChunkSize(1, 16);
+    imageIO->SetChunkSize(2, 4);
+    return imageIO;
+  }
+
+  void
+  Write(const std::string & fileName, bool useCompression, unsigned int numberOfStreamDivisions = 1) const
+  {
+    const auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(m_Image);
+    writer->SetFileName(fileName);
+    writer->SetImageIO(MakeImageIO());
+    writer->SetUseCompression(useCompression);
+    writer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+    writer->Update();
+  }
+
+  // Writes the image of sourceFileName to fileName, in the given number of
+  // pieces which are each read from the source file when written, and
+  // returns the number of pieces.
+  template <typename TImage>
+  static int
+  StreamWrite(const std::string & sourceFileName, const std::string & fileName, unsigned int numberOfStreamDivisions)
+  {
+    const auto reader = itk::ImageFileReader<TImage>::New();
+    reader->SetFileName(sourceFileName);
+    reader->UseStreamingOn();
+    const auto monitor = itk::PipelineMonitorImageFilter<TImage>::New();
+    monitor->SetInput(reader->GetOutput());
+
+    const auto writer = itk::ImageFileWriter<TImage>::New();
+    writer->SetInput(monitor->GetOutput());
+    writer->SetFileName(fileName);
+    writer->SetImageIO(MakeImageIO());
+    writer->SetUseCompression(true);
+    writer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+    writer->Update();
+    return static_cast<int>(monitor->GetNumberOfUpdates());
+  }
+
+  static itk::ImageFileReader<ImageType>::Pointer
+  MakeReader(const std::string & fileName)
+  {
+    const auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetFileName(fileName);
+    reader->SetImageIO(itk::ChunkedImageIO::New());
+    return reader;
+  }
+
+  // Expects the buffered pixels of the image to be the pixels of m_Image.
+  void
+  ExpectSamePixels(const ImageType * image) const
+  {
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      ASSERT_EQ(it.Get(), m_Image->GetPixel(it.GetIndex())) << it.GetIndex();
+    }
+  }
+
+  ImageType::Pointer m_Image{};
+};
+
+} // namespace
+
+
+TEST_F(ITKChunkedImageIOTest, WritesAndReadsImages)
+{
+  for (const bool useCompression : { false, true })
+  {
+    const std::string fileName = useCompression ? "chunkedImageIOTestCompressed.cki" : "chunkedImageIOTest.cki";
+    Write(fileName, useCompression);
+
+    const auto reader = MakeReader(fileName);
+    reader->Update();
+    const ImageType * const output = reader->GetOutput();
+    EXPECT_EQ(output->GetLargestPossibleRegion(), m_Image->GetLargestPossibleRegion());
+    EXPECT_EQ(output->GetSpacing(), m_Image->GetSpacing());
+    EXPECT_EQ(output->GetOrigin(), m_Image->GetOrigin());
+    EXPECT_EQ(output->GetDirection(), m_Image->GetDirection());
+    ExpectSamePixels(output);
+
+    const itk::ImageIOBase * const imageIO = reader->GetImageIO();
+    EXPECT_EQ(dynamic_cast<const itk::ChunkedImageIO &>(*imageIO).GetChunkSize(1), 16u);
+  }
+
+  const auto fileSize = [](const char * fileName) { return itksys::SystemTools::FileLength(fileName); };
+  EXPECT_LT(fileSize("chunkedImageIOTestCompressed.cki"), fileSize("chunkedImageIOTest.cki"));
+}
+
+
+TEST_F(ITKChunkedImageIOTest, ReadsRequestedRegions)
+{
+  const std::string fileName = "chunkedImageIOTestRegions.cki";
+  Write(fileName, true);
+
+  const auto reader = MakeReader(fileName);
+  reader->UpdateOutputInformation();
+  ImageType * const output = reader->GetOutput();
+
+  for (const RegionType & region : { RegionType({ { 3, 5, 2 } }, { { 20, 13, 5 } }),
+                                     RegionType({ { 8, 16, 4 } }, { { 8, 13, 4 } }),
+                                     RegionType({ { 36, 0, 10 } }, { { 1, 29, 1 } }) })
+  {
+    output->SetRequestedRegion(region);
+    output->Update();
+    EXPECT_EQ(output->GetBufferedRegion(), region);
+    ExpectSamePixels(output);
+  }
+}
+
+
+TEST_F(ITKChunkedImageIOTest, UsesAtMostTheMaximumNumberOfWorkUnits)
+{
+  // With 1, the chunks are encoded and decoded on the calling thread.
+  for (const itk::ThreadIdType maximumNumberOfWorkUnits : { 1, 2, 0 })
+  {
+    const std::string fileName = "chunkedImageIOTestWorkUnits" + std::to_string(maximumNumberOfWorkUnits) + ".cki";
+    const auto        writerIO = MakeImageIO();
+    writerIO->GetMultiThreader()->SetNumberOfWorkUnits(3);
+    writerIO->SetMaximumNumberOfWorkUnits(maximumNumberOfWorkUnits);
+    const auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(m_Image);
+    writer->SetFileName(fileName);
+    writer->SetImageIO(writerIO);
+    writer->UseCompressionOn();
+    writer->Update();
+
+    const auto readerIO = itk::ChunkedImageIO::New();
+    readerIO->GetMultiThreader()->SetNumberOfWorkUnits(3);
+    readerIO->SetMaximumNumberOfWorkUnits(maximumNumberOfWorkUnits);
+    const auto reader = MakeReader(fileName);
+    reader->SetImageIO(readerIO);
+    reader->Update();
+    EXPECT_EQ(reader->GetOutput()->GetBufferedRegion(), m_Image->GetLargestPossibleRegion());
+    ExpectSamePixels(reader->GetOutput());
+  }
+}
+
+
+TEST_F(ITKChunkedImageIOTest, StreamsWriting)
+{
+  const std::string sourceFileName = "chunkedImageIOTestStreamSource.cki";
+  Write(sourceFileName, false);
+  for (const unsigned int numberOfStreamDivisions : { 2u, 3u, 11u })
+  {
+    const std::string fileName = "chunkedImageIOTestStreamed.cki";
+    itksys::SystemTools::RemoveFile(fileName);
+    EXPECT_EQ(StreamWrite<ImageType>(sourceFileName, fileName, numberOfStreamDivisions),
+              static_cast<int>(std::min(numberOfStreamDivisions, 3u)));
+    ExpectSamePixels(itk::ReadImage<ImageType>(fileName));
+  }
+
+  // The splits are aligned to the chunk layers along the last axis.
+  const auto               imageIO = MakeImageIO();
+  const itk::ImageIORegion largestRegion = [this] {
+    itk::ImageIORegion region(3);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      region.SetSize(i, m_Image->GetLargestPossibleRegion().GetSize(i));
+    }
+    return region;
+  }();
+  imageIO->SetFileName("chunkedImageIOTestSplits.cki");
+  imageIO->SetNumberOfDimensions(3);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    imageIO->SetDimensions(i, largestRegion.GetSize(i));
+  }
+  EXPECT_EQ(imageIO->GetActualNumberOfSplitsForWriting(11, largestRegion, largestRegion), 3u);
+  EXPECT_EQ(imageIO->GetSplitRegionForWriting(1, 3, largestRegion, largestRegion).GetIndex(2), 4);
+  EXPECT_EQ(imageIO->GetSplitRegionForWriting(1, 3, largestRegion, largestRegion).GetSize(2), 4u);
+  EXPECT_EQ(imageIO->GetSplitRegionForWriting(2, 3, largestRegion, largestRegion).GetSize(2), 3u);
+}
+
+
+// Tests that long pixels, which are stored with their fixed size equivalent, can be written by streaming.
+TEST_F(ITKChunkedImageIOTest, StreamsWritingOfLongPixels)
+{
+  using LongImageType = itk::Image<long, 3>;
+  const auto image = LongImageType::New();
+  image->SetRegions(m_Image->GetLargestPossibleRegion());
+  image->Allocate();
+  long value = -100000;
+  for (auto & pixel : itk::MakeImageBufferRange(image.GetPointer()))
+  {
+    pixel = value;
+    value += 7;
+  }
+
+  const std::string sourceFileName = "chunkedImageIOTestLongSource.cki";
+  const std::string fileName = "chunkedImageIOTestLong.cki";
+  itk::WriteImage(image, sourceFileName);
+  itksys::SystemTools::RemoveFile(fileName);
+  EXPECT_EQ(StreamWrite<LongImageType>(sourceFileName, fileName, 3), 3);
+
+  const auto      output = itk::ReadImage<LongImageType>(fileName);
+  const long *    buffer = image->GetBufferPointer();
+  const long *    outputBuffer = output->GetBufferPointer();
+  const ptrdiff_t numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  ASSERT_EQ(output->GetBufferedRegion(), image->GetBufferedRegion());
+  EXPECT_TRUE(std::equal(buffer, buffer + numberOfPixels, outputBuffer));
+}
+
+
+TEST_F(ITKChunkedImageIOTest, PastesRegions)
+{
+  const std::string fileName = "chunkedImageIOTestPaste.cki";
+  Write(fileName, true);
+
+  // Paste a region which only partially covers chunks.
+  const RegionType pasteRegion({ { 5, 10, 3 } }, { { 20, 7, 6 } });
+  const auto       original = ImageType::New();
+  original->Graft(m_Image);
+  m_Image = ImageType::New();
+  m_Image->CopyInformation(original);
+  m_Image->SetRegions(original->GetLargestPossibleRegion());
+  m_Image->Allocate();
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(original, original->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    m_Image->SetPixel(it.GetIndex(), pasteRegion.IsInside(it.GetIndex()) ? short{ 42 } : it.Get());
+  }
+
+  // Only the paste region is buffered, otherwise the writer writes the whole image.
+  const auto pasted = ImageType::New();
+  pasted->CopyInformation(m_Image);
+  pasted->SetBufferedRegion(pasteRegion);
+  pasted->SetRequestedRegion(pasteRegion);
+  pasted->Allocate();
+  pasted->FillBuffer(42);
+
+  const auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(pasted);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(itk::ChunkedImageIO::New());
+  itk::ImageIORegion ioRegion(3);
+  itk::ImageIORegionAdaptor<3>::Convert(pasteRegion, ioRegion, m_Image->GetLargestPossibleRegion().GetIndex());
+  writer->SetIORegion(ioRegion);
+  writer->Update();
+
+  ExpectSamePixels(itk::ReadImage<ImageType>(fileName));
+}
+
+
+TEST_F(ITKChunkedImageIOTest, WritesVectorImages)
+{
+  using VectorImageType = itk::VectorImage<float, 2>;
+  const auto image = VectorImageType::New();
+  image->SetRegions(VectorImageType::SizeType{ { 100, 70 } });
+  image->SetNumberOfComponentsPerPixel(3);
+  image->Allocate();
+  const size_t numberOfComponents = 3 * image->GetBufferedRegion().GetNumberOfPixels();
+  for (size_t i = 0; i < numberOfComponents; ++i)
+  {
+    image->GetBufferPointer()[i] = 0.25f + 1.5f * i;
+  }
+
+  const std::string fileName = "chunkedImageIOTestVector.cki";
+  itk::WriteImage(image, fileName, true);
+
+  const auto output = itk::ReadImage<VectorImageType>(fileName);
+  ASSERT_EQ(output->GetNumberOfComponentsPerPixel(), 3u);
+  ASSERT_EQ(output->GetBufferedRegion(), image->GetBufferedRegion());
+  EXPECT_TRUE(std::equal(
+    image->GetBufferPointer(), image->GetBufferPointer() + numberOfComponents, output->GetBufferPointer()));
+}
+
+
+TEST_F(ITKChunkedImageIOTest, CanReadOnlyChunkedImages)
+{
+  const std::string fileName = "chunkedImageIOTestCanRead.cki";
+  Write(fileName, false);
+  EXPECT_TRUE(itk::ChunkedImageIO::New()->CanReadFile(fileName.c_str()));
+  EXPECT_FALSE(itk::ChunkedImageIO::New()->CanReadFile("chunkedImageIOTestMissing.cki"));
+
+  std::ofstream other("chunkedImageIOTestOther.cki");
+  other << "Not a chunked image";
+  other.close();
+  EXPECT_FALSE(itk::ChunkedImageIO::New()->CanReadFile("chunkedImageIOTestOther.cki"));
+}
+
+
+TEST_F(ITKChunkedImageIOTest, ThrowsOnTruncatedOrCorruptFiles)
+{
+  for (const bool useCompression : { false, true })
+  {
+    const std::string fileName = "chunkedImageIOTestValid.cki";
+    Write(fileName, useCompression);
+    std::string contents;
+    {
+      std::ifstream file(fileName, std::ios::binary);
+      contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // The last chunks lie beyond the end of a truncated file.
+    const std::string truncatedFileName = "chunkedImageIOTestTruncated.cki";
+    {
+      std::ofstream file(truncatedFileName, std::ios::binary);
+      file.write(contents.data(), static_cast<std::streamsize>(contents.size() / 2));
+    }
+    EXPECT_THROW(MakeReader(truncatedFileName)->Update(), itk::ExceptionObject);
+
+    // The first chunk is one byte long. Its size follows the magic, the
+    // header, the geometry of the 3-D image, the number of chunks and the
+    // offset of the chunk.
+    const std::string corruptFileName = "chunkedImageIOTestCorrupt.cki";
+    {
+      std::string corrupt = contents;
+      constexpr size_t firstChunkSizePosition = 8 + 24 + 4 * 3 * 8 + 9 * 8 + 8 + 8;
+      corrupt[firstChunkSizePosition] = 1;
+      std::fill_n(corrupt.begin() + firstChunkSizePosition + 1, 7, '\0');
+      std::ofstream file(corruptFileName, std::ios::binary);
+      file.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+    }
+    EXPECT_THROW(MakeReader(corruptFileName)->Update(), itk::ExceptionObject);
+  }
+}
@@ -116,6 +116,13 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(GDCMImageIO);
 
+  /** \see ImageIOBase::CanCloneSettings() */
+  bool
+  CanCloneSettings() const override
+  {
+    return true;
+  }
+
   /*-------- This part of the interface deals with reading data. ------ */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -222,6 +229,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Create a GDCMImageIO with the same settings. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalReadImageInformation();
 
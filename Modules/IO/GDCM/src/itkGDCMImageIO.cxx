@@ -126,6 +126,24 @@ GDCMImageIO::GDCMImageIO()
 
 GDCMImageIO::~GDCMImageIO() { delete this->m_DICOMHeader; }
 
+LightObject::Pointer
+GDCMImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_UIDPrefix = m_UIDPrefix;
+  rval->m_KeepOriginalUID = m_KeepOriginalUID;
+  rval->m_LoadPrivateTags = m_LoadPrivateTags;
+  rval->m_ReadYBRtoRGB = m_ReadYBRtoRGB;
+  rval->m_CompressionType = m_CompressionType;
+  return loPtr;
+}
+
 /**
  * Helper function to test for some dicom like formatting.
  * @param file A stream to test if the file is dicom like
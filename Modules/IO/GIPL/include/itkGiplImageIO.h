@@ -54,6 +54,13 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(GiplImageIO);
 
+  /** \see ImageIOBase::CanCloneSettings() */
+  bool
+  CanCloneSettings() const override
+  {
+    return true;
+  }
+
   /*-------- This part of the interfaces deals with reading data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -118,6 +118,19 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
 
+  /** Set/Get whether the pixels are memory-mapped from the file instead of
+   * read, when the ImageIO supports it (see
+   * ImageIOBase::CanMemoryMapIORegion) and no pixel conversion is needed.
+   * The output then uses a MemoryMappedImageContainer: the pixels are only
+   * loaded when accessed, from the page cache shared with other processes.
+   * Modifying the pixels does not modify the file. The file must not be
+   * truncated or overwritten while the output image exists. Default is off.
+   * Turning it off releases a memory-mapped output, which unmaps the file. */
+  virtual void
+  SetUseMemoryMapping(bool useMemoryMapping);
+  itkGetConstReferenceMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+
 protected:
   ImageFileReader();
   ~ImageFileReader() override = default;
@@ -160,7 +173,18 @@ protected:
 
   bool m_UseStreaming{};
 
+  bool m_UseMemoryMapping{ false };
+
 private:
+  /** Make the buffer of the output a memory mapping of the current IORegion
+   * of the file, when possible. Returns false when the pixels must be read. */
+  bool
+  MapOutputBuffer();
+
+  /** Whether the buffer of the output is a memory mapping of the file. */
+  bool
+  IsOutputMemoryMapped() const;
+
   std::string m_ExceptionMessage{};
 
   // The region that the ImageIO class will return when we ask to
@@ -24,6 +24,7 @@
 #include "itkPixelTraits.h"
 #include "itkVectorImage.h"
 #include "itkMetaDataObject.h"
+#include "itkMemoryMappedImageContainer.h"
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
@@ -50,6 +51,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   itkPrintSelfBooleanMacro(UserSpecifiedImageIO);
   itkPrintSelfBooleanMacro(UseStreaming);
+  itkPrintSelfBooleanMacro(UseMemoryMapping);
 
   os << indent << "ExceptionMessage: " << m_ExceptionMessage << std::endl;
   os << indent << "ActualIORegion: " << m_ActualIORegion << std::endl;
@@ -359,9 +361,6 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
                 << "Allocating the buffer with the EnlargedRequestedRegion \n"
                 << output->GetRequestedRegion() << '\n');
 
-  // allocated the output image to the size of the enlarge requested region
-  this->AllocateOutputs();
-
   // Test if the file exists and if it can be opened.
   // An exception will be thrown otherwise, since we can't
   // successfully read the file. We catch the exception because some
@@ -384,6 +383,23 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   itkDebugMacro("Setting imageIO IORegion to: " << m_ActualIORegion);
   m_ImageIO->SetIORegion(m_ActualIORegion);
 
+  // The pixels are not read into the mapping of a previous update, which
+  // would keep the file mapped.
+  if (this->IsOutputMemoryMapped())
+  {
+    output->SetPixelContainer(TOutputImage::PixelContainer::New());
+  }
+
+  if (m_UseMemoryMapping && this->MapOutputBuffer())
+  {
+    itkDebugMacro("Pixels are memory-mapped from " << this->GetFileName());
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
+  // allocated the output image to the size of the enlarge requested region
+  this->AllocateOutputs();
+
   // the size of the buffer is computed based on the actual number of
   // pixels to be read and the actual size of the pixels to be read
   // (as opposed to the sizes of the output)
@@ -440,6 +456,89 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::MapOutputBuffer()
+{
+  using PixelContainerType = typename TOutputImage::PixelContainer;
+  using ElementIdentifier = typename PixelContainerType::ElementIdentifier;
+  using ElementType = typename PixelContainerType::Element;
+
+  if constexpr (std::is_same_v<PixelContainerType, ImportImageContainer<ElementIdentifier, ElementType>> &&
+                std::is_trivially_copyable_v<ElementType>)
+  {
+    using MappedContainerType = MemoryMappedImageContainer<ElementIdentifier, ElementType>;
+    TOutputImage * output = this->GetOutput();
+
+    const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
+    if (m_ImageIO->GetComponentType() != ioType ||
+        m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents() ||
+        m_ActualIORegion.GetNumberOfPixels() != output->GetRequestedRegion().GetNumberOfPixels())
+    {
+      return false;
+    }
+    const SizeValueType numberOfBytes =
+      m_ActualIORegion.GetNumberOfPixels() * m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents();
+    if (numberOfBytes % sizeof(ElementType) != 0)
+    {
+      return false;
+    }
+
+    std::string   dataFileName;
+    SizeValueType offset = 0;
+    if (!m_ImageIO->CanMemoryMapIORegion(dataFileName, offset) || offset % alignof(ElementType) != 0)
+    {
+      return false;
+    }
+
+    const auto container = MappedContainerType::New();
+    container->MapFile(dataFileName, offset, static_cast<ElementIdentifier>(numberOfBytes / sizeof(ElementType)));
+
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->SetPixelContainer(container);
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::IsOutputMemoryMapped() const
+{
+  using PixelContainerType = typename TOutputImage::PixelContainer;
+  using ElementIdentifier = typename PixelContainerType::ElementIdentifier;
+  using ElementType = typename PixelContainerType::Element;
+
+  if constexpr (std::is_same_v<PixelContainerType, ImportImageContainer<ElementIdentifier, ElementType>> &&
+                std::is_trivially_copyable_v<ElementType>)
+  {
+    using MappedContainerType = MemoryMappedImageContainer<ElementIdentifier, ElementType>;
+    return dynamic_cast<const MappedContainerType *>(this->GetOutput()->GetPixelContainer()) != nullptr;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::SetUseMemoryMapping(bool useMemoryMapping)
+{
+  if (m_UseMemoryMapping != useMemoryMapping)
+  {
+    m_UseMemoryMapping = useMemoryMapping;
+    if (!useMemoryMapping && this->IsOutputMemoryMapped())
+    {
+      this->GetOutput()->ReleaseData();
+    }
+    this->Modified();
+  }
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(const void * inputData, size_t numberOfPixels)
@@ -88,6 +88,19 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(ImageIOBase);
 
+  /** Create an ImageIO of the same type, with the same settings. */
+  itkCloneMacro(Self);
+
+  /** Determine if Clone() copies all the settings of this ImageIO: the
+   * settings of ImageIOBase, and those of the ImageIO type, which must then
+   * override InternalClone(). Default is false, since the settings of an
+   * ImageIO type are unknown to ImageIOBase. */
+  virtual bool
+  CanCloneSettings() const
+  {
+    return false;
+  }
+
   /** Set/Get the name of the file to be read. */
   itkSetStringMacro(FileName);
   itkGetStringMacro(FileName);
@@ -307,6 +320,14 @@ public:
   itkGetConstMacro(WritePalette, bool);
   itkBooleanMacro(WritePalette);
 
+  /** Set/Get the maximum number of work units used by the ImageIO types
+   * which read or write a file in parallel on their own multi-threader, such
+   * as TIFFImageIO. With 1, they read and write on the calling thread, which
+   * is needed when that thread is itself a worker of the thread pool. The
+   * default, 0, sets no other limit than their multi-threader. */
+  itkSetMacro(MaximumNumberOfWorkUnits, ThreadIdType);
+  itkGetConstMacro(MaximumNumberOfWorkUnits, ThreadIdType);
+
   /** Determine whether a palletized image file has been read as a scalar image
    *  plus a color palette.
    *  ExpandRGBPalette must be set to true, and the file must be a
@@ -440,6 +461,19 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Determine whether the pixels of the current IORegion are stored in the
+   * file uncompressed, contiguously, and in the byte order of this machine,
+   * so that they can be memory-mapped instead of read (see
+   * ImageFileReader::SetUseMemoryMapping). If so, the name of the file which
+   * contains the pixels and the offset, in bytes, of the first pixel of the
+   * IORegion in that file are returned. Assumes ReadImageInformation has
+   * been called. The default implementation returns false. */
+  virtual bool
+  CanMemoryMapIORegion(std::string & itkNotUsed(dataFileName), SizeValueType & itkNotUsed(offset))
+  {
+    return false;
+  }
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -683,6 +717,12 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Create an ImageIO of the same type, with the same compression, streaming
+   * and palette settings. The information about the image is not copied.
+   * Subclasses copy their own settings, and override CanCloneSettings(). */
+  LightObject::Pointer
+  InternalClone() const override;
+
   virtual const ImageRegionSplitterBase *
   GetImageRegionSplitter() const;
 
@@ -755,6 +795,8 @@ protected:
   /** Should we try to include a RGB palette while writing the image  */
   bool m_WritePalette{};
 
+  ThreadIdType m_MaximumNumberOfWorkUnits{ 0 };
+
   /** The region to read or write. The region contains information about the
    * data within the region to read or write. */
   ImageIORegion m_IORegion{};
@@ -798,6 +840,13 @@ protected:
   void
   ComputeStrides();
 
+  /** Helper for CanMemoryMapIORegion. Returns true when the file type is
+   * binary, the byte order is the one of this machine, and the IORegion is a
+   * contiguous part of the image, along with the offset, in bytes, of the
+   * IORegion relative to the first pixel of the image. */
+  bool
+  GetContiguousIORegionOffset(SizeValueType & offset) const;
+
   /** Convenient method for accessing number of bytes to get to the next pixel
    * component. Returns m_Strides[0]. */
   SizeType
@@ -173,6 +173,24 @@ public:
   itkSetMacro(SpacingWarningRelThreshold, double);
   itkGetConstMacro(SpacingWarningRelThreshold, double);
 
+  /** \brief Set/Get ParallelReading enables the concurrent reading of the
+   * slices.
+   *
+   * When enabled, the slices in the requested region are split into up to
+   * NumberOfWorkUnits contiguous groups, which are read on the multi-threader,
+   * each directly into its place in the output buffer. Each group uses its own
+   * ImageIO, a Clone() of the ImageIO set on this reader, or of the one the
+   * factory selects for the first file. The slices are read serially when
+   * the CanCloneSettings() of that ImageIO is false, since its clones could
+   * miss some of its settings. With several groups, the ImageIOs read with a
+   * MaximumNumberOfWorkUnits of 1, since the groups already run on the
+   * workers of the thread pool. The output, the spacing checks and the
+   * MetaDataDictionaryArray are the same as with the serial reading.
+   * The multi-threader of this reader is left unchanged. Off by default. */
+  itkSetMacro(ParallelReading, bool);
+  itkGetConstMacro(ParallelReading, bool);
+  itkBooleanMacro(ParallelReading);
+
 protected:
   ImageSeriesReader()
     : m_ImageIO(nullptr)
@@ -215,6 +233,8 @@ protected:
 
   double m_SpacingWarningRelThreshold{ 1e-4 };
 
+  bool m_ParallelReading{ false };
+
 private:
   using ReaderType = ImageFileReader<TOutputImage>;
 
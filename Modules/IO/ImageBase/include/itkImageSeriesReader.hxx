@@ -24,9 +24,12 @@
 #include "itkVector.h"
 #include "itkMath.h"
 #include "itkProgressReporter.h"
+#include "itkTotalProgressReporter.h"
+#include "itkImageIOFactory.h"
 #include "itkMetaDataObject.h"
 #include <cstddef> // For ptrdiff_t.
 #include <iomanip>
+#include <mutex>
 
 namespace itk
 {
@@ -55,6 +58,7 @@ ImageSeriesReader<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) con
   os << indent << "ReverseOrder: " << m_ReverseOrder << std::endl;
   os << indent << "ForceOrthogonalDirection: " << m_ForceOrthogonalDirection << std::endl;
   os << indent << "UseStreaming: " << m_UseStreaming << std::endl;
+  os << indent << "ParallelReading: " << m_ParallelReading << std::endl;
 
   itkPrintSelfObjectMacro(ImageIO);
 
@@ -297,129 +301,277 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   double                             maxSpacingDeviation = 0.0;
   bool                               prevSliceIsValid = false;
 
-  for (int i = 0; i != numberOfFiles; ++i)
-  {
+  // Reads the slice of the i-th file, which is inside the requested region,
+  // into the output buffer.
+  const auto readSlice = [&](ReaderType * reader, int i) {
+    TOutputImage * readerOutput = reader->GetOutput();
+    IndexType      sliceIndex = requestedRegion.GetIndex();
     if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
     {
-      sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
+      sliceIndex[this->m_NumberOfDimensionsInImage] = i;
     }
+    const int iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
 
-    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
+    // read the meta data information
+    readerOutput->UpdateOutputInformation();
 
-    // check if we need this slice
-    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+    // propagate the requested region to determine what the region
+    // will actually be read
+    readerOutput->PropagateRequestedRegion();
+
+    // check that the size of each slice is the same
+    if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
     {
-      continue;
+      itkExceptionMacro("Size mismatch! The size of  "
+                        << m_FileNames[iFileName].c_str() << " is "
+                        << readerOutput->GetLargestPossibleRegion().GetSize()
+                        << " and does not match the required size " << validSize << " from file "
+                        << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
     }
 
-    // configure reader
-    auto reader = ReaderType::New();
-    reader->SetFileName(m_FileNames[iFileName].c_str());
+    // get the size of the region to be read
+    const SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
 
-    TOutputImage * readerOutput = reader->GetOutput();
+    if (readSize == sliceRegionToRequest.GetSize())
+    {
+      // if the buffer of the ImageReader is going to match that of
+      // ourselves, then set the ImageReader's buffer to a section
+      // of ours
+
+      const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+
+      using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+      const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+
+
+      const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+                                      ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                      : 0;
 
-    if (m_ImageIO)
+      const ptrdiff_t numberOfPixelComponentsUpToSlice =
+        numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+      const bool bufferDelete = false;
+
+      typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
+
+      if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+      {
+        // if the input image type is a vector image then the number
+        // of components needs to be set for the size
+        readerOutput->GetPixelContainer()->SetImportPointer(
+          outputSliceBuffer,
+          static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
+          bufferDelete);
+      }
+      else
+      {
+        // otherwise the actual number of pixels needs to be passed
+        readerOutput->GetPixelContainer()->SetImportPointer(
+          outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+      }
+      readerOutput->UpdateOutputData();
+    }
+    else
     {
-      reader->SetImageIO(m_ImageIO);
+      // the read region isn't going to match exactly what we need
+      // to update to buffer created by the reader, then copy
+
+      reader->Update();
+
+      // output of buffer copy
+      ImageRegionType outRegion = requestedRegion;
+      outRegion.SetIndex(sliceIndex);
+
+      // set the moving dimension to a size of 1
+      if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+      {
+        outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+      }
+
+      ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
     }
-    reader->SetUseStreaming(m_UseStreaming);
-    readerOutput->SetRequestedRegion(sliceRegionToRequest);
+  };
 
-    // update the data or info
-    if (!insideRequestedRegion)
+  // The origin and the meta data of the slices read in parallel, which are
+  // checked and collected in order by the per slice loop below.
+  struct SliceInformation
+  {
+    typename TOutputImage::PointType Origin{};
+    DictionaryType                   MetaDataDictionary{};
+  };
+  std::vector<SliceInformation> parallelSlices;
+
+  if (m_ParallelReading)
+  {
+    // the slices inside the requested region
+    std::vector<int> slicesToRead;
+    for (int i = 0; i != numberOfFiles; ++i)
     {
-      reader->UpdateOutputInformation();
+      if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+      {
+        sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
+      }
+      if (requestedRegion.IsInside(sliceStartIndex))
+      {
+        slicesToRead.push_back(i);
+      }
     }
-    else
+
+    ImageIOBase::Pointer prototypeImageIO = m_ImageIO;
+    if (prototypeImageIO.IsNull())
     {
-      // read the meta data information
-      readerOutput->UpdateOutputInformation();
+      prototypeImageIO = ImageIOFactory::CreateImageIO(m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str(),
+                                                       ImageIOFactory::IOFileModeEnum::ReadMode);
+    }
 
-      // propagate the requested region to determine what the region
-      // will actually be read
-      readerOutput->PropagateRequestedRegion();
+    // Without an ImageIO, the serial reading reports the error. An ImageIO
+    // whose clones may lack some of its settings is only used serially.
+    if (prototypeImageIO.IsNotNull() && prototypeImageIO->CanCloneSettings() && !slicesToRead.empty())
+    {
+      // Each group of contiguous slices is read by its own ImageIO, all
+      // of which are created before the reading.
+      const auto numberOfGroups =
+        std::min(static_cast<size_t>(this->GetNumberOfWorkUnits()), slicesToRead.size());
+      std::vector<ImageIOBase::Pointer> imageIOs{ prototypeImageIO };
+      std::vector<typename ReaderType::Pointer> readers;
+      while (imageIOs.size() < numberOfGroups)
+      {
+        imageIOs.push_back(prototypeImageIO->Clone());
+      }
 
-      // check that the size of each slice is the same
-      if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+      // The groups run on workers of the thread pool, where an ImageIO
+      // waiting for work of its own multi-threader could wait forever, once
+      // all the workers wait. The ImageIOs then read on a single work unit,
+      // and the prototype gets its own limit back after the reading.
+      const ThreadIdType prototypeMaximumNumberOfWorkUnits = prototypeImageIO->GetMaximumNumberOfWorkUnits();
+      if (numberOfGroups > 1)
       {
-        itkExceptionMacro("Size mismatch! The size of  "
-                          << m_FileNames[iFileName].c_str() << " is "
-                          << readerOutput->GetLargestPossibleRegion().GetSize()
-                          << " and does not match the required size " << validSize << " from file "
-                          << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+        for (const auto & imageIO : imageIOs)
+        {
+          imageIO->SetMaximumNumberOfWorkUnits(1);
+        }
       }
+      for (size_t j = 0; j < slicesToRead.size(); ++j)
+      {
+        auto reader = ReaderType::New();
+        reader->SetFileName(m_FileNames[m_ReverseOrder ? numberOfFiles - slicesToRead[j] - 1 : slicesToRead[j]]);
+        reader->SetImageIO(imageIOs[j * numberOfGroups / slicesToRead.size()]);
+        reader->SetUseStreaming(m_UseStreaming);
+        reader->GetOutput()->SetRequestedRegion(sliceRegionToRequest);
+        readers.push_back(reader);
+      }
+
+      parallelSlices.resize(numberOfFiles);
+      std::exception_ptr exception;
+      std::mutex         exceptionMutex;
 
-      // get the size of the region to be read
-      const SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+      this->GetMultiThreader()->ParallelizeArray(
+        0,
+        numberOfGroups,
+        [&](SizeValueType group) {
+          TotalProgressReporter groupProgress(this, slicesToRead.size());
+          try
+          {
+            // the slices j such that j * numberOfGroups / slicesToRead.size() == group
+            const size_t groupBegin = (group * slicesToRead.size() + numberOfGroups - 1) / numberOfGroups;
+            const size_t groupEnd = ((group + 1) * slicesToRead.size() + numberOfGroups - 1) / numberOfGroups;
+            for (size_t j = groupBegin; j < groupEnd; ++j)
+            {
+              readSlice(readers[j], slicesToRead[j]);
+
+              SliceInformation & slice = parallelSlices[slicesToRead[j]];
+              slice.Origin = readers[j]->GetOutput()->GetOrigin();
+              slice.MetaDataDictionary = readers[j]->GetImageIO()->GetMetaDataDictionary();
+              readers[j] = nullptr;
+              groupProgress.CompletedPixel();
+            }
+          }
+          catch (...)
+          {
+            const std::lock_guard<std::mutex> lock(exceptionMutex);
+            if (!exception)
+            {
+              exception = std::current_exception();
+            }
+          }
+        },
+        nullptr);
+      prototypeImageIO->SetMaximumNumberOfWorkUnits(prototypeMaximumNumberOfWorkUnits);
 
-      if (readSize == sliceRegionToRequest.GetSize())
+      if (exception)
       {
-        // if the buffer of the ImageReader is going to match that of
-        // ourselves, then set the ImageReader's buffer to a section
-        // of ours
+        std::rethrow_exception(exception);
+      }
+    }
+  }
 
-        const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+  for (int i = 0; i != numberOfFiles; ++i)
+  {
+    if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+    {
+      sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
+    }
 
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
+    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
+    bool       nonUniformSampling = false;
+    double     spacingDeviation = 0.0;
 
+    // check if we need this slice
+    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+    {
+      continue;
+    }
 
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
+    typename TOutputImage::PointType sliceOrigin;
+    const DictionaryType *           sliceMetaDataDictionary = nullptr;
+    typename ReaderType::Pointer     reader;
 
-        const ptrdiff_t numberOfPixelComponentsUpToSlice =
-          numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-        const bool bufferDelete = false;
+    if (insideRequestedRegion && !parallelSlices.empty())
+    {
+      // already read in parallel
+      sliceOrigin = parallelSlices[i].Origin;
+      sliceMetaDataDictionary = &parallelSlices[i].MetaDataDictionary;
+    }
+    else
+    {
+      // configure reader
+      reader = ReaderType::New();
+      reader->SetFileName(m_FileNames[iFileName].c_str());
 
-        typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
+      if (m_ImageIO)
+      {
+        reader->SetImageIO(m_ImageIO);
+      }
+      reader->SetUseStreaming(m_UseStreaming);
+      reader->GetOutput()->SetRequestedRegion(sliceRegionToRequest);
 
-        if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
-        {
-          // if the input image type is a vector image then the number
-          // of components needs to be set for the size
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer,
-            static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
-            bufferDelete);
-        }
-        else
-        {
-          // otherwise the actual number of pixels needs to be passed
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
-        }
-        readerOutput->UpdateOutputData();
+      // update the data or info
+      if (!insideRequestedRegion)
+      {
+        reader->UpdateOutputInformation();
       }
       else
       {
-        // the read region isn't going to match exactly what we need
-        // to update to buffer created by the reader, then copy
+        readSlice(reader, i);
 
-        reader->Update();
-
-        // output of buffer copy
-        ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex(sliceStartIndex);
-
-        // set the moving dimension to a size of 1
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-        {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
-        }
-
-        ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+        // report progress for read slices
+        progress.CompletedPixel();
       }
+      sliceOrigin = reader->GetOutput()->GetOrigin();
+      if (reader->GetImageIO())
+      {
+        sliceMetaDataDictionary = &reader->GetImageIO()->GetMetaDataDictionary();
+      }
+    }
 
+    if (insideRequestedRegion)
+    {
       // verify that slice spacing is the expected one
       // since we can be skipping some slices because they are outside of requested region
       // I am using additional variable
       if (prevSliceIsValid)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
         using SpacingScalarType = typename TOutputImage::SpacingValueType;
         Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
         for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
@@ -446,19 +598,16 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       }
       else
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
+        prevSliceOrigin = sliceOrigin;
         prevSliceIsValid = true;
       }
-
-      // report progress for read slices
-      progress.CompletedPixel();
     } // end !insideRequestedRegion
 
     // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+    if (sliceMetaDataDictionary && needToUpdateMetaDataDictionaryArray)
     {
       auto newDictionary = new DictionaryType;
-      *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
+      *newDictionary = *sliceMetaDataDictionary;
       if (nonUniformSampling)
       {
         // slice-specific information
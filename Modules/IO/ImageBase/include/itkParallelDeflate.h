@@ -0,0 +1,129 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelDeflate_h
+#define itkParallelDeflate_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkMultiThreaderBase.h"
+
+#include <ostream>
+#include <vector>
+
+namespace itk
+{
+/** \class ParallelDeflateEnums
+ * \brief Contains all enum classes used by the ParallelDeflate class.
+ * \ingroup ITKIOImageBase
+ */
+class ParallelDeflateEnums
+{
+public:
+  /** \class Format
+   * \ingroup ITKIOImageBase
+   * The container of the deflate stream. */
+  enum class Format : uint8_t
+  {
+    Zlib,
+    Gzip
+  };
+};
+// Define how to print enumeration
+extern ITKIOImageBase_EXPORT std::ostream &
+                             operator<<(std::ostream & out, const ParallelDeflateEnums::Format value);
+
+/** \class ParallelDeflate
+ * \brief Compresses a buffer with deflate, block by block in parallel.
+ *
+ * The data is divided into blocks of BlockSize bytes, which are compressed
+ * independently on the multi-threader, as done by pigz. Each block uses the
+ * last 32 KiB of the data before it as dictionary, so that the compression
+ * ratio is close to the one of a serial deflate. All but the last block end
+ * with a sync flush, so that the compressed blocks concatenate into a single
+ * deflate stream, which is wrapped in a zlib or gzip container whose checksum
+ * is combined from the checksums of the blocks. The result can be read by
+ * any zlib or gzip decoder.
+ *
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT ParallelDeflate : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ParallelDeflate);
+
+  /** Standard class type aliases. */
+  using Self = ParallelDeflate;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using FormatEnum = ParallelDeflateEnums::Format;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ParallelDeflate);
+
+  /** Set/Get the container of the stream, zlib by default. */
+  itkSetEnumMacro(Format, FormatEnum);
+  itkGetEnumMacro(Format, FormatEnum);
+
+  /** Set/Get the deflate compression level, from 0 (no compression) to 9
+   * (best compression). Defaults to 6, the default level of zlib. */
+  itkSetClampMacro(CompressionLevel, int, 0, 9);
+  itkGetConstMacro(CompressionLevel, int);
+
+  /** Set/Get the number of bytes compressed by each block, 128 KiB by
+   * default. Smaller blocks give more parallelism, at the expense of the
+   * compression ratio. */
+  itkSetClampMacro(BlockSize, SizeValueType, 32 * 1024, 1024 * 1024 * 1024);
+  itkGetConstMacro(BlockSize, SizeValueType);
+
+  /** Set/Get the multi-threader which compresses the blocks. Its number of
+   * work units is the number of blocks compressed at the same time. */
+  itkSetObjectMacro(MultiThreader, MultiThreaderBase);
+  itkGetModifiableObjectMacro(MultiThreader, MultiThreaderBase);
+
+  /** Compress numberOfBytes bytes of data, and write the stream to os.
+   * Throws an exception when the compression or the writing fails. */
+  void
+  Compress(const void * data, SizeValueType numberOfBytes, std::ostream & os);
+
+  /** Compress numberOfBytes bytes of data, and return the stream. */
+  std::vector<char>
+  Compress(const void * data, SizeValueType numberOfBytes);
+
+protected:
+  ParallelDeflate();
+  ~ParallelDeflate() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  FormatEnum                 m_Format{ FormatEnum::Zlib };
+  int                        m_CompressionLevel{ 6 };
+  SizeValueType              m_BlockSize{ 128 * 1024 };
+  MultiThreaderBase::Pointer m_MultiThreader{};
+};
+} // end namespace itk
+
+#endif // itkParallelDeflate_h
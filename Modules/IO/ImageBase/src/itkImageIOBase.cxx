@@ -18,6 +18,7 @@
 
 #include "itkImageIOBase.h"
 #include "itkImageRegionSplitterSlowDimension.h"
+#include "itkByteSwapper.h"
 #include <mutex>
 #include "itksys/SystemTools.hxx"
 #include "itkPrintHelper.h"
@@ -49,6 +50,28 @@ ImageIOBase::Reset(const bool)
 
 ImageIOBase::~ImageIOBase() = default;
 
+LightObject::Pointer
+ImageIOBase::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_UseCompression = m_UseCompression;
+  rval->m_CompressionLevel = m_CompressionLevel;
+  rval->m_MaximumCompressionLevel = m_MaximumCompressionLevel;
+  rval->m_Compressor = m_Compressor;
+  rval->m_UseStreamedReading = m_UseStreamedReading;
+  rval->m_UseStreamedWriting = m_UseStreamedWriting;
+  rval->m_ExpandRGBPalette = m_ExpandRGBPalette;
+  rval->m_WritePalette = m_WritePalette;
+  rval->m_MaximumNumberOfWorkUnits = m_MaximumNumberOfWorkUnits;
+  return loPtr;
+}
+
 const ImageIOBase::ArrayOfExtensionsType &
 ImageIOBase::GetSupportedWriteExtensions() const
 {
@@ -323,6 +346,52 @@ ImageIOBase::GetPixelSize() const
   return this->GetComponentSize() * this->GetNumberOfComponents();
 }
 
+bool
+ImageIOBase::GetContiguousIORegionOffset(SizeValueType & offset) const
+{
+  if (m_FileType != IOFileEnum::Binary)
+  {
+    return false;
+  }
+  if (this->GetComponentSize() > 1)
+  {
+    const IOByteOrderEnum systemByteOrder =
+      ByteSwapper<int>::SystemIsBigEndian() ? IOByteOrderEnum::BigEndian : IOByteOrderEnum::LittleEndian;
+    if (m_ByteOrder != systemByteOrder)
+    {
+      return false;
+    }
+  }
+  if (m_IORegion.GetImageDimension() != m_NumberOfDimensions)
+  {
+    return false;
+  }
+
+  // The region is contiguous when it spans the whole image along all the
+  // dimensions below the highest one along which it has more than one pixel.
+  unsigned int highestDimension = 0;
+  for (unsigned int i = 0; i < m_NumberOfDimensions; ++i)
+  {
+    if (m_IORegion.GetSize(i) > 1)
+    {
+      highestDimension = i;
+    }
+  }
+  SizeValueType pixelOffset = 0;
+  SizeValueType stride = 1;
+  for (unsigned int i = 0; i < m_NumberOfDimensions; ++i)
+  {
+    if (i < highestDimension && (m_IORegion.GetIndex(i) != 0 || m_IORegion.GetSize(i) != m_Dimensions[i]))
+    {
+      return false;
+    }
+    pixelOffset += static_cast<SizeValueType>(m_IORegion.GetIndex(i)) * stride;
+    stride *= m_Dimensions[i];
+  }
+  offset = pixelOffset * this->GetPixelSize();
+  return true;
+}
+
 
 void
 ImageIOBase::SetCompressor(std::string _c)
@@ -1178,6 +1247,7 @@ ImageIOBase::PrintSelf(std::ostream & os, Indent indent) const
   itkPrintSelfBooleanMacro(ExpandRGBPalette);
   itkPrintSelfBooleanMacro(IsReadAsScalarPlusPalette);
   itkPrintSelfBooleanMacro(WritePalette);
+  os << indent << "MaximumNumberOfWorkUnits: " << m_MaximumNumberOfWorkUnits << std::endl;
 }
 
 } // namespace itk
@@ -0,0 +1,238 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkParallelDeflate.h"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+
+namespace itk
+{
+namespace
+{
+// The size of the deflate window, and hence of the largest useful dictionary.
+constexpr SizeValueType DeflateWindowSize = 32 * 1024;
+
+struct DeflatedBlock
+{
+  std::vector<char> Data{};
+  uLong             Checksum{ 0 };
+};
+
+// Raw-deflates a block, primed with the window of data preceding it. All but
+// the last block end on a byte boundary with a sync flush.
+bool
+DeflateBlock(const unsigned char * blockBegin,
+             SizeValueType         blockSize,
+             SizeValueType         dictionarySize,
+             int                   compressionLevel,
+             bool                  isLastBlock,
+             DeflatedBlock &       block)
+{
+  z_stream stream{};
+  if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+  if (dictionarySize > 0 &&
+      deflateSetDictionary(&stream, blockBegin - dictionarySize, static_cast<uInt>(dictionarySize)) != Z_OK)
+  {
+    deflateEnd(&stream);
+    return false;
+  }
+
+  // The bound does not account for the empty stored block of the sync flush.
+  block.Data.resize(deflateBound(&stream, static_cast<uLong>(blockSize)) + 16);
+  stream.next_in = const_cast<unsigned char *>(blockBegin);
+  stream.avail_in = static_cast<uInt>(blockSize);
+  const int flush = isLastBlock ? Z_FINISH : Z_SYNC_FLUSH;
+  int       result = Z_OK;
+  do
+  {
+    if (stream.total_out == block.Data.size())
+    {
+      block.Data.resize(2 * block.Data.size());
+    }
+    stream.next_out = reinterpret_cast<unsigned char *>(block.Data.data()) + stream.total_out;
+    stream.avail_out = static_cast<uInt>(block.Data.size() - stream.total_out);
+    result = deflate(&stream, flush);
+  } while (result == Z_OK && (isLastBlock || stream.avail_out == 0));
+  block.Data.resize(stream.total_out);
+  deflateEnd(&stream);
+  return isLastBlock ? result == Z_STREAM_END : (result == Z_OK || result == Z_BUF_ERROR) && stream.avail_in == 0;
+}
+
+// The FLEVEL field of the zlib header, as set by zlib itself.
+unsigned int
+ZlibLevelFlag(int compressionLevel)
+{
+  if (compressionLevel < 2)
+  {
+    return 0;
+  }
+  if (compressionLevel < 6)
+  {
+    return 1;
+  }
+  return compressionLevel == 6 ? 2 : 3;
+}
+} // namespace
+
+ParallelDeflate::ParallelDeflate()
+  : m_MultiThreader(MultiThreaderBase::New())
+{}
+
+void
+ParallelDeflate::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Format: " << m_Format << std::endl;
+  os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
+  os << indent << "BlockSize: " << m_BlockSize << std::endl;
+  itkPrintSelfObjectMacro(MultiThreader);
+}
+
+void
+ParallelDeflate::Compress(const void * data, SizeValueType numberOfBytes, std::ostream & os)
+{
+  const auto * const input = static_cast<const unsigned char *>(data);
+  const bool         isGzip = m_Format == FormatEnum::Gzip;
+
+  const auto writeBytes = [&os](const void * bytes, SizeValueType size) {
+    os.write(static_cast<const char *>(bytes), static_cast<std::streamsize>(size));
+  };
+
+  if (isGzip)
+  {
+    // ID1, ID2, CM (deflate), FLG, MTIME (none), XFL, OS (unknown).
+    const unsigned char extraFlags = m_CompressionLevel == 9 ? 2 : (m_CompressionLevel == 1 ? 4 : 0);
+    const unsigned char header[10] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, extraFlags, 255 };
+    writeBytes(header, sizeof(header));
+  }
+  else
+  {
+    constexpr unsigned int compressionMethodAndFlags = 0x78;
+    unsigned int           flags = ZlibLevelFlag(m_CompressionLevel) << 6;
+    flags += 31 - (compressionMethodAndFlags * 256 + flags) % 31;
+    const unsigned char header[2] = { compressionMethodAndFlags, static_cast<unsigned char>(flags) };
+    writeBytes(header, sizeof(header));
+  }
+
+  uLong checksum = isGzip ? crc32(0, nullptr, 0) : adler32(0, nullptr, 0);
+
+  // The blocks are compressed in parallel and written sequentially, a batch
+  // at a time to bound the memory of the compressed blocks.
+  const SizeValueType numberOfBlocks = std::max<SizeValueType>(1, (numberOfBytes + m_BlockSize - 1) / m_BlockSize);
+  const SizeValueType batchSize = 4 * static_cast<SizeValueType>(m_MultiThreader->GetNumberOfWorkUnits());
+  for (SizeValueType batchBegin = 0; batchBegin < numberOfBlocks; batchBegin += batchSize)
+  {
+    const SizeValueType        batchEnd = std::min(batchBegin + batchSize, numberOfBlocks);
+    std::vector<DeflatedBlock> blocks(batchEnd - batchBegin);
+
+    std::atomic<bool> compressionFailed{ false };
+    m_MultiThreader->ParallelizeArray(
+      batchBegin,
+      batchEnd,
+      [&](SizeValueType i) {
+        const SizeValueType blockOffset = i * m_BlockSize;
+        const SizeValueType blockSize = std::min(m_BlockSize, numberOfBytes - blockOffset);
+        DeflatedBlock &     block = blocks[i - batchBegin];
+        if (!DeflateBlock(input + blockOffset,
+                          blockSize,
+                          std::min(DeflateWindowSize, blockOffset),
+                          m_CompressionLevel,
+                          i + 1 == numberOfBlocks,
+                          block))
+        {
+          compressionFailed = true;
+          return;
+        }
+        block.Checksum = isGzip ? crc32(crc32(0, nullptr, 0), input + blockOffset, static_cast<uInt>(blockSize))
+                                : adler32(adler32(0, nullptr, 0), input + blockOffset, static_cast<uInt>(blockSize));
+      },
+      nullptr);
+    if (compressionFailed)
+    {
+      itkExceptionMacro("Could not deflate the data");
+    }
+
+    for (SizeValueType i = batchBegin; i < batchEnd; ++i)
+    {
+      const DeflatedBlock & block = blocks[i - batchBegin];
+      const auto            blockSize = static_cast<z_off_t>(std::min(m_BlockSize, numberOfBytes - i * m_BlockSize));
+      checksum = isGzip ? crc32_combine(checksum, block.Checksum, blockSize)
+                        : adler32_combine(checksum, block.Checksum, blockSize);
+      writeBytes(block.Data.data(), block.Data.size());
+    }
+  }
+
+  if (isGzip)
+  {
+    // CRC32 and ISIZE, little endian.
+    const auto    size = static_cast<uint32_t>(numberOfBytes);
+    unsigned char trailer[8];
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      trailer[i] = static_cast<unsigned char>(checksum >> (8 * i));
+      trailer[4 + i] = static_cast<unsigned char>(size >> (8 * i));
+    }
+    writeBytes(trailer, sizeof(trailer));
+  }
+  else
+  {
+    // ADLER32, big endian.
+    const unsigned char trailer[4] = { static_cast<unsigned char>(checksum >> 24),
+                                       static_cast<unsigned char>(checksum >> 16),
+                                       static_cast<unsigned char>(checksum >> 8),
+                                       static_cast<unsigned char>(checksum) };
+    writeBytes(trailer, sizeof(trailer));
+  }
+
+  if (os.fail())
+  {
+    itkExceptionMacro("Could not write the deflated data");
+  }
+}
+
+std::vector<char>
+ParallelDeflate::Compress(const void * data, SizeValueType numberOfBytes)
+{
+  std::ostringstream os;
+  this->Compress(data, numberOfBytes, os);
+  const std::string compressed = os.str();
+  return { compressed.cbegin(), compressed.cend() };
+}
+
+std::ostream &
+operator<<(std::ostream & out, const ParallelDeflateEnums::Format value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case ParallelDeflateEnums::Format::Zlib:
+        return "itk::ParallelDeflateEnums::Format::Zlib";
+      case ParallelDeflateEnums::Format::Gzip:
+        return "itk::ParallelDeflateEnums::Format::Gzip";
+      default:
+        return "INVALID VALUE FOR itk::ParallelDeflateEnums::Format";
+    }
+  }();
+}
+} // namespace itk
@@ -0,0 +1,193 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkMemoryMappedImageContainer.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageFileReaderMemoryMappingTest : public ::testing::Test
+{
+  using ImageType = itk::Image<short, 3>;
+  using RegionType = ImageType::RegionType;
+  using MappedContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, short>;
+
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+
+    m_Image = ImageType::New();
+    m_Image->SetRegions(ImageType::SizeType{ { 7, 6, 5 } });
+    m_Image->Allocate();
+    short value = -100;
+    for (auto & pixel : itk::MakeImageBufferRange(m_Image.GetPointer()))
+    {
+      pixel = value;
+      value += 3;
+    }
+  }
+
+  static bool
+  IsMapped(const ImageType * image)
+  {
+    return dynamic_cast<const MappedContainerType *>(image->GetPixelContainer()) != nullptr;
+  }
+
+  // Expects the buffered pixels of the image to be the pixels of m_Image.
+  void
+  ExpectSamePixels(const ImageType * image) const
+  {
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      ASSERT_EQ(it.Get(), m_Image->GetPixel(it.GetIndex()));
+    }
+  }
+
+  ImageType::Pointer m_Image{};
+};
+
+} // namespace
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, MapsUncompressedMetaImages)
+{
+  for (const std::string fileName : { "memoryMappingTest.mha", "memoryMappingTest.mhd" })
+  {
+    itk::WriteImage(m_Image, fileName);
+
+    const auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetFileName(fileName);
+    EXPECT_FALSE(reader->GetUseMemoryMapping());
+    reader->UseMemoryMappingOn();
+    reader->Update();
+
+    const ImageType * const output = reader->GetOutput();
+    EXPECT_TRUE(IsMapped(output));
+    EXPECT_EQ(output->GetBufferedRegion(), m_Image->GetLargestPossibleRegion());
+    ExpectSamePixels(output);
+  }
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, MapsContiguousRequestedRegions)
+{
+  const std::string fileName = "memoryMappingTest.mha";
+  itk::WriteImage(m_Image, fileName);
+
+  const auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->UseMemoryMappingOn();
+  reader->UpdateOutputInformation();
+
+  // A range of slices is contiguous in the file.
+  ImageType * const output = reader->GetOutput();
+  const RegionType  slices({ { 0, 0, 2 } }, { { 7, 6, 2 } });
+  output->SetRequestedRegion(slices);
+  output->Update();
+  EXPECT_TRUE(IsMapped(output));
+  EXPECT_EQ(output->GetBufferedRegion(), slices);
+  ExpectSamePixels(output);
+
+  // A region which is not contiguous in the file is read.
+  const RegionType block({ { 1, 2, 1 } }, { { 3, 2, 2 } });
+  output->SetRequestedRegion(block);
+  output->Update();
+  EXPECT_FALSE(IsMapped(output));
+  EXPECT_TRUE(output->GetBufferedRegion().IsInside(block));
+  ExpectSamePixels(output);
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, UnmapsWhenTurnedOff)
+{
+  const std::string fileName = "memoryMappingTest.mha";
+  itk::WriteImage(m_Image, fileName);
+
+  const auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  ASSERT_TRUE(IsMapped(reader->GetOutput()));
+
+  reader->UseMemoryMappingOff();
+  EXPECT_FALSE(IsMapped(reader->GetOutput()));
+  reader->Update();
+  EXPECT_FALSE(IsMapped(reader->GetOutput()));
+  EXPECT_EQ(reader->GetOutput()->GetBufferedRegion(), m_Image->GetLargestPossibleRegion());
+  ExpectSamePixels(reader->GetOutput());
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, DoesNotModifyFiles)
+{
+  const std::string fileName = "memoryMappingTest.mha";
+  itk::WriteImage(m_Image, fileName);
+
+  const auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  ASSERT_TRUE(IsMapped(reader->GetOutput()));
+  reader->GetOutput()->FillBuffer(42);
+
+  ExpectSamePixels(itk::ReadImage<ImageType>(fileName));
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, ReadsCompressedFiles)
+{
+  const std::string fileName = "memoryMappingTestCompressed.mha";
+  itk::WriteImage(m_Image, fileName, true);
+
+  const auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  EXPECT_FALSE(IsMapped(reader->GetOutput()));
+  ExpectSamePixels(reader->GetOutput());
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, ReadsWithPixelConversion)
+{
+  const std::string fileName = "memoryMappingTest.mha";
+  itk::WriteImage(m_Image, fileName);
+
+  using FloatImageType = itk::Image<float, 3>;
+  using FloatMappedContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, float>;
+  const auto reader = itk::ImageFileReader<FloatImageType>::New();
+  reader->SetFileName(fileName);
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  EXPECT_EQ(dynamic_cast<const FloatMappedContainerType *>(reader->GetOutput()->GetPixelContainer()), nullptr);
+  EXPECT_EQ(reader->GetOutput()->GetPixel({ { 6, 5, 4 } }), m_Image->GetPixel({ { 6, 5, 4 } }));
+}
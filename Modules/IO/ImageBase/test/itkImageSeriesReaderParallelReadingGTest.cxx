@@ -0,0 +1,289 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSeriesReader.h"
+#include "itkImageFileWriter.h"
+#include "itkMetaImageIO.h"
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkMetaDataObject.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#include <atomic>
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+// A MetaImageIO type whose clones would miss its settings.
+class UncloneableMetaImageIO : public itk::MetaImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(UncloneableMetaImageIO);
+
+  using Self = UncloneableMetaImageIO;
+  using Superclass = itk::MetaImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(UncloneableMetaImageIO);
+
+  bool
+  CanCloneSettings() const override
+  {
+    return false;
+  }
+
+protected:
+  UncloneableMetaImageIO() = default;
+  ~UncloneableMetaImageIO() override = default;
+
+  itk::LightObject::Pointer
+  InternalClone() const override
+  {
+    itkExceptionMacro("UncloneableMetaImageIO is not cloned.");
+  }
+};
+
+// A MetaImageIO type which records whether it has read with more than one
+// work unit.
+class RecordingMetaImageIO : public itk::MetaImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RecordingMetaImageIO);
+
+  using Self = RecordingMetaImageIO;
+  using Superclass = itk::MetaImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(RecordingMetaImageIO);
+
+  void
+  Read(void * buffer) override
+  {
+    if (this->GetMaximumNumberOfWorkUnits() != 1)
+    {
+      s_ReadWithSeveralWorkUnits = true;
+    }
+    Superclass::Read(buffer);
+  }
+
+  static std::atomic<bool> s_ReadWithSeveralWorkUnits;
+
+protected:
+  RecordingMetaImageIO() = default;
+  ~RecordingMetaImageIO() override = default;
+};
+
+std::atomic<bool> RecordingMetaImageIO::s_ReadWithSeveralWorkUnits{ false };
+
+struct ITKImageSeriesReaderParallelReadingTest : public ::testing::Test
+{
+  using ImageType = itk::Image<short, 3>;
+  using ReaderType = itk::ImageSeriesReader<ImageType>;
+
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+
+    // Single slice volumes, with a missing slice to exercise the detection of
+    // the non uniform sampling.
+    short value = 0;
+    for (unsigned int k = 0; k < 23; ++k)
+    {
+      const auto slice = ImageType::New();
+      slice->SetRegions(ImageType::SizeType{ { 9, 7, 1 } });
+      slice->Allocate();
+      for (auto & pixel : itk::MakeImageBufferRange(slice.GetPointer()))
+      {
+        pixel = value++;
+      }
+      slice->SetOrigin(ImageType::PointType{ { { 0.0, 0.0, 2.0 * (k < 15 ? k : k + 1) } } });
+
+      m_FileNames.push_back("imageSeriesReaderParallelReading" + std::to_string(k) + ".mha");
+      itk::WriteImage(slice, m_FileNames.back());
+    }
+  }
+
+  ReaderType::Pointer
+  MakeReader(bool parallelReading) const
+  {
+    auto reader = ReaderType::New();
+    reader->SetFileNames(m_FileNames);
+    reader->SetParallelReading(parallelReading);
+    reader->SetNumberOfWorkUnits(4);
+    return reader;
+  }
+
+  // Expects the outputs and the dictionaries of the readers to be the same.
+  static void
+  ExpectSameOutput(ReaderType * serialReader, ReaderType * parallelReader)
+  {
+    const ImageType * serial = serialReader->GetOutput();
+    const ImageType * parallel = parallelReader->GetOutput();
+    ASSERT_EQ(parallel->GetBufferedRegion(), serial->GetBufferedRegion());
+    EXPECT_EQ(parallel->GetOrigin(), serial->GetOrigin());
+    EXPECT_EQ(parallel->GetSpacing(), serial->GetSpacing());
+    const auto serialPixels = itk::MakeImageBufferRange(serial);
+    EXPECT_TRUE(std::equal(serialPixels.cbegin(), serialPixels.cend(), parallel->GetBufferPointer()));
+
+    const auto & serialDictionaries = *serialReader->GetMetaDataDictionaryArray();
+    const auto & parallelDictionaries = *parallelReader->GetMetaDataDictionaryArray();
+    ASSERT_EQ(parallelDictionaries.size(), serialDictionaries.size());
+    for (size_t i = 0; i < serialDictionaries.size(); ++i)
+    {
+      EXPECT_EQ(parallelDictionaries[i]->GetKeys(), serialDictionaries[i]->GetKeys()) << "dictionary " << i;
+    }
+    double serialDeviation = 0.0;
+    double parallelDeviation = 0.0;
+    EXPECT_TRUE(
+      itk::ExposeMetaData(serial->GetMetaDataDictionary(), "ITK_non_uniform_sampling_deviation", serialDeviation));
+    EXPECT_TRUE(
+      itk::ExposeMetaData(parallel->GetMetaDataDictionary(), "ITK_non_uniform_sampling_deviation", parallelDeviation));
+    EXPECT_EQ(parallelDeviation, serialDeviation);
+  }
+
+  std::vector<std::string> m_FileNames{};
+};
+
+} // namespace
+
+
+TEST_F(ITKImageSeriesReaderParallelReadingTest, ReadsAsTheSerialReading)
+{
+  for (const bool reverseOrder : { false, true })
+  {
+    const auto serialReader = MakeReader(false);
+    const auto parallelReader = MakeReader(true);
+    EXPECT_TRUE(parallelReader->GetParallelReading());
+    serialReader->SetReverseOrder(reverseOrder);
+    parallelReader->SetReverseOrder(reverseOrder);
+    serialReader->Update();
+    parallelReader->Update();
+    ExpectSameOutput(serialReader, parallelReader);
+    EXPECT_EQ(parallelReader->GetMetaDataDictionaryArray()->size(), m_FileNames.size());
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderParallelReadingTest, ReadsRequestedRegions)
+{
+  for (const bool useImageIO : { false, true })
+  {
+    const auto serialReader = MakeReader(false);
+    const auto parallelReader = MakeReader(true);
+    if (useImageIO)
+    {
+      serialReader->SetImageIO(itk::MetaImageIO::New());
+      parallelReader->SetImageIO(itk::MetaImageIO::New());
+    }
+    for (ReaderType * reader : { serialReader.GetPointer(), parallelReader.GetPointer() })
+    {
+      reader->UpdateOutputInformation();
+      reader->GetOutput()->SetRequestedRegion(
+        ImageType::RegionType{ ImageType::IndexType{ { 0, 0, 5 } }, ImageType::SizeType{ { 9, 7, 13 } } });
+      reader->Update();
+    }
+    ExpectSameOutput(serialReader, parallelReader);
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderParallelReadingTest, ThrowsOnSizeMismatch)
+{
+  const auto slice = ImageType::New();
+  slice->SetRegions(ImageType::SizeType{ { 8, 7, 1 } });
+  slice->Allocate(true);
+  itk::WriteImage(slice, "imageSeriesReaderParallelReadingMismatch.mha");
+  m_FileNames[11] = "imageSeriesReaderParallelReadingMismatch.mha";
+
+  EXPECT_THROW(MakeReader(true)->Update(), itk::ExceptionObject);
+}
+
+
+TEST_F(ITKImageSeriesReaderParallelReadingTest, KeepsTheSettings)
+{
+  // The slices are read by clones of the ImageIO, with its settings.
+  const auto imageIO = itk::MetaImageIO::New();
+  imageIO->SetUseCompression(true);
+  imageIO->SetCompressionLevel(7);
+  imageIO->SetSubSamplingFactor(3);
+  EXPECT_TRUE(imageIO->CanCloneSettings());
+  const itk::ImageIOBase::Pointer clone = imageIO->Clone();
+  ASSERT_NE(clone, nullptr);
+  EXPECT_NE(clone, imageIO);
+  EXPECT_STREQ(clone->GetNameOfClass(), "MetaImageIO");
+  EXPECT_TRUE(clone->GetUseCompression());
+  EXPECT_EQ(clone->GetCompressionLevel(), 7);
+  EXPECT_EQ(dynamic_cast<itk::MetaImageIO &>(*clone).GetSubSamplingFactor(), 3u);
+  imageIO->SetSubSamplingFactor(1);
+
+  // The number of work units of the multi-threader is left unchanged.
+  const auto parallelReader = MakeReader(true);
+  parallelReader->SetImageIO(imageIO);
+  parallelReader->GetMultiThreader()->SetNumberOfWorkUnits(2);
+  const auto serialReader = MakeReader(false);
+  serialReader->Update();
+  parallelReader->Update();
+  ExpectSameOutput(serialReader, parallelReader);
+  EXPECT_EQ(parallelReader->GetMultiThreader()->GetNumberOfWorkUnits(), 2);
+}
+
+
+TEST_F(ITKImageSeriesReaderParallelReadingTest, ReadsSeriallyWithoutCloneableSettings)
+{
+  // The slices are all read by the ImageIO of the reader, which is not cloned.
+  const auto imageIO = UncloneableMetaImageIO::New();
+  EXPECT_FALSE(imageIO->CanCloneSettings());
+
+  const auto parallelReader = MakeReader(true);
+  parallelReader->SetImageIO(imageIO);
+  const auto serialReader = MakeReader(false);
+  serialReader->Update();
+  parallelReader->Update();
+  ExpectSameOutput(serialReader, parallelReader);
+}
+
+
+TEST_F(ITKImageSeriesReaderParallelReadingTest, ReadsWithOneWorkUnitPerImageIO)
+{
+  // The groups already run on the thread pool, so the ImageIOs must not wait
+  // for work units of their own on it, however many work units are used.
+  const auto imageIO = RecordingMetaImageIO::New();
+  imageIO->SetMaximumNumberOfWorkUnits(3);
+  RecordingMetaImageIO::s_ReadWithSeveralWorkUnits = false;
+
+  const auto parallelReader = MakeReader(true);
+  parallelReader->SetImageIO(imageIO);
+  parallelReader->SetNumberOfWorkUnits(4 * itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() + 1);
+  parallelReader->GetMultiThreader()->SetNumberOfWorkUnits(parallelReader->GetNumberOfWorkUnits());
+  const auto serialReader = MakeReader(false);
+  serialReader->Update();
+  parallelReader->Update();
+  ExpectSameOutput(serialReader, parallelReader);
+  EXPECT_FALSE(RecordingMetaImageIO::s_ReadWithSeveralWorkUnits);
+  EXPECT_EQ(imageIO->GetMaximumNumberOfWorkUnits(), 3u);
+}
@@ -0,0 +1,107 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Compares the time and the compression ratio of ParallelDeflate on one
+// thread and on all the threads, for the compression levels 1 to 9, then
+// times the writing of compressed MetaImage, NRRD and NIfTI files. The
+// default size keeps the test short; pass a bigger one to benchmark, e.g.
+//   ITKIOImageBaseTestDriver itkParallelDeflateBenchmarkTest outputDirectory 256
+
+#include "itkParallelDeflate.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkTimeProbesCollectorBase.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <string>
+
+int
+itkParallelDeflateBenchmarkTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory [imageEdge]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string        outputDirectory = argv[1];
+  const itk::SizeValueType edge = argc > 2 ? std::stoul(argv[2]) : 64;
+
+  // A smooth image with some noise, which compresses like a typical scan.
+  using ImageType = itk::Image<short, 3>;
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { edge, edge, edge } });
+  image->Allocate();
+  unsigned int       state = 1;
+  itk::SizeValueType i = 0;
+  for (auto & pixel : itk::MakeImageBufferRange(image.GetPointer()))
+  {
+    state = state * 1103515245 + 12345;
+    pixel = static_cast<short>(1000 * std::sin(0.01 * static_cast<double>(i++ % 10007)) + (state >> 28));
+  }
+  const itk::SizeValueType numberOfBytes = image->GetBufferedRegion().GetNumberOfPixels() * sizeof(short);
+
+  const itk::ThreadIdType maximumThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  itk::TimeProbesCollectorBase collector;
+  bool                         success = true;
+
+  const auto parallelDeflate = itk::ParallelDeflate::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(parallelDeflate, ParallelDeflate, Object);
+  for (int level = 1; level <= 9; ++level)
+  {
+    parallelDeflate->SetCompressionLevel(level);
+    for (const itk::ThreadIdType threads : { itk::ThreadIdType{ 1 }, maximumThreads })
+    {
+      parallelDeflate->GetMultiThreader()->SetMaximumNumberOfThreads(threads);
+      parallelDeflate->GetMultiThreader()->SetNumberOfWorkUnits(threads);
+      const std::string probe = "Level " + std::to_string(level) + ", " + std::to_string(threads) + " threads";
+      collector.Start(probe.c_str());
+      const std::vector<char> compressed = parallelDeflate->Compress(image->GetBufferPointer(), numberOfBytes);
+      collector.Stop(probe.c_str());
+      success &= !compressed.empty();
+      std::cout << probe << ": ratio " << static_cast<double>(numberOfBytes) / compressed.size() << std::endl;
+    }
+  }
+
+  for (const std::string extension : { ".mha", ".nrrd", ".nii.gz" })
+  {
+    const std::string fileName = outputDirectory + "/parallelDeflateBenchmark" + extension;
+    const std::string probe = "Write " + extension;
+    collector.Start(probe.c_str());
+    ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, fileName, true));
+    collector.Stop(probe.c_str());
+
+    const auto output = itk::ReadImage<ImageType>(fileName);
+    success &= std::equal(image->GetBufferPointer(),
+                          image->GetBufferPointer() + image->GetBufferedRegion().GetNumberOfPixels(),
+                          output->GetBufferPointer());
+  }
+
+  collector.Report();
+
+  if (!success)
+  {
+    std::cerr << "Test failed: an image was not written correctly." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
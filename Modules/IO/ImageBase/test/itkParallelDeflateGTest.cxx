@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkParallelDeflate.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itk_zlib.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#include <fstream>
+#include <iterator>
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+// Partly compressible data: runs of values mixed with pseudo-random bytes.
+std::vector<char>
+MakeData(size_t numberOfBytes)
+{
+  std::vector<char> data(numberOfBytes);
+  unsigned int      state = 12345;
+  for (size_t i = 0; i < numberOfBytes; ++i)
+  {
+    state = state * 1103515245 + 12345;
+    data[i] = (i / 64) % 3 == 0 ? static_cast<char>(state >> 16) : static_cast<char>(i / 256);
+  }
+  return data;
+}
+
+// Inflates a zlib (windowBits 15) or gzip (windowBits 31) stream.
+std::vector<char>
+Inflate(const std::vector<char> & compressed, size_t numberOfBytes, int windowBits)
+{
+  std::vector<char> data(numberOfBytes + 1);
+  z_stream          stream{};
+  EXPECT_EQ(inflateInit2(&stream, windowBits), Z_OK);
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed.data()));
+  stream.avail_in = static_cast<uInt>(compressed.size());
+  stream.next_out = reinterpret_cast<Bytef *>(data.data());
+  stream.avail_out = static_cast<uInt>(data.size());
+  EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+  EXPECT_EQ(stream.avail_in, 0u);
+  data.resize(stream.total_out);
+  inflateEnd(&stream);
+  return data;
+}
+
+} // namespace
+
+
+TEST(ParallelDeflate, CompressesZlibStreams)
+{
+  const std::vector<char> data = MakeData(1000 * 1000);
+  const auto              parallelDeflate = itk::ParallelDeflate::New();
+  for (const itk::SizeValueType blockSize : { 32 * 1024, 100 * 1000, 2 * 1000 * 1000 })
+  {
+    parallelDeflate->SetBlockSize(blockSize);
+    for (const int compressionLevel : { 0, 1, 6, 9 })
+    {
+      parallelDeflate->SetCompressionLevel(compressionLevel);
+      const std::vector<char> compressed = parallelDeflate->Compress(data.data(), data.size());
+
+      std::vector<char> uncompressed(data.size());
+      uLongf            uncompressedSize = static_cast<uLongf>(uncompressed.size());
+      ASSERT_EQ(uncompress(reinterpret_cast<Bytef *>(uncompressed.data()),
+                           &uncompressedSize,
+                           reinterpret_cast<const Bytef *>(compressed.data()),
+                           static_cast<uLong>(compressed.size())),
+                Z_OK)
+        << "block size " << blockSize << ", level " << compressionLevel;
+      EXPECT_EQ(uncompressed, data);
+      EXPECT_EQ(Inflate(compressed, data.size(), 15), data);
+    }
+  }
+}
+
+
+TEST(ParallelDeflate, CompressesGzipStreams)
+{
+  const std::vector<char> data = MakeData(500 * 1000);
+  const auto              parallelDeflate = itk::ParallelDeflate::New();
+  parallelDeflate->SetFormat(itk::ParallelDeflate::FormatEnum::Gzip);
+  parallelDeflate->SetBlockSize(64 * 1024);
+  const std::vector<char> compressed = parallelDeflate->Compress(data.data(), data.size());
+  EXPECT_EQ(Inflate(compressed, data.size(), 31), data);
+
+  // Concatenated gzip members decompress as their concatenated data.
+  std::vector<char> twoMembers = compressed;
+  twoMembers.insert(twoMembers.end(), compressed.cbegin(), compressed.cend());
+  const std::string fileName = std::string(TOSTRING(ITK_TEST_OUTPUT_DIR)) + "/parallelDeflateTest.gz";
+  std::ofstream(fileName, std::ios::binary).write(twoMembers.data(), static_cast<std::streamsize>(twoMembers.size()));
+  std::vector<char> uncompressed(3 * data.size());
+  gzFile            file = gzopen(fileName.c_str(), "rb");
+  const int numberOfBytesRead = gzread(file, uncompressed.data(), static_cast<unsigned int>(uncompressed.size()));
+  gzclose(file);
+  ASSERT_EQ(numberOfBytesRead, static_cast<int>(2 * data.size()));
+  EXPECT_TRUE(std::equal(data.cbegin(), data.cend(), uncompressed.cbegin()));
+  EXPECT_TRUE(std::equal(data.cbegin(), data.cend(), uncompressed.cbegin() + data.size()));
+}
+
+
+TEST(ParallelDeflate, DoesNotDependOnTheNumberOfWorkUnits)
+{
+  const std::vector<char> data = MakeData(700 * 1000);
+  const auto              parallelDeflate = itk::ParallelDeflate::New();
+  parallelDeflate->SetBlockSize(32 * 1024);
+  parallelDeflate->GetMultiThreader()->SetNumberOfWorkUnits(1);
+  const std::vector<char> serial = parallelDeflate->Compress(data.data(), data.size());
+  parallelDeflate->GetMultiThreader()->SetNumberOfWorkUnits(7);
+  EXPECT_EQ(parallelDeflate->Compress(data.data(), data.size()), serial);
+}
+
+
+TEST(ParallelDeflate, CompressesEmptyData)
+{
+  const auto parallelDeflate = itk::ParallelDeflate::New();
+  EXPECT_TRUE(Inflate(parallelDeflate->Compress(nullptr, 0), 0, 15).empty());
+  parallelDeflate->SetFormat(itk::ParallelDeflate::FormatEnum::Gzip);
+  EXPECT_TRUE(Inflate(parallelDeflate->Compress(nullptr, 0), 0, 31).empty());
+}
+
+
+TEST(ParallelDeflate, WritesCompressedImages)
+{
+  RegisterRequiredFactories();
+  itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+
+  // Several blocks of the default block size.
+  using ImageType = itk::Image<short, 3>;
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 61, 40 } });
+  image->Allocate();
+  int value = 0;
+  for (auto & pixel : itk::MakeImageBufferRange(image.GetPointer()))
+  {
+    pixel = static_cast<short>((value++ / 5) % 1000);
+  }
+
+  for (const std::string fileName : { "parallelDeflateTest.mha",
+                                      "parallelDeflateTest.mhd",
+                                      "parallelDeflateTest.nrrd",
+                                      "parallelDeflateTest.nhdr",
+                                      "parallelDeflateTest.nii.gz",
+                                      "parallelDeflateTest.hdr.gz" })
+  {
+    itk::WriteImage(image, fileName, true);
+    const auto output = itk::ReadImage<ImageType>(fileName);
+    ASSERT_EQ(output->GetBufferedRegion(), image->GetBufferedRegion()) << fileName;
+    const auto expectedPixels = itk::MakeImageBufferRange(image.GetPointer());
+    EXPECT_TRUE(std::equal(expectedPixels.cbegin(), expectedPixels.cend(), output->GetBufferPointer())) << fileName;
+  }
+
+  // The MetaImage header has the compressed size, and names the data file.
+  std::ifstream     headerFile("parallelDeflateTest.mhd");
+  const std::string header{ std::istreambuf_iterator<char>(headerFile), std::istreambuf_iterator<char>() };
+  EXPECT_NE(header.find("CompressedData = True"), std::string::npos);
+  EXPECT_NE(header.find("CompressedDataSize = "), std::string::npos);
+  EXPECT_NE(header.find("ElementDataFile = parallelDeflateTest.zraw"), std::string::npos);
+}
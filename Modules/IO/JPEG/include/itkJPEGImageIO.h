@@ -52,6 +52,13 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(JPEGImageIO);
 
+  /** \see ImageIOBase::CanCloneSettings() */
+  bool
+  CanCloneSettings() const override
+  {
+    return true;
+  }
+
   /** Set/Get the level of quality for the output images. */
   virtual void
   SetQuality(int _JPEGQuality)
@@ -116,6 +123,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Create a JPEGImageIO with the same settings. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   WriteSlice(const std::string & fileName, const void * const buffer);
 
@@ -71,6 +71,13 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(MRCImageIO);
 
+  /** \see ImageIOBase::CanCloneSettings() */
+  bool
+  CanCloneSettings() const override
+  {
+    return true;
+  }
+
   // we don't use this method
   void
   WriteImageInformation() override
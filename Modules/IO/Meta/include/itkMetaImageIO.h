@@ -37,6 +37,9 @@ namespace itk
  *  For a detailed description of using this format, please see
  *  https://www.itk.org/Wiki/ITK/MetaIO/Documentation
  *
+ *  Compressed images are deflated on multiple threads, see ParallelDeflate,
+ *  unless their data file name is set.
+ *
  *  \ingroup IOFilters
  * \ingroup ITKIOMeta
  */
@@ -56,6 +59,13 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(MetaImageIO);
 
+  /** \see ImageIOBase::CanCloneSettings() */
+  bool
+  CanCloneSettings() const override
+  {
+    return true;
+  }
+
   /** The different types of ImageIO's can support data of varying
    * dimensionality. For example, some file formats are strictly 2D
    * while others can support 2D, 3D, or even n-D. This method returns
@@ -82,6 +92,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The pixels of uncompressed MetaImages stored in a single data file (LOCAL
+   * or not) in the byte order of this machine can be memory-mapped. */
+  bool
+  CanMemoryMapIORegion(std::string & dataFileName, SizeValueType & offset) override;
+
   MetaImage *
   GetMetaImagePointer();
 
@@ -187,6 +202,10 @@ protected:
   ~MetaImageIO() override;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Create a MetaImageIO with the same settings. */
+  LightObject::Pointer
+  InternalClone() const override;
   template <unsigned int VNRows, unsigned int VNColumns = VNRows>
   bool
   WriteMatrixInMetaData(std::ostringstream &       strs,
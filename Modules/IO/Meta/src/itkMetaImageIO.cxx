@@ -23,8 +23,11 @@
 #include "itkMath.h"
 #include "itkSingleton.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkParallelDeflate.h"
 #include "metaImageUtils.h"
 
+#include <fstream>
+
 // Function to join strings with a delimiter similar to python's ' '.join([1, 2, 3 ])
 template <typename ContainerType, typename DelimiterType, typename StreamType>
 static auto
@@ -48,6 +51,67 @@ itkGetGlobalValueMacro(MetaImageIO, unsigned int, DefaultDoublePrecision, 17);
 
 unsigned int * MetaImageIO::m_DefaultDoublePrecision;
 
+namespace
+{
+// MetaIO deflates the pixels on a single thread, while it writes them. Here
+// the pixels are deflated by ParallelDeflate, and MetaIO writes the header of
+// the compressed image, with its compressed size. The pixels then follow the
+// header in the header file (.mha), or go to a .zraw data file (.mhd), as
+// MetaIO would name it.
+bool
+WriteWithParallelCompression(MetaImage &         metaImage,
+                             const std::string & fileName,
+                             const void *        buffer,
+                             SizeValueType       numberOfBytes,
+                             int                 compressionLevel)
+{
+  const bool  isLocal = itksys::SystemTools::GetFilenameLastExtension(fileName) == ".mha";
+  std::string headerFileName = fileName;
+  std::string dataFileName;
+  if (!isLocal)
+  {
+    MET_SetFileSuffix(headerFileName, "mhd");
+    dataFileName = itksys::SystemTools::GetFilenameWithoutLastExtension(fileName) + ".zraw";
+  }
+
+  const auto parallelDeflate = ParallelDeflate::New();
+  // A negative level selects the default level of zlib, as for deflateInit.
+  if (compressionLevel >= 0)
+  {
+    parallelDeflate->SetCompressionLevel(compressionLevel);
+  }
+  const std::vector<char> compressedData = parallelDeflate->Compress(buffer, numberOfBytes);
+
+  std::ofstream headerFile(headerFileName, std::ios::binary | std::ios::trunc);
+  if (!headerFile.is_open())
+  {
+    return false;
+  }
+  // The data file is named relative to the header file, and the reader
+  // needs the compressed size to find the end of LOCAL data.
+  const std::string userDataFileName = metaImage.ElementDataFileName();
+  metaImage.FileName(headerFileName.c_str());
+  metaImage.ElementDataFileName(isLocal ? "LOCAL" : dataFileName.c_str());
+  const bool headerWritten =
+    metaImage.WriteCompressedHeaderStream(&headerFile, static_cast<std::streamoff>(compressedData.size()));
+  metaImage.ElementDataFileName(userDataFileName.c_str());
+  if (!headerWritten)
+  {
+    return false;
+  }
+
+  std::ofstream dataFile;
+  if (!isLocal)
+  {
+    const std::string path = itksys::SystemTools::GetFilenamePath(headerFileName);
+    dataFile.open(path.empty() ? dataFileName : path + '/' + dataFileName, std::ios::binary | std::ios::trunc);
+  }
+  std::ofstream & dataStream = isLocal ? headerFile : dataFile;
+  dataStream.write(compressedData.data(), static_cast<std::streamsize>(compressedData.size()));
+  return headerFile.good() && dataStream.good();
+}
+} // namespace
+
 MetaImageIO::MetaImageIO()
 {
   itkInitGlobalsMacro(DefaultDoublePrecision);
@@ -77,6 +141,21 @@ MetaImageIO::MetaImageIO()
 
 MetaImageIO::~MetaImageIO() = default;
 
+LightObject::Pointer
+MetaImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_SubSamplingFactor = m_SubSamplingFactor;
+  rval->m_MetaImage.SetDoublePrecision(m_MetaImage.GetDoublePrecision());
+  return loPtr;
+}
+
 void
 MetaImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -511,6 +590,63 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+bool
+MetaImageIO::CanMemoryMapIORegion(std::string & dataFileName, SizeValueType & offset)
+{
+  SizeValueType regionOffset = 0;
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() || m_SubSamplingFactor != 1 ||
+      !this->GetContiguousIORegionOffset(regionOffset))
+  {
+    return false;
+  }
+  int elementSize = 0;
+  MET_SizeOfType(m_MetaImage.ElementType(), &elementSize);
+  if (elementSize != static_cast<int>(this->GetComponentSize()) ||
+      (elementSize > 1 && m_MetaImage.BinaryDataByteOrderMSB() != MET_SystemByteOrderMSB()))
+  {
+    return false;
+  }
+
+  // Lists of files, and file name patterns, spread the pixels over several files.
+  const std::string elementDataFileName = m_MetaImage.ElementDataFileName();
+  if (elementDataFileName.substr(0, 4) == "LIST" || elementDataFileName.find('%') != std::string::npos)
+  {
+    return false;
+  }
+  const bool isLocal =
+    elementDataFileName == "LOCAL" || elementDataFileName == "Local" || elementDataFileName == "local";
+  if (isLocal)
+  {
+    dataFileName = m_FileName;
+  }
+  else
+  {
+    const std::string path = itksys::SystemTools::GetFilenamePath(m_FileName);
+    dataFileName = (path.empty() || itksys::SystemTools::FileIsFullPath(elementDataFileName))
+                     ? elementDataFileName
+                     : path + '/' + elementDataFileName;
+  }
+
+  SizeValueType dataOffset = 0;
+  if (m_MetaImage.HeaderSize() > 0)
+  {
+    dataOffset = static_cast<SizeValueType>(m_MetaImage.HeaderSize());
+  }
+  else if (m_MetaImage.HeaderSize() == -1 || isLocal)
+  {
+    // The pixels are at the end of the file.
+    const auto fileSize = static_cast<SizeValueType>(itksys::SystemTools::FileLength(dataFileName));
+    const auto imageSize = static_cast<SizeValueType>(this->GetImageSizeInBytes());
+    if (fileSize < imageSize)
+    {
+      return false;
+    }
+    dataOffset = fileSize - imageSize;
+  }
+  offset = dataOffset + regionOffset;
+  return true;
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
@@ -893,6 +1029,15 @@ MetaImageIO::Write(const void * buffer)
                                                        << "Reason: " << itksys::SystemTools::GetLastSystemError());
     }
   }
+  else if (m_UseCompression && binaryData && std::string(m_MetaImage.ElementDataFileName()).empty())
+  {
+    if (!WriteWithParallelCompression(
+          m_MetaImage, m_FileName, buffer, this->GetImageSizeInBytes(), this->GetCompressionLevel()))
+    {
+      itkExceptionMacro("File cannot be written: " << this->GetFileName() << std::endl
+                                                   << "Reason: " << itksys::SystemTools::GetLastSystemError());
+    }
+  }
   else
   {
     if (!m_MetaImage.Write(m_FileName.c_str()))
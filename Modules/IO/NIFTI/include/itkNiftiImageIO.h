@@ -91,6 +91,9 @@ extern ITKIONIFTI_EXPORT std::ostream &
  * The specification for this file format is taken from the
  * web site https://analyzedirect.com/support/10.0Documents/Analyze_Resource_01.pdf
  *
+ * The data of gzip compressed files is deflated on multiple threads, see
+ * ParallelDeflate, and stored in a gzip member following the one of the header.
+ *
  * \ingroup IOFilters
  * \ingroup ITKIONIFTI
  */
@@ -110,6 +113,13 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(NiftiImageIO);
 
+  /** \see ImageIOBase::CanCloneSettings() */
+  bool
+  CanCloneSettings() const override
+  {
+    return true;
+  }
+
   //-------- This part of the interfaces deals with reading data. -----
 
 #if !defined(ITK_LEGACY_REMOVE)
@@ -230,6 +240,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Create a NiftiImageIO with the same settings. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   virtual bool
   GetUseLegacyModeForTwoFileWriting() const
   {
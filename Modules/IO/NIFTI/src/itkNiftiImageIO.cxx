@@ -22,6 +22,7 @@
 #include <nifti1_io.h>
 #include "itkNiftiImageIOConfigurePrivate.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkParallelDeflate.h"
 #include "itksys/SystemTools.hxx"
 #include "itksys/SystemInformation.hxx"
 
@@ -439,6 +440,23 @@ NiftiImageIO::NiftiImageIO()
 
 NiftiImageIO::~NiftiImageIO() { nifti_image_free(this->m_NiftiImage); }
 
+LightObject::Pointer
+NiftiImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_ConvertRASVectors = m_ConvertRASVectors;
+  rval->m_ConvertRASDisplacementVectors = m_ConvertRASDisplacementVectors;
+  rval->m_LegacyAnalyze75Mode = m_LegacyAnalyze75Mode;
+  rval->m_SFORM_Permissive = m_SFORM_Permissive;
+  return loPtr;
+}
+
 void
 NiftiImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -2380,6 +2398,91 @@ NiftiImageIO::SetNIfTIOrientationFromImageIO(unsigned short origdims, unsigned s
   this->m_NiftiImage->sform_code = NIFTI_XFORM_SCANNER_ANAT;
 }
 
+namespace
+{
+// Same as nifti_image_write_status, except that the data of a gzip file is
+// compressed in parallel. The header and the data are then stored as two
+// consecutive gzip members, which gzip readers decompress as a single stream.
+int
+WriteNiftiImageStatus(nifti_image * nim)
+{
+  if (nim->nifti_type == NIFTI_FTYPE_ASCII)
+  {
+    return nifti_image_write_status(nim);
+  }
+
+  // The data of a header/image pair goes to iname, which niftilib would
+  // otherwise only name while writing the header.
+  const bool singleFile = nim->nifti_type == NIFTI_FTYPE_NIFTI1_1;
+  if (!singleFile && (nim->iname == nullptr || strcmp(nim->iname, nim->fname) == 0))
+  {
+    free(nim->iname);
+    nim->iname = nifti_makeimgname(nim->fname, nim->nifti_type, 0, nifti_is_gzfile(nim->fname));
+    if (nim->iname == nullptr)
+    {
+      return 1;
+    }
+  }
+  const std::string dataFileName = singleFile ? nim->fname : nim->iname;
+  if (!nifti_is_gzfile(dataFileName.c_str()))
+  {
+    return nifti_image_write_status(nim);
+  }
+
+  // Write the header and the extensions only, which sets iname_offset. The
+  // data file is left open, as that tells whether the header was written.
+  znzFile openFile = nifti_image_write_hdr_img2(nim, 2, "wb", nullptr, nullptr);
+  if (znz_isnull(openFile))
+  {
+    return 1;
+  }
+  znzclose(openFile);
+
+  // Pad the data up to its offset, after the uncompressed size of the
+  // header member, as stored at the end of the file.
+  SizeValueType paddingSize = nim->iname_offset;
+  if (singleFile)
+  {
+    std::ifstream headerFile(dataFileName, std::ios::binary | std::ios::ate);
+    unsigned char headerSize[4];
+    if (!headerFile || headerFile.tellg() < 4 || !headerFile.seekg(-4, std::ios::end) ||
+        !headerFile.read(reinterpret_cast<char *>(headerSize), 4))
+    {
+      return 1;
+    }
+    const SizeValueType writtenSize =
+      headerSize[0] | (headerSize[1] << 8) | (headerSize[2] << 16) | (SizeValueType{ headerSize[3] } << 24);
+    if (writtenSize > paddingSize)
+    {
+      return 1;
+    }
+    paddingSize -= writtenSize;
+  }
+
+  std::ofstream dataFile(dataFileName, std::ios::binary | (singleFile ? std::ios::app : std::ios::trunc));
+  if (!dataFile)
+  {
+    return 1;
+  }
+  try
+  {
+    const auto parallelDeflate = ParallelDeflate::New();
+    parallelDeflate->SetFormat(ParallelDeflate::FormatEnum::Gzip);
+    if (paddingSize > 0)
+    {
+      const std::vector<char> padding(paddingSize, 0);
+      parallelDeflate->Compress(padding.data(), paddingSize, dataFile);
+    }
+    parallelDeflate->Compress(nim->data, nifti_get_volsize(nim), dataFile);
+  }
+  catch (const ExceptionObject &)
+  {
+    return 1;
+  }
+  return 0;
+}
+} // namespace
+
 void
 NiftiImageIO::Write(const void * buffer)
 {
@@ -2393,7 +2496,7 @@ NiftiImageIO::Write(const void * buffer)
     // Need a const cast here so that we don't have to copy the memory
     // for writing.
     this->m_NiftiImage->data = const_cast<void *>(buffer);
-    const int nifti_write_status = nifti_image_write_status(this->m_NiftiImage);
+    const int nifti_write_status = WriteNiftiImageStatus(this->m_NiftiImage);
     this->m_NiftiImage->data = nullptr; // Must free before throwing exception.
                                         // if left pointing to data buffer
                                         // nifti_image_free inside Destructor of ITKNiftiIO
@@ -2502,7 +2605,7 @@ NiftiImageIO::Write(const void * buffer)
     // Need a const cast here so that we don't have to copy the memory for
     // writing.
     this->m_NiftiImage->data = static_cast<void *>(nifti_buf.get());
-    const int nifti_write_status = nifti_image_write_status(this->m_NiftiImage);
+    const int nifti_write_status = WriteNiftiImageStatus(this->m_NiftiImage);
     this->m_NiftiImage->data = nullptr; // if left pointing to data buffer
     if (nifti_write_status)
     {
@@ -36,7 +36,8 @@ namespace itk
  *
  * The compressor supported may include "gzip" (default) and
  * "bzip2".  Only the "gzip" compressor support the compression level
- * in the range 0-9.
+ * in the range 0-9. The "gzip" compression is multi-threaded, see
+ * ParallelDeflate.
  *
  *  \ingroup IOFilters
  * \ingroup ITKIONRRD
@@ -57,6 +58,13 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(NrrdImageIO);
 
+  /** \see ImageIOBase::CanCloneSettings() */
+  bool
+  CanCloneSettings() const override
+  {
+    return true;
+  }
+
   /** The different types of ImageIO's can support data of varying
    * dimensionality. For example, some file formats are strictly 2D
    * while others can support 2D, 3D, or even n-D. This method returns
@@ -78,6 +86,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The pixels of raw encoded files, with a single data file (attached or
+   * detached) in the byte order of this machine, can be memory-mapped. */
+  bool
+  CanMemoryMapIORegion(std::string & dataFileName, SizeValueType & offset) override;
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool
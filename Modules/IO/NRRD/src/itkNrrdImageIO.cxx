@@ -22,6 +22,8 @@
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
 #include "itkFloatingPointExceptions.h"
+#include "itkParallelDeflate.h"
+#include "itksys/SystemTools.hxx"
 
 #include <sstream>
 
@@ -852,6 +854,84 @@ NrrdImageIO::Read(void * buffer)
   }
 }
 
+bool
+NrrdImageIO::CanMemoryMapIORegion(std::string & dataFileName, SizeValueType & offset)
+{
+  SizeValueType regionOffset = 0;
+  if (IOPixelEnum::SYMMETRICSECONDRANKTENSOR == this->GetPixelType() ||
+      !this->GetContiguousIORegionOffset(regionOffset))
+  {
+    return false;
+  }
+
+  // Read the header again, letting nrrdLoad leave the data file open at the
+  // first pixel, after any line and byte skipping.
+  Nrrd *        nrrd = nrrdNew();
+  NrrdIoState * nio = nrrdIoStateNew();
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
+
+  bool saveFPEState(false);
+  if (FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    saveFPEState = FloatingPointExceptions::GetEnabled();
+    FloatingPointExceptions::Disable();
+  }
+  const bool loaded = nrrdLoad(nrrd, this->GetFileName(), nio) == 0;
+  if (FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    FloatingPointExceptions::SetEnabled(saveFPEState);
+  }
+
+  bool canMap = false;
+  if (loaded)
+  {
+    unsigned int       rangeAxisIdx[NRRD_DIM_MAX];
+    const unsigned int rangeAxisNum = nrrdRangeAxesGet(nrrd, rangeAxisIdx);
+
+    // The data file is only kept open when it is the single data file.
+    // Read() permutes the axes when the range axis is not the fastest one.
+    if (nio->dataFile != nullptr && nio->encoding == nrrdEncodingRaw &&
+        (rangeAxisNum == 0 || (rangeAxisNum == 1 && rangeAxisIdx[0] == 0)))
+    {
+#if defined(_WIN32)
+      const auto position = _ftelli64(nio->dataFile);
+#else
+      const auto position = ftello(nio->dataFile);
+#endif
+      if (position >= 0)
+      {
+        if (nio->dataFNArr->len == 0)
+        {
+          dataFileName = this->GetFileName();
+        }
+        else
+        {
+          dataFileName = nio->dataFN[0];
+          if (nio->path != nullptr && !itksys::SystemTools::FileIsFullPath(dataFileName))
+          {
+            dataFileName = std::string(nio->path) + '/' + dataFileName;
+          }
+        }
+        offset = static_cast<SizeValueType>(position) + regionOffset;
+        canMap = true;
+      }
+    }
+  }
+  else
+  {
+    free(biffGetDone(NRRD));
+  }
+
+  if (nio->dataFile != nullptr)
+  {
+    nio->dataFile = airFclose(nio->dataFile);
+  }
+  nrrd = nrrdNix(nrrd);
+  nio = nrrdIoStateNix(nio);
+  return canMap;
+}
+
 bool
 NrrdImageIO::CanWriteFile(const char * name)
 {
@@ -1141,6 +1221,13 @@ NrrdImageIO::Write(const void * buffer)
       break;
   }
 
+  // Gzip data is compressed in parallel, after nrrdSave writes the header.
+  const bool compressInParallel = nio->encoding == nrrdEncodingGzip;
+  if (compressInParallel)
+  {
+    nrrdIoStateSet(nio, nrrdIoStateSkipData, AIR_TRUE);
+  }
+
   // Write the nrrd to file.
   if (nrrdSave(this->GetFileName(), nrrd, nio))
   {
@@ -1148,6 +1235,23 @@ NrrdImageIO::Write(const void * buffer)
     itkExceptionMacro("Write: Error writing " << this->GetFileName() << ":\n" << err);
   }
 
+  if (compressInParallel)
+  {
+    // The data file of a detached header is relative to the header, while
+    // attached data follows the header.
+    const bool        detachedData = nio->detachedHeader;
+    const std::string dataFileName =
+      detachedData ? std::string(nio->path) + '/' + nio->dataFN[0] : std::string(this->GetFileName());
+    std::ofstream dataFile;
+    this->OpenFileForWriting(dataFile, dataFileName, detachedData);
+    dataFile.seekp(0, std::ios::end);
+
+    const auto parallelDeflate = ParallelDeflate::New();
+    parallelDeflate->SetFormat(ParallelDeflate::FormatEnum::Gzip);
+    parallelDeflate->SetCompressionLevel(nio->zlibLevel < 0 ? 6 : nio->zlibLevel);
+    parallelDeflate->Compress(buffer, this->GetImageSizeInBytes(), dataFile);
+  }
+
   // Free the nrrd struct but don't touch nrrd->data
   nrrdNix(nrrd);
   nrrdIoStateNix(nio);
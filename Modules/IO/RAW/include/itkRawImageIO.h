@@ -123,6 +123,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Binary files in the byte order of this machine can be memory-mapped,
+   * from the header size on. */
+  bool
+  CanMemoryMapIORegion(std::string & dataFileName, SizeValueType & offset) override;
+
   /** Set/Get the Data mask. */
   itkGetConstReferenceMacro(ImageMask, unsigned short);
   void
@@ -161,6 +161,20 @@ RawImageIO<TPixel, VImageDimension>::Read(void * buffer)
   ReadRawBytesAfterSwapping(componentType, buffer, m_ByteOrder, numberOfComponents);
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+bool
+RawImageIO<TPixel, VImageDimension>::CanMemoryMapIORegion(std::string & dataFileName, SizeValueType & offset)
+{
+  SizeValueType regionOffset = 0;
+  if (m_FileName.empty() || !this->GetContiguousIORegionOffset(regionOffset))
+  {
+    return false;
+  }
+  dataFileName = m_FileName;
+  offset = this->GetHeaderSize() + regionOffset;
+  return true;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 bool
 RawImageIO<TPixel, VImageDimension>::CanWriteFile(const char * fname)
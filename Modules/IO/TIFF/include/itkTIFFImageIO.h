@@ -20,6 +20,7 @@
 #include "ITKIOTIFFExport.h"
 
 #include "itkImageIOBase.h"
+#include "itkMultiThreaderBase.h"
 #include <fstream>
 
 namespace itk
@@ -38,6 +39,19 @@ class TIFFReaderInternal;
  * supports the compression level for JPEG quality parameter in the
  * range 0-100.
  *
+ * Images which can be read without conversion to RGBA are read tile by
+ * tile, or strip by strip, in parallel on the MultiThreader, each work
+ * unit decoding with its own handle on the file. Only the tiles or strips which intersect the
+ * IORegion are decoded, so that streamed reading of a sub-region of a
+ * large image is supported for those files. At most
+ * MaximumNumberOfWorkUnits work units are used when it is not 0, and
+ * with 1, the file is decoded on the calling thread.
+ *
+ * The writer writes strips by default, or tiles of TileWidth by TileHeight
+ * pixels when a tile size is set. Multi-page images are written as one
+ * page per slice, and the file is written as BigTIFF when UseBigTIFF is on
+ * or when the image is larger than 2 GiB.
+ *
  * \ingroup IOFilters
  * \ingroup ITKIOTIFF
  *
@@ -64,6 +78,13 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(TIFFImageIO);
 
+  /** \see ImageIOBase::CanCloneSettings() */
+  bool
+  CanCloneSettings() const override
+  {
+    return true;
+  }
+
   /*-------- This part of the interface deals with reading data. ------ */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -83,6 +104,18 @@ public:
   virtual void
   ReadVolume(void * buffer);
 
+  /** Returns true when the file read by the last ReadImageInformation()
+   * is decoded natively, tile by tile or strip by strip, in which case
+   * any IORegion can be read. */
+  bool
+  CanStreamRead() override;
+
+  /** Method for supporting streaming. Given a requested region, determine
+   * what could be the region that we can read from the file: the requested
+   * region itself when streamed reading is enabled and supported. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const override;
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -157,6 +190,25 @@ public:
   }
 
 
+  /** Set the size of the tiles written, in pixels. The width and the height
+   * are rounded up to multiples of 16, as required by the TIFF
+   * specification. A zero width or height writes strips, the default. */
+  void
+  SetTileSize(unsigned int width, unsigned int height);
+  itkGetConstMacro(TileWidth, unsigned int);
+  itkGetConstMacro(TileHeight, unsigned int);
+
+  /** Set/Get the multi-threader which decodes the tiles or the strips. */
+  itkSetObjectMacro(MultiThreader, MultiThreaderBase);
+  itkGetModifiableObjectMacro(MultiThreader, MultiThreaderBase);
+
+  /** Set/Get whether the file is written as BigTIFF, whose 64-bit offsets
+   * support files larger than 4 GiB. Images larger than 2 GiB are written as
+   * BigTIFF regardless. Off by default. */
+  itkSetMacro(UseBigTIFF, bool);
+  itkGetConstMacro(UseBigTIFF, bool);
+  itkBooleanMacro(UseBigTIFF);
+
   /** Set/Get the level of quality for the output images if
    * Compression is JPEG. Settings vary from 1 to 100.
    * 100 is the highest quality. Default is 75 */
@@ -196,6 +248,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Create a TIFFImageIO with the same settings. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalSetCompressor(const std::string & _compressor) override;
 
@@ -255,6 +311,19 @@ private:
   void
   ReadCurrentPage(void * buffer, size_t pixelOffset);
 
+  // Reads the IORegion, decoding the intersecting tiles or strips in parallel.
+  void
+  ReadRegion(void * buffer);
+
+  template <typename TComponent>
+  void
+  ReadRegion(void * buffer);
+
+  // Converts a run of pixels of the file to the pixel type of the IO.
+  template <typename TComponent>
+  void
+  PutPixels(TComponent * to, const void * from, unsigned int numberOfPixels);
+
   template <typename TComponent>
   void
   ReadGenericImage(void * _out, unsigned int width, unsigned int height);
@@ -309,6 +378,13 @@ private:
   uint16_t *   m_ColorBlue{};
   uint64_t     m_TotalColors{ 0 };
   unsigned int m_ImageFormat{ TIFFImageIO::NOFORMAT };
+
+  unsigned int m_TileWidth{ 0 };
+  unsigned int m_TileHeight{ 0 };
+  bool         m_UseBigTIFF{ false };
+  bool         m_CanStreamRead{ false };
+
+  MultiThreaderBase::Pointer m_MultiThreader{};
 };
 } // end namespace itk
 
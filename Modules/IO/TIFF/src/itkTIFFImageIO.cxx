@@ -24,8 +24,49 @@
 
 #include "itk_tiff.h"
 
+#include <exception>
+#include <mutex>
+#include <vector>
+
 namespace itk
 {
+namespace
+{
+// Writes the rows of a page as the tiles set on the directory, padding the
+// tiles across the right and bottom edges with zeros.
+bool
+WriteTiles(TIFF * tif, const char * page, uint32_t width, uint32_t height, SizeValueType rowLength)
+{
+  uint32_t tileWidth = 0;
+  uint32_t tileHeight = 0;
+  TIFFGetField(tif, TIFFTAG_TILEWIDTH, &tileWidth);
+  TIFFGetField(tif, TIFFTAG_TILELENGTH, &tileHeight);
+  const SizeValueType pixelLength = rowLength / width;
+  std::vector<char>   tile(static_cast<size_t>(TIFFTileSize64(tif)));
+
+  for (uint32_t y = 0; y < height; y += tileHeight)
+  {
+    for (uint32_t x = 0; x < width; x += tileWidth)
+    {
+      const uint32_t rows = std::min(tileHeight, height - y);
+      const uint32_t columns = std::min(tileWidth, width - x);
+      std::fill(tile.begin(), tile.end(), 0);
+      for (uint32_t row = 0; row < rows; ++row)
+      {
+        std::copy_n(page + (y + row) * rowLength + x * pixelLength,
+                    columns * pixelLength,
+                    tile.data() + row * tileWidth * pixelLength);
+      }
+      if (TIFFWriteEncodedTile(tif, TIFFComputeTile(tif, x, y, 0, 0), tile.data(), static_cast<tmsize_t>(tile.size())) <
+          0)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
 
 bool
 TIFFImageIO::CanReadFile(const char * file)
@@ -188,9 +229,14 @@ TIFFImageIO::Read(void * buffer)
     }
   }
 
-  // The IO region should be of dimensions 3 otherwise we read only the first
-  // page
-  if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
+  // Files which can be read natively are read tile by tile or strip by
+  // strip. The IO region should be of dimensions 3 otherwise we read only
+  // the first page
+  if (m_InternalImage->CanRead())
+  {
+    this->ReadRegion(buffer);
+  }
+  else if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
   {
     this->ReadVolume(buffer);
   }
@@ -202,9 +248,39 @@ TIFFImageIO::Read(void * buffer)
   m_InternalImage->Clean();
 }
 
+bool
+TIFFImageIO::CanStreamRead()
+{
+  return m_CanStreamRead;
+}
+
+ImageIORegion
+TIFFImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const
+{
+  if (!m_UseStreamedReading || !m_CanStreamRead)
+  {
+    return ImageIOBase::GenerateStreamableReadRegionFromRequestedRegion(requestedRegion);
+  }
+  return requestedRegion;
+}
+
+void
+TIFFImageIO::SetTileSize(unsigned int width, unsigned int height)
+{
+  // Tile sizes must be multiples of 16
+  width = (width + 15) / 16 * 16;
+  height = (height + 15) / 16 * 16;
+  if (width != m_TileWidth || height != m_TileHeight)
+  {
+    m_TileWidth = width;
+    m_TileHeight = height;
+    this->Modified();
+  }
+}
+
 TIFFImageIO::TIFFImageIO()
   : m_ColorPalette(0)
-
+  , m_MultiThreader(MultiThreaderBase::New())
 {
   this->SetNumberOfDimensions(2);
   this->Self::SetJPEGQuality(75);
@@ -240,6 +316,25 @@ TIFFImageIO::~TIFFImageIO()
   delete m_InternalImage;
 }
 
+LightObject::Pointer
+TIFFImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_Compression = m_Compression;
+  rval->m_TileWidth = m_TileWidth;
+  rval->m_TileHeight = m_TileHeight;
+  rval->m_UseBigTIFF = m_UseBigTIFF;
+  // Each clone decodes on its own multi-threader, with as many work units.
+  rval->m_MultiThreader->SetNumberOfWorkUnits(m_MultiThreader->GetNumberOfWorkUnits());
+  return loPtr;
+}
+
 void
 TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -247,6 +342,11 @@ TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "Compression: " << m_Compression << std::endl;
   os << indent << "JPEGQuality: " << this->GetJPEGQuality() << std::endl;
+  os << indent << "TileWidth: " << m_TileWidth << std::endl;
+  os << indent << "TileHeight: " << m_TileHeight << std::endl;
+  os << indent << "UseBigTIFF: " << m_UseBigTIFF << std::endl;
+  os << indent << "CanStreamRead: " << m_CanStreamRead << std::endl;
+  itkPrintSelfObjectMacro(MultiThreader);
   if (!m_ColorPalette.empty())
   {
     os << indent << "Image RGB palette:" << '\n';
@@ -488,6 +588,8 @@ TIFFImageIO::ReadImageInformation()
   }
 
 
+  m_CanStreamRead = m_InternalImage->CanRead();
+
   if (!m_InternalImage->CanRead())
   {
     //  exception if compression is not supported
@@ -619,7 +721,7 @@ TIFFImageIO::InternalWrite(const void * buffer)
   constexpr SizeType oneGibiByte = 1024 * oneMebiByte;
   constexpr SizeType twoGibiBytes = 2 * oneGibiByte;
 
-  if (this->GetImageSizeInBytes() > twoGibiBytes)
+  if (m_UseBigTIFF || this->GetImageSizeInBytes() > twoGibiBytes)
   {
 #ifdef TIFF_INT64_T // detect if libtiff4
     // Adding the "8" option enables the use of big tiff
@@ -781,7 +883,16 @@ TIFFImageIO::InternalWrite(const void * buffer)
       rowsperstrip = 1;
     }
 
-    TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+    const bool isTiled = m_TileWidth > 0 && m_TileHeight > 0;
+    if (isTiled)
+    {
+      TIFFSetField(tif, TIFFTAG_TILEWIDTH, m_TileWidth);
+      TIFFSetField(tif, TIFFTAG_TILELENGTH, m_TileHeight);
+    }
+    else
+    {
+      TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+    }
 
     if (resolution_x > 0 && resolution_y > 0)
     {
@@ -823,15 +934,26 @@ TIFFImageIO::InternalWrite(const void * buffer)
     rowLength *= this->GetNumberOfComponents();
     rowLength *= width;
 
-    uint32_t row = 0;
-    for (unsigned int idx2 = 0; idx2 < height; ++idx2)
+    if (isTiled)
     {
-      if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
+      if (!WriteTiles(tif, outPtr, w, h, rowLength))
       {
         itkExceptionMacro("TIFFImageIO: error out of disk space");
       }
-      outPtr += rowLength;
-      ++row;
+      outPtr += rowLength * height;
+    }
+    else
+    {
+      uint32_t row = 0;
+      for (unsigned int idx2 = 0; idx2 < height; ++idx2)
+      {
+        if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
+        {
+          itkExceptionMacro("TIFFImageIO: error out of disk space");
+        }
+        outPtr += rowLength;
+        ++row;
+      }
     }
 
     if (m_NumberOfDimensions == 3)
@@ -1313,6 +1435,290 @@ TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
   }
 }
 
+
+void
+TIFFImageIO::ReadRegion(void * buffer)
+{
+  switch (m_ComponentType)
+  {
+    case IOComponentEnum::CHAR:
+      this->ReadRegion<char>(buffer);
+      break;
+    case IOComponentEnum::USHORT:
+      this->ReadRegion<unsigned short>(buffer);
+      break;
+    case IOComponentEnum::SHORT:
+      this->ReadRegion<short>(buffer);
+      break;
+    case IOComponentEnum::UINT:
+      this->ReadRegion<uint32_t>(buffer);
+      break;
+    case IOComponentEnum::INT:
+      this->ReadRegion<int32_t>(buffer);
+      break;
+    case IOComponentEnum::FLOAT:
+      this->ReadRegion<float>(buffer);
+      break;
+    default:
+      this->ReadRegion<unsigned char>(buffer);
+      break;
+  }
+}
+
+template <typename TComponent>
+void
+TIFFImageIO::ReadRegion(void * buffer)
+{
+  TIFF * const   tif = m_InternalImage->m_Image;
+  const uint32_t height = m_InternalImage->m_Height;
+  const bool     bottomLeft = m_InternalImage->m_Orientation == ORIENTATION_BOTLEFT;
+
+  // The columns, rows and pages of the IORegion. A 2D IORegion reads the
+  // first page.
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  const auto            beginColumn = static_cast<uint32_t>(ioRegion.GetIndex(0));
+  const auto            endColumn = static_cast<uint32_t>(beginColumn + ioRegion.GetSize(0));
+  const auto            beginRow = static_cast<uint32_t>(ioRegion.GetIndex(1));
+  const auto            endRow = static_cast<uint32_t>(beginRow + ioRegion.GetSize(1));
+  SizeValueType         beginPage = 0;
+  SizeValueType         numberOfPages = 1;
+  if (ioRegion.GetImageDimension() > 2 && m_NumberOfDimensions > 2)
+  {
+    beginPage = ioRegion.GetIndex(2);
+    numberOfPages = ioRegion.GetSize(2);
+  }
+
+  // The directories of the pages, without the reduced images and the masks.
+  std::vector<tdir_t> directories;
+  const SizeValueType endPage = beginPage + numberOfPages;
+  for (tdir_t directory = 0; directory < m_InternalImage->m_NumberOfPages && directories.size() < endPage; ++directory)
+  {
+    TIFFSetDirectory(tif, directory);
+    int32_t subfiletype = 0;
+    if (m_InternalImage->m_IgnoredSubFiles > 0 && TIFFGetField(tif, TIFFTAG_SUBFILETYPE, &subfiletype) &&
+        (subfiletype & FILETYPE_REDUCEDIMAGE || subfiletype & FILETYPE_MASK))
+    {
+      continue;
+    }
+    directories.push_back(directory);
+  }
+  if (directories.size() < endPage)
+  {
+    itkExceptionMacro("The IORegion " << ioRegion << " is outside of the pages of " << m_FileName);
+  }
+
+  // The rows of the file holding the rows of the IORegion.
+  const uint32_t beginFileRow = bottomLeft ? height - endRow : beginRow;
+  const uint32_t endFileRow = bottomLeft ? height - beginRow : endRow;
+
+  // A tile or a strip of a page, and the part of it inside the IORegion.
+  struct Chunk
+  {
+    tdir_t        Directory;
+    SizeValueType Page;
+    uint32_t      Index;
+    uint32_t      X;
+    uint32_t      Y;
+    uint32_t      BeginColumn;
+    uint32_t      EndColumn;
+    uint32_t      BeginRow;
+    uint32_t      EndRow;
+  };
+  std::vector<Chunk> chunks;
+  for (SizeValueType page = 0; page < numberOfPages; ++page)
+  {
+    const tdir_t directory = directories[beginPage + page];
+    TIFFSetDirectory(tif, directory);
+    if (TIFFIsTiled(tif))
+    {
+      uint32_t tileWidth = 0;
+      uint32_t tileHeight = 0;
+      TIFFGetField(tif, TIFFTAG_TILEWIDTH, &tileWidth);
+      TIFFGetField(tif, TIFFTAG_TILELENGTH, &tileHeight);
+      for (uint32_t y = beginFileRow - beginFileRow % tileHeight; y < endFileRow; y += tileHeight)
+      {
+        for (uint32_t x = beginColumn - beginColumn % tileWidth; x < endColumn; x += tileWidth)
+        {
+          chunks.push_back({ directory,
+                             page,
+                             TIFFComputeTile(tif, x, y, 0, 0),
+                             x,
+                             y,
+                             std::max(x, beginColumn),
+                             std::min(x + tileWidth, endColumn),
+                             std::max(y, beginFileRow),
+                             std::min(y + tileHeight, endFileRow) });
+        }
+      }
+    }
+    else
+    {
+      uint32_t rowsPerStrip = height;
+      TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+      rowsPerStrip = std::min(std::max(rowsPerStrip, uint32_t{ 1 }), height);
+      for (uint32_t y = beginFileRow - beginFileRow % rowsPerStrip; y < endFileRow; y += rowsPerStrip)
+      {
+        chunks.push_back({ directory,
+                           page,
+                           TIFFComputeStrip(tif, y, 0),
+                           0,
+                           y,
+                           beginColumn,
+                           endColumn,
+                           std::max(y, beginFileRow),
+                           std::min(y + rowsPerStrip, endFileRow) });
+      }
+    }
+  }
+
+  // Back to the first page, which holds the palette.
+  if (TIFFCurrentDirectory(tif) != 0)
+  {
+    TIFFSetDirectory(tif, 0);
+  }
+  this->InitializeColors();
+  this->GetFormat();
+
+  const size_t bytesPerPixel = size_t{ m_InternalImage->m_SamplesPerPixel } * m_InternalImage->m_BitsPerSample / 8;
+  const size_t numberOfComponents = this->GetNumberOfComponents();
+  const size_t regionWidth = endColumn - beginColumn;
+  const size_t regionHeight = endRow - beginRow;
+  auto * const out = static_cast<TComponent *>(buffer);
+
+  // The chunks are divided into contiguous groups. As libtiff handles cannot
+  // be shared between threads, the first group is decoded with the handle of
+  // this IO, and each other group with its own handle on the file. A single
+  // group is decoded on the calling thread, which may be a worker of the
+  // thread pool that must not wait for other workers.
+  size_t numberOfGroups = std::min<size_t>(m_MultiThreader->GetNumberOfWorkUnits(), chunks.size());
+  if (this->GetMaximumNumberOfWorkUnits() > 0)
+  {
+    numberOfGroups = std::min<size_t>(numberOfGroups, this->GetMaximumNumberOfWorkUnits());
+  }
+
+  std::exception_ptr exception;
+  std::mutex         exceptionMutex;
+  m_MultiThreader->ParallelizeArray(
+    0,
+    numberOfGroups,
+    [&](SizeValueType group) {
+      try
+      {
+        TIFFReaderInternal reader;
+        if (group > 0 && !reader.Open(m_FileName.c_str()))
+        {
+          itkExceptionMacro("Cannot open file " << m_FileName << '!');
+        }
+        TIFF * const      groupTIFF = group > 0 ? reader.m_Image : tif;
+        std::vector<char> chunkBuffer;
+
+        const size_t beginChunk = group * chunks.size() / numberOfGroups;
+        const size_t endChunk = (group + 1) * chunks.size() / numberOfGroups;
+        for (size_t c = beginChunk; c < endChunk; ++c)
+        {
+          const Chunk & chunk = chunks[c];
+          if (TIFFCurrentDirectory(groupTIFF) != chunk.Directory)
+          {
+            TIFFSetDirectory(groupTIFF, chunk.Directory);
+          }
+
+          const bool     isTiled = TIFFIsTiled(groupTIFF);
+          const uint64_t rowSize = isTiled ? TIFFTileRowSize64(groupTIFF) : TIFFScanlineSize64(groupTIFF);
+          chunkBuffer.resize(
+            static_cast<size_t>(isTiled ? TIFFTileSize64(groupTIFF) : TIFFStripSize64(groupTIFF)));
+          const tmsize_t decodedSize =
+            isTiled ? TIFFReadEncodedTile(groupTIFF, chunk.Index, chunkBuffer.data(), -1)
+                    : TIFFReadEncodedStrip(groupTIFF, chunk.Index, chunkBuffer.data(), -1);
+          if (decodedSize < 0)
+          {
+            itkExceptionMacro("Cannot read the " << (isTiled ? "tile " : "strip ") << chunk.Index << " of page "
+                                                 << chunk.Page << " of " << m_FileName);
+          }
+
+          for (uint32_t row = chunk.BeginRow; row < chunk.EndRow; ++row)
+          {
+            const char *  from = chunkBuffer.data() + (row - chunk.Y) * rowSize +
+                                (chunk.BeginColumn - chunk.X) * bytesPerPixel;
+            const size_t  regionRow = (bottomLeft ? height - 1 - row : row) - beginRow;
+            TComponent *  to = out + ((chunk.Page * regionHeight + regionRow) * regionWidth +
+                                     (chunk.BeginColumn - beginColumn)) *
+                                      numberOfComponents;
+            this->PutPixels<TComponent>(to, from, chunk.EndColumn - chunk.BeginColumn);
+          }
+        }
+      }
+      catch (...)
+      {
+        const std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!exception)
+        {
+          exception = std::current_exception();
+        }
+      }
+    },
+    nullptr);
+
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+template <typename TComponent>
+void
+TIFFImageIO::PutPixels(TComponent * to, const void * from, unsigned int numberOfPixels)
+{
+  auto * const fromComponents = static_cast<TComponent *>(const_cast<void *>(from));
+  auto * const fromBytes = static_cast<unsigned char *>(const_cast<void *>(from));
+  auto * const fromShorts = static_cast<unsigned short *>(const_cast<void *>(from));
+
+  switch (this->GetFormat())
+  {
+    case TIFFImageIO::GRAYSCALE:
+      PutGrayscale<TComponent>(to, fromComponents, numberOfPixels, 1, 0, 0);
+      break;
+    case TIFFImageIO::RGB_:
+      PutRGB_<TComponent>(to, fromComponents, numberOfPixels, 1, 0, 0);
+      break;
+    case TIFFImageIO::PALETTE_GRAYSCALE:
+      if (m_InternalImage->m_BitsPerSample == 8)
+      {
+        PutPaletteGrayscale<TComponent, unsigned char>(to, fromBytes, numberOfPixels, 1, 0, 0);
+      }
+      else
+      {
+        PutPaletteGrayscale<TComponent, unsigned short>(to, fromShorts, numberOfPixels, 1, 0, 0);
+      }
+      break;
+    case TIFFImageIO::PALETTE_RGB:
+      if (!this->GetIsReadAsScalarPlusPalette())
+      {
+        if (m_InternalImage->m_BitsPerSample == 8)
+        {
+          PutPaletteRGB<TComponent, unsigned char>(to, fromBytes, numberOfPixels, 1, 0, 0);
+        }
+        else
+        {
+          PutPaletteRGB<TComponent, unsigned short>(to, fromShorts, numberOfPixels, 1, 0, 0);
+        }
+      }
+      else
+      {
+        if (m_InternalImage->m_BitsPerSample == 8)
+        {
+          PutPaletteScalar<TComponent, unsigned char>(to, fromBytes, numberOfPixels, 1, 0, 0);
+        }
+        else
+        {
+          PutPaletteScalar<TComponent, unsigned short>(to, fromShorts, numberOfPixels, 1, 0, 0);
+        }
+      }
+      break;
+    default:
+      itkExceptionMacro("Logic Error: Unexpected format!");
+  }
+}
+
 template <typename TComponent>
 void
 TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int height)
@@ -0,0 +1,224 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkTIFFImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageSeriesReader.h"
+#include "itkRGBPixel.h"
+#include "itkTestingMacros.h"
+#include "itkThreadPool.h"
+
+#include <algorithm>
+
+namespace
+{
+
+// Writes an image with the given tile size, then reads it whole and
+// streams a sub-region of it, which must not need the whole image.
+template <typename TImage>
+int
+TestTiledStreaming(const std::string &                fileName,
+                   const typename TImage::SizeType &   size,
+                   unsigned int                        tileSize,
+                   bool                                useBigTIFF,
+                   const std::string &                 compressor,
+                   const typename TImage::RegionType & requestedRegion)
+{
+  using PixelType = typename TImage::PixelType;
+
+  const auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    itk::IndexValueType value = 0;
+    for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+    {
+      value = 7 * value + it.GetIndex()[i];
+    }
+    it.Set(static_cast<PixelType>(value % 100));
+  }
+
+  auto tiffIO = itk::TIFFImageIO::New();
+  tiffIO->SetTileSize(tileSize, tileSize);
+  tiffIO->SetUseBigTIFF(useBigTIFF);
+  ITK_TEST_EXPECT_EQUAL(tiffIO->GetTileWidth(), (tileSize + 15) / 16 * 16);
+  ITK_TEST_EXPECT_EQUAL(tiffIO->GetUseBigTIFF(), useBigTIFF);
+
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(tiffIO);
+  if (!compressor.empty())
+  {
+    writer->UseCompressionOn();
+    tiffIO->SetCompressor(compressor);
+  }
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  int testStatus = EXIT_SUCCESS;
+  for (const bool streaming : { false, true })
+  {
+    auto reader = itk::ImageFileReader<TImage>::New();
+    reader->SetFileName(fileName);
+    // Several groups of tiles or strips, whatever the number of processors.
+    auto readerIO = itk::TIFFImageIO::New();
+    readerIO->GetMultiThreader()->SetNumberOfWorkUnits(3);
+    reader->SetImageIO(readerIO);
+    reader->SetUseStreaming(streaming);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->UpdateOutputInformation());
+    const typename TImage::RegionType region =
+      streaming ? requestedRegion : reader->GetOutput()->GetLargestPossibleRegion();
+    reader->GetOutput()->SetRequestedRegion(region);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+    const TImage * output = reader->GetOutput();
+    if (!reader->GetImageIO()->CanStreamRead() || output->GetBufferedRegion() != region)
+    {
+      std::cerr << fileName << ": read the region " << output->GetBufferedRegion() << " instead of " << region
+                << std::endl;
+      testStatus = EXIT_FAILURE;
+      continue;
+    }
+    for (itk::ImageRegionConstIteratorWithIndex<TImage> it(output, region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != image->GetPixel(it.GetIndex()))
+      {
+        std::cerr << fileName << ": wrong pixel at " << it.GetIndex() << std::endl;
+        testStatus = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+  return testStatus;
+}
+
+// Reads a series of tiled slices in parallel, with more slice groups than
+// threads in the pool, while the ImageIO also reads with several work units.
+// The groups run on the workers of the pool, so the ImageIOs must decode
+// their tiles on the calling thread instead of waiting for the pool.
+int
+TestParallelSeriesReading(const std::string & outputDirectory)
+{
+  using SliceType = itk::Image<unsigned char, 2>;
+  using VolumeType = itk::Image<unsigned char, 3>;
+
+  const unsigned int numberOfSlices = std::max(4u, itk::ThreadPool::GetInstance()->GetMaximumNumberOfThreads() + 2);
+
+  std::vector<std::string> fileNames;
+  for (unsigned int k = 0; k < numberOfSlices; ++k)
+  {
+    const auto slice = SliceType::New();
+    slice->SetRegions(SliceType::SizeType{ { 70, 50 } });
+    slice->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<SliceType> it(slice, slice->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(static_cast<unsigned char>((it.GetIndex()[0] + 3 * it.GetIndex()[1] + 5 * k) % 100));
+    }
+    auto tiffIO = itk::TIFFImageIO::New();
+    tiffIO->SetTileSize(16, 16);
+    fileNames.push_back(outputDirectory + "/itkTIFFImageIOSeries" + std::to_string(k) + ".tif");
+    auto writer = itk::ImageFileWriter<SliceType>::New();
+    writer->SetInput(slice);
+    writer->SetFileName(fileNames.back());
+    writer->SetImageIO(tiffIO);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  }
+
+  auto readerIO = itk::TIFFImageIO::New();
+  readerIO->GetMultiThreader()->SetNumberOfWorkUnits(3);
+  auto reader = itk::ImageSeriesReader<VolumeType>::New();
+  reader->SetFileNames(fileNames);
+  reader->SetImageIO(readerIO);
+  reader->ParallelReadingOn();
+  reader->SetNumberOfWorkUnits(numberOfSlices);
+  reader->GetMultiThreader()->SetNumberOfWorkUnits(numberOfSlices);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetMaximumNumberOfWorkUnits(), 0);
+
+  const VolumeType * output = reader->GetOutput();
+  for (itk::ImageRegionConstIteratorWithIndex<VolumeType> it(output, output->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const VolumeType::IndexType index = it.GetIndex();
+    if (it.Get() != (index[0] + 3 * index[1] + 5 * index[2]) % 100)
+    {
+      std::cerr << "Series: wrong pixel at " << index << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkTIFFImageIOTiledStreamingTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  auto tiffIO = itk::TIFFImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(tiffIO, TIFFImageIO, ImageIOBase);
+  ITK_TEST_SET_GET_BOOLEAN(tiffIO, UseBigTIFF, true);
+
+  using Image2DType = itk::Image<unsigned char, 2>;
+  using ShortImage2DType = itk::Image<unsigned short, 2>;
+  using RGBImage2DType = itk::Image<itk::RGBPixel<unsigned char>, 2>;
+  using Image3DType = itk::Image<short, 3>;
+  using FloatImage3DType = itk::Image<float, 3>;
+
+  const Image2DType::RegionType region2D{ { { 45, 70 } }, { { 100, 33 } } };
+  const Image3DType::RegionType region3D{ { { 10, 17, 2 } }, { { 31, 20, 2 } } };
+
+  bool success = true;
+  success &= TestTiledStreaming<Image2DType>(outputDirectory + "/itkTIFFImageIOTiled.tif",
+                                             { { 300, 211 } }, 64, false, "", region2D) == EXIT_SUCCESS;
+  success &= TestTiledStreaming<Image2DType>(outputDirectory + "/itkTIFFImageIOTiledDeflate.tif",
+                                             { { 300, 211 } }, 40, false, "Deflate", region2D) == EXIT_SUCCESS;
+  success &= TestTiledStreaming<ShortImage2DType>(outputDirectory + "/itkTIFFImageIOStrips.tif",
+                                                  { { 300, 211 } }, 0, false, "PackBits", region2D) == EXIT_SUCCESS;
+  success &= TestTiledStreaming<RGBImage2DType>(outputDirectory + "/itkTIFFImageIOTiledRGB.tif",
+                                                { { 150, 100 } },
+                                                16,
+                                                false,
+                                                "LZW",
+                                                { { { 3, 5 } }, { { 50, 90 } } }) == EXIT_SUCCESS;
+  success &= TestTiledStreaming<Image3DType>(outputDirectory + "/itkTIFFImageIOTiledBigTIFF.tif",
+                                             { { 70, 50, 5 } }, 32, true, "", region3D) == EXIT_SUCCESS;
+  success &= TestTiledStreaming<FloatImage3DType>(outputDirectory + "/itkTIFFImageIOStripsBigTIFF.tif",
+                                                  { { 70, 50, 5 } }, 0, true, "", region3D) == EXIT_SUCCESS;
+  success &= TestParallelSeriesReading(outputDirectory) == EXIT_SUCCESS;
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -148,7 +148,11 @@ public:
 protected:
   ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader()
     : m_ANTSAssociate(nullptr)
-  {}
+  {
+    // The sparse threader evaluates the moving image at the neighbors of the
+    // virtual points, instead of at the virtual points themselves.
+    this->m_MapMovingPointsInBatches = false;
+  }
 
   /**
    * Dense threader and sparse threader invoke different in multi-threading. This class uses overloaded
@@ -205,8 +205,8 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   MovingImageGradientType mappedMovingImageGradient;
   try
   {
-    pointIsValid = this->m_CorrelationAssociate->TransformAndEvaluateMovingPoint(
-      virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
+    pointIsValid =
+      this->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, mappedMovingPixelValue, threadId);
     if (pointIsValid && this->m_CorrelationAssociate->GetComputeDerivative() &&
         this->m_CorrelationAssociate->GetGradientSourceIncludesMoving())
     {
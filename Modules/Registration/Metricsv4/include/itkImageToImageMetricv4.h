@@ -32,6 +32,8 @@
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkDefaultImageToImageMetricTraitsv4.h"
 
+#include <vector>
+
 namespace itk
 {
 /** \class ImageToImageMetricv4
@@ -567,6 +569,21 @@ public:
   /** Get Moving Gradient Image. */
   itkGetModifiableObjectMacro(MovingImageGradientImage, MovingImageGradientImageType);
 
+  /** Set the gradient image of \c fixedImage computed beforehand, as the default fixed
+   * image gradient filter does, e.g. by ImageRegistrationPyramidCache. When the metric
+   * uses its default fixed image gradient filter and its fixed image is \c fixedImage,
+   * Initialize() uses this gradient image instead of computing it again. */
+  virtual void
+  SetPrecomputedFixedImageGradientImage(const FixedImageType * fixedImage, FixedImageGradientImageType * gradientImage);
+
+  /** Set the gradient image of \c movingImage computed beforehand, as the default moving
+   * image gradient filter does, e.g. by ImageRegistrationPyramidCache. When the metric
+   * uses its default moving image gradient filter and its moving image is \c movingImage,
+   * Initialize() uses this gradient image instead of computing it again. */
+  virtual void
+  SetPrecomputedMovingImageGradientImage(const MovingImageType *        movingImage,
+                                         MovingImageGradientImageType * gradientImage);
+
   /** Get the number of points in the domain used to evaluate
    * the metric. This will differ depending on whether a sampled
    * point set or dense sampling is used, and will be greater than
@@ -598,6 +615,23 @@ public:
   itkSetMacro(FloatingPointCorrectionResolution, DerivativeValueType);
   itkGetConstMacro(FloatingPointCorrectionResolution, DerivativeValueType);
 
+  /** Set/Get whether the fixed image samples are cached. When on, the
+   * points of the domain mapped into the fixed image space, their fixed
+   * image values and, when the derivative uses them, their fixed image
+   * gradients are stored during the first evaluation of the metric after
+   * Initialize(), and read back by the next evaluations, instead of being
+   * computed again at each iteration of an optimizer. The cache is computed
+   * again when the fixed transform is modified. Off by default.
+   * \note The cache stores a point, a value and a gradient for each point
+   * of the virtual domain, or of the sampled point set.
+   * \note The cache is used by the metrics whose threaders process the
+   * virtual points with ImageToImageMetricv4GetValueAndDerivativeThreaderBase,
+   * e.g. MeanSquaresImageToImageMetricv4 and
+   * MattesMutualInformationImageToImageMetricv4. */
+  itkSetMacro(UseFixedSampleCache, bool);
+  itkGetConstReferenceMacro(UseFixedSampleCache, bool);
+  itkBooleanMacro(UseFixedSampleCache);
+
   /* Initialize the metric before calling GetValue or GetDerivative.
    * Derived classes must call this Superclass version if they override
    * this to perform their own initialization.
@@ -694,6 +728,14 @@ protected:
                                   MovingImagePointType &   mappedMovingPoint,
                                   MovingImagePixelType &   mappedMovingPixelValue) const;
 
+  /** Evaluate the moving image at a point of the moving domain, to which the
+   * moving transform has already mapped a virtual point. The point is
+   * checked against the mask and the moving image buffer as in
+   * TransformAndEvaluateMovingPoint(). */
+  bool
+  EvaluateMovingPoint(const MovingImagePointType & mappedMovingPoint,
+                      MovingImagePixelType &       mappedMovingPixelValue) const;
+
   /** Compute image derivatives for a Fixed point. */
   virtual void
   ComputeFixedImageGradientAtPoint(const FixedImagePointType & mappedPoint, FixedImageGradientType & gradient) const;
@@ -765,6 +807,12 @@ protected:
   mutable FixedImageGradientImagePointer  m_FixedImageGradientImage{};
   mutable MovingImageGradientImagePointer m_MovingImageGradientImage{};
 
+  /** Gradient images computed beforehand, with the images they are the gradients of. */
+  FixedImageConstPointer          m_PrecomputedFixedImageGradientImageSource{};
+  FixedImageGradientImagePointer  m_PrecomputedFixedImageGradientImage{};
+  MovingImageConstPointer         m_PrecomputedMovingImageGradientImageSource{};
+  MovingImageGradientImagePointer m_PrecomputedMovingImageGradientImage{};
+
   /** Image gradient calculators */
   FixedImageGradientCalculatorPointer  m_FixedImageGradientCalculator{};
   MovingImageGradientCalculatorPointer m_MovingImageGradientCalculator{};
@@ -860,6 +908,31 @@ private:
   bool                m_UseFloatingPointCorrection{};
   DerivativeValueType m_FloatingPointCorrectionResolution{};
 
+  /** Prepare the fixed sample cache for an evaluation: keep its entries
+   * when they are still valid, otherwise reset them to be computed again. */
+  void
+  InitializeFixedSampleCacheForIteration() const;
+
+  /** The state of an entry of the fixed sample cache. */
+  enum class FixedSampleCacheEntryEnum : uint8_t
+  {
+    NotComputed,
+    Invalid,
+    Valid
+  };
+
+  bool m_UseFixedSampleCache{ false };
+
+  /** The fixed sample cache, as a structure of arrays indexed by the
+   * position of the points in the domain. The entries are computed by the
+   * first evaluation which processes their point. */
+  mutable std::vector<FixedSampleCacheEntryEnum> m_FixedSampleCacheEntries{};
+  mutable std::vector<FixedImagePointType>       m_FixedSampleCachePoints{};
+  mutable std::vector<FixedImagePixelType>       m_FixedSampleCachePixelValues{};
+  mutable std::vector<FixedImageGradientType>    m_FixedSampleCacheGradients{};
+  mutable bool                                   m_FixedSampleCacheHasGradients{ false };
+  mutable ModifiedTimeType                       m_FixedSampleCacheFixedTransformMTime{};
+
   MetricTraits m_MetricTraits{};
 
   /** Flag to know if derivative should be calculated */
@@ -137,6 +137,13 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
    */
   Superclass::Initialize();
 
+  /* The fixed samples change with the images, masks and domain. */
+  this->m_FixedSampleCacheEntries.clear();
+  this->m_FixedSampleCachePoints.clear();
+  this->m_FixedSampleCachePixelValues.clear();
+  this->m_FixedSampleCacheGradients.clear();
+  this->m_FixedSampleCacheHasGradients = false;
+
   /* Map the fixed samples into the virtual domain and store in
    * a separate point set. */
   if (this->m_UseSampledPointSet && !this->m_UseVirtualSampledPointSet)
@@ -294,6 +301,37 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
     /* Clear derivative final result. */
     this->m_DerivativeResult->Fill(DerivativeValueType{});
   }
+
+  if (this->m_UseFixedSampleCache)
+  {
+    this->InitializeFixedSampleCacheForIteration();
+  }
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  InitializeFixedSampleCacheForIteration() const
+{
+  const SizeValueType numberOfPoints = this->GetNumberOfDomainPoints();
+  const bool          needsGradients = this->m_ComputeDerivative && this->GetGradientSourceIncludesFixed();
+  const auto          fixedTransformMTime = this->m_FixedTransform->GetMTime();
+
+  if (this->m_FixedSampleCacheEntries.size() != numberOfPoints ||
+      this->m_FixedSampleCacheFixedTransformMTime != fixedTransformMTime ||
+      (needsGradients && !this->m_FixedSampleCacheHasGradients))
+  {
+    this->m_FixedSampleCacheHasGradients = this->m_FixedSampleCacheHasGradients || needsGradients;
+    this->m_FixedSampleCacheEntries.assign(numberOfPoints, FixedSampleCacheEntryEnum::NotComputed);
+    this->m_FixedSampleCachePoints.resize(numberOfPoints);
+    this->m_FixedSampleCachePixelValues.resize(numberOfPoints);
+    this->m_FixedSampleCacheGradients.resize(this->m_FixedSampleCacheHasGradients ? numberOfPoints : 0);
+    this->m_FixedSampleCacheFixedTransformMTime = fixedTransformMTime;
+  }
 }
 
 template <typename TFixedImage,
@@ -364,6 +402,22 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   localMappedMovingPoint = this->m_MovingTransform->TransformPoint(localVirtualPoint);
   mappedMovingPoint.CastFrom(localMappedMovingPoint);
 
+  return this->EvaluateMovingPoint(mappedMovingPoint, mappedMovingPixelValue);
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+bool
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  EvaluateMovingPoint(const MovingImagePointType & mappedMovingPoint,
+                      MovingImagePixelType &       mappedMovingPixelValue) const
+{
+  bool pointIsValid = true;
+  mappedMovingPixelValue = MovingImagePixelType{};
+
   // check against the mask if one is assigned
   if (this->m_MovingImageMask)
   {
@@ -440,6 +494,43 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   }
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  SetPrecomputedFixedImageGradientImage(const FixedImageType * fixedImage, FixedImageGradientImageType * gradientImage)
+{
+  if (this->m_PrecomputedFixedImageGradientImageSource.GetPointer() != fixedImage ||
+      this->m_PrecomputedFixedImageGradientImage.GetPointer() != gradientImage)
+  {
+    this->m_PrecomputedFixedImageGradientImageSource = fixedImage;
+    this->m_PrecomputedFixedImageGradientImage = gradientImage;
+    this->Modified();
+  }
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  SetPrecomputedMovingImageGradientImage(const MovingImageType *        movingImage,
+                                         MovingImageGradientImageType * gradientImage)
+{
+  if (this->m_PrecomputedMovingImageGradientImageSource.GetPointer() != movingImage ||
+      this->m_PrecomputedMovingImageGradientImage.GetPointer() != gradientImage)
+  {
+    this->m_PrecomputedMovingImageGradientImageSource = movingImage;
+    this->m_PrecomputedMovingImageGradientImage = gradientImage;
+    this->Modified();
+  }
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -449,9 +540,18 @@ void
 ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
   ComputeFixedImageGradientFilterImage()
 {
-  this->m_FixedImageGradientFilter->SetInput(this->m_FixedImage);
-  this->m_FixedImageGradientFilter->Update();
-  this->m_FixedImageGradientImage = this->m_FixedImageGradientFilter->GetOutput();
+  if (this->m_PrecomputedFixedImageGradientImage.IsNotNull() &&
+      this->m_PrecomputedFixedImageGradientImageSource == this->m_FixedImage &&
+      this->m_FixedImageGradientFilter.GetPointer() == this->m_DefaultFixedImageGradientFilter.GetPointer())
+  {
+    this->m_FixedImageGradientImage = this->m_PrecomputedFixedImageGradientImage;
+  }
+  else
+  {
+    this->m_FixedImageGradientFilter->SetInput(this->m_FixedImage);
+    this->m_FixedImageGradientFilter->Update();
+    this->m_FixedImageGradientImage = this->m_FixedImageGradientFilter->GetOutput();
+  }
   this->m_FixedImageGradientInterpolator->SetInputImage(this->m_FixedImageGradientImage);
 }
 
@@ -464,9 +564,18 @@ void
 ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
   ComputeMovingImageGradientFilterImage() const
 {
-  this->m_MovingImageGradientFilter->SetInput(this->m_MovingImage);
-  this->m_MovingImageGradientFilter->Update();
-  this->m_MovingImageGradientImage = this->m_MovingImageGradientFilter->GetOutput();
+  if (this->m_PrecomputedMovingImageGradientImage.IsNotNull() &&
+      this->m_PrecomputedMovingImageGradientImageSource == this->m_MovingImage &&
+      this->m_MovingImageGradientFilter.GetPointer() == this->m_DefaultMovingImageGradientFilter.GetPointer())
+  {
+    this->m_MovingImageGradientImage = this->m_PrecomputedMovingImageGradientImage;
+  }
+  else
+  {
+    this->m_MovingImageGradientFilter->SetInput(this->m_MovingImage);
+    this->m_MovingImageGradientFilter->Update();
+    this->m_MovingImageGradientImage = this->m_MovingImageGradientFilter->GetOutput();
+  }
   this->m_MovingImageGradientInterpolator->SetInputImage(this->m_MovingImageGradientImage);
 }
 
@@ -527,13 +636,15 @@ void
 ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
   SetMaximumNumberOfWorkUnits(const ThreadIdType number)
 {
-  if (number != this->m_SparseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads())
+  if (number != this->m_SparseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads() ||
+      number != this->m_SparseGetValueAndDerivativeThreader->GetNumberOfWorkUnits())
   {
     this->m_SparseGetValueAndDerivativeThreader->SetMaximumNumberOfThreads(number);
     this->m_SparseGetValueAndDerivativeThreader->SetNumberOfWorkUnits(number);
     this->Modified();
   }
-  if (number != this->m_DenseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads())
+  if (number != this->m_DenseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads() ||
+      number != this->m_DenseGetValueAndDerivativeThreader->GetNumberOfWorkUnits())
   {
     this->m_DenseGetValueAndDerivativeThreader->SetMaximumNumberOfThreads(number);
     this->m_DenseGetValueAndDerivativeThreader->SetNumberOfWorkUnits(number);
@@ -665,7 +776,8 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
      << indent << "GetUseFixedImageGradientFilter: " << this->GetUseFixedImageGradientFilter() << std::endl
      << indent << "GetUseMovingImageGradientFilter: " << this->GetUseMovingImageGradientFilter() << std::endl
      << indent << "UseFloatingPointCorrection: " << this->GetUseFloatingPointCorrection() << std::endl
-     << indent << "FloatingPointCorrectionResolution: " << this->GetFloatingPointCorrectionResolution() << std::endl;
+     << indent << "FloatingPointCorrectionResolution: " << this->GetFloatingPointCorrectionResolution() << std::endl
+     << indent << "UseFixedSampleCache: " << this->GetUseFixedSampleCache() << std::endl;
 
   itkPrintSelfObjectMacro(FixedImage);
   itkPrintSelfObjectMacro(MovingImage);
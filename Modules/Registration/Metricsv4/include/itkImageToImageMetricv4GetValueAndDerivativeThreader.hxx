@@ -19,6 +19,7 @@
 #define itkImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include <array>
 
 namespace itk
 {
@@ -31,12 +32,26 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<
 {
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
   using IteratorType = ImageRegionConstIteratorWithIndex<VirtualImageType>;
-  VirtualPointType virtualPoint;
+  std::array<VirtualIndexType, Superclass::VirtualPointBatchSize> virtualIndices;
+  std::array<VirtualPointType, Superclass::VirtualPointBatchSize> virtualPoints;
+  std::array<SizeValueType, Superclass::VirtualPointBatchSize>    virtualPointPositions;
+  SizeValueType                                                   numberOfPoints = 0;
   for (IteratorType it(virtualImage, imageSubRegion); !it.IsAtEnd(); ++it)
   {
-    const VirtualIndexType & virtualIndex = it.GetIndex();
-    virtualImage->TransformIndexToPhysicalPoint(virtualIndex, virtualPoint);
-    this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    virtualIndices[numberOfPoints] = it.GetIndex();
+    virtualImage->TransformIndexToPhysicalPoint(virtualIndices[numberOfPoints], virtualPoints[numberOfPoints]);
+    virtualPointPositions[numberOfPoints] = virtualImage->ComputeOffset(virtualIndices[numberOfPoints]);
+    if (++numberOfPoints == Superclass::VirtualPointBatchSize)
+    {
+      this->ProcessVirtualPoints(
+        virtualIndices.data(), virtualPoints.data(), virtualPointPositions.data(), numberOfPoints, threadId);
+      numberOfPoints = 0;
+    }
+  }
+  if (numberOfPoints > 0)
+  {
+    this->ProcessVirtualPoints(
+      virtualIndices.data(), virtualPoints.data(), virtualPointPositions.data(), numberOfPoints, threadId);
   }
   // Finalize per thread actions
   this->m_Associate->FinalizeThread(threadId);
@@ -53,11 +68,26 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<ThreadedIndexedContainerPartit
   const ElementIdentifierType                   begin = indexSubRange[0];
   const ElementIdentifierType                   end = indexSubRange[1];
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
+  std::array<VirtualIndexType, Superclass::VirtualPointBatchSize> virtualIndices;
+  std::array<VirtualPointType, Superclass::VirtualPointBatchSize> virtualPoints;
+  std::array<SizeValueType, Superclass::VirtualPointBatchSize>    virtualPointPositions;
+  SizeValueType                                                   numberOfPoints = 0;
   for (ElementIdentifierType i = begin; i <= end; ++i)
   {
-    const VirtualPointType & virtualPoint = virtualSampledPointSet->GetPoint(i);
-    const auto               virtualIndex = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
-    this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    virtualPoints[numberOfPoints] = virtualSampledPointSet->GetPoint(i);
+    virtualIndices[numberOfPoints] = virtualImage->TransformPhysicalPointToIndex(virtualPoints[numberOfPoints]);
+    virtualPointPositions[numberOfPoints] = i;
+    if (++numberOfPoints == Superclass::VirtualPointBatchSize)
+    {
+      this->ProcessVirtualPoints(
+        virtualIndices.data(), virtualPoints.data(), virtualPointPositions.data(), numberOfPoints, threadId);
+      numberOfPoints = 0;
+    }
+  }
+  if (numberOfPoints > 0)
+  {
+    this->ProcessVirtualPoints(
+      virtualIndices.data(), virtualPoints.data(), virtualPointPositions.data(), numberOfPoints, threadId);
   }
   // Finalize per thread actions
   this->m_Associate->FinalizeThread(threadId);
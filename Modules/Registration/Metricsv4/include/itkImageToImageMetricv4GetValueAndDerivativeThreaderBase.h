@@ -77,7 +77,9 @@ public:
   using FixedTransformType = typename ImageToImageMetricv4Type::FixedTransformType;
   using FixedOutputPointType = typename FixedTransformType::OutputPointType;
   using MovingTransformType = typename ImageToImageMetricv4Type::MovingTransformType;
+  using MovingInputPointType = typename MovingTransformType::InputPointType;
   using MovingOutputPointType = typename MovingTransformType::OutputPointType;
+  using NonZeroJacobianIndicesType = typename MovingTransformType::NonZeroJacobianIndicesType;
 
   using MeasureType = typename ImageToImageMetricv4Type::MeasureType;
   using DerivativeType = typename ImageToImageMetricv4Type::DerivativeType;
@@ -122,6 +124,33 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId);
 
+  /** The maximum number of virtual points which \c ProcessVirtualPoints maps
+   * to the moving domain with a single call to TransformPoints() of the moving
+   * transform. */
+  static constexpr SizeValueType VirtualPointBatchSize = 64;
+
+  /** Process a batch of at most VirtualPointBatchSize virtual points, with
+   * their positions in the domain. The virtual points are first mapped
+   * together by the moving transform, then \c ProcessVirtualPoint is called on
+   * each of them, and finds its mapped point with \c
+   * TransformAndEvaluateMovingPoint. */
+  void
+  ProcessVirtualPoints(const VirtualIndexType * virtualIndices,
+                       const VirtualPointType * virtualPoints,
+                       const SizeValueType *    virtualPointPositions,
+                       const SizeValueType      numberOfPoints,
+                       const ThreadIdType       threadId);
+
+  /** Map a virtual point into the moving space and evaluate the moving image
+   * there, like the method of the metric with the same name, but reuse the
+   * point mapped by \c ProcessVirtualPoints when the virtual point is
+   * processed in a batch. */
+  bool
+  TransformAndEvaluateMovingPoint(const VirtualPointType & virtualPoint,
+                                  MovingImagePointType &   mappedMovingPoint,
+                                  MovingImagePixelType &   mappedMovingPixelValue,
+                                  const ThreadIdType       threadId) const;
+
   /** Method to calculate the metric value and derivative
    * given a point, value and image derivative for both fixed and moving
    * spaces. The provided values have been calculated from \c virtualPoint,
@@ -170,6 +199,17 @@ protected:
   virtual void
   StorePointDerivativeResult(const VirtualIndexType & virtualIndex, const ThreadIdType threadId);
 
+  /** Compute the Jacobian of the moving transform with respect to its
+   * parameters at a virtual point, in the MovingTransformJacobian of the
+   * work unit, and return its number of columns. When the moving transform
+   * has a sparse Jacobian, only the columns which may be nonzero are
+   * computed, the indices of their parameters are stored in
+   * MovingTransformNonZeroJacobianIndices, and StorePointDerivativeResult
+   * accumulates the entries of the local derivatives at these indices.
+   * Otherwise, there is a column for each local parameter. */
+  NumberOfParametersType
+  ComputeMovingTransformJacobian(const VirtualPointType & virtualPoint, const ThreadIdType threadId) const;
+
   struct GetValueAndDerivativePerThreadStruct
   {
     /** Intermediary threaded metric value storage. */
@@ -186,6 +226,16 @@ protected:
      * classes for efficiency. */
     JacobianType MovingTransformJacobian;
     JacobianType MovingTransformJacobianPositional;
+    /** The parameters of the columns of MovingTransformJacobian, when it
+     * holds the columns of a sparse Jacobian. */
+    NonZeroJacobianIndicesType MovingTransformNonZeroJacobianIndices;
+    bool                       MovingTransformJacobianIsSparse;
+    /** The position in the domain of the virtual point being processed, used
+     * to index the fixed sample cache of the metric. */
+    SizeValueType VirtualPointPosition;
+    /** The virtual point being processed, mapped by the moving transform in
+     * \c ProcessVirtualPoints, or nullptr when it is not processed in a batch. */
+    const MovingOutputPointType * MappedMovingPoint;
   };
   itkPadStruct(ITK_CACHE_LINE_ALIGNMENT,
                GetValueAndDerivativePerThreadStruct,
@@ -199,6 +249,12 @@ protected:
    *  These will only be set once threading has been started. */
   mutable NumberOfParametersType m_CachedNumberOfParameters{};
   mutable NumberOfParametersType m_CachedNumberOfLocalParameters{};
+  mutable bool                   m_CachedMovingTransformHasSparseJacobian{};
+
+  /** Whether \c ProcessVirtualPoints maps the virtual points in batches.
+   * Threaders which do not evaluate the moving image at the virtual points
+   * they are given turn it off. */
+  bool m_MapMovingPointsInBatches{ true };
 };
 
 } // end namespace itk
@@ -20,6 +20,7 @@
 
 #include "itkNumericTraits.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include <array>
 
 namespace itk
 {
@@ -43,6 +44,10 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   // Cache some values
   this->m_CachedNumberOfParameters = this->m_Associate->GetNumberOfParameters();
   this->m_CachedNumberOfLocalParameters = this->m_Associate->GetNumberOfLocalParameters();
+  this->m_CachedMovingTransformHasSparseJacobian =
+    this->m_Associate->m_MovingTransform->GetTransformCategory() !=
+      MovingTransformType::TransformCategoryEnum::DisplacementField &&
+    this->m_Associate->m_MovingTransform->HasSparseJacobianWithRespectToParameters();
 
   /* Per-thread results */
   const ThreadIdType numWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
@@ -93,6 +98,8 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   {
     this->m_GetValueAndDerivativePerThreadVariables[workUnit].NumberOfValidPoints = SizeValueType{};
     this->m_GetValueAndDerivativePerThreadVariables[workUnit].Measure = InternalComputationValueType{};
+    this->m_GetValueAndDerivativePerThreadVariables[workUnit].MovingTransformJacobianIsSparse = false;
+    this->m_GetValueAndDerivativePerThreadVariables[workUnit].MappedMovingPoint = nullptr;
     if (this->m_Associate->GetComputeDerivative())
     {
       if (this->m_Associate->m_MovingTransform->GetTransformCategory() !=
@@ -187,36 +194,78 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   bool                    pointIsValid = false;
   MeasureType             metricValueResult;
 
-  /* Transform the point into fixed and moving spaces, and evaluate.
-   * Do this in a try block to catch exceptions and print more useful info
-   * then we otherwise get when exceptions are caught in MultiThreaderBase. */
-  try
+  /* Read the fixed sample from the cache of the metric when it was computed
+   * by a previous evaluation. */
+  using FixedSampleCacheEntryEnum = typename TImageToImageMetricv4::FixedSampleCacheEntryEnum;
+  const bool          useFixedSampleCache = this->m_Associate->m_UseFixedSampleCache;
+  const SizeValueType position =
+    useFixedSampleCache ? this->m_GetValueAndDerivativePerThreadVariables[threadId].VirtualPointPosition : 0;
+  const bool computeFixedImageGradient =
+    this->m_Associate->GetComputeDerivative() && this->m_Associate->GetGradientSourceIncludesFixed();
+  if (useFixedSampleCache &&
+      this->m_Associate->m_FixedSampleCacheEntries[position] != FixedSampleCacheEntryEnum::NotComputed)
   {
-    pointIsValid =
-      this->m_Associate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, mappedFixedPixelValue);
-    if (pointIsValid && this->m_Associate->GetComputeDerivative() &&
-        this->m_Associate->GetGradientSourceIncludesFixed())
+    if (this->m_Associate->m_FixedSampleCacheEntries[position] == FixedSampleCacheEntryEnum::Invalid)
     {
-      this->m_Associate->ComputeFixedImageGradientAtPoint(mappedFixedPoint, mappedFixedImageGradient);
+      return false;
+    }
+    mappedFixedPoint = this->m_Associate->m_FixedSampleCachePoints[position];
+    mappedFixedPixelValue = this->m_Associate->m_FixedSampleCachePixelValues[position];
+    if (computeFixedImageGradient)
+    {
+      mappedFixedImageGradient = this->m_Associate->m_FixedSampleCacheGradients[position];
     }
   }
-  catch (const ExceptionObject & exc)
-  {
-    // NOTE: there must be a cleaner way to do this:
-    std::string msg("Caught exception: \n");
-    msg += exc.what();
-    ExceptionObject err(__FILE__, __LINE__, msg);
-    throw err;
-  }
-  if (!pointIsValid)
+  else
   {
-    return pointIsValid;
+    /* When the sample is cached with its gradient, the gradient is computed
+     * even if this evaluation does not use it. */
+    const bool cacheFixedImageGradient = useFixedSampleCache && this->m_Associate->m_FixedSampleCacheHasGradients;
+
+    /* Transform the point into fixed and moving spaces, and evaluate.
+     * Do this in a try block to catch exceptions and print more useful info
+     * then we otherwise get when exceptions are caught in MultiThreaderBase. */
+    try
+    {
+      pointIsValid =
+        this->m_Associate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, mappedFixedPixelValue);
+      if (pointIsValid && (computeFixedImageGradient || cacheFixedImageGradient))
+      {
+        this->m_Associate->ComputeFixedImageGradientAtPoint(mappedFixedPoint, mappedFixedImageGradient);
+      }
+    }
+    catch (const ExceptionObject & exc)
+    {
+      // NOTE: there must be a cleaner way to do this:
+      std::string msg("Caught exception: \n");
+      msg += exc.what();
+      ExceptionObject err(__FILE__, __LINE__, msg);
+      throw err;
+    }
+    if (useFixedSampleCache)
+    {
+      if (pointIsValid)
+      {
+        this->m_Associate->m_FixedSampleCachePoints[position] = mappedFixedPoint;
+        this->m_Associate->m_FixedSampleCachePixelValues[position] = mappedFixedPixelValue;
+        if (cacheFixedImageGradient)
+        {
+          this->m_Associate->m_FixedSampleCacheGradients[position] = mappedFixedImageGradient;
+        }
+      }
+      this->m_Associate->m_FixedSampleCacheEntries[position] =
+        pointIsValid ? FixedSampleCacheEntryEnum::Valid : FixedSampleCacheEntryEnum::Invalid;
+    }
+    if (!pointIsValid)
+    {
+      return pointIsValid;
+    }
   }
 
   try
   {
     pointIsValid =
-      this->m_Associate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
+      this->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, mappedMovingPixelValue, threadId);
     if (pointIsValid && this->m_Associate->GetComputeDerivative() &&
         this->m_Associate->GetGradientSourceIncludesMoving())
     {
@@ -272,6 +321,67 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   return pointIsValid;
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+void
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::ProcessVirtualPoints(
+  const VirtualIndexType * virtualIndices,
+  const VirtualPointType * virtualPoints,
+  const SizeValueType *    virtualPointPositions,
+  const SizeValueType      numberOfPoints,
+  const ThreadIdType       threadId)
+{
+  itkAssertInDebugAndIgnoreInReleaseMacro(numberOfPoints <= VirtualPointBatchSize);
+  auto & threadVariables = this->m_GetValueAndDerivativePerThreadVariables[threadId];
+
+  std::array<MovingOutputPointType, VirtualPointBatchSize> mappedMovingPoints;
+  if (m_MapMovingPointsInBatches)
+  {
+    std::array<MovingInputPointType, VirtualPointBatchSize> localVirtualPoints;
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      localVirtualPoints[i].CastFrom(virtualPoints[i]);
+    }
+    try
+    {
+      this->m_Associate->m_MovingTransform->TransformPoints(
+        localVirtualPoints.data(), mappedMovingPoints.data(), numberOfPoints);
+    }
+    catch (const ExceptionObject & exc)
+    {
+      std::string msg("Caught exception: \n");
+      msg += exc.what();
+      ExceptionObject err(__FILE__, __LINE__, msg);
+      throw err;
+    }
+  }
+
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    threadVariables.VirtualPointPosition = virtualPointPositions[i];
+    threadVariables.MappedMovingPoint = m_MapMovingPointsInBatches ? &mappedMovingPoints[i] : nullptr;
+    this->ProcessVirtualPoint(virtualIndices[i], virtualPoints[i], threadId);
+  }
+  threadVariables.MappedMovingPoint = nullptr;
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+bool
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  TransformAndEvaluateMovingPoint(const VirtualPointType & virtualPoint,
+                                  MovingImagePointType &   mappedMovingPoint,
+                                  MovingImagePixelType &   mappedMovingPixelValue,
+                                  const ThreadIdType       threadId) const
+{
+  const MovingOutputPointType * batchMappedMovingPoint =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].MappedMovingPoint;
+  if (batchMappedMovingPoint == nullptr)
+  {
+    return this->m_Associate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
+  }
+  mappedMovingPoint.CastFrom(*batchMappedMovingPoint);
+  return this->m_Associate->EvaluateMovingPoint(mappedMovingPoint, mappedMovingPixelValue);
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetricv4>
 void
 ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
@@ -281,21 +391,35 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
       MovingTransformType::TransformCategoryEnum::DisplacementField)
   {
     /* Global support */
+    auto &                       threadVariables = this->m_GetValueAndDerivativePerThreadVariables[threadId];
+    const bool                   isSparse = threadVariables.MovingTransformJacobianIsSparse;
+    const NumberOfParametersType numberOfLocalDerivatives =
+      isSparse ? static_cast<NumberOfParametersType>(threadVariables.MovingTransformNonZeroJacobianIndices.size())
+               : this->m_CachedNumberOfParameters;
     if (this->m_Associate->GetUseFloatingPointCorrection())
     {
       const DerivativeValueType correctionResolution = this->m_Associate->GetFloatingPointCorrectionResolution();
-      for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; ++p)
+      for (NumberOfParametersType p = 0; p < numberOfLocalDerivatives; ++p)
+      {
+        auto test = static_cast<intmax_t>(threadVariables.LocalDerivatives[p] * correctionResolution);
+        threadVariables.LocalDerivatives[p] = static_cast<DerivativeValueType>(test / correctionResolution);
+      }
+    }
+    if (isSparse)
+    {
+      /* Only the parameters of the nonzero columns of the Jacobian */
+      for (NumberOfParametersType p = 0; p < numberOfLocalDerivatives; ++p)
       {
-        auto test = static_cast<intmax_t>(
-          this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p] * correctionResolution);
-        this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p] =
-          static_cast<DerivativeValueType>(test / correctionResolution);
+        threadVariables.CompensatedDerivatives[threadVariables.MovingTransformNonZeroJacobianIndices[p]] +=
+          threadVariables.LocalDerivatives[p];
       }
     }
-    for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; ++p)
+    else
     {
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives[p] +=
-        this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p];
+      for (NumberOfParametersType p = 0; p < numberOfLocalDerivatives; ++p)
+      {
+        threadVariables.CompensatedDerivatives[p] += threadVariables.LocalDerivatives[p];
+      }
     }
   }
   else
@@ -326,6 +450,27 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+auto
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ComputeMovingTransformJacobian(const VirtualPointType & virtualPoint, const ThreadIdType threadId) const
+  -> NumberOfParametersType
+{
+  auto & threadVariables = this->m_GetValueAndDerivativePerThreadVariables[threadId];
+  threadVariables.MovingTransformJacobianIsSparse = this->m_CachedMovingTransformHasSparseJacobian;
+  if (this->m_CachedMovingTransformHasSparseJacobian)
+  {
+    this->m_Associate->GetMovingTransform()->ComputeSparseJacobianWithRespectToParameters(
+      virtualPoint, threadVariables.MovingTransformJacobian, threadVariables.MovingTransformNonZeroJacobianIndices);
+    return static_cast<NumberOfParametersType>(threadVariables.MovingTransformNonZeroJacobianIndices.size());
+  }
+
+  /** For dense transforms, this returns identity */
+  this->m_Associate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
+    virtualPoint, threadVariables.MovingTransformJacobian, threadVariables.MovingTransformJacobianPositional);
+  return this->m_CachedNumberOfLocalParameters;
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetricv4>
 bool
 ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::GetComputeDerivative()
@@ -157,6 +157,16 @@ public:
   itkSetClampMacro(NumberOfHistogramBins, SizeValueType, 5, NumericTraits<SizeValueType>::max());
   itkGetConstReferenceMacro(NumberOfHistogramBins, SizeValueType);
 
+  /** Maximum amount of memory, in bytes, of the copies of the joint PDF
+   * derivatives private to the work units. With a transform which does not
+   * have local support, each work unit accumulates the joint PDF derivatives
+   * in its own copy when the copies of all the work units fit in this amount
+   * of memory, and the copies are summed after the threaded execution.
+   * Otherwise, the work units share the joint PDF derivatives, and update it
+   * under a lock. The default is 1 GiB. */
+  itkSetMacro(MaximumPrivateJointPDFDerivativesMemory, SizeValueType);
+  itkGetConstMacro(MaximumPrivateJointPDFDerivativesMemory, SizeValueType);
+
   void
   Initialize() override;
 
@@ -246,6 +256,7 @@ protected:
 
   /** Variables to define the marginal and joint histograms. */
   SizeValueType m_NumberOfHistogramBins{ 50 };
+  SizeValueType m_MaximumPrivateJointPDFDerivativesMemory{ 1024 * 1024 * 1024 };
   PDFValueType  m_MovingImageNormalizedMin{};
   PDFValueType  m_FixedImageNormalizedMin{};
   PDFValueType  m_FixedImageTrueMin{};
@@ -363,6 +374,12 @@ protected:
   std::mutex                                m_JointPDFDerivativesLock{};
   typename JointPDFDerivativesType::Pointer m_JointPDFDerivatives{};
 
+  /** The copies of the joint PDF derivatives private to the work units, but
+   * the first one, which accumulates directly in m_JointPDFDerivatives. Only
+   * used when m_JointPDFDerivativesArePrivate is true. */
+  std::vector<std::vector<JointPDFDerivativesValueType>> m_ThreaderJointPDFDerivatives{};
+  bool                                                   m_JointPDFDerivativesArePrivate{ false };
+
   PDFValueType m_JointPDFSum{};
 
   /** Store the per-point local derivative result by parzen window bin.
@@ -283,7 +283,7 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TInternalComputationValueType,
                                             TMetricTraits>::FinalizeThread(const ThreadIdType threadId)
 {
-  if (this->GetComputeDerivative() && (!this->HasLocalSupport()))
+  if (this->GetComputeDerivative() && (!this->HasLocalSupport()) && !this->m_JointPDFDerivativesArePrivate)
   {
     this->m_ThreaderDerivativeManager[threadId].BlockAndReduce();
   }
@@ -501,6 +501,10 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TMetricTraits>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfHistogramBins: " << this->m_NumberOfHistogramBins << std::endl;
+  os << indent << "MaximumPrivateJointPDFDerivativesMemory: " << this->m_MaximumPrivateJointPDFDerivativesMemory
+     << std::endl;
 }
 
 template <typename TFixedImage,
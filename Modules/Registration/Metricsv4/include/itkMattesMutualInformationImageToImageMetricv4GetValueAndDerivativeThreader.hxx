@@ -18,6 +18,7 @@
 #ifndef itkMattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 #define itkMattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 
+#include <algorithm>
 
 namespace itk
 {
@@ -189,25 +190,47 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
       // Initialize to zero for accumulation
       this->m_MattesAssociate->m_JointPDFDerivatives->FillBuffer(0.0F);
     }
-    if ((this->m_MattesAssociate->m_ThreaderDerivativeManager.size() != localNumberOfWorkUnitsUsed))
+
+    // Each work unit accumulates in its own copy of the joint PDF derivatives
+    // when the copies fit in the allowed memory, so that the work units do not
+    // wait for each other.
+    const SizeValueType numberOfJointPDFDerivatives = jointPDFDerivativesRegion.GetNumberOfPixels();
+    this->m_MattesAssociate->m_JointPDFDerivativesArePrivate =
+      numberOfJointPDFDerivatives * sizeof(JointPDFDerivativesValueType) * (localNumberOfWorkUnitsUsed - 1) <=
+      this->m_MattesAssociate->m_MaximumPrivateJointPDFDerivativesMemory;
+    if (this->m_MattesAssociate->m_JointPDFDerivativesArePrivate)
     {
-      this->m_MattesAssociate->m_ThreaderDerivativeManager.resize(localNumberOfWorkUnitsUsed);
+      // The first work unit accumulates directly in m_JointPDFDerivatives
+      this->m_MattesAssociate->m_ThreaderJointPDFDerivatives.resize(localNumberOfWorkUnitsUsed - 1);
+      for (auto & threaderJointPDFDerivatives : this->m_MattesAssociate->m_ThreaderJointPDFDerivatives)
+      {
+        threaderJointPDFDerivatives.assign(numberOfJointPDFDerivatives, JointPDFDerivativesValueType{});
+      }
+      this->m_MattesAssociate->m_ThreaderDerivativeManager.clear();
     }
-    for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+    else
     {
-      this->m_MattesAssociate->m_ThreaderDerivativeManager[workUnitID].Initialize(
-        // A heuristic that assumes memory for 2x size of
-        // m_JointPDFDerivative efficient and easy to make, so
-        // split it across all the threads.  A work unit of at least 400 is needed
-        // when the thread size approaches the number of histograms so that the
-        // there is enough work to be done between thread lockings.
-        std::max<size_t>(500,
-                         this->m_MattesAssociate->m_NumberOfHistogramBins *
-                           this->m_MattesAssociate->m_NumberOfHistogramBins / localNumberOfWorkUnitsUsed),
-        this->GetCachedNumberOfLocalParameters(),
-        // Need address of the lock
-        &this->m_MattesAssociate->m_JointPDFDerivativesLock,
-        this->m_MattesAssociate->m_JointPDFDerivatives);
+      this->m_MattesAssociate->m_ThreaderJointPDFDerivatives.clear();
+      if ((this->m_MattesAssociate->m_ThreaderDerivativeManager.size() != localNumberOfWorkUnitsUsed))
+      {
+        this->m_MattesAssociate->m_ThreaderDerivativeManager.resize(localNumberOfWorkUnitsUsed);
+      }
+      for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+      {
+        this->m_MattesAssociate->m_ThreaderDerivativeManager[workUnitID].Initialize(
+          // A heuristic that assumes memory for 2x size of
+          // m_JointPDFDerivative efficient and easy to make, so
+          // split it across all the threads.  A work unit of at least 400 is needed
+          // when the thread size approaches the number of histograms so that the
+          // there is enough work to be done between thread lockings.
+          std::max<size_t>(500,
+                           this->m_MattesAssociate->m_NumberOfHistogramBins *
+                             this->m_MattesAssociate->m_NumberOfHistogramBins / localNumberOfWorkUnitsUsed),
+          this->GetCachedNumberOfLocalParameters(),
+          // Need address of the lock
+          &this->m_MattesAssociate->m_JointPDFDerivativesLock,
+          this->m_MattesAssociate->m_JointPDFDerivatives);
+      }
     }
   }
 }
@@ -313,14 +336,28 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
 
   // Compute the transform Jacobian.
   using JacobianReferenceType = JacobianType &;
-  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+  JacobianReferenceType  jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+  NumberOfParametersType numberOfJacobianColumns = this->GetCachedNumberOfLocalParameters();
   if (doComputeDerivative)
   {
-    JacobianReferenceType jacobianPositional =
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
-    this->m_MattesAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-      virtualPoint, jacobian, jacobianPositional);
+    if (this->m_MattesAssociate->m_JointPDFDerivativesArePrivate)
+    {
+      // Only the nonzero columns of a sparse Jacobian, whose contributions
+      // are added at the indices of their parameters.
+      numberOfJacobianColumns = this->ComputeMovingTransformJacobian(virtualPoint, threadId);
+    }
+    else
+    {
+      JacobianReferenceType jacobianPositional =
+        this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+      this->m_MattesAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
+        virtualPoint, jacobian, jacobianPositional);
+    }
   }
+  const bool jacobianIsSparse =
+    doComputeDerivative && this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianIsSparse;
+  const auto * const nonZeroJacobianIndices =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformNonZeroJacobianIndices.data();
 
   SizeValueType movingParzenBin = 0;
 
@@ -356,21 +393,43 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
           (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[2]) +
           (pdfMovingIndex * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[1]);
 
-        PDFValueType * derivativeContributionPtr =
-          this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(ThisIndexOffset);
-        for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement;
-             ++mu)
+        if (this->m_MattesAssociate->m_JointPDFDerivativesArePrivate)
         {
-          PDFValueType innerProduct = 0.0;
-          for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+          // Accumulate directly in the copy of this work unit
+          JointPDFDerivativesValueType * derivativeContributionPtr =
+            (threadId == 0 ? this->m_MattesAssociate->m_JointPDFDerivatives->GetBufferPointer()
+                           : this->m_MattesAssociate->m_ThreaderJointPDFDerivatives[threadId - 1].data()) +
+            ThisIndexOffset;
+          for (NumberOfParametersType mu = 0; mu < numberOfJacobianColumns; ++mu)
           {
-            innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+            PDFValueType innerProduct = 0.0;
+            for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+            {
+              innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+            }
+
+            derivativeContributionPtr[jacobianIsSparse ? nonZeroJacobianIndices[mu] : mu] +=
+              innerProduct * cubicBSplineDerivativeValue;
           }
-
-          *(derivativeContributionPtr) = innerProduct * cubicBSplineDerivativeValue;
-          ++derivativeContributionPtr;
         }
-        this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].CheckAndReduceIfNecessary();
+        else
+        {
+          PDFValueType * derivativeContributionPtr =
+            this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(ThisIndexOffset);
+          for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement;
+               ++mu)
+          {
+            PDFValueType innerProduct = 0.0;
+            for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+            {
+              innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+            }
+
+            *(derivativeContributionPtr) = innerProduct * cubicBSplineDerivativeValue;
+            ++derivativeContributionPtr;
+          }
+          this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].CheckAndReduceIfNecessary();
+        }
       }
     }
 
@@ -446,15 +505,34 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     const PDFValueType nFactor =
       -1.0 / (this->m_MattesAssociate->m_MovingImageBinSize * this->m_MattesAssociate->GetNumberOfValidPoints());
 
+    // Sum the copies private to the work units, if any, and scale, in
+    // parallel over blocks of elements.
     JointPDFDerivativesValueType * const accumulatorPdfDPtrStart =
       this->m_MattesAssociate->m_JointPDFDerivatives->GetBufferPointer();
-    JointPDFDerivativesValueType *             accumulatorPdfDPtr = accumulatorPdfDPtrStart;
-    const JointPDFDerivativesValueType * const tempThreadPdfDPtrEnd =
-      accumulatorPdfDPtrStart + histogramTotalElementsSize;
-    while (accumulatorPdfDPtr < tempThreadPdfDPtrEnd)
-    {
-      *(accumulatorPdfDPtr++) *= nFactor;
-    }
+    const auto &            threaderJointPDFDerivatives = this->m_MattesAssociate->m_ThreaderJointPDFDerivatives;
+    constexpr SizeValueType blockSize = 4096;
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      (histogramTotalElementsSize + blockSize - 1) / blockSize,
+      [accumulatorPdfDPtrStart, &threaderJointPDFDerivatives, histogramTotalElementsSize, nFactor](
+        SizeValueType block) {
+        const SizeValueType                  first = block * blockSize;
+        const SizeValueType                  last = std::min(first + blockSize, histogramTotalElementsSize);
+        JointPDFDerivativesValueType * const accumulatorPdfDPtr = accumulatorPdfDPtrStart + first;
+        for (const auto & threadJointPDFDerivatives : threaderJointPDFDerivatives)
+        {
+          const JointPDFDerivativesValueType * const tempThreadPdfDPtr = threadJointPDFDerivatives.data() + first;
+          for (SizeValueType i = 0; i < last - first; ++i)
+          {
+            accumulatorPdfDPtr[i] += tempThreadPdfDPtr[i];
+          }
+        }
+        for (SizeValueType i = 0; i < last - first; ++i)
+        {
+          accumulatorPdfDPtr[i] *= nFactor;
+        }
+      },
+      nullptr);
   }
 
   // Collect and compute results.
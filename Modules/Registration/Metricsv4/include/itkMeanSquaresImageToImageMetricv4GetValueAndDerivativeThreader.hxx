@@ -56,17 +56,13 @@ MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader<
     return true;
   }
 
-  /* Use a pre-allocated jacobian object for efficiency */
-  using JacobianReferenceType = typename TImageToImageMetric::JacobianType &;
-  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-  JacobianReferenceType jacobianPositional =
-    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+  /* Use a pre-allocated jacobian object for efficiency. Only its nonzero
+   * columns are computed when the Jacobian of the transform is sparse. */
+  const NumberOfParametersType numberOfColumns = this->ComputeMovingTransformJacobian(virtualPoint, threadId);
+  const typename TImageToImageMetric::JacobianType & jacobian =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-  /** For dense transforms, this returns identity */
-  this->m_Associate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-    virtualPoint, jacobian, jacobianPositional);
-
-  for (unsigned int par = 0; par < this->GetCachedNumberOfLocalParameters(); ++par)
+  for (NumberOfParametersType par = 0; par < numberOfColumns; ++par)
   {
     localDerivativeReturn[par] = DerivativeValueType{};
     for (unsigned int nc = 0; nc < nComponents; ++nc)
@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkTranslationTransform.h"
+#include "itkImageToImageMetricv4TestImage.h"
+
+#include <cmath>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+using TransformType = itk::TranslationTransform<double, Dimension>;
+
+// Points of the virtual domain, some of them outside of the images.
+template <typename TPointSet>
+typename TPointSet::Pointer
+CreatePointSet()
+{
+  auto pointSet = TPointSet::New();
+  for (unsigned int i = 0; i < 300; ++i)
+  {
+    typename TPointSet::PointType point;
+    point[0] = -2.0 + 44.0 * std::abs(std::sin(1.3 * i));
+    point[1] = -2.0 + 36.0 * std::abs(std::cos(0.7 * i));
+    pointSet->SetPoint(i, point);
+  }
+  return pointSet;
+}
+
+template <typename TMetric>
+bool
+Compare(const char * name, const TMetric * metric, const TMetric * cachedMetric, bool withDerivative)
+{
+  typename TMetric::MeasureType    values[2];
+  typename TMetric::DerivativeType derivatives[2];
+  if (withDerivative)
+  {
+    metric->GetValueAndDerivative(values[0], derivatives[0]);
+    cachedMetric->GetValueAndDerivative(values[1], derivatives[1]);
+  }
+  else
+  {
+    values[0] = metric->GetValue();
+    values[1] = cachedMetric->GetValue();
+  }
+
+  if (std::abs(values[1] - values[0]) > 1e-12 * (1.0 + std::abs(values[0])) ||
+      metric->GetNumberOfValidPoints() != cachedMetric->GetNumberOfValidPoints())
+  {
+    std::cerr << name << ": different values " << values[1] << " != " << values[0] << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < derivatives[0].size(); ++i)
+  {
+    if (std::abs(derivatives[1][i] - derivatives[0][i]) > 1e-12 * (1.0 + std::abs(derivatives[0][i])))
+    {
+      std::cerr << name << ": different derivatives at " << i << ": " << derivatives[1][i]
+                << " != " << derivatives[0][i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The metric gives the same values and derivatives with the fixed sample
+// cache as without it, along the evaluations of a registration, and when the
+// fixed transform is modified between them.
+template <typename TMetric>
+bool
+TestMetric(const char *                         name,
+           const ImageType *                    fixedImage,
+           const ImageType *                    movingImage,
+           typename TMetric::GradientSourceEnum gradientSource,
+           bool                                 useSampledPointSet)
+{
+  std::cout << name << (useSampledPointSet ? ", sampled point set" : ", dense sampling") << std::endl;
+
+  typename TMetric::Pointer metrics[2];
+  TransformType::Pointer    fixedTransforms[2];
+  TransformType::Pointer    movingTransforms[2];
+  for (unsigned int m = 0; m < 2; ++m)
+  {
+    metrics[m] = TMetric::New();
+    fixedTransforms[m] = TransformType::New();
+    movingTransforms[m] = TransformType::New();
+    metrics[m]->SetFixedImage(fixedImage);
+    metrics[m]->SetMovingImage(movingImage);
+    metrics[m]->SetFixedTransform(fixedTransforms[m]);
+    metrics[m]->SetMovingTransform(movingTransforms[m]);
+    metrics[m]->SetGradientSource(gradientSource);
+    // several work units, whatever the number of processors
+    metrics[m]->SetMaximumNumberOfWorkUnits(4);
+    if (useSampledPointSet)
+    {
+      metrics[m]->SetFixedSampledPointSet(CreatePointSet<typename TMetric::FixedSampledPointSetType>());
+      metrics[m]->SetUseSampledPointSet(true);
+    }
+    metrics[m]->SetUseFixedSampleCache(m == 1);
+    metrics[m]->Initialize();
+  }
+
+  bool success = Compare(name, metrics[0].GetPointer(), metrics[1].GetPointer(), false);
+  success = Compare(name, metrics[0].GetPointer(), metrics[1].GetPointer(), true) && success;
+  success = Compare(name, metrics[0].GetPointer(), metrics[1].GetPointer(), true) && success;
+
+  TransformType::ParametersType parameters(Dimension);
+  parameters[0] = 1.5;
+  parameters[1] = -0.75;
+  for (auto & movingTransform : movingTransforms)
+  {
+    movingTransform->SetParameters(parameters);
+  }
+  success = Compare(name, metrics[0].GetPointer(), metrics[1].GetPointer(), true) && success;
+  success = Compare(name, metrics[0].GetPointer(), metrics[1].GetPointer(), false) && success;
+
+  parameters[0] = -0.5;
+  parameters[1] = 1.25;
+  for (auto & fixedTransform : fixedTransforms)
+  {
+    fixedTransform->SetParameters(parameters);
+  }
+  success = Compare(name, metrics[0].GetPointer(), metrics[1].GetPointer(), true) && success;
+  success = Compare(name, metrics[0].GetPointer(), metrics[1].GetPointer(), true) && success;
+
+  metrics[1]->SetUseFixedSampleCache(false);
+  success = Compare(name, metrics[0].GetPointer(), metrics[1].GetPointer(), true) && success;
+  return success;
+}
+} // namespace
+
+int
+itkImageToImageMetricv4FixedSampleCacheTest(int, char *[])
+{
+  const ImageType::SizeType size{ { 40, 32 } };
+  const auto                fixedImage = CreateImageToImageMetricv4TestImage<ImageType>(size, 0.0);
+  const auto                movingImage = CreateImageToImageMetricv4TestImage<ImageType>(size, 2.5);
+
+  using MeanSquaresMetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+  using MattesMetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+
+  bool success = true;
+  for (const bool useSampledPointSet : { false, true })
+  {
+    // the fixed image gradients are cached when the derivative uses them
+    success = TestMetric<MeanSquaresMetricType>("MeanSquares",
+                                                fixedImage,
+                                                movingImage,
+                                                MeanSquaresMetricType::GradientSourceEnum::GRADIENT_SOURCE_BOTH,
+                                                useSampledPointSet) &&
+              success;
+    success = TestMetric<MattesMetricType>("MattesMutualInformation",
+                                           fixedImage,
+                                           movingImage,
+                                           MattesMetricType::GradientSourceEnum::GRADIENT_SOURCE_MOVING,
+                                           useSampledPointSet) &&
+              success;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
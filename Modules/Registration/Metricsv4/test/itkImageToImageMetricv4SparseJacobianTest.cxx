@@ -0,0 +1,145 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkBSplineTransform.h"
+#include "itkImageToImageMetricv4TestImage.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+using SparseTransformType = itk::BSplineTransform<double, Dimension, 3>;
+
+// A B-spline transform which does not tell that its Jacobian is sparse, so
+// that the metrics compute the whole Jacobian.
+class DenseJacobianBSplineTransform : public SparseTransformType
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DenseJacobianBSplineTransform);
+
+  using Self = DenseJacobianBSplineTransform;
+  using Superclass = SparseTransformType;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(DenseJacobianBSplineTransform);
+
+  bool
+  HasSparseJacobianWithRespectToParameters() const override
+  {
+    return false;
+  }
+
+protected:
+  DenseJacobianBSplineTransform() = default;
+  ~DenseJacobianBSplineTransform() override = default;
+};
+
+template <typename TTransform>
+typename TTransform::Pointer
+CreateTransform(const ImageType * image)
+{
+  auto transform = TTransform::New();
+  transform->SetTransformDomainOrigin(image->GetOrigin());
+  transform->SetTransformDomainDirection(image->GetDirection());
+  typename TTransform::PhysicalDimensionsType physicalDimensions;
+  physicalDimensions[0] = 63.0;
+  physicalDimensions[1] = 47.0;
+  transform->SetTransformDomainPhysicalDimensions(physicalDimensions);
+  transform->SetTransformDomainMeshSize(itk::MakeFilled<typename TTransform::MeshSizeType>(8));
+  typename TTransform::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.5 * std::sin(0.3 * i);
+  }
+  transform->SetParameters(parameters);
+  return transform;
+}
+
+// The metric gives the same value and derivative with the sparse Jacobian of
+// the B-spline transform as with its whole Jacobian.
+template <typename TMetric>
+bool
+TestMetric(const char * name, const ImageType * fixedImage, const ImageType * movingImage, itk::ThreadIdType workUnits)
+{
+  std::cout << name << ", work units: " << workUnits << std::endl;
+
+  typename TMetric::MeasureType    values[2];
+  typename TMetric::DerivativeType derivatives[2];
+  for (const bool sparse : { false, true })
+  {
+    auto metric = TMetric::New();
+    metric->SetFixedImage(fixedImage);
+    metric->SetMovingImage(movingImage);
+    if (sparse)
+    {
+      metric->SetMovingTransform(CreateTransform<SparseTransformType>(fixedImage));
+    }
+    else
+    {
+      metric->SetMovingTransform(CreateTransform<DenseJacobianBSplineTransform>(fixedImage));
+    }
+    metric->SetMaximumNumberOfWorkUnits(workUnits);
+    metric->Initialize();
+    metric->GetValueAndDerivative(values[sparse], derivatives[sparse]);
+  }
+
+  if (std::abs(values[1] - values[0]) > 1e-10 * std::abs(values[0]) || derivatives[1].size() != derivatives[0].size())
+  {
+    std::cerr << name << ": different values " << values[1] << " != " << values[0] << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < derivatives[0].size(); ++i)
+  {
+    if (std::abs(derivatives[1][i] - derivatives[0][i]) > 1e-10 * (1.0 + std::abs(derivatives[0][i])))
+    {
+      std::cerr << name << ": different derivatives at " << i << ": " << derivatives[1][i]
+                << " != " << derivatives[0][i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageToImageMetricv4SparseJacobianTest(int, char *[])
+{
+  const ImageType::SizeType size{ { 64, 48 } };
+  const auto                fixedImage = CreateImageToImageMetricv4TestImage<ImageType>(size, 0.0);
+  const auto                movingImage = CreateImageToImageMetricv4TestImage<ImageType>(size, 2.5);
+
+  using MeanSquaresMetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+  using MattesMetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+
+  bool success = true;
+  for (const itk::ThreadIdType workUnits : { 1, 4 })
+  {
+    success = TestMetric<MeanSquaresMetricType>("MeanSquares", fixedImage, movingImage, workUnits) && success;
+    success = TestMetric<MattesMetricType>("MattesMutualInformation", fixedImage, movingImage, workUnits) && success;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
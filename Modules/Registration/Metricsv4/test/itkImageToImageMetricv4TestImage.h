@@ -0,0 +1,47 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkImageToImageMetricv4TestImage_h
+#define itkImageToImageMetricv4TestImage_h
+
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <cmath>
+
+// A 2D Gaussian blob over a ramp, centered in the image and shifted by the
+// given number of pixels, so that the images created with two shifts are a
+// fixed and a moving image with a smooth metric between them.
+template <typename TImage>
+typename TImage::Pointer
+CreateImageToImageMetricv4TestImage(const typename TImage::SizeType & size, double shift)
+{
+  static_assert(TImage::ImageDimension == 2, "The test images are 2D.");
+
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - 0.5 * size[0] - shift;
+    const double y = it.GetIndex()[1] - 0.5 * size[1] + 0.5 * shift;
+    it.Set(static_cast<typename TImage::PixelType>(100.0 * std::exp(-(x * x + 2.0 * y * y) / 200.0) + 0.1 * x));
+  }
+  return image;
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkBSplineTransform.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageToImageMetricv4TestImage.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+using MetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+using TransformType = itk::BSplineTransform<double, Dimension, 3>;
+
+// Computes the value and the derivative of the metric.
+void
+Compute(const ImageType *            fixedImage,
+        const ImageType *            movingImage,
+        TransformType *              transform,
+        itk::ThreadIdType            numberOfWorkUnits,
+        itk::SizeValueType           maximumPrivateJointPDFDerivativesMemory,
+        bool                         useSampledPointSet,
+        MetricType::MeasureType &    value,
+        MetricType::DerivativeType & derivative)
+{
+  auto metric = MetricType::New();
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->SetMovingTransform(transform);
+  metric->SetNumberOfHistogramBins(20);
+  metric->SetMaximumNumberOfWorkUnits(numberOfWorkUnits);
+  metric->SetMaximumPrivateJointPDFDerivativesMemory(maximumPrivateJointPDFDerivativesMemory);
+  if (useSampledPointSet)
+  {
+    auto               pointSet = MetricType::FixedSampledPointSetType::New();
+    itk::SizeValueType count = 0;
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(fixedImage, fixedImage->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it, ++count)
+    {
+      if (count % 3 == 0)
+      {
+        ImageType::PointType point;
+        fixedImage->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+        pointSet->SetPoint(pointSet->GetNumberOfPoints(), point);
+      }
+    }
+    metric->SetFixedSampledPointSet(pointSet);
+    metric->SetUseSampledPointSet(true);
+  }
+  metric->Initialize();
+  metric->GetValueAndDerivative(value, derivative);
+}
+} // namespace
+
+// The joint PDF derivatives accumulated in copies private to the work units
+// give the same metric derivative as the joint PDF derivatives shared under a
+// lock, for a transform with many parameters.
+int
+itkMattesMutualInformationImageToImageMetricv4PrivateDerivativesTest(int, char *[])
+{
+  const ImageType::SizeType size{ { 64, 48 } };
+  const auto                fixedImage = CreateImageToImageMetricv4TestImage<ImageType>(size, 0.0);
+  const auto                movingImage = CreateImageToImageMetricv4TestImage<ImageType>(size, 2.5);
+
+  auto transform = TransformType::New();
+  transform->SetTransformDomainOrigin(fixedImage->GetOrigin());
+  transform->SetTransformDomainDirection(fixedImage->GetDirection());
+  TransformType::PhysicalDimensionsType physicalDimensions;
+  physicalDimensions[0] = 63.0;
+  physicalDimensions[1] = 47.0;
+  transform->SetTransformDomainPhysicalDimensions(physicalDimensions);
+  transform->SetTransformDomainMeshSize(itk::MakeFilled<TransformType::MeshSizeType>(8));
+  TransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.5 * std::sin(0.3 * i);
+  }
+  transform->SetParameters(parameters);
+
+  constexpr itk::SizeValueType defaultMaximumMemory = 1024 * 1024 * 1024;
+  auto                         metric = MetricType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(metric, MattesMutualInformationImageToImageMetricv4, ImageToImageMetricv4);
+  ITK_TEST_SET_GET_VALUE(defaultMaximumMemory, metric->GetMaximumPrivateJointPDFDerivativesMemory());
+
+  for (const bool useSampledPointSet : { false, true })
+  {
+    MetricType::MeasureType    referenceValue;
+    MetricType::DerivativeType referenceDerivative;
+    Compute(fixedImage, movingImage, transform, 1, 0, useSampledPointSet, referenceValue, referenceDerivative);
+
+    for (const itk::SizeValueType maximumMemory : { itk::SizeValueType{ 0 }, defaultMaximumMemory })
+    {
+      MetricType::MeasureType    value;
+      MetricType::DerivativeType derivative;
+      Compute(fixedImage, movingImage, transform, 4, maximumMemory, useSampledPointSet, value, derivative);
+
+      std::cout << "UseSampledPointSet: " << useSampledPointSet << ", MaximumPrivateJointPDFDerivativesMemory: "
+                << maximumMemory << ", value: " << value << std::endl;
+      ITK_TEST_EXPECT_TRUE(std::abs(value - referenceValue) <= 1e-10 * std::abs(referenceValue));
+      ITK_TEST_EXPECT_EQUAL(derivative.size(), referenceDerivative.size());
+      for (unsigned int i = 0; i < derivative.size(); ++i)
+      {
+        if (std::abs(derivative[i] - referenceDerivative[i]) > 1e-10 * (1.0 + std::abs(referenceDerivative[i])))
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Different derivatives at " << i << ": " << derivative[i] << " != " << referenceDerivative[i]
+                    << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,7 @@
 #include "itkObjectToObjectMultiMetricv4.h"
 #include "itkObjectToObjectOptimizerBase.h"
 #include "itkImageToImageMetricv4.h"
+#include "itkImageRegistrationPyramidCache.h"
 #include "itkPointSetToPointSetMetricWithIndexv4.h"
 #include "itkShrinkImageFilter.h"
 #include "itkIdentityTransform.h"
@@ -199,6 +200,10 @@ public:
   using SmoothingSigmasArrayType = Array<RealType>;
   using MetricSamplingPercentageArrayType = Array<RealType>;
 
+  /** Type of the cache of the smooth images and shrunk virtual domain images. */
+  using PyramidCacheType = ImageRegistrationPyramidCache<FixedImageType, MovingImageType, VirtualImageType>;
+  using PyramidCachePointer = typename PyramidCacheType::Pointer;
+
   /** Transform adaptor type alias */
   using TransformParametersAdaptorType = TransformParametersAdaptorBase<InitialTransformType>;
   using TransformParametersAdaptorPointer = typename TransformParametersAdaptorType::Pointer;
@@ -432,6 +437,15 @@ public:
   itkGetConstMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits, bool);
   itkBooleanMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits);
 
+  /**
+   * Set/Get the cache of the smooth fixed and moving images and of the shrunk virtual
+   * domain images of the levels.  Sharing one cache between the stages of a cascade, or
+   * between registrations of the same images, computes each of these images only once.
+   * Not set by default, in which case the images are computed at each level.
+   */
+  itkSetObjectMacro(PyramidCache, PyramidCacheType);
+  itkGetModifiableObjectMacro(PyramidCache, PyramidCacheType);
+
   /** Make a DataObject of the correct type to be used as the specified output. */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
   using Superclass::MakeOutput;
@@ -559,6 +573,7 @@ protected:
   std::vector<ShrinkFactorsPerDimensionContainerType> m_ShrinkFactorsPerLevel{};
   SmoothingSigmasArrayType                            m_SmoothingSigmasPerLevel{};
   bool                                                m_SmoothingSigmasAreSpecifiedInPhysicalUnits{};
+  PyramidCachePointer                                 m_PyramidCache{};
 
   bool m_ReseedIterator{};
   int  m_RandomSeed{};
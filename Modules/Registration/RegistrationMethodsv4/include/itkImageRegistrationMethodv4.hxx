@@ -459,7 +459,12 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   //   2. smooth the fixed and moving images.
 
   typename VirtualImageType::Pointer currentLevelVirtualDomainImage = nullptr;
-  if (this->m_VirtualDomainImage.IsNotNull())
+  if (this->m_VirtualDomainImage.IsNotNull() && this->m_PyramidCache.IsNotNull())
+  {
+    currentLevelVirtualDomainImage = this->m_PyramidCache->GetShrunkVirtualDomainImage(
+      this->m_VirtualDomainImage, this->m_ShrinkFactorsPerLevel[level]);
+  }
+  else if (this->m_VirtualDomainImage.IsNotNull())
   {
     auto shrinkFilter = ShrinkFilterType::New();
     shrinkFilter->SetShrinkFactors(this->m_ShrinkFactorsPerLevel[level]);
@@ -608,7 +613,6 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
       if (this->m_SmoothingSigmasPerLevel[level] > 0)
       {
         using FixedImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<FixedImageType, FixedImageType>;
-        auto fixedImageSmoothingFilter = FixedImageSmoothingFilterType::New();
         typename FixedImageSmoothingFilterType::SigmaArrayType fixedImageSigmaArray(
           this->m_SmoothingSigmasPerLevel[level]);
 
@@ -620,15 +624,23 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
             fixedImageSigmaArray[i] *= fixedSpacing[i];
           }
         }
-        fixedImageSmoothingFilter->SetSigmaArray(fixedImageSigmaArray);
-        fixedImageSmoothingFilter->SetInput(this->GetFixedImage(n));
+        if (this->m_PyramidCache)
+        {
+          this->m_FixedSmoothImages[n] =
+            this->m_PyramidCache->GetSmoothFixedImage(this->GetFixedImage(n), fixedImageSigmaArray);
+        }
+        else
+        {
+          auto fixedImageSmoothingFilter = FixedImageSmoothingFilterType::New();
+          fixedImageSmoothingFilter->SetSigmaArray(fixedImageSigmaArray);
+          fixedImageSmoothingFilter->SetInput(this->GetFixedImage(n));
 
-        this->m_FixedSmoothImages[n] = fixedImageSmoothingFilter->GetOutput();
-        fixedImageSmoothingFilter->Update();
-        fixedImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+          this->m_FixedSmoothImages[n] = fixedImageSmoothingFilter->GetOutput();
+          fixedImageSmoothingFilter->Update();
+          fixedImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+        }
 
         using MovingImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<MovingImageType, MovingImageType>;
-        auto movingImageSmoothingFilter = MovingImageSmoothingFilterType::New();
         typename MovingImageSmoothingFilterType::SigmaArrayType movingImageSigmaArray(
           this->m_SmoothingSigmasPerLevel[level]);
 
@@ -640,12 +652,21 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
             movingImageSigmaArray[i] *= movingSpacing[i];
           }
         }
-        movingImageSmoothingFilter->SetSigmaArray(movingImageSigmaArray);
-        movingImageSmoothingFilter->SetInput(this->GetMovingImage(n));
+        if (this->m_PyramidCache)
+        {
+          this->m_MovingSmoothImages[n] =
+            this->m_PyramidCache->GetSmoothMovingImage(this->GetMovingImage(n), movingImageSigmaArray);
+        }
+        else
+        {
+          auto movingImageSmoothingFilter = MovingImageSmoothingFilterType::New();
+          movingImageSmoothingFilter->SetSigmaArray(movingImageSigmaArray);
+          movingImageSmoothingFilter->SetInput(this->GetMovingImage(n));
 
-        this->m_MovingSmoothImages[n] = movingImageSmoothingFilter->GetOutput();
-        movingImageSmoothingFilter->Update();
-        movingImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+          this->m_MovingSmoothImages[n] = movingImageSmoothingFilter->GetOutput();
+          movingImageSmoothingFilter->Update();
+          movingImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+        }
       }
       else
       {
@@ -678,6 +699,33 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
       {
         itkExceptionMacro("Invalid metric type.");
       }
+
+      // Share the gradient images of the smooth images too, when the image metric computes them with its
+      // default gradient filters.
+
+      if (this->m_PyramidCache)
+      {
+        ImageMetricType * imageMetric =
+          this->m_Metric->GetMetricCategory() == ObjectToObjectMetricBaseTemplateEnums::MetricCategory::MULTI_METRIC
+            ? dynamic_cast<ImageMetricType *>(multiMetric->GetMetricQueue()[n].GetPointer())
+            : dynamic_cast<ImageMetricType *>(this->m_Metric.GetPointer());
+        if (imageMetric->GetUseFixedImageGradientFilter() && imageMetric->GetGradientSourceIncludesFixed() &&
+            dynamic_cast<typename PyramidCacheType::DefaultFixedImageGradientFilterType *>(
+              imageMetric->GetFixedImageGradientFilter()) != nullptr)
+        {
+          imageMetric->SetPrecomputedFixedImageGradientImage(
+            this->m_FixedSmoothImages[n],
+            this->m_PyramidCache->GetFixedImageGradientImage(this->m_FixedSmoothImages[n]));
+        }
+        if (imageMetric->GetUseMovingImageGradientFilter() && imageMetric->GetGradientSourceIncludesMoving() &&
+            dynamic_cast<typename PyramidCacheType::DefaultMovingImageGradientFilterType *>(
+              imageMetric->GetMovingImageGradientFilter()) != nullptr)
+        {
+          imageMetric->SetPrecomputedMovingImageGradientImage(
+            this->m_MovingSmoothImages[n],
+            this->m_PyramidCache->GetMovingImageGradientImage(this->m_MovingSmoothImages[n]));
+        }
+      }
     }
     else if (this->m_Metric->GetMetricCategory() ==
                ObjectToObjectMetricBaseTemplateEnums::MetricCategory::POINT_SET_METRIC ||
@@ -1180,6 +1228,7 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   os << indent << "ShrinkFactorsPerLevel: " << m_ShrinkFactorsPerLevel << std::endl;
   os << indent << "SmoothingSigmasPerLevel: " << m_SmoothingSigmasPerLevel << std::endl;
   itkPrintSelfBooleanMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits);
+  itkPrintSelfObjectMacro(PyramidCache);
 
   itkPrintSelfBooleanMacro(ReseedIterator);
   os << indent << "RandomSeed: " << m_RandomSeed << std::endl;
@@ -0,0 +1,213 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegistrationPyramidCache_h
+#define itkImageRegistrationPyramidCache_h
+
+#include "itkObject.h"
+#include "itkDefaultImageToImageMetricTraitsv4.h"
+#include "itkShrinkImageFilter.h"
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class ImageRegistrationPyramidCache
+ * \brief Cache of the multi-resolution images of image registration methods.
+ *
+ * At each level, ImageRegistrationMethodv4 and its subclasses, e.g.
+ * SyNImageRegistrationMethod and BSplineSyNImageRegistrationMethod, smooth
+ * the fixed and moving images and shrink the virtual domain image, and the
+ * image metrics compute the gradient images of the smooth images. A typical
+ * cascade of stages, e.g. rigid, affine then SyN, uses the same shrink
+ * factors and smoothing sigmas in each stage, and therefore computes the
+ * same images again in each stage. When the stages, or separate
+ * registrations against the same images, share one pyramid cache with
+ * SetPyramidCache(), each image is computed once, by the first level which
+ * needs it, and read back by the next ones.
+ *
+ * The smooth images are keyed by their input image, its modification time,
+ * and the smoothing sigmas in physical units. The gradient images are keyed
+ * by their input image and its modification time, and are computed as the
+ * default gradient filters of ImageToImageMetricv4 do. The shrunk virtual
+ * domain images are keyed by the geometry of the virtual domain and the
+ * shrink factors. The cached images are shared, and must not be modified.
+ *
+ * The cache holds its images until ReleaseImages() is called, or the
+ * cache is deleted. An entry is replaced when its input image is modified.
+ *
+ * \note The image metrics use the cached gradient images only with their
+ * default gradient filters, see
+ * ImageToImageMetricv4::SetPrecomputedFixedImageGradientImage(). The
+ * metrics of SyNImageRegistrationMethod and BSplineSyNImageRegistrationMethod
+ * compute the gradient images of the warped images at each iteration, which
+ * are not cached.
+ *
+ * \note The cache is not thread safe: the registration methods which share
+ * it must run one after the other.
+ *
+ * \ingroup ITKRegistrationMethodsv4
+ */
+template <typename TFixedImage, typename TMovingImage = TFixedImage, typename TVirtualImage = TFixedImage>
+class ITK_TEMPLATE_EXPORT ImageRegistrationPyramidCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageRegistrationPyramidCache);
+
+  /** Standard class type aliases. */
+  using Self = ImageRegistrationPyramidCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageRegistrationPyramidCache);
+
+  /** ImageDimension constants */
+  static constexpr unsigned int ImageDimension = TFixedImage::ImageDimension;
+
+  /** Image type alias support */
+  using FixedImageType = TFixedImage;
+  using FixedImageConstPointer = typename FixedImageType::ConstPointer;
+  using MovingImageType = TMovingImage;
+  using MovingImageConstPointer = typename MovingImageType::ConstPointer;
+  using VirtualImageType = TVirtualImage;
+  using VirtualImagePointer = typename VirtualImageType::Pointer;
+
+  /** Smoothing and shrinking type alias support, as in ImageRegistrationMethodv4 */
+  using FixedImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<FixedImageType, FixedImageType>;
+  using FixedImageSigmaArrayType = typename FixedImageSmoothingFilterType::SigmaArrayType;
+  using MovingImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<MovingImageType, MovingImageType>;
+  using MovingImageSigmaArrayType = typename MovingImageSmoothingFilterType::SigmaArrayType;
+  using ShrinkFilterType = ShrinkImageFilter<VirtualImageType, VirtualImageType>;
+  using ShrinkFactorsType = typename ShrinkFilterType::ShrinkFactorsType;
+
+  /** Gradient type alias support, as in the default traits of ImageToImageMetricv4 */
+  using MetricTraitsType = DefaultImageToImageMetricTraitsv4<FixedImageType, MovingImageType, VirtualImageType>;
+  using FixedImageGradientImageType = typename MetricTraitsType::FixedImageGradientImageType;
+  using FixedImageGradientImagePointer = typename FixedImageGradientImageType::Pointer;
+  using DefaultFixedImageGradientFilterType = typename MetricTraitsType::DefaultFixedImageGradientFilter;
+  using MovingImageGradientImageType = typename MetricTraitsType::MovingImageGradientImageType;
+  using MovingImageGradientImagePointer = typename MovingImageGradientImageType::Pointer;
+  using DefaultMovingImageGradientFilterType = typename MetricTraitsType::DefaultMovingImageGradientFilter;
+
+  /** Get the fixed image smoothed with the sigmas, in physical units,
+   * computing it when it is not cached yet. */
+  FixedImageConstPointer
+  GetSmoothFixedImage(const FixedImageType * image, const FixedImageSigmaArrayType & sigmas);
+
+  /** Get the moving image smoothed with the sigmas, in physical units,
+   * computing it when it is not cached yet. */
+  MovingImageConstPointer
+  GetSmoothMovingImage(const MovingImageType * image, const MovingImageSigmaArrayType & sigmas);
+
+  /** Get the gradient image of the fixed image, computing it when it is not
+   * cached yet. */
+  FixedImageGradientImagePointer
+  GetFixedImageGradientImage(const FixedImageType * image);
+
+  /** Get the gradient image of the moving image, computing it when it is not
+   * cached yet. */
+  MovingImageGradientImagePointer
+  GetMovingImageGradientImage(const MovingImageType * image);
+
+  /** Get the virtual domain image shrunk by the factors, computing it when an
+   * image of the same domain and factors is not cached yet. */
+  VirtualImagePointer
+  GetShrunkVirtualDomainImage(const VirtualImageType * image, const ShrinkFactorsType & shrinkFactors);
+
+  /** Get the number of cached images. */
+  SizeValueType
+  GetNumberOfImages() const;
+
+  /** Release all the cached images. */
+  void
+  ReleaseImages();
+
+protected:
+  ImageRegistrationPyramidCache() = default;
+  ~ImageRegistrationPyramidCache() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** A smooth image, with its input image, the modification time of its
+   * input image, and its smoothing sigmas. */
+  template <typename TImage, typename TSigmaArray>
+  struct SmoothImageEntry
+  {
+    typename TImage::ConstPointer Input;
+    ModifiedTimeType              InputMTime;
+    TSigmaArray                   Sigmas;
+    typename TImage::ConstPointer Output;
+  };
+
+  /** A gradient image, with its input image and the modification time of its
+   * input image. */
+  template <typename TImage, typename TGradientImage>
+  struct GradientImageEntry
+  {
+    typename TImage::ConstPointer    Input;
+    ModifiedTimeType                 InputMTime;
+    typename TGradientImage::Pointer Output;
+  };
+
+  /** A shrunk virtual domain image, with the virtual domain of its input
+   * image and its shrink factors. */
+  struct ShrunkVirtualDomainImageEntry
+  {
+    typename VirtualImageType::PointType     Origin;
+    typename VirtualImageType::SpacingType   Spacing;
+    typename VirtualImageType::DirectionType Direction;
+    typename VirtualImageType::RegionType    Region;
+    ShrinkFactorsType                        ShrinkFactors;
+    VirtualImagePointer                      Output;
+  };
+
+  template <typename TImage, typename TSigmaArray>
+  static typename TImage::ConstPointer
+  GetSmoothImage(std::vector<SmoothImageEntry<TImage, TSigmaArray>> & entries,
+                 const TImage *                                      image,
+                 const TSigmaArray &                                 sigmas);
+
+  template <typename TGradientFilter, typename TImage, typename TGradientImage>
+  static typename TGradientImage::Pointer
+  GetGradientImage(std::vector<GradientImageEntry<TImage, TGradientImage>> & entries, const TImage * image);
+
+  /** Remove the entries computed from a previous state of the image. */
+  template <typename TEntry, typename TImage>
+  static void
+  RemoveEntriesOfModifiedImage(std::vector<TEntry> & entries, const TImage * image);
+
+  std::vector<SmoothImageEntry<FixedImageType, FixedImageSigmaArrayType>>        m_SmoothFixedImages{};
+  std::vector<SmoothImageEntry<MovingImageType, MovingImageSigmaArrayType>>      m_SmoothMovingImages{};
+  std::vector<GradientImageEntry<FixedImageType, FixedImageGradientImageType>>   m_FixedImageGradientImages{};
+  std::vector<GradientImageEntry<MovingImageType, MovingImageGradientImageType>> m_MovingImageGradientImages{};
+  std::vector<ShrunkVirtualDomainImageEntry>                                     m_ShrunkVirtualDomainImages{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkImageRegistrationPyramidCache.hxx"
+#endif
+
+#endif
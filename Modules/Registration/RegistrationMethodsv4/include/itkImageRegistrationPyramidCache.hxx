@@ -0,0 +1,229 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegistrationPyramidCache_hxx
+#define itkImageRegistrationPyramidCache_hxx
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+template <typename TEntry, typename TImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::RemoveEntriesOfModifiedImage(
+  std::vector<TEntry> & entries,
+  const TImage *        image)
+{
+  const ModifiedTimeType imageMTime = image->GetMTime();
+  entries.erase(std::remove_if(entries.begin(),
+                               entries.end(),
+                               [image, imageMTime](const TEntry & entry) {
+                                 return entry.Input.GetPointer() == image && entry.InputMTime != imageMTime;
+                               }),
+                entries.end());
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+template <typename TImage, typename TSigmaArray>
+typename TImage::ConstPointer
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetSmoothImage(
+  std::vector<SmoothImageEntry<TImage, TSigmaArray>> & entries,
+  const TImage *                                      image,
+  const TSigmaArray &                                 sigmas)
+{
+  if (image == nullptr)
+  {
+    return nullptr;
+  }
+
+  RemoveEntriesOfModifiedImage(entries, image);
+  for (const auto & entry : entries)
+  {
+    if (entry.Input.GetPointer() == image && entry.Sigmas == sigmas)
+    {
+      return entry.Output;
+    }
+  }
+
+  using SmoothingFilterType = SmoothingRecursiveGaussianImageFilter<TImage, TImage>;
+  auto smoothingFilter = SmoothingFilterType::New();
+  smoothingFilter->SetSigmaArray(sigmas);
+  smoothingFilter->SetInput(image);
+  smoothingFilter->Update();
+
+  const typename TImage::Pointer smoothImage = smoothingFilter->GetOutput();
+  smoothImage->DisconnectPipeline();
+
+  entries.push_back({ image, image->GetMTime(), sigmas, smoothImage.GetPointer() });
+  return smoothImage.GetPointer();
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+template <typename TGradientFilter, typename TImage, typename TGradientImage>
+typename TGradientImage::Pointer
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetGradientImage(
+  std::vector<GradientImageEntry<TImage, TGradientImage>> & entries,
+  const TImage *                                           image)
+{
+  if (image == nullptr)
+  {
+    return nullptr;
+  }
+
+  RemoveEntriesOfModifiedImage(entries, image);
+  for (const auto & entry : entries)
+  {
+    if (entry.Input.GetPointer() == image)
+    {
+      return entry.Output;
+    }
+  }
+
+  // As the default gradient filters of ImageToImageMetricv4.
+  const typename TImage::SpacingType & spacing = image->GetSpacing();
+  double                               maximumSpacing = 0.0;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    maximumSpacing = std::max(maximumSpacing, static_cast<double>(spacing[i]));
+  }
+  auto gradientFilter = TGradientFilter::New();
+  gradientFilter->SetSigma(maximumSpacing);
+  gradientFilter->SetNormalizeAcrossScale(true);
+  gradientFilter->SetUseImageDirection(true);
+  gradientFilter->SetInput(image);
+  gradientFilter->Update();
+
+  const typename TGradientImage::Pointer gradientImage = gradientFilter->GetOutput();
+  gradientImage->DisconnectPipeline();
+
+  entries.push_back({ image, image->GetMTime(), gradientImage });
+  return gradientImage;
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetSmoothFixedImage(
+  const FixedImageType *           image,
+  const FixedImageSigmaArrayType & sigmas) -> FixedImageConstPointer
+{
+  return GetSmoothImage(this->m_SmoothFixedImages, image, sigmas);
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetSmoothMovingImage(
+  const MovingImageType *           image,
+  const MovingImageSigmaArrayType & sigmas) -> MovingImageConstPointer
+{
+  return GetSmoothImage(this->m_SmoothMovingImages, image, sigmas);
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetFixedImageGradientImage(
+  const FixedImageType * image) -> FixedImageGradientImagePointer
+{
+  return GetGradientImage<DefaultFixedImageGradientFilterType>(this->m_FixedImageGradientImages, image);
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetMovingImageGradientImage(
+  const MovingImageType * image) -> MovingImageGradientImagePointer
+{
+  return GetGradientImage<DefaultMovingImageGradientFilterType>(this->m_MovingImageGradientImages, image);
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetShrunkVirtualDomainImage(
+  const VirtualImageType *  image,
+  const ShrinkFactorsType & shrinkFactors) -> VirtualImagePointer
+{
+  if (image == nullptr)
+  {
+    return nullptr;
+  }
+
+  // The shrunk image only depends on the virtual domain of the input image,
+  // not on its pixels.
+  for (const auto & entry : this->m_ShrunkVirtualDomainImages)
+  {
+    if (entry.ShrinkFactors == shrinkFactors && entry.Region == image->GetLargestPossibleRegion() &&
+        entry.Origin == image->GetOrigin() && entry.Spacing == image->GetSpacing() &&
+        entry.Direction == image->GetDirection())
+    {
+      return entry.Output;
+    }
+  }
+
+  auto shrinkFilter = ShrinkFilterType::New();
+  shrinkFilter->SetShrinkFactors(shrinkFactors);
+  shrinkFilter->SetInput(image);
+  shrinkFilter->Update();
+
+  const VirtualImagePointer shrunkImage = shrinkFilter->GetOutput();
+  shrunkImage->DisconnectPipeline();
+
+  this->m_ShrunkVirtualDomainImages.push_back({ image->GetOrigin(),
+                                                image->GetSpacing(),
+                                                image->GetDirection(),
+                                                image->GetLargestPossibleRegion(),
+                                                shrinkFactors,
+                                                shrunkImage });
+  return shrunkImage;
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+SizeValueType
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetNumberOfImages() const
+{
+  return this->m_SmoothFixedImages.size() + this->m_SmoothMovingImages.size() +
+         this->m_FixedImageGradientImages.size() + this->m_MovingImageGradientImages.size() +
+         this->m_ShrunkVirtualDomainImages.size();
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::ReleaseImages()
+{
+  this->m_SmoothFixedImages.clear();
+  this->m_SmoothMovingImages.clear();
+  this->m_FixedImageGradientImages.clear();
+  this->m_MovingImageGradientImages.clear();
+  this->m_ShrunkVirtualDomainImages.clear();
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::PrintSelf(std::ostream & os,
+                                                                                    Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfSmoothFixedImages: " << this->m_SmoothFixedImages.size() << std::endl;
+  os << indent << "NumberOfSmoothMovingImages: " << this->m_SmoothMovingImages.size() << std::endl;
+  os << indent << "NumberOfFixedImageGradientImages: " << this->m_FixedImageGradientImages.size() << std::endl;
+  os << indent << "NumberOfMovingImageGradientImages: " << this->m_MovingImageGradientImages.size() << std::endl;
+  os << indent << "NumberOfShrunkVirtualDomainImages: " << this->m_ShrunkVirtualDomainImages.size() << std::endl;
+}
+
+} // end namespace itk
+
+#endif
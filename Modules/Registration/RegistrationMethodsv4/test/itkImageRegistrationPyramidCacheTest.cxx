@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegistrationPyramidCache.h"
+#include "itkImageRegistrationMethodv4.h"
+#include "itkSyNImageRegistrationMethod.h"
+#include "itkDisplacementFieldTransformParametersAdaptor.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkGradientDescentOptimizerv4.h"
+#include "itkTranslationTransform.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+using PyramidCacheType = itk::ImageRegistrationPyramidCache<ImageType>;
+
+ImageType::Pointer
+CreateImage(double shift)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 40, 36 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - 20.0 - shift;
+    const double y = it.GetIndex()[1] - 18.0 + 0.5 * shift;
+    it.Set(static_cast<float>(100.0 * std::exp(-(x * x + 2.0 * y * y) / 60.0)));
+  }
+  return image;
+}
+
+bool
+ImagesAreEqual(const ImageType * image1, const ImageType * image2)
+{
+  if (image1->GetBufferedRegion() != image2->GetBufferedRegion())
+  {
+    return false;
+  }
+  itk::ImageRegionConstIterator<ImageType> it1(image1, image1->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> it2(image2, image2->GetBufferedRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (it1.Get() != it2.Get())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TRegistration>
+void
+SetLevels(TRegistration * registration)
+{
+  registration->SetNumberOfLevels(2);
+  typename TRegistration::ShrinkFactorsArrayType shrinkFactorsPerLevel(2);
+  shrinkFactorsPerLevel[0] = 2;
+  shrinkFactorsPerLevel[1] = 1;
+  registration->SetShrinkFactorsPerLevel(shrinkFactorsPerLevel);
+  typename TRegistration::SmoothingSigmasArrayType smoothingSigmasPerLevel(2);
+  smoothingSigmasPerLevel[0] = 1.5;
+  smoothingSigmasPerLevel[1] = 0.0;
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmasPerLevel);
+}
+
+// Runs a translation stage followed by a SyN stage, which share the pyramid
+// cache when it is not null, and returns the parameters of both stages.
+itk::Array<double>
+RunRegistration(const ImageType * fixedImage, const ImageType * movingImage, PyramidCacheType * pyramidCache)
+{
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+  using OptimizerType = itk::GradientDescentOptimizerv4;
+
+  using TranslationTransformType = itk::TranslationTransform<double, Dimension>;
+  using TranslationRegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TranslationTransformType>;
+  auto translationOptimizer = OptimizerType::New();
+  translationOptimizer->SetLearningRate(0.5);
+  translationOptimizer->SetNumberOfIterations(10);
+  translationOptimizer->SetDoEstimateLearningRateOnce(false);
+  translationOptimizer->SetDoEstimateLearningRateAtEachIteration(false);
+  translationOptimizer->SetDoEstimateScales(false);
+  auto translationRegistration = TranslationRegistrationType::New();
+  translationRegistration->SetFixedImage(fixedImage);
+  translationRegistration->SetMovingImage(movingImage);
+  translationRegistration->SetMetric(MetricType::New());
+  translationRegistration->SetOptimizer(translationOptimizer);
+  translationRegistration->SetPyramidCache(pyramidCache);
+  SetLevels(translationRegistration.GetPointer());
+  translationRegistration->Update();
+
+  using SyNTransformType = itk::DisplacementFieldTransform<double, Dimension>;
+  using SyNRegistrationType = itk::SyNImageRegistrationMethod<ImageType, ImageType, SyNTransformType>;
+  auto synRegistration = SyNRegistrationType::New();
+  synRegistration->SetFixedImage(fixedImage);
+  synRegistration->SetMovingImage(movingImage);
+  synRegistration->SetMetric(MetricType::New());
+  synRegistration->SetMovingInitialTransform(translationRegistration->GetModifiableTransform());
+  synRegistration->SetPyramidCache(pyramidCache);
+  SetLevels(synRegistration.GetPointer());
+  auto synTransform = SyNTransformType::New();
+  for (const bool inverse : { false, true })
+  {
+    auto displacementField = SyNTransformType::DisplacementFieldType::New();
+    displacementField->CopyInformation(fixedImage);
+    displacementField->SetRegions(fixedImage->GetBufferedRegion());
+    displacementField->AllocateInitialized();
+    if (inverse)
+    {
+      synTransform->SetInverseDisplacementField(displacementField);
+    }
+    else
+    {
+      synTransform->SetDisplacementField(displacementField);
+    }
+  }
+  synRegistration->SetInitialTransform(synTransform);
+  synRegistration->InPlaceOn();
+  using AdaptorType = itk::DisplacementFieldTransformParametersAdaptor<SyNTransformType>;
+  SyNRegistrationType::TransformParametersAdaptorsContainerType adaptors;
+  for (unsigned int level = 0; level < 2; ++level)
+  {
+    using ShrinkFilterType = itk::ShrinkImageFilter<ImageType, ImageType>;
+    auto shrinkFilter = ShrinkFilterType::New();
+    shrinkFilter->SetShrinkFactors(synRegistration->GetShrinkFactorsPerDimension(level));
+    shrinkFilter->SetInput(fixedImage);
+    shrinkFilter->UpdateOutputInformation();
+    auto adaptor = AdaptorType::New();
+    adaptor->SetRequiredSpacing(shrinkFilter->GetOutput()->GetSpacing());
+    adaptor->SetRequiredSize(shrinkFilter->GetOutput()->GetLargestPossibleRegion().GetSize());
+    adaptor->SetRequiredDirection(shrinkFilter->GetOutput()->GetDirection());
+    adaptor->SetRequiredOrigin(shrinkFilter->GetOutput()->GetOrigin());
+    adaptor->SetTransform(synTransform);
+    adaptors.push_back(adaptor);
+  }
+  synRegistration->SetTransformParametersAdaptorsPerLevel(adaptors);
+  SyNRegistrationType::NumberOfIterationsArrayType numberOfIterationsPerLevel(2);
+  numberOfIterationsPerLevel.Fill(5);
+  synRegistration->SetNumberOfIterationsPerLevel(numberOfIterationsPerLevel);
+  synRegistration->Update();
+
+  const auto &       translationParameters = translationRegistration->GetTransform()->GetParameters();
+  const auto &       synParameters = synRegistration->GetTransform()->GetParameters();
+  itk::Array<double> parameters(translationParameters.size() + synParameters.size());
+  for (unsigned int i = 0; i < translationParameters.size(); ++i)
+  {
+    parameters[i] = translationParameters[i];
+  }
+  for (unsigned int i = 0; i < synParameters.size(); ++i)
+  {
+    parameters[translationParameters.size() + i] = synParameters[i];
+  }
+  return parameters;
+}
+} // namespace
+
+int
+itkImageRegistrationPyramidCacheTest(int, char *[])
+{
+  const auto fixedImage = CreateImage(0.0);
+  const auto movingImage = CreateImage(1.5);
+
+  auto pyramidCache = PyramidCacheType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(pyramidCache, ImageRegistrationPyramidCache, Object);
+
+  // The smooth images are computed once, as the smoothing filter does.
+  auto sigmas = itk::MakeFilled<PyramidCacheType::FixedImageSigmaArrayType>(2.0);
+  const auto smoothImage = pyramidCache->GetSmoothFixedImage(fixedImage, sigmas);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetSmoothFixedImage(fixedImage, sigmas).GetPointer(), smoothImage.GetPointer());
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfImages(), 1);
+
+  using SmoothingFilterType = PyramidCacheType::FixedImageSmoothingFilterType;
+  auto smoothingFilter = SmoothingFilterType::New();
+  smoothingFilter->SetSigmaArray(sigmas);
+  smoothingFilter->SetInput(fixedImage);
+  smoothingFilter->Update();
+  ITK_TEST_EXPECT_TRUE(ImagesAreEqual(smoothImage, smoothingFilter->GetOutput()));
+
+  sigmas[1] = 1.0;
+  ITK_TEST_EXPECT_TRUE(pyramidCache->GetSmoothFixedImage(fixedImage, sigmas) != smoothImage);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfImages(), 2);
+
+  // The images smoothed from a modified image are replaced.
+  const auto modifiedImage = CreateImage(0.0);
+  const auto modifiedSmoothImage = pyramidCache->GetSmoothMovingImage(modifiedImage, sigmas);
+  modifiedImage->Modified();
+  ITK_TEST_EXPECT_TRUE(pyramidCache->GetSmoothMovingImage(modifiedImage, sigmas) != modifiedSmoothImage);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfImages(), 3);
+
+  // The shrunk virtual domain images only depend on the virtual domain.
+  auto       shrinkFactors = itk::MakeFilled<PyramidCacheType::ShrinkFactorsType>(2);
+  const auto shrunkImage = pyramidCache->GetShrunkVirtualDomainImage(fixedImage, shrinkFactors);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetShrunkVirtualDomainImage(movingImage, shrinkFactors), shrunkImage);
+  ITK_TEST_EXPECT_EQUAL(shrunkImage->GetLargestPossibleRegion().GetSize(), (ImageType::SizeType{ { 20, 18 } }));
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfImages(), 4);
+
+  pyramidCache->ReleaseImages();
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfImages(), 0);
+
+  // The registration stages give the same transforms with the cache as
+  // without it. The second stage computes no image.
+  const itk::Array<double> parameters = RunRegistration(fixedImage, movingImage, nullptr);
+  const itk::Array<double> cachedParameters = RunRegistration(fixedImage, movingImage, pyramidCache);
+  ITK_TEST_EXPECT_EQUAL(cachedParameters.size(), parameters.size());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    if (std::abs(cachedParameters[i] - parameters[i]) > 1e-12 * (1.0 + std::abs(parameters[i])))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Different parameters at " << i << ": " << cachedParameters[i] << " != " << parameters[i]
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  // Smooth fixed and moving images at the first level, moving gradient
+  // images and shrunk virtual domain images at both levels.
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfImages(), 6);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
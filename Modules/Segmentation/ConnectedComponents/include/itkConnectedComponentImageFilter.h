@@ -18,6 +18,7 @@
 #ifndef itkConnectedComponentImageFilter_h
 #define itkConnectedComponentImageFilter_h
 
+#include "itkIndexRange.h"
 #include "itkScanlineFilterCommon.h"
 
 namespace itk
@@ -43,6 +44,20 @@ namespace itk
  *
  * After the filter is executed, ObjectCount holds the number of connected components.
  *
+ * By default the filter needs the whole input. When NumberOfStreamDivisions
+ * is greater than 1, the input is divided in as many slabs along the last
+ * axis, and the filter updates its inputs slab by slab, as
+ * StreamingImageFilter does, so that it can be streamed, e.g. by an
+ * ImageFileWriter. The first update streams all the slabs: the runs of
+ * each slab are labeled with a union-find table local to the slab, and only
+ * the resulting components and the runs of the last slice of the slab are
+ * kept for the next slabs, to link the components across the slabs. The
+ * output requested region is enlarged to whole slabs, and each of its slabs
+ * is labeled again, its components taking the labels resolved by the first
+ * update. The following requested regions are labeled the same way, until
+ * the input or the filter is modified. The labels are the same as without
+ * streaming.
+ *
  * \sa ImageToImageFilter
  *
  * \ingroup SingleThreaded
@@ -152,6 +167,14 @@ public:
   itkSetMacro(BackgroundValue, OutputImagePixelType);
   itkGetConstMacro(BackgroundValue, OutputImagePixelType);
 
+  /**
+   * Set/Get the number of slabs in which the input is streamed to compute
+   * the label equivalences. With the default value of 1, the whole input
+   * is requested and processed at once.
+   */
+  itkSetClampMacro(NumberOfStreamDivisions, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfStreamDivisions, unsigned int);
+
 protected:
   ConnectedComponentImageFilter();
 
@@ -181,6 +204,15 @@ protected:
   void
   EnlargeOutputRequestedRegion(DataObject * itkNotUsed(output)) override;
 
+  /** When streamed, the requested regions are not propagated to the
+   * inputs, since UpdateOutputData() updates the inputs slab by slab. */
+  void
+  PropagateRequestedRegion(DataObject * output) override;
+
+  /** When streamed, updates the inputs slab by slab, and labels them. */
+  void
+  UpdateOutputData(DataObject * output) override;
+
   using ScanlineFunctions = ScanlineFilterCommon<TInputImage, TOutputImage>;
 
   using InternalLabelType = typename ScanlineFunctions::InternalLabelType;
@@ -197,10 +229,83 @@ protected:
   using WorkUnitData = typename ScanlineFunctions::WorkUnitData;
 
 private:
+  bool
+  IsStreamed() const
+  {
+    return m_NumberOfStreamDivisions > 1 && ImageDimension > 1;
+  }
+
+  /** Streamed labeling, used when there are several stream divisions. */
+  void
+  StreamedGenerateData();
+
+  /** Streams the whole input, and computes the output label of the
+   * components of each slab. */
+  void
+  ComputeStreamedComponentLabels();
+
+  /** Updates the inputs for a slab, and labels its runs with the
+   * components of the slab, numbered from 0 in raster order. Returns the
+   * number of components. */
+  SizeValueType
+  LabelSlabRuns(const RegionType & slabRegion, LineMapType & slabLines);
+
+  /** Processes the lines of a slab on the multi-threader, with the number
+   * of work units of the filter. The number of work units of the
+   * multi-threader, which may be shared, is restored afterwards. */
+  template <typename TFunction>
+  void
+  ParallelizeSlab(const RegionType & slabRegion, TFunction && function);
+
+  /** Updates the input, and the mask if any, for a region. */
+  void
+  UpdateInputs(const RegionType & region);
+
+  /** The offsets to the neighbor lines which precede a line in raster order. */
+  std::vector<OffsetType>
+  GetPreviousLineOffsets() const;
+
+  /** The number of slabs of the largest possible region, and the region of
+   * the slabs in [firstSlab, endSlab). */
+  SizeValueType
+  GetNumberOfSlabs(const RegionType & largestRegion) const;
+
+  static RegionType
+  SlabsRegion(const RegionType & largestRegion,
+              SizeValueType      numberOfSlabs,
+              SizeValueType      firstSlab,
+              SizeValueType      endSlab);
+
+  /** The slab of a slice, along the last axis. */
+  static SizeValueType
+  SlabOfSlice(const RegionType & largestRegion, SizeValueType numberOfSlabs, IndexValueType slice);
+
+  /** Run length encoding of a line of the input, masked by the mask image. */
+  void
+  EncodeLine(const IndexType & lineIndex, SizeValueType lineLength, LineEncodingType & line) const;
+
+  /** The first index of each line of a region, along the x axis. */
+  static ImageRegionIndexRange<ImageDimension>
+  LineStarts(const RegionType & region);
+
+  /** Position of a line in the lines of a region, along the x axis. */
+  static SizeValueType
+  LineIndex(const IndexType & index, const RegionType & region);
+
   OutputPixelType m_BackgroundValue{};
   LabelType       m_ObjectCount = 0;
 
   typename TInputImage::ConstPointer m_Input{};
+
+  unsigned int m_NumberOfStreamDivisions{ 1 };
+
+  /** The first component of each slab, and the output label of each
+   * component, from the streamed equivalence computation. The components
+   * are numbered from 1. */
+  std::vector<SizeValueType> m_SlabFirstComponents{};
+  UnionFindType              m_ComponentLabels{};
+  RegionType                 m_ComponentLabelsRegion{};
+  TimeStamp                  m_ComponentLabelsTime{};
 };
 } // end namespace itk
 
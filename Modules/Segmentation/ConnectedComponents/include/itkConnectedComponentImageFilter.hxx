@@ -26,6 +26,9 @@
 #include "itkConnectedComponentAlgorithm.h"
 #include "itkProgressTransformer.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage, typename TMaskImage>
@@ -65,7 +68,97 @@ template <typename TInputImage, typename TOutputImage, typename TMaskImage>
 void
 ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::EnlargeOutputRequestedRegion(DataObject *)
 {
-  this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+  OutputImageType * output = this->GetOutput();
+  RegionType        region = output->GetLargestPossibleRegion();
+  if (this->IsStreamed())
+  {
+    // whole slabs, along the last axis
+    const RegionType &   requestedRegion = output->GetRequestedRegion();
+    const IndexValueType firstSlice = requestedRegion.GetIndex(ImageDimension - 1);
+    const IndexValueType lastSlice =
+      firstSlice + static_cast<IndexValueType>(requestedRegion.GetSize(ImageDimension - 1)) - 1;
+    const SizeValueType numberOfSlabs = this->GetNumberOfSlabs(region);
+    region = SlabsRegion(region,
+                         numberOfSlabs,
+                         SlabOfSlice(region, numberOfSlabs, firstSlice),
+                         SlabOfSlice(region, numberOfSlabs, lastSlice) + 1);
+  }
+  output->SetRequestedRegion(region);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::PropagateRequestedRegion(DataObject * output)
+{
+  if (!this->IsStreamed())
+  {
+    Superclass::PropagateRequestedRegion(output);
+    return;
+  }
+
+  // check flag to avoid executing forever if there is a loop
+  if (this->m_Updating)
+  {
+    return;
+  }
+
+  // As in StreamingImageFilter, the requested regions of the inputs are
+  // managed when the filter is executed.
+  this->EnlargeOutputRequestedRegion(output);
+  this->GenerateOutputRequestedRegion(output);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::UpdateOutputData(DataObject * output)
+{
+  if (!this->IsStreamed())
+  {
+    Superclass::UpdateOutputData(output);
+    return;
+  }
+
+  // prevent chasing our tail
+  if (this->m_Updating)
+  {
+    return;
+  }
+
+  this->PrepareOutputs();
+  if (this->GetNumberOfValidRequiredInputs() < this->GetNumberOfRequiredInputs())
+  {
+    itkExceptionMacro("At least " << this->GetNumberOfRequiredInputs() << " inputs are required but only "
+                                  << this->GetNumberOfValidRequiredInputs() << " are specified.");
+  }
+
+  this->InvokeEvent(StartEvent());
+  this->SetAbortGenerateData(false);
+  this->UpdateProgress(0.0f);
+  this->m_Updating = true;
+
+  try
+  {
+    this->StreamedGenerateData();
+  }
+  catch (...)
+  {
+    this->ResetPipeline();
+    throw;
+  }
+
+  this->UpdateProgress(1.0f);
+  this->InvokeEvent(EndEvent());
+
+  // mark the data as up to date
+  for (auto & outputName : this->GetOutputNames())
+  {
+    if (this->ProcessObject::GetOutput(outputName))
+    {
+      this->ProcessObject::GetOutput(outputName)->DataHasBeenGenerated();
+    }
+  }
+  this->ReleaseInputs();
+  this->m_Updating = false;
 }
 
 template <typename TInputImage, typename TOutputImage, typename TMaskImage>
@@ -257,6 +350,480 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::ThreadedWr
   }
 }
 
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+SizeValueType
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::LineIndex(const IndexType &  index,
+                                                                                const RegionType & region)
+{
+  SizeValueType lineIndex = 0;
+  SizeValueType stride = 1;
+  for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+  {
+    lineIndex += static_cast<SizeValueType>(index[dim] - region.GetIndex(dim)) * stride;
+    stride *= region.GetSize(dim);
+  }
+  return lineIndex;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+auto
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::LineStarts(const RegionType & region)
+  -> ImageRegionIndexRange<ImageDimension>
+{
+  RegionType lineStarts = region;
+  lineStarts.SetSize(0, 1);
+  return ImageRegionIndexRange<ImageDimension>(lineStarts);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::EncodeLine(const IndexType & lineIndex,
+                                                                                 SizeValueType     lineLength,
+                                                                                 LineEncodingType & line) const
+{
+  const MaskImageType * mask = this->GetMaskImage();
+  SizeType              lineSize;
+  lineSize.Fill(1);
+  lineSize[0] = lineLength;
+  const RegionType lineRegion(lineIndex, lineSize);
+
+  ImageScanlineConstIterator<InputImageType> inLineIt(this->GetInput(), lineRegion);
+  ImageScanlineConstIterator<MaskImageType>  maskLineIt;
+  if (mask)
+  {
+    maskLineIt = ImageScanlineConstIterator<MaskImageType>(mask, lineRegion);
+  }
+  const auto isForeground = [&inLineIt, &maskLineIt, mask]() {
+    return inLineIt.Get() != InputPixelType{} && (!mask || maskLineIt.Get() != MaskPixelType{});
+  };
+  const auto next = [&inLineIt, &maskLineIt, mask]() {
+    ++inLineIt;
+    if (mask)
+    {
+      ++maskLineIt;
+    }
+  };
+
+  line.clear();
+  while (!inLineIt.IsAtEndOfLine())
+  {
+    if (isForeground())
+    {
+      // We've hit the start of a run
+      const IndexType thisIndex = inLineIt.GetIndex();
+      SizeValueType   length = 1;
+      next();
+      while (!inLineIt.IsAtEndOfLine() && isForeground())
+      {
+        ++length;
+        next();
+      }
+      line.push_back(RunLength(length, thisIndex));
+    }
+    else
+    {
+      next();
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::UpdateInputs(const RegionType & region)
+{
+  // as StreamingImageFilter does for each of its pieces
+  auto * input = const_cast<InputImageType *>(this->GetInput());
+  input->SetRequestedRegion(region);
+  input->PropagateRequestedRegion();
+  input->UpdateOutputData();
+
+  auto * mask = const_cast<MaskImageType *>(this->GetMaskImage());
+  if (mask)
+  {
+    mask->SetRequestedRegion(region);
+    mask->PropagateRequestedRegion();
+    mask->UpdateOutputData();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+auto
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::GetPreviousLineOffsets() const
+  -> std::vector<OffsetType>
+{
+  std::vector<OffsetType> lineOffsets;
+  OffsetType              lineOffset;
+  lineOffset.Fill(-1);
+  lineOffset[0] = 0;
+  for (;;)
+  {
+    unsigned int numberOfAxes = 0;
+    int          lastStep = 0;
+    for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+    {
+      if (lineOffset[dim] != 0)
+      {
+        ++numberOfAxes;
+        lastStep = lineOffset[dim];
+      }
+    }
+    if (lastStep < 0 && (this->m_FullyConnected || numberOfAxes == 1))
+    {
+      lineOffsets.push_back(lineOffset);
+    }
+    unsigned int dim = 1;
+    while (dim < ImageDimension && lineOffset[dim] == 1)
+    {
+      lineOffset[dim++] = -1;
+    }
+    if (dim == ImageDimension)
+    {
+      break;
+    }
+    ++lineOffset[dim];
+  }
+  return lineOffsets;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+SizeValueType
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::GetNumberOfSlabs(
+  const RegionType & largestRegion) const
+{
+  return std::min<SizeValueType>(m_NumberOfStreamDivisions, largestRegion.GetSize(ImageDimension - 1));
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+auto
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::SlabsRegion(const RegionType & largestRegion,
+                                                                                  SizeValueType      numberOfSlabs,
+                                                                                  SizeValueType      firstSlab,
+                                                                                  SizeValueType endSlab) -> RegionType
+{
+  constexpr unsigned int SlabAxis = ImageDimension - 1;
+  const SizeValueType    numberOfSlices = largestRegion.GetSize(SlabAxis);
+  const SizeValueType    firstSlice = numberOfSlices * firstSlab / numberOfSlabs;
+  RegionType             region = largestRegion;
+  region.SetIndex(SlabAxis, largestRegion.GetIndex(SlabAxis) + static_cast<IndexValueType>(firstSlice));
+  region.SetSize(SlabAxis, numberOfSlices * endSlab / numberOfSlabs - firstSlice);
+  return region;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+SizeValueType
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::SlabOfSlice(const RegionType & largestRegion,
+                                                                                  SizeValueType      numberOfSlabs,
+                                                                                  IndexValueType     slice)
+{
+  // the last slab whose first slice, numberOfSlices * slab / numberOfSlabs,
+  // is not after the slice
+  constexpr unsigned int SlabAxis = ImageDimension - 1;
+  const auto             position = static_cast<SizeValueType>(slice - largestRegion.GetIndex(SlabAxis));
+  return ((position + 1) * numberOfSlabs - 1) / largestRegion.GetSize(SlabAxis);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+template <typename TFunction>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::ParallelizeSlab(const RegionType & slabRegion,
+                                                                                      TFunction &&       function)
+{
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  const ThreadIdType  numberOfWorkUnits = multiThreader->GetNumberOfWorkUnits();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  try
+  {
+    multiThreader->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+      0, slabRegion, std::forward<TFunction>(function), nullptr);
+  }
+  catch (...)
+  {
+    multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+    throw;
+  }
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+SizeValueType
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::LabelSlabRuns(const RegionType & slabRegion,
+                                                                                    LineMapType &      slabLines)
+{
+  this->UpdateInputs(slabRegion);
+
+  slabLines.assign(slabRegion.GetNumberOfPixels() / slabRegion.GetSize(0), LineEncodingType());
+  this->ParallelizeSlab(slabRegion, [this, &slabRegion, &slabLines](const RegionType & region) {
+    for (const IndexType & lineIndex : LineStarts(region))
+    {
+      this->EncodeLine(lineIndex, region.GetSize(0), slabLines[LineIndex(lineIndex, slabRegion)]);
+    }
+  });
+
+  // the runs are numbered in raster order, from 1, in a union-find table
+  // local to the slab
+  UnionFindType & unionFind = this->m_UnionFind;
+  unionFind.assign(1, 0);
+  for (auto & line : slabLines)
+  {
+    for (auto & run : line)
+    {
+      run.label = static_cast<InternalLabelType>(unionFind.size());
+      unionFind.push_back(run.label);
+    }
+  }
+
+  // link the runs to the ones of the previous lines of the slab
+  const std::vector<OffsetType> lineOffsets = this->GetPreviousLineOffsets();
+  for (auto & line : slabLines)
+  {
+    if (line.empty())
+    {
+      continue;
+    }
+    for (const OffsetType & offset : lineOffsets)
+    {
+      const IndexType neighborIndex = line[0].where + offset;
+      if (!slabRegion.IsInside(neighborIndex))
+      {
+        continue;
+      }
+      const LineEncodingType & neighbor = slabLines[LineIndex(neighborIndex, slabRegion)];
+      if (!neighbor.empty())
+      {
+        this->CompareLines(line,
+                           neighbor,
+                           false,
+                           false,
+                           0,
+                           [this](const LineEncodingConstIterator & currentRun,
+                                  const LineEncodingConstIterator & neighborRun,
+                                  OffsetValueType,
+                                  OffsetValueType) { this->LinkLabels(neighborRun->label, currentRun->label); });
+      }
+    }
+  }
+
+  // The parent of a run is always a previous run, so a single pass in
+  // raster order replaces each run by the component of its set.
+  SizeValueType numberOfComponents = 0;
+  for (auto & line : slabLines)
+  {
+    for (auto & run : line)
+    {
+      const InternalLabelType parent = unionFind[run.label];
+      unionFind[run.label] =
+        parent == run.label ? static_cast<InternalLabelType>(numberOfComponents++) : unionFind[parent];
+      run.label = unionFind[run.label];
+    }
+  }
+  UnionFindType().swap(unionFind);
+  return numberOfComponents;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::ComputeStreamedComponentLabels()
+{
+  const RegionType       largestRegion = this->GetOutput()->GetLargestPossibleRegion();
+  constexpr unsigned int SlabAxis = ImageDimension - 1;
+  const SizeValueType    numberOfSlabs = this->GetNumberOfSlabs(largestRegion);
+  const SizeValueType    linesPerSlice =
+    largestRegion.GetNumberOfPixels() / largestRegion.GetSize(0) / largestRegion.GetSize(SlabAxis);
+
+  // the components of all the slabs, numbered from 1
+  UnionFindType & componentLabels = m_ComponentLabels;
+  componentLabels.assign(1, 0);
+  m_SlabFirstComponents.assign(1, 1);
+  const auto findRoot = [&componentLabels](InternalLabelType label) {
+    while (label != componentLabels[label])
+    {
+      label = componentLabels[label];
+    }
+    return label;
+  };
+
+  // the offsets to the lines of the previous slice
+  std::vector<OffsetType> sliceOffsets;
+  for (const OffsetType & offset : this->GetPreviousLineOffsets())
+  {
+    if (offset[SlabAxis] != 0)
+    {
+      sliceOffsets.push_back(offset);
+    }
+  }
+
+  LineMapType border;
+  RegionType  borderRegion;
+  LineMapType slabLines;
+  for (SizeValueType slab = 0; slab < numberOfSlabs; ++slab)
+  {
+    const RegionType    slabRegion = SlabsRegion(largestRegion, numberOfSlabs, slab, slab + 1);
+    const SizeValueType numberOfComponents = this->LabelSlabRuns(slabRegion, slabLines);
+    const auto          firstComponent = static_cast<InternalLabelType>(componentLabels.size());
+    for (SizeValueType component = 0; component < numberOfComponents; ++component)
+    {
+      componentLabels.push_back(static_cast<InternalLabelType>(firstComponent + component));
+    }
+    m_SlabFirstComponents.push_back(componentLabels.size());
+    for (auto & line : slabLines)
+    {
+      for (auto & run : line)
+      {
+        run.label += firstComponent;
+      }
+    }
+
+    // link the components of the first slice to the ones of the last
+    // slice of the previous slab
+    for (SizeValueType line = 0; slab > 0 && line < linesPerSlice; ++line)
+    {
+      if (slabLines[line].empty())
+      {
+        continue;
+      }
+      for (const OffsetType & offset : sliceOffsets)
+      {
+        const IndexType neighborIndex = slabLines[line][0].where + offset;
+        if (!borderRegion.IsInside(neighborIndex))
+        {
+          continue;
+        }
+        const LineEncodingType & neighbor = border[LineIndex(neighborIndex, borderRegion)];
+        if (!neighbor.empty())
+        {
+          this->CompareLines(slabLines[line],
+                             neighbor,
+                             false,
+                             false,
+                             0,
+                             [&componentLabels, &findRoot](const LineEncodingConstIterator & currentRun,
+                                                           const LineEncodingConstIterator & neighborRun,
+                                                           OffsetValueType,
+                                                           OffsetValueType) {
+                               const InternalLabelType root1 = findRoot(neighborRun->label);
+                               const InternalLabelType root2 = findRoot(currentRun->label);
+                               componentLabels[std::max(root1, root2)] = std::min(root1, root2);
+                             });
+        }
+      }
+    }
+
+    // keep only the last slice for the next slab
+    border.assign(std::make_move_iterator(slabLines.end() - static_cast<OffsetValueType>(linesPerSlice)),
+                  std::make_move_iterator(slabLines.end()));
+    borderRegion = slabRegion;
+    borderRegion.SetIndex(SlabAxis, slabRegion.GetIndex(SlabAxis) + slabRegion.GetSize(SlabAxis) - 1);
+    borderRegion.SetSize(SlabAxis, 1);
+    this->UpdateProgress(0.5f * static_cast<float>(slab + 1) / static_cast<float>(numberOfSlabs));
+  }
+  LineMapType().swap(border);
+  LineMapType().swap(slabLines);
+
+  // The parent of a component is always a previous component, so a single
+  // pass replaces each component by the consecutive label of its set.
+  OutputPixelType consecutiveLabel = 0;
+  SizeValueType   numberOfObjects = 0;
+  componentLabels[0] = static_cast<InternalLabelType>(m_BackgroundValue);
+  for (SizeValueType component = 1; component < componentLabels.size(); ++component)
+  {
+    const InternalLabelType parent = componentLabels[component];
+    if (parent == component)
+    {
+      if (consecutiveLabel == m_BackgroundValue)
+      {
+        ++consecutiveLabel;
+      }
+      componentLabels[component] = static_cast<InternalLabelType>(consecutiveLabel);
+      ++consecutiveLabel;
+      ++numberOfObjects;
+    }
+    else
+    {
+      componentLabels[component] = componentLabels[parent];
+    }
+  }
+  // check for overflow exception here
+  if (numberOfObjects > static_cast<SizeValueType>(NumericTraits<OutputPixelType>::max()))
+  {
+    itkExceptionMacro("Number of objects (" << numberOfObjects << ") greater than maximum of output pixel type ("
+                                            << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(
+                                                 NumericTraits<OutputPixelType>::max())
+                                            << ").");
+  }
+  m_ObjectCount = numberOfObjects;
+  m_ComponentLabelsRegion = largestRegion;
+  m_ComponentLabelsTime.Modified();
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::StreamedGenerateData()
+{
+  // The component labels are computed again if the filter or the upstream
+  // pipeline have been modified. The modified time of a generated input
+  // changes with its buffered region, so the pipeline modified time is
+  // used for it.
+  ModifiedTimeType mtime = this->GetMTime();
+  for (const DataObject * input : { static_cast<const DataObject *>(this->GetInput()),
+                                    static_cast<const DataObject *>(this->GetMaskImage()) })
+  {
+    if (input)
+    {
+      mtime = std::max(mtime, input->GetSource() ? input->GetPipelineMTime() : input->GetMTime());
+    }
+  }
+  const RegionType largestRegion = this->GetOutput()->GetLargestPossibleRegion();
+  if (m_ComponentLabelsTime.GetMTime() < mtime || m_ComponentLabelsRegion != largestRegion)
+  {
+    this->ComputeStreamedComponentLabels();
+  }
+
+  this->AllocateOutputs();
+
+  // label the slabs of the requested region, which has been enlarged to
+  // whole slabs
+  OutputImageType *      output = this->GetOutput();
+  const RegionType &     requestedRegion = output->GetRequestedRegion();
+  constexpr unsigned int SlabAxis = ImageDimension - 1;
+  const SizeValueType    numberOfSlabs = m_SlabFirstComponents.size() - 1;
+  const SizeValueType    firstSlab = SlabOfSlice(largestRegion, numberOfSlabs, requestedRegion.GetIndex(SlabAxis));
+  const SizeValueType    endSlab = SlabOfSlice(largestRegion,
+                                            numberOfSlabs,
+                                            requestedRegion.GetIndex(SlabAxis) +
+                                              static_cast<IndexValueType>(requestedRegion.GetSize(SlabAxis)) - 1) +
+                                1;
+  LineMapType slabLines;
+  for (SizeValueType slab = firstSlab; slab < endSlab; ++slab)
+  {
+    const RegionType    slabRegion = SlabsRegion(largestRegion, numberOfSlabs, slab, slab + 1);
+    const SizeValueType firstComponent = m_SlabFirstComponents[slab];
+    if (this->LabelSlabRuns(slabRegion, slabLines) != m_SlabFirstComponents[slab + 1] - firstComponent)
+    {
+      itkExceptionMacro("The input has changed since the labels were computed.");
+    }
+
+    this->ParallelizeSlab(
+      slabRegion, [this, output, firstComponent, &slabRegion, &slabLines](const RegionType & region) {
+        for (const IndexType & lineIndex : LineStarts(region))
+        {
+          OutputPixelType * outLine = output->GetBufferPointer() + output->ComputeOffset(lineIndex);
+          OutputPixelType * outLineEnd = outLine + region.GetSize(0);
+          IndexValueType    x = lineIndex[0];
+          for (const RunLength & run : slabLines[LineIndex(lineIndex, slabRegion)])
+          {
+            outLine = std::fill_n(outLine, run.where[0] - x, m_BackgroundValue);
+            outLine = std::fill_n(
+              outLine, run.length, static_cast<OutputPixelType>(m_ComponentLabels[firstComponent + run.label]));
+            x = run.where[0] + static_cast<IndexValueType>(run.length);
+          }
+          std::fill(outLine, outLineEnd, m_BackgroundValue);
+        }
+      });
+    this->UpdateProgress(0.5f + 0.5f * static_cast<float>(slab + 1 - firstSlab) /
+                                  static_cast<float>(endSlab - firstSlab));
+  }
+}
+
 template <typename TInputImage, typename TOutputImage, typename TMaskImage>
 void
 ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -264,6 +831,7 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::PrintSelf(
   Superclass::PrintSelf(os, indent);
 
   os << indent << "ObjectCount: " << m_ObjectCount << std::endl;
+  os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
 }
 } // end namespace itk
 
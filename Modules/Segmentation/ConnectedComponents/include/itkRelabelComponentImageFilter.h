@@ -68,6 +68,22 @@ namespace itk
  * controlled via methods in the superclass,
  * InPlaceImageFilter::InPlaceOn() and InPlaceImageFilter::InPlaceOff().
  *
+ * By default the filter needs the whole input. When NumberOfStreamDivisions
+ * is greater than 1, the filter updates its input itself, as
+ * StreamingImageFilter does, so that it can be streamed. The first update
+ * streams the whole input in NumberOfStreamDivisions slabs along the last
+ * axis to count the object sizes. The input is then updated for the output
+ * requested region, which is relabeled with the sizes until the input or the
+ * filter is modified.
+ *
+ * When streamed in place, the slabs read to count the sizes are never
+ * modified. The input is relabeled in place only when its buffered region
+ * is the output requested region; it is not, for instance, when the input
+ * is a streamed ConnectedComponentImageFilter, which enlarges its requested
+ * regions to whole slabs, and the output is then allocated. A relabeled
+ * input is released, so the upstream pipeline generates it again for the
+ * next requested region.
+ *
  * \sa ConnectedComponentImageFilter, BinaryThresholdImageFilter, ThresholdImageFilter
  *
  * \ingroup SingleThreaded
@@ -177,6 +193,12 @@ public:
   itkGetConstMacro(SortByObjectSize, bool);
   itkBooleanMacro(SortByObjectSize);
 
+  /** Set/Get the number of slabs in which the input is streamed to count
+   * the object sizes. With the default value of 1, the whole input is
+   * requested and processed at once. */
+  itkSetClampMacro(NumberOfStreamDivisions, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfStreamDivisions, unsigned int);
+
   /** Get the size of each object in pixels. This information is only
    * valid after the filter has executed.  Size of the background is
    * not calculated.  Size of object #1 is
@@ -260,6 +282,16 @@ protected:
   void
   GenerateInputRequestedRegion() override;
 
+  /** When streamed, the requested region is not propagated to the input,
+   * since UpdateOutputData() updates the input. */
+  void
+  PropagateRequestedRegion(DataObject * output) override;
+
+  /** When streamed, updates the input slab by slab to count the object
+   * sizes, then for the output requested region to relabel it. */
+  void
+  UpdateOutputData(DataObject * output) override;
+
   /** Standard printself method */
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
@@ -277,17 +309,36 @@ protected:
   };
 
 private:
+  /** Streamed relabeling, used when there are several stream divisions. */
+  void
+  StreamedGenerateData();
+
+  /** Computes the relabeling and the object sizes from the size map. */
+  void
+  ComputeRelabelMap();
+
+  /** Allocates the output, and relabels the output requested region of
+   * the input. */
+  void
+  RelabelOutput();
+
   SizeValueType  m_NumberOfObjects{ 0 };
   SizeValueType  m_NumberOfObjectsToPrint{ 10 };
   SizeValueType  m_OriginalNumberOfObjects{ 0 };
   ObjectSizeType m_MinimumObjectSize{ 0 };
   bool           m_SortByObjectSize{ true };
+  unsigned int   m_NumberOfStreamDivisions{ 1 };
 
   std::mutex m_Mutex{};
 
   using MapType = std::map<LabelType, RelabelComponentObjectType>;
   MapType m_SizeMap{};
 
+  /** A map from the input pixel labels to the output labels */
+  using RelabelMapType = std::map<LabelType, OutputPixelType>;
+  RelabelMapType m_RelabelMap{};
+  TimeStamp      m_RelabelMapTime{};
+
   ObjectSizeInPixelsContainerType        m_SizeOfObjectsInPixels{};
   ObjectSizeInPhysicalUnitsContainerType m_SizeOfObjectsInPhysicalUnits{};
 };
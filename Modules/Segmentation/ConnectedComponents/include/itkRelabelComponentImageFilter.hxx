@@ -23,6 +23,7 @@
 #include "itkProgressReporter.h"
 #include "itkProgressTransformer.h"
 #include "itkImageScanlineIterator.h"
+#include <algorithm>
 #include <map>
 #include <utility>
 #include "itkTotalProgressReporter.h"
@@ -122,27 +123,206 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::ParallelComputeLabels(co
 
 template <typename TInputImage, typename TOutputImage>
 void
-RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
+RelabelComponentImageFilter<TInputImage, TOutputImage>::PropagateRequestedRegion(DataObject * output)
 {
-  using LabelComponentPairType = std::pair<LabelType, RelabelComponentObjectType>;
+  if (m_NumberOfStreamDivisions == 1)
+  {
+    Superclass::PropagateRequestedRegion(output);
+    return;
+  }
 
-  // Get the input and the output
-  const TInputImage * input = this->GetInput();
-  TOutputImage *      output = this->GetOutput();
+  // check flag to avoid executing forever if there is a loop
+  if (this->m_Updating)
+  {
+    return;
+  }
 
-  // Calculate the size of pixel
-  float physicalPixelSize = 1.0;
-  for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+  // As in StreamingImageFilter, the requested region of the input is
+  // managed when the filter is executed.
+  this->EnlargeOutputRequestedRegion(output);
+  this->GenerateOutputRequestedRegion(output);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RelabelComponentImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * output)
+{
+  if (m_NumberOfStreamDivisions == 1)
+  {
+    Superclass::UpdateOutputData(output);
+    return;
+  }
+
+  // prevent chasing our tail
+  if (this->m_Updating)
+  {
+    return;
+  }
+
+  this->PrepareOutputs();
+  if (this->GetNumberOfValidRequiredInputs() < this->GetNumberOfRequiredInputs())
   {
-    physicalPixelSize *= input->GetSpacing()[i];
+    itkExceptionMacro("At least " << this->GetNumberOfRequiredInputs() << " inputs are required but only "
+                                  << this->GetNumberOfValidRequiredInputs() << " are specified.");
   }
 
+  this->InvokeEvent(StartEvent());
+  this->SetAbortGenerateData(false);
+  this->UpdateProgress(0.0f);
+  this->m_Updating = true;
+
+  try
+  {
+    this->StreamedGenerateData();
+  }
+  catch (...)
+  {
+    this->ResetPipeline();
+    throw;
+  }
+
+  this->UpdateProgress(1.0f);
+  this->InvokeEvent(EndEvent());
+
+  // mark the data as up to date
+  for (auto & outputName : this->GetOutputNames())
+  {
+    if (this->ProcessObject::GetOutput(outputName))
+    {
+      this->ProcessObject::GetOutput(outputName)->DataHasBeenGenerated();
+    }
+  }
+  this->ReleaseInputs();
+  this->m_Updating = false;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  // Discard the counts of a previous update which was aborted, or which threw.
+  m_SizeMap.clear();
+
   // Walk the entire input image and compute used labels and the number of each label.
   this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
-    input->GetRequestedRegion(),
+    this->GetInput()->GetRequestedRegion(),
     [this](const RegionType & inputRegion) { this->ParallelComputeLabels(inputRegion); },
     nullptr);
+  this->ComputeRelabelMap();
+
+  this->RelabelOutput();
+  RelabelMapType().swap(m_RelabelMap);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RelabelComponentImageFilter<TInputImage, TOutputImage>::StreamedGenerateData()
+{
+  // Discard the counts of a previous update which was aborted, or which threw.
+  m_SizeMap.clear();
+
+  auto * input = const_cast<TInputImage *>(this->GetInput());
+
+  // The modified time of a generated input changes with its buffered
+  // region, so the pipeline modified time is used for it.
+  if (m_RelabelMapTime.GetMTime() < this->GetMTime() ||
+      m_RelabelMapTime.GetMTime() < (input->GetSource() ? input->GetPipelineMTime() : input->GetMTime()))
+  {
+    // Stream the input in slabs along the last axis to compute the used
+    // labels and the number of each label.
+    const RegionType    largestRegion = input->GetLargestPossibleRegion();
+    constexpr auto      SlabAxis = ImageDimension - 1;
+    const SizeValueType numberOfSlices = largestRegion.GetSize(SlabAxis);
+    const SizeValueType numberOfSlabs = std::min<SizeValueType>(m_NumberOfStreamDivisions, numberOfSlices);
+    for (SizeValueType slab = 0; slab < numberOfSlabs; ++slab)
+    {
+      const SizeValueType firstSlice = numberOfSlices * slab / numberOfSlabs;
+      RegionType          slabRegion = largestRegion;
+      slabRegion.SetIndex(SlabAxis, largestRegion.GetIndex(SlabAxis) + static_cast<IndexValueType>(firstSlice));
+      slabRegion.SetSize(SlabAxis, numberOfSlices * (slab + 1) / numberOfSlabs - firstSlice);
+      input->SetRequestedRegion(slabRegion);
+      input->PropagateRequestedRegion();
+      input->UpdateOutputData();
+
+      this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+        slabRegion, [this](const RegionType & inputRegion) { this->ParallelComputeLabels(inputRegion); }, nullptr);
+    }
+    this->ComputeRelabelMap();
+    m_RelabelMapTime.Modified();
+  }
+
+  // Update the input for the output requested region, which is relabeled
+  // in place when the input buffer is that region.
+  input->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
+  input->PropagateRequestedRegion();
+  input->UpdateOutputData();
 
+  this->RelabelOutput();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RelabelComponentImageFilter<TInputImage, TOutputImage>::RelabelOutput()
+{
+  // Second pass: walk just the output requested region and relabel
+  // the necessary pixels.
+  //
+
+  // Allocate the output
+  this->AllocateOutputs();
+
+  // In parallel apply the relabeling map
+  const RelabelMapType & relabelMap = m_RelabelMap;
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    this->GetOutput()->GetRequestedRegion(),
+    [this, &relabelMap](const RegionType & outputRegionForThread) {
+      auto                  outputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+      TotalProgressReporter report(this, outputRequestedRegion.GetNumberOfPixels(), 100, 0.5f);
+
+      ImageScanlineIterator      oit(this->GetOutput(), outputRegionForThread);
+      ImageScanlineConstIterator it(this->GetInput(), outputRegionForThread);
+
+      auto mapIt = relabelMap.cbegin();
+
+      while (!oit.IsAtEnd())
+      {
+        while (!oit.IsAtEndOfLine())
+        {
+          const auto && inputValue = it.Get();
+
+          if (mapIt->first != inputValue)
+          {
+            mapIt = relabelMap.find(inputValue);
+          }
+
+          // no new labels should be encountered in the input
+          assert(mapIt != relabelMap.cend());
+
+          oit.Set(mapIt->second);
+
+          ++oit;
+          ++it;
+        }
+        report.Completed(outputRequestedRegion.GetSize(0));
+        oit.NextLine();
+        it.NextLine();
+      }
+    },
+    nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RelabelComponentImageFilter<TInputImage, TOutputImage>::ComputeRelabelMap()
+{
+  using LabelComponentPairType = std::pair<LabelType, RelabelComponentObjectType>;
+
+  // Calculate the size of pixel
+  float physicalPixelSize = 1.0;
+  for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+  {
+    physicalPixelSize *= this->GetInput()->GetSpacing()[i];
+  }
 
   // Construct an array of the label, component information pair to sort
   auto sizeVector = std::vector<LabelComponentPairType>(m_SizeMap.begin(), m_SizeMap.end());
@@ -164,8 +344,8 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
 
 
   // A map from the input pixel labels to the output labels
-  using RelabelMapType = std::map<LabelType, OutputPixelType>;
-  RelabelMapType relabelMap;
+  RelabelMapType & relabelMap = m_RelabelMap;
+  relabelMap.clear();
 
   // create a lookup table to map the input label to the output label.
   // cache the object sizes for later access by the user
@@ -218,51 +398,6 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   // After the objects stats are computed add in the background label so the relabelMap can be directly applied.
   relabelMap.insert({ LabelType{}, OutputPixelType{} });
-
-  // Second pass: walk just the output requested region and relabel
-  // the necessary pixels.
-  //
-
-  // Allocate the output
-  this->AllocateOutputs();
-
-  // In parallel apply the relabeling map
-  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
-    output->GetRequestedRegion(),
-    [this, &relabelMap](const RegionType & outputRegionForThread) {
-      auto                  outputRequestedRegion = this->GetOutput()->GetRequestedRegion();
-      TotalProgressReporter report(this, outputRequestedRegion.GetNumberOfPixels(), 100, 0.5f);
-
-      ImageScanlineIterator      oit(this->GetOutput(), outputRegionForThread);
-      ImageScanlineConstIterator it(this->GetInput(), outputRegionForThread);
-
-      auto mapIt = relabelMap.cbegin();
-
-      while (!oit.IsAtEnd())
-      {
-        while (!oit.IsAtEndOfLine())
-        {
-          const auto && inputValue = it.Get();
-
-          if (mapIt->first != inputValue)
-          {
-            mapIt = relabelMap.find(inputValue);
-          }
-
-          // no new labels should be encountered in the input
-          assert(mapIt != relabelMap.cend());
-
-          oit.Set(mapIt->second);
-
-          ++oit;
-          ++it;
-        }
-        report.Completed(outputRequestedRegion.GetSize(0));
-        oit.NextLine();
-        it.NextLine();
-      }
-    },
-    nullptr);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -276,6 +411,7 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream &
   os << indent << "NumberOfObjectsToPrint: " << m_NumberOfObjectsToPrint << std::endl;
   os << indent << "MinimumObjectSizes: " << m_MinimumObjectSize << std::endl;
   os << indent << "SortByObjectSize: " << m_SortByObjectSize << std::endl;
+  os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
 
   typename ObjectSizeInPixelsContainerType::const_iterator it;
   ObjectSizeInPhysicalUnitsContainerType::const_iterator   fit;
@@ -0,0 +1,192 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConnectedComponentImageFilter.h"
+#include "itkRelabelComponentImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+template <typename TImage>
+typename TImage::Pointer
+CreateRandomBinaryImage(const typename TImage::SizeType & size, double foregroundProbability, unsigned int seed)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(seed);
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(generator->GetVariateWithClosedRange() < foregroundProbability ? 1 : 0);
+  }
+  return image;
+}
+
+template <typename TImage>
+bool
+ImagesAreEqual(const TImage * image1, const TImage * image2)
+{
+  for (itk::ImageRegionConstIterator<TImage> it1(image1, image1->GetLargestPossibleRegion()),
+       it2(image2, image1->GetLargestPossibleRegion());
+       !it1.IsAtEnd();
+       ++it1, ++it2)
+  {
+    if (it1.Get() != it2.Get())
+    {
+      std::cerr << "Different labels at " << it1.GetIndex() << ": " << it1.Get() << " != " << it2.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The labels and the object sizes computed by streaming must be the same as
+// the ones computed on the whole image.
+template <unsigned int VDimension>
+int
+TestStreaming(const typename itk::Image<unsigned char, VDimension>::SizeType & size, bool fullyConnected, bool useMask)
+{
+  using InputImageType = itk::Image<unsigned char, VDimension>;
+  using LabelImageType = itk::Image<unsigned int, VDimension>;
+  using FilterType = itk::ConnectedComponentImageFilter<InputImageType, LabelImageType, InputImageType>;
+  using RelabelType = itk::RelabelComponentImageFilter<LabelImageType, LabelImageType>;
+  using StreamerType = itk::StreamingImageFilter<LabelImageType, LabelImageType>;
+
+  std::cout << "Dimension: " << VDimension << ", FullyConnected: " << fullyConnected << ", Mask: " << useMask
+            << std::endl;
+
+  const auto input = CreateRandomBinaryImage<InputImageType>(size, 0.55, 42);
+  const auto mask = CreateRandomBinaryImage<InputImageType>(size, 0.9, 7);
+
+  auto filter = FilterType::New();
+  filter->SetInput(input);
+  filter->SetFullyConnected(fullyConnected);
+  if (useMask)
+  {
+    filter->SetMaskImage(mask);
+  }
+  auto relabel = RelabelType::New();
+  relabel->SetInput(filter->GetOutput());
+  relabel->SetMinimumObjectSize(3);
+  ITK_TRY_EXPECT_NO_EXCEPTION(relabel->Update());
+  const typename LabelImageType::Pointer expectedLabels = filter->GetOutput();
+  expectedLabels->DisconnectPipeline();
+  const typename LabelImageType::Pointer expectedRelabels = relabel->GetOutput();
+  expectedRelabels->DisconnectPipeline();
+  const itk::SizeValueType expectedObjectCount = filter->GetObjectCount();
+  const auto               expectedSizes = relabel->GetSizeOfObjectsInPixels();
+
+  // the input is generated slab by slab through the pipeline
+  using CastType = itk::CastImageFilter<InputImageType, InputImageType>;
+  auto cast = CastType::New();
+  cast->SetInput(input);
+
+  auto streamedFilter = FilterType::New();
+  streamedFilter->SetInput(cast->GetOutput());
+  streamedFilter->SetFullyConnected(fullyConnected);
+  if (useMask)
+  {
+    streamedFilter->SetMaskImage(mask);
+  }
+  streamedFilter->SetNumberOfStreamDivisions(5);
+  ITK_TEST_SET_GET_VALUE(5, streamedFilter->GetNumberOfStreamDivisions());
+  streamedFilter->SetNumberOfWorkUnits(2);
+  streamedFilter->GetMultiThreader()->SetNumberOfWorkUnits(3);
+
+  auto labelStreamer = StreamerType::New();
+  labelStreamer->SetInput(streamedFilter->GetOutput());
+  labelStreamer->SetNumberOfStreamDivisions(3);
+  ITK_TRY_EXPECT_NO_EXCEPTION(labelStreamer->Update());
+  // the slabs are labeled with the work units of the filter, and the work
+  // units of its multi-threader are restored afterwards
+  ITK_TEST_EXPECT_EQUAL(streamedFilter->GetMultiThreader()->GetNumberOfWorkUnits(), 3);
+  ITK_TEST_EXPECT_EQUAL(streamedFilter->GetObjectCount(), expectedObjectCount);
+  ITK_TEST_EXPECT_TRUE(ImagesAreEqual<LabelImageType>(labelStreamer->GetOutput(), expectedLabels));
+  ITK_TEST_EXPECT_TRUE(cast->GetOutput()->GetBufferedRegion().GetSize(VDimension - 1) < size[VDimension - 1] / 2);
+
+  auto streamedRelabel = RelabelType::New();
+  streamedRelabel->SetInput(streamedFilter->GetOutput());
+  streamedRelabel->SetMinimumObjectSize(3);
+  streamedRelabel->SetNumberOfStreamDivisions(4);
+  ITK_TEST_SET_GET_VALUE(4, streamedRelabel->GetNumberOfStreamDivisions());
+
+  auto relabelStreamer = StreamerType::New();
+  relabelStreamer->SetInput(streamedRelabel->GetOutput());
+  relabelStreamer->SetNumberOfStreamDivisions(6);
+  ITK_TRY_EXPECT_NO_EXCEPTION(relabelStreamer->Update());
+  ITK_TEST_EXPECT_EQUAL(streamedRelabel->GetNumberOfObjects(), relabel->GetNumberOfObjects());
+  ITK_TEST_EXPECT_TRUE(streamedRelabel->GetSizeOfObjectsInPixels() == expectedSizes);
+  ITK_TEST_EXPECT_TRUE(ImagesAreEqual<LabelImageType>(relabelStreamer->GetOutput(), expectedRelabels));
+
+  // in place: the pieces which are not whole slabs of the labels are
+  // relabeled out of place, and the whole image in place, which releases
+  // the labels
+  streamedRelabel->InPlaceOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(relabelStreamer->Update());
+  ITK_TEST_EXPECT_TRUE(ImagesAreEqual<LabelImageType>(relabelStreamer->GetOutput(), expectedRelabels));
+  relabelStreamer->SetNumberOfStreamDivisions(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(relabelStreamer->Update());
+  ITK_TEST_EXPECT_TRUE(ImagesAreEqual<LabelImageType>(relabelStreamer->GetOutput(), expectedRelabels));
+  ITK_TEST_EXPECT_EQUAL(streamedFilter->GetOutput()->GetBufferedRegion().GetNumberOfPixels(), 0);
+  ITK_TEST_EXPECT_TRUE(streamedRelabel->GetSizeOfObjectsInPixels() == expectedSizes);
+
+  // an input changed without being marked as modified is detected
+  input->FillBuffer(0);
+  labelStreamer->Modified();
+  ITK_TRY_EXPECT_EXCEPTION(labelStreamer->Update());
+
+  // a modified input is labeled again
+  labelStreamer->ResetPipeline();
+  input->Modified();
+  cast->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(labelStreamer->Update());
+  ITK_TEST_EXPECT_EQUAL(streamedFilter->GetObjectCount(), 0);
+
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkConnectedComponentImageFilterStreamingTest(int, char *[])
+{
+  int result = EXIT_SUCCESS;
+  for (const bool fullyConnected : { false, true })
+  {
+    for (const bool useMask : { false, true })
+    {
+      if (TestStreaming<2>({ { 97, 61 } }, fullyConnected, useMask) == EXIT_FAILURE)
+      {
+        result = EXIT_FAILURE;
+      }
+      if (TestStreaming<3>({ { 23, 17, 31 } }, fullyConnected, useMask) == EXIT_FAILURE)
+      {
+        result = EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
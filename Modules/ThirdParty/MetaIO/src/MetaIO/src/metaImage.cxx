@@ -1725,6 +1725,28 @@ MetaImage::WriteStream(METAIO_STREAM::ofstream * _stream, bool _writeElements, c
   return writeResult;
 }
 
+bool
+MetaImage::WriteCompressedHeaderStream(METAIO_STREAM::ofstream * _stream, std::streamoff _compressedDataSize)
+{
+  if (m_WriteStream != nullptr)
+  {
+    std::cerr << "MetaImage: WriteCompressedHeaderStream: two files open?" << '\n';
+    delete m_WriteStream;
+  }
+
+  m_WriteStream = _stream;
+  m_CompressedData = true;
+  m_CompressedDataSize = _compressedDataSize;
+
+  M_SetupWriteFields();
+  const bool result = M_Write();
+
+  m_WriteStream = nullptr;
+  m_CompressedDataSize = 0;
+
+  return result;
+}
+
 
 /** Write a portion of an image */
 bool
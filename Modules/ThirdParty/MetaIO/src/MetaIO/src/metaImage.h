@@ -398,6 +398,12 @@ public:
   bool
   WriteStream(METAIO_STREAM::ofstream * _stream, bool _writeElements = true, const void * _constElementData = nullptr);
 
+  // Writes only the header of compressed element data to the stream, with
+  // the given compressed size. The caller writes the compressed elements,
+  // after the header for LOCAL data, or to ElementDataFile otherwise.
+  bool
+  WriteCompressedHeaderStream(METAIO_STREAM::ofstream * _stream, std::streamoff _compressedDataSize);
+
 
   bool
   Append(const char * _headName = nullptr) override;